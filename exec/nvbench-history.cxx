@@ -0,0 +1,258 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/results.cuh>
+#include <nvbench/results_history.cuh>
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+void print_usage()
+{
+  fmt::print(
+    "Usage: nvbench-history append --history <history.jsonl> --revision <rev>\n"
+    "                              [--host <name>] <results.json>...\n"
+    "       nvbench-history report --history <history.jsonl> [--penalty <beta>]\n"
+    "                              [--min-segment <n>] [--threshold <percent>]\n"
+    "\n"
+    "Maintains an append-only performance history of a project.\n"
+    "\n"
+    "append  Records the mean time of every state in the NVBench JSON result\n"
+    "        files, keyed by the project revision, host, device and state.\n"
+    "        --host defaults to the hostname.\n"
+    "\n"
+    "report  Runs change-point detection on the history of each state, in the\n"
+    "        order revisions were first appended, and prints the revision that\n"
+    "        introduced each step change. --penalty (default 2) trades\n"
+    "        sensitivity for false positives, --min-segment (default 2) is the\n"
+    "        fewest revisions between changes and --threshold (default 5)\n"
+    "        hides changes smaller than the given percentage.\n");
+}
+
+std::string get_hostname()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  char name[256]{};
+  if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0')
+  {
+    return name;
+  }
+#endif
+  return "unknown";
+}
+
+std::string format_duration(double seconds)
+{
+  if (seconds >= 1.)
+  {
+    return fmt::format("{:.3f} s", seconds);
+  }
+  if (seconds >= 1e-3)
+  {
+    return fmt::format("{:.3f} ms", seconds * 1e3);
+  }
+  if (seconds >= 1e-6)
+  {
+    return fmt::format("{:.3f} us", seconds * 1e6);
+  }
+  return fmt::format("{:.3f} ns", seconds * 1e9);
+}
+
+double segment_mean(const std::vector<double> &values, std::size_t begin, std::size_t end)
+{
+  double sum = 0.;
+  for (auto i = begin; i < end; ++i)
+  {
+    sum += values[i];
+  }
+  return sum / static_cast<double>(end - begin);
+}
+
+int report(const nvbench::results::history_store &store,
+           double penalty,
+           std::size_t min_segment_size,
+           double threshold)
+{
+  const auto series = nvbench::results::make_history_series(store.read());
+
+  std::size_t num_changes = 0;
+  for (const auto &s : series)
+  {
+    const auto change_points =
+      nvbench::results::detect_change_points(s.values, penalty, min_segment_size);
+
+    std::size_t begin = 0;
+    for (std::size_t c = 0; c < change_points.size(); ++c)
+    {
+      const auto split  = change_points[c];
+      const auto end    = c + 1 < change_points.size() ? change_points[c + 1] : s.values.size();
+      const auto before = segment_mean(s.values, begin, split);
+      const auto after  = segment_mean(s.values, split, end);
+      begin             = split;
+
+      const auto diff = (after - before) / before;
+      if (!(std::abs(diff) * 100. >= threshold))
+      {
+        continue;
+      }
+
+      fmt::print("{} [{}] on {} ({}, {}):\n  {} -> {} ({:+.2f}%) at revision {} (after {})\n",
+                 s.benchmark,
+                 s.state,
+                 s.host,
+                 s.device,
+                 s.tag,
+                 format_duration(before),
+                 format_duration(after),
+                 diff * 100.,
+                 s.revisions[split],
+                 s.revisions[split - 1]);
+      ++num_changes;
+    }
+  }
+
+  fmt::print("Found {} step changes in {} series.\n", num_changes, series.size());
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char const *const *argv)
+try
+{
+  if (argc < 2)
+  {
+    print_usage();
+    return 1;
+  }
+
+  const std::string command = argv[1];
+  if (command == "--help" || command == "-h")
+  {
+    print_usage();
+    return 0;
+  }
+
+  std::string history;
+  std::string revision;
+  std::string host             = get_hostname();
+  double penalty               = 2.;
+  double threshold             = 5.;
+  std::size_t min_segment_size = 2;
+  std::vector<std::string> inputs;
+
+  for (int i = 2; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h")
+    {
+      print_usage();
+      return 0;
+    }
+    else if (arg == "--history" || arg == "--revision" || arg == "--host" || arg == "--penalty" ||
+             arg == "--min-segment" || arg == "--threshold")
+    {
+      if (i + 1 == argc)
+      {
+        fmt::print(stderr, "Missing value for {}.\n", arg);
+        return 1;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--history")
+      {
+        history = value;
+      }
+      else if (arg == "--revision")
+      {
+        revision = value;
+      }
+      else if (arg == "--host")
+      {
+        host = value;
+      }
+      else if (arg == "--penalty")
+      {
+        penalty = std::stod(value);
+      }
+      else if (arg == "--min-segment")
+      {
+        min_segment_size = static_cast<std::size_t>(std::stoul(value));
+      }
+      else
+      {
+        threshold = std::stod(value);
+      }
+    }
+    else
+    {
+      inputs.push_back(arg);
+    }
+  }
+
+  if (history.empty())
+  {
+    print_usage();
+    return 1;
+  }
+  const nvbench::results::history_store store{history};
+
+  if (command == "append")
+  {
+    if (revision.empty() || inputs.empty())
+    {
+      print_usage();
+      return 1;
+    }
+
+    std::size_t num_records = 0;
+    for (const auto &input : inputs)
+    {
+      const auto file    = nvbench::results::result_file::read(input);
+      const auto records = nvbench::results::make_history_records(file, revision, host);
+      store.append(records);
+      num_records += records.size();
+    }
+    fmt::print("Appended {} records for revision {} to '{}'.\n", num_records, revision, history);
+    return 0;
+  }
+  else if (command == "report")
+  {
+    return report(store, penalty, min_segment_size, threshold);
+  }
+
+  fmt::print(stderr, "Unknown command '{}'.\n", command);
+  print_usage();
+  return 1;
+}
+catch (std::exception &e)
+{
+  fmt::print(stderr, "\nnvbench-history encountered an error:\n\n{}\n", e.what());
+  return 1;
+}
@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/results_merge.cuh>
+
+#include <fmt/format.h>
+
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void print_usage()
+{
+  fmt::print(
+    "Usage: nvbench-merge [--policy <policy>] --output <merged.json> <results.json>...\n"
+    "\n"
+    "Merges NVBench JSON result files. States are matched by benchmark, device\n"
+    "and axis values. When a state appears in several inputs, --policy selects:\n"
+    "\n"
+    "  latest          The copy from the last input that has it (default).\n"
+    "  best-converged  The copy with the lowest relative standard deviation.\n"
+    "  pool            All samples combined.\n"
+    "\n"
+    "Sample-times files written by --jsonbin are copied to <merged.json>-bin.\n");
+}
+
+} // namespace
+
+int main(int argc, char const *const *argv)
+try
+{
+  std::string output;
+  std::vector<std::string> inputs;
+  auto policy = nvbench::results::merge_policy::latest;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h")
+    {
+      print_usage();
+      return 0;
+    }
+    else if (arg == "--output" || arg == "-o" || arg == "--policy")
+    {
+      if (i + 1 == argc)
+      {
+        fmt::print(stderr, "Missing value for {}.\n", arg);
+        return 1;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--policy")
+      {
+        policy = nvbench::results::parse_merge_policy(value);
+      }
+      else
+      {
+        output = value;
+      }
+    }
+    else
+    {
+      inputs.push_back(arg);
+    }
+  }
+
+  if (output.empty() || inputs.empty())
+  {
+    print_usage();
+    return 1;
+  }
+
+  const auto stats = nvbench::results::merge_result_files(inputs, output, policy);
+  fmt::print("Merged {} states of {} benchmarks from {} files into '{}'.\n",
+             stats.num_states,
+             stats.num_benchmarks,
+             inputs.size(),
+             output);
+  if (stats.num_duplicate_states != 0)
+  {
+    fmt::print("Resolved {} duplicate states with policy '{}'.\n",
+               stats.num_duplicate_states,
+               nvbench::results::merge_policy_to_string(policy));
+  }
+  if (stats.num_bin_files != 0)
+  {
+    fmt::print("Wrote {} sample times files to '{}-bin'.\n", stats.num_bin_files, output);
+  }
+  if (stats.num_missing_bin_files != 0)
+  {
+    fmt::print(stderr,
+               "Warning: {} sample times files could not be found and were dropped.\n",
+               stats.num_missing_bin_files);
+  }
+  return 0;
+}
+catch (std::exception &e)
+{
+  fmt::print(stderr, "\nnvbench-merge encountered an error:\n\n{}\n", e.what());
+  return 1;
+}
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nvbench
+{
+
+namespace detail
+{
+
+/// Completions reported by `nvbench::async_completion`, possibly from other
+/// threads. Shared with the handles so that operations completing after the
+/// measurement has given up on them don't touch freed memory.
+struct async_completion_queue
+{
+  using clock = std::chrono::steady_clock;
+
+  struct entry
+  {
+    std::size_t slot;
+    nvbench::uint64_t sequence;
+    clock::time_point time;
+  };
+
+  void push(std::size_t slot, nvbench::uint64_t sequence)
+  {
+    const auto now = clock::now();
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_entries.push_back({slot, sequence, now});
+    }
+    m_cv.notify_one();
+  }
+
+  /// Moves the pending completions into `entries`, waiting until there is at
+  /// least one or `deadline` has passed. Returns false on timeout.
+  bool pop_all(std::vector<entry> &entries, clock::time_point deadline)
+  {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (!m_cv.wait_until(lock, deadline, [this] { return !m_entries.empty(); }))
+    {
+      return false;
+    }
+    entries.clear();
+    std::swap(entries, m_entries);
+    return true;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<entry> m_entries;
+};
+
+} // namespace detail
+
+/**
+ * Passed to the launchers of `nvbench::exec_tag::async` benchmarks, which must
+ * call it exactly once, from any thread, when the operation they started has
+ * completed. The latency of the operation is the time from the launcher being
+ * called to the completion being reported.
+ *
+ * Handles are cheap to copy, so they can be captured by callbacks, thread
+ * pool tasks and coroutines.
+ */
+struct async_completion
+{
+  async_completion(std::shared_ptr<nvbench::detail::async_completion_queue> queue,
+                   std::size_t slot,
+                   nvbench::uint64_t sequence)
+      : m_queue{std::move(queue)}
+      , m_slot{slot}
+      , m_sequence{sequence}
+  {}
+
+  void operator()() const { m_queue->push(m_slot, m_sequence); }
+
+private:
+  std::shared_ptr<nvbench::detail::async_completion_queue> m_queue;
+  std::size_t m_slot;
+  nvbench::uint64_t m_sequence;
+};
+
+} // namespace nvbench
@@ -19,18 +19,26 @@
 #pragma once
 
 #include <nvbench/axes_metadata.cuh>
+#include <nvbench/complexity.cuh>
 #include <nvbench/device_info.cuh>
 #include <nvbench/state.cuh>
 #include <nvbench/stopping_criterion.cuh>
+#include <nvbench/summary_group.cuh>
 
 #include <functional> // reference_wrapper, ref
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace nvbench
 {
 
+namespace results
+{
+struct result_file;
+}
+
 struct printer_base;
 struct runner_base;
 
@@ -108,6 +116,12 @@ struct benchmark_base
     return *this;
   }
 
+  /// Adds a "CoRunner" string axis. Each value is a `<kind>[@<cpu>]` spec
+  /// naming background load that runs during CPU-only trials: "membw", "llc"
+  /// or "smt". "none" is added if missing, and states measured with a
+  /// co-runner report their slowdown relative to it.
+  benchmark_base &add_co_runner_axis(std::vector<std::string> specs);
+
   benchmark_base &set_devices(std::vector<int> device_ids);
 
   benchmark_base &set_devices(std::vector<nvbench::device_info> devices)
@@ -144,6 +158,53 @@ struct benchmark_base
   [[nodiscard]] const std::vector<nvbench::state> &get_states() const { return m_states; }
   [[nodiscard]] std::vector<nvbench::state> &get_states() { return m_states; }
 
+  // Summaries computed across groups of states, e.g. complexity fits.
+  // Is empty until run() is called.
+  [[nodiscard]] const std::vector<nvbench::summary_group> &get_summary_groups() const
+  {
+    return m_summary_groups;
+  }
+  [[nodiscard]] std::vector<nvbench::summary_group> &get_summary_groups()
+  {
+    return m_summary_groups;
+  }
+
+  /// Returns the summary group matching `device` and `axis_values`, creating
+  /// it if needed.
+  nvbench::summary_group &add_summary_group(const std::optional<nvbench::device_info> &device,
+                                            const nvbench::named_values &axis_values);
+
+  /// Fit the measured times to an asymptotic complexity model along the int64
+  /// axis `axis_name`. One fit is computed for each device and combination of
+  /// the remaining axes. By default, the best fitting of O(1), O(log n), O(n),
+  /// O(n log n) and O(n^2) is reported. @{
+  benchmark_base &add_complexity_fit(std::string axis_name,
+                                     nvbench::complexity model = nvbench::complexity::automatic);
+  benchmark_base &add_complexity_fit(std::string axis_name,
+                                     nvbench::complexity_function function,
+                                     std::string label = "f(n)");
+  [[nodiscard]] const std::vector<nvbench::complexity_fit> &get_complexity_fits() const
+  {
+    return m_complexity_fits;
+  }
+  /// @}
+
+  /// Aggregate the states that differ only in the axes `axis_names` into a
+  /// geometric mean time, harmonic mean throughputs and their worst state.
+  /// One aggregate is computed for each device and combination of the
+  /// remaining axes. If `axis_names` is empty, all states of each device are
+  /// aggregated. @{
+  benchmark_base &add_aggregate(std::vector<std::string> axis_names = {})
+  {
+    m_aggregates.push_back(std::move(axis_names));
+    return *this;
+  }
+  [[nodiscard]] const std::vector<std::vector<std::string>> &get_aggregates() const
+  {
+    return m_aggregates;
+  }
+  /// @}
+
   void run() { this->do_run(); }
 
   void set_printer(nvbench::printer_base &printer) { m_printer = std::ref(printer); }
@@ -192,6 +253,57 @@ struct benchmark_base
   }
   /// @}
 
+  /// If non-empty, CPU-only measurements send `enable` / `disable` commands to
+  /// a `perf record --control=fifo:<ctl>[,<ack>]` session around their timed
+  /// trials, so that host profiles exclude warmup and harness overhead. The
+  /// spec is the same `<ctl>[,<ack>]` pair of fifo paths passed to perf. @{
+  [[nodiscard]] const std::string &get_perf_ctl() const { return m_perf_ctl; }
+  benchmark_base &set_perf_ctl(std::string spec)
+  {
+    m_perf_ctl = std::move(spec);
+    return *this;
+  }
+  /// @}
+
+  /// If non-empty, CPU-only measurements run a SIGPROF sampling profiler during
+  /// their timed trials. The hottest functions are added to each state's
+  /// summaries and folded stacks are written to this directory. @{
+  [[nodiscard]] const std::string &get_cpu_profile_directory() const
+  {
+    return m_cpu_profile_directory;
+  }
+  benchmark_base &set_cpu_profile_directory(std::string directory)
+  {
+    m_cpu_profile_directory = std::move(directory);
+    return *this;
+  }
+  /// @}
+
+  /// Results of a previous run to compare each state against as it completes.
+  /// Matching states gain baseline time, difference and verdict summaries.
+  /// @{
+  [[nodiscard]] const nvbench::results::result_file *get_baseline() const
+  {
+    return m_baseline.get();
+  }
+  benchmark_base &set_baseline(std::shared_ptr<const nvbench::results::result_file> baseline)
+  {
+    m_baseline = std::move(baseline);
+    return *this;
+  }
+  /// @}
+
+  /// States that are significantly slower than the baseline by more than this
+  /// fraction of the baseline time are logged as regressions. Default is 0.05.
+  /// @{
+  [[nodiscard]] nvbench::float64_t get_baseline_threshold() const { return m_baseline_threshold; }
+  benchmark_base &set_baseline_threshold(nvbench::float64_t threshold)
+  {
+    m_baseline_threshold = threshold;
+    return *this;
+  }
+  /// @}
+
   /// If a warmup run finishes in less than `skip_time`, the measurement will
   /// be skipped.
   /// Extremely fast kernels (< 5000 ns) often timeout before they can
@@ -221,6 +333,29 @@ struct benchmark_base
   }
   /// @}
 
+  /// CPU-only states that reach `timeout` before meeting the stopping
+  /// criterion are measured again after the other states of the benchmark,
+  /// with `retry_factor` times the timeout. Zero (default) disables the retry
+  /// pass. See nvbench::detail::retry_pass. @{
+  [[nodiscard]] nvbench::float64_t get_retry_factor() const { return m_retry_factor; }
+  benchmark_base &set_retry_factor(nvbench::float64_t factor)
+  {
+    m_retry_factor = factor;
+    return *this;
+  }
+  /// @}
+
+  /// If true, a retried state whose mean time is statistically compatible
+  /// with its first pass reports the samples of both passes combined.
+  /// Otherwise only the retry is reported. Default is false. @{
+  [[nodiscard]] bool get_retry_combine() const { return m_retry_combine; }
+  benchmark_base &set_retry_combine(bool combine)
+  {
+    m_retry_combine = combine;
+    return *this;
+  }
+  /// @}
+
   [[nodiscard]] nvbench::float32_t get_throttle_threshold() const { return m_throttle_threshold; }
 
   benchmark_base &set_throttle_threshold(nvbench::float32_t throttle_threshold)
@@ -240,6 +375,144 @@ struct benchmark_base
     return *this;
   }
 
+  /// The order in which states are run on each device: "canonical" (default),
+  /// "reverse", "interleave", "random[:<seed>]" or "grouped" (by fixture
+  /// axes). Results are always reported in canonical order. A random seed is
+  /// drawn if omitted, and `get_run_order()` always includes it.
+  /// See nvbench::detail::run_order.
+  /// @{
+  [[nodiscard]] const std::string &get_run_order() const { return m_run_order; }
+  benchmark_base &set_run_order(const std::string &order);
+  /// @}
+
+  /// Seed for the generators returned by `nvbench::state::get_data_generator`,
+  /// which combine it with the benchmark name and the state's axis values.
+  /// @{
+  [[nodiscard]] nvbench::uint64_t get_data_seed() const { return m_data_seed; }
+  benchmark_base &set_data_seed(nvbench::uint64_t seed)
+  {
+    m_data_seed = seed;
+    return *this;
+  }
+  /// @}
+
+  /// The axes that fixtures from `nvbench::state::get_fixture` depend on.
+  /// States with the same values for these axes, device and type
+  /// configuration share fixtures. If unset, fixtures depend on all axes and
+  /// are only shared between calls within a state. @{
+  [[nodiscard]] const std::optional<std::vector<std::string>> &get_fixture_axes() const
+  {
+    return m_fixture_axes;
+  }
+  benchmark_base &set_fixture_axes(std::vector<std::string> axis_names)
+  {
+    m_fixture_axes = std::move(axis_names);
+    return *this;
+  }
+  /// @}
+
+  /// Maximum total size of the fixtures kept in the nvbench::fixture_cache
+  /// between states, in bytes. Zero disables caching. @{
+  [[nodiscard]] std::size_t get_fixture_cache_size() const { return m_fixture_cache_size; }
+  benchmark_base &set_fixture_cache_size(std::size_t bytes)
+  {
+    m_fixture_cache_size = bytes;
+    return *this;
+  }
+  /// @}
+
+  /// Maximum number of operations in flight for `nvbench::exec_tag::async`
+  /// benchmarks. Default is 1. @{
+  [[nodiscard]] nvbench::int64_t get_async_depth() const { return m_async_depth; }
+  benchmark_base &set_async_depth(nvbench::int64_t depth)
+  {
+    m_async_depth = depth;
+    return *this;
+  }
+  /// @}
+
+  /// How states are isolated from each other: "none" (default), "fork" or
+  /// "fork:state" (a child process per state) or "fork:benchmark" (a child
+  /// process per benchmark). Only CPU-only benchmarks can be forked.
+  /// See nvbench::detail::isolation. @{
+  [[nodiscard]] const std::string &get_isolation() const { return m_isolation; }
+  benchmark_base &set_isolation(const std::string &isolation);
+  /// @}
+
+  /// Forked states that run for longer than `hard_timeout` seconds are
+  /// killed and skipped. Unlike `timeout`, this also stops states that hang
+  /// inside a sample. Zero (default) uses ten times `timeout` plus the soak
+  /// duration. @{
+  [[nodiscard]] nvbench::float64_t get_hard_timeout() const { return m_hard_timeout; }
+  benchmark_base &set_hard_timeout(nvbench::float64_t hard_timeout)
+  {
+    m_hard_timeout = hard_timeout;
+    return *this;
+  }
+  /// @}
+
+  /// Cores to reserve on the host while the benchmark runs, so that
+  /// concurrent nvbench processes don't measure on the same cores: "none"
+  /// (default), a number of physical cores, or "numa" for a whole NUMA node.
+  /// The measuring thread is pinned to the reserved CPUs.
+  /// See nvbench::detail::core_reservation. @{
+  [[nodiscard]] const std::string &get_reserve_cores() const { return m_reserve_cores; }
+  benchmark_base &set_reserve_cores(const std::string &spec);
+  /// @}
+
+  /// Seconds to wait for reserved cores to become free before failing.
+  /// Default is 600. @{
+  [[nodiscard]] nvbench::float64_t get_reserve_timeout() const { return m_reserve_timeout; }
+  benchmark_base &set_reserve_timeout(nvbench::float64_t timeout)
+  {
+    m_reserve_timeout = timeout;
+    return *this;
+  }
+  /// @}
+
+  /// The pages backing buffers from `nvbench::state::allocate_host_buffer`:
+  /// "none", "transparent" (default) or "hugetlb".
+  /// See nvbench::host_buffer_pool. @{
+  [[nodiscard]] const std::string &get_huge_pages() const { return m_huge_pages; }
+  benchmark_base &set_huge_pages(const std::string &mode);
+  /// @}
+
+  /// Soak mode: cold and CPU-only measurements run for this many seconds
+  /// and / or samples instead of until the stopping criterion is met, and
+  /// report the drift of the mean time across `soak_windows` equal windows.
+  /// A drift larger than `soak_threshold` (a fraction, e.g. 0.05 for 5%) that
+  /// is statistically significant is reported as a degradation. Zero disables
+  /// the corresponding limit; soak mode is off if both are zero.
+  /// See nvbench::detail::soak_tracker. @{
+  [[nodiscard]] nvbench::float64_t get_soak_duration() const { return m_soak_duration; }
+  benchmark_base &set_soak_duration(nvbench::float64_t duration)
+  {
+    m_soak_duration = duration;
+    return *this;
+  }
+
+  [[nodiscard]] nvbench::int64_t get_soak_iterations() const { return m_soak_iterations; }
+  benchmark_base &set_soak_iterations(nvbench::int64_t iterations)
+  {
+    m_soak_iterations = iterations;
+    return *this;
+  }
+
+  [[nodiscard]] nvbench::int64_t get_soak_windows() const { return m_soak_windows; }
+  benchmark_base &set_soak_windows(nvbench::int64_t windows)
+  {
+    m_soak_windows = windows;
+    return *this;
+  }
+
+  [[nodiscard]] nvbench::float64_t get_soak_threshold() const { return m_soak_threshold; }
+  benchmark_base &set_soak_threshold(nvbench::float64_t threshold)
+  {
+    m_soak_threshold = threshold;
+    return *this;
+  }
+  /// @}
+
   /// Control the stopping criterion for the measurement loop.
   /// @{
   [[nodiscard]] const std::string &get_stopping_criterion() const { return m_stopping_criterion; }
@@ -297,6 +570,10 @@ protected:
   nvbench::axes_metadata m_axes;
   std::vector<nvbench::device_info> m_devices;
   std::vector<nvbench::state> m_states;
+  std::vector<nvbench::summary_group> m_summary_groups;
+
+  std::vector<nvbench::complexity_fit> m_complexity_fits;
+  std::vector<std::vector<std::string>> m_aggregates;
 
   optional_ref<nvbench::printer_base> m_printer;
 
@@ -304,17 +581,48 @@ protected:
   bool m_run_once{false};
   bool m_disable_blocking_kernel{false};
 
+  std::string m_perf_ctl;
+  std::string m_cpu_profile_directory;
+
+  std::shared_ptr<const nvbench::results::result_file> m_baseline;
+  nvbench::float64_t m_baseline_threshold{0.05};
+
   nvbench::int64_t m_min_samples{10};
 
   nvbench::float64_t m_skip_time{-1.};
   nvbench::float64_t m_timeout{15.};
 
+  nvbench::float64_t m_retry_factor{0.};
+  bool m_retry_combine{false};
+
   nvbench::float32_t m_throttle_threshold{0.75f};      // [% of default SM clock rate]
   nvbench::float32_t m_throttle_recovery_delay{0.05f}; // [seconds]
 
   nvbench::criterion_params m_criterion_params;
   std::string m_stopping_criterion{};
 
+  std::string m_run_order{"canonical"};
+
+  nvbench::uint64_t m_data_seed{};
+
+  std::optional<std::vector<std::string>> m_fixture_axes;
+  std::size_t m_fixture_cache_size{std::size_t{4} << 30};
+
+  std::string m_huge_pages{"transparent"};
+
+  nvbench::int64_t m_async_depth{1};
+
+  std::string m_isolation{"none"};
+  nvbench::float64_t m_hard_timeout{0.};
+
+  std::string m_reserve_cores{"none"};
+  nvbench::float64_t m_reserve_timeout{600.};
+
+  nvbench::float64_t m_soak_duration{0.};
+  nvbench::int64_t m_soak_iterations{0};
+  nvbench::int64_t m_soak_windows{10};
+  nvbench::float64_t m_soak_threshold{0.05};
+
 private:
   // route these through virtuals so the templated subclass can inject type info
   virtual std::unique_ptr<benchmark_base> do_clone() const            = 0;
@@ -18,10 +18,17 @@
 
 #include <nvbench/benchmark_base.cuh>
 #include <nvbench/criterion_manager.cuh>
+#include <nvbench/detail/co_runner.cuh>
+#include <nvbench/detail/core_reservation.cuh>
+#include <nvbench/detail/isolation.cuh>
+#include <nvbench/detail/run_order.cuh>
+#include <nvbench/detail/throw.cuh>
 #include <nvbench/detail/transform_reduce.cuh>
+#include <nvbench/host_buffer_pool.cuh>
 
 #include <algorithm>
 #include <cstdint>
+#include <stdexcept>
 
 namespace nvbench
 {
@@ -43,20 +50,102 @@ std::unique_ptr<benchmark_base> benchmark_base::clone() const
   result->m_run_once                = m_run_once;
   result->m_disable_blocking_kernel = m_disable_blocking_kernel;
 
+  result->m_perf_ctl              = m_perf_ctl;
+  result->m_cpu_profile_directory = m_cpu_profile_directory;
+
+  result->m_baseline           = m_baseline;
+  result->m_baseline_threshold = m_baseline_threshold;
+
   result->m_min_samples = m_min_samples;
 
   result->m_skip_time = m_skip_time;
   result->m_timeout   = m_timeout;
 
+  result->m_retry_factor  = m_retry_factor;
+  result->m_retry_combine = m_retry_combine;
+
   result->m_criterion_params        = m_criterion_params;
   result->m_throttle_threshold      = m_throttle_threshold;
   result->m_throttle_recovery_delay = m_throttle_recovery_delay;
 
   result->m_stopping_criterion = m_stopping_criterion;
 
+  result->m_complexity_fits = m_complexity_fits;
+  result->m_aggregates      = m_aggregates;
+  result->m_run_order       = m_run_order;
+
+  result->m_data_seed = m_data_seed;
+
+  result->m_fixture_axes       = m_fixture_axes;
+  result->m_fixture_cache_size = m_fixture_cache_size;
+
+  result->m_huge_pages = m_huge_pages;
+
+  result->m_async_depth = m_async_depth;
+
+  result->m_isolation    = m_isolation;
+  result->m_hard_timeout = m_hard_timeout;
+
+  result->m_reserve_cores   = m_reserve_cores;
+  result->m_reserve_timeout = m_reserve_timeout;
+
+  result->m_soak_duration   = m_soak_duration;
+  result->m_soak_iterations = m_soak_iterations;
+  result->m_soak_windows    = m_soak_windows;
+  result->m_soak_threshold  = m_soak_threshold;
+
   return result;
 }
 
+nvbench::summary_group &
+benchmark_base::add_summary_group(const std::optional<nvbench::device_info> &device,
+                                  const nvbench::named_values &axis_values)
+{
+  auto iter =
+    std::find_if(m_summary_groups.begin(), m_summary_groups.end(), [&](const auto &group) {
+      return group.get_device() == device && group.get_axis_values() == axis_values;
+    });
+  if (iter != m_summary_groups.end())
+  {
+    return *iter;
+  }
+  return m_summary_groups.emplace_back(device, axis_values);
+}
+
+benchmark_base &benchmark_base::add_complexity_fit(std::string axis_name,
+                                                   nvbench::complexity model)
+{
+  NVBENCH_THROW_IF(model == nvbench::complexity::user,
+                   std::invalid_argument,
+                   "{}",
+                   "complexity::user requires a complexity_function.");
+  m_complexity_fits.push_back({std::move(axis_name), model, {}, {}});
+  return *this;
+}
+
+benchmark_base &benchmark_base::add_complexity_fit(std::string axis_name,
+                                                   nvbench::complexity_function function,
+                                                   std::string label)
+{
+  m_complexity_fits.push_back(
+    {std::move(axis_name), nvbench::complexity::user, std::move(function), std::move(label)});
+  return *this;
+}
+
+benchmark_base &benchmark_base::add_co_runner_axis(std::vector<std::string> specs)
+{
+  // Validate the specs before any states are generated:
+  for (const auto &spec : specs)
+  {
+    [[maybe_unused]] nvbench::detail::co_runner runner{spec};
+  }
+  if (std::find(specs.cbegin(), specs.cend(), "none") == specs.cend())
+  {
+    specs.insert(specs.begin(), "none");
+  }
+  return this->add_string_axis(nvbench::detail::co_runner::axis_name, std::move(specs));
+}
+
 benchmark_base &benchmark_base::set_devices(std::vector<int> device_ids)
 {
   std::vector<device_info> devices;
@@ -100,4 +189,30 @@ benchmark_base &benchmark_base::set_stopping_criterion(std::string criterion)
   return *this;
 }
 
+benchmark_base &benchmark_base::set_run_order(const std::string &order)
+{
+  // Validates the order and fixes the random seed:
+  m_run_order = nvbench::detail::run_order::parse(order).to_string();
+  return *this;
+}
+
+benchmark_base &benchmark_base::set_isolation(const std::string &isolation)
+{
+  m_isolation = nvbench::detail::isolation::parse(isolation).to_string();
+  return *this;
+}
+
+benchmark_base &benchmark_base::set_reserve_cores(const std::string &spec)
+{
+  m_reserve_cores = nvbench::detail::core_reservation::spec::parse(spec).to_string();
+  return *this;
+}
+
+benchmark_base &benchmark_base::set_huge_pages(const std::string &mode)
+{
+  m_huge_pages =
+    nvbench::host_buffer_pool::to_string(nvbench::host_buffer_pool::parse_page_mode(mode));
+  return *this;
+}
+
 } // namespace nvbench
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nvbench
+{
+
+struct benchmark_base;
+
+/**
+ * Asymptotic complexity models that may be fit to the measured times of an
+ * int64 axis. See `benchmark_base::add_complexity_fit`.
+ */
+enum class complexity
+{
+  automatic, // Pick the built-in model with the lowest RMS error.
+  o1,        // O(1)
+  log_n,     // O(log n)
+  n,         // O(n)
+  n_log_n,   // O(n log n)
+  n_squared, // O(n^2)
+  user       // User-provided function
+};
+
+/// Maps an axis value `n` to the model's predicted cost, up to a constant.
+using complexity_function = std::function<nvbench::float64_t(nvbench::int64_t)>;
+
+/**
+ * Describes a complexity fit requested for a single int64 axis.
+ */
+struct complexity_fit
+{
+  std::string axis_name;
+  nvbench::complexity model{nvbench::complexity::automatic};
+
+  // Only used when `model == complexity::user`:
+  nvbench::complexity_function function;
+  std::string label;
+};
+
+/**
+ * The result of fitting `time = coefficient * f(n)` to a set of measurements.
+ */
+struct complexity_fit_result
+{
+  nvbench::complexity model{nvbench::complexity::automatic};
+  std::string big_o;
+  nvbench::float64_t coefficient{};
+  // Root-mean-square error of the fit, normalized by the mean time.
+  nvbench::float64_t rms{};
+};
+
+/// Returns the big-O notation for `model`, e.g. "O(n log n)".
+[[nodiscard]] std::string complexity_to_string(nvbench::complexity model);
+
+/// Parses names such as "auto", "1", "logn", "n", "nlogn", and "n2".
+/// Throws `std::runtime_error` on unrecognized input.
+[[nodiscard]] nvbench::complexity complexity_from_string(std::string_view name);
+
+namespace detail
+{
+
+/**
+ * Least-squares fit of `times[i] = coefficient * f(ns[i])`.
+ *
+ * If `fit.model` is `complexity::automatic`, all built-in models are tried
+ * and the one with the lowest RMS error is returned.
+ *
+ * Throws `std::runtime_error` if fewer than two distinct `n` are provided.
+ */
+[[nodiscard]] nvbench::complexity_fit_result
+fit_complexity(const std::vector<nvbench::int64_t> &ns,
+               const std::vector<nvbench::float64_t> &times,
+               const nvbench::complexity_fit &fit);
+
+/**
+ * Fits every `complexity_fit` requested by `bench` to its measured states and
+ * stores the results in `bench.get_summary_groups()`.
+ */
+void add_complexity_summaries(nvbench::benchmark_base &bench);
+
+} // namespace detail
+
+} // namespace nvbench
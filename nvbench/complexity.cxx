@@ -0,0 +1,321 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/complexity.cuh>
+#include <nvbench/detail/state_group.cuh>
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+nvbench::complexity_function get_builtin_function(nvbench::complexity model)
+{
+  switch (model)
+  {
+    case nvbench::complexity::o1:
+      return [](nvbench::int64_t) { return 1.; };
+    case nvbench::complexity::log_n:
+      return [](nvbench::int64_t n) { return std::log2(static_cast<nvbench::float64_t>(n)); };
+    case nvbench::complexity::n:
+      return [](nvbench::int64_t n) { return static_cast<nvbench::float64_t>(n); };
+    case nvbench::complexity::n_log_n:
+      return [](nvbench::int64_t n) {
+        const auto x = static_cast<nvbench::float64_t>(n);
+        return x * std::log2(x);
+      };
+    case nvbench::complexity::n_squared:
+      return [](nvbench::int64_t n) {
+        const auto x = static_cast<nvbench::float64_t>(n);
+        return x * x;
+      };
+    default:
+      NVBENCH_THROW(std::runtime_error, "{}", "Not a built-in complexity model.");
+  }
+}
+
+nvbench::complexity_fit_result fit_function(const std::vector<nvbench::int64_t> &ns,
+                                            const std::vector<nvbench::float64_t> &times,
+                                            const nvbench::complexity_function &function)
+{
+  // Minimize sum((t - c * f(n))^2) over c:
+  nvbench::float64_t sum_ff{};
+  nvbench::float64_t sum_tf{};
+  nvbench::float64_t sum_t{};
+  for (std::size_t i = 0; i < ns.size(); ++i)
+  {
+    const nvbench::float64_t f = function(ns[i]);
+    sum_ff += f * f;
+    sum_tf += times[i] * f;
+    sum_t += times[i];
+  }
+
+  nvbench::complexity_fit_result result;
+  if (!(sum_ff > 0.) || !std::isfinite(sum_ff))
+  {
+    result.coefficient = std::numeric_limits<nvbench::float64_t>::quiet_NaN();
+    result.rms         = std::numeric_limits<nvbench::float64_t>::infinity();
+    return result;
+  }
+  result.coefficient = sum_tf / sum_ff;
+
+  nvbench::float64_t sum_sq_err{};
+  for (std::size_t i = 0; i < ns.size(); ++i)
+  {
+    const nvbench::float64_t err = times[i] - result.coefficient * function(ns[i]);
+    sum_sq_err += err * err;
+  }
+
+  const auto num_samples = static_cast<nvbench::float64_t>(ns.size());
+  const auto mean_time   = sum_t / num_samples;
+  result.rms             = std::sqrt(sum_sq_err / num_samples) / mean_time;
+  return result;
+}
+
+} // namespace
+
+namespace nvbench
+{
+
+std::string complexity_to_string(nvbench::complexity model)
+{
+  switch (model)
+  {
+    case nvbench::complexity::automatic:
+      return "auto";
+    case nvbench::complexity::o1:
+      return "O(1)";
+    case nvbench::complexity::log_n:
+      return "O(log n)";
+    case nvbench::complexity::n:
+      return "O(n)";
+    case nvbench::complexity::n_log_n:
+      return "O(n log n)";
+    case nvbench::complexity::n_squared:
+      return "O(n^2)";
+    case nvbench::complexity::user:
+      return "f(n)";
+  }
+  return "unknown";
+}
+
+nvbench::complexity complexity_from_string(std::string_view name)
+{
+  if (name == "auto")
+  {
+    return nvbench::complexity::automatic;
+  }
+  else if (name == "1" || name == "o1")
+  {
+    return nvbench::complexity::o1;
+  }
+  else if (name == "logn")
+  {
+    return nvbench::complexity::log_n;
+  }
+  else if (name == "n")
+  {
+    return nvbench::complexity::n;
+  }
+  else if (name == "nlogn")
+  {
+    return nvbench::complexity::n_log_n;
+  }
+  else if (name == "n2")
+  {
+    return nvbench::complexity::n_squared;
+  }
+  NVBENCH_THROW(std::runtime_error,
+                "Unrecognized complexity model '{}'. "
+                "Expected one of: auto, 1, logn, n, nlogn, n2.",
+                name);
+}
+
+namespace detail
+{
+
+nvbench::complexity_fit_result fit_complexity(const std::vector<nvbench::int64_t> &ns,
+                                              const std::vector<nvbench::float64_t> &times,
+                                              const nvbench::complexity_fit &fit)
+{
+  NVBENCH_THROW_IF(ns.size() != times.size(),
+                   std::runtime_error,
+                   "Mismatched complexity inputs ({} sizes, {} times).",
+                   ns.size(),
+                   times.size());
+
+  const std::set<nvbench::int64_t> distinct_ns(ns.cbegin(), ns.cend());
+  NVBENCH_THROW_IF(distinct_ns.size() < 2,
+                   std::runtime_error,
+                   "At least two distinct values of '{}' are required, {} provided.",
+                   fit.axis_name,
+                   distinct_ns.size());
+
+  if (fit.model == nvbench::complexity::user)
+  {
+    NVBENCH_THROW_IF(!fit.function,
+                     std::runtime_error,
+                     "No complexity function provided for '{}'.",
+                     fit.axis_name);
+    auto result  = ::fit_function(ns, times, fit.function);
+    result.model = nvbench::complexity::user;
+    result.big_o = fmt::format("O({})", fit.label.empty() ? "f(n)" : fit.label);
+    return result;
+  }
+
+  if (fit.model != nvbench::complexity::automatic)
+  {
+    auto result  = ::fit_function(ns, times, ::get_builtin_function(fit.model));
+    result.model = fit.model;
+    result.big_o = nvbench::complexity_to_string(fit.model);
+    return result;
+  }
+
+  std::optional<nvbench::complexity_fit_result> best;
+  for (auto model : {nvbench::complexity::o1,
+                     nvbench::complexity::log_n,
+                     nvbench::complexity::n,
+                     nvbench::complexity::n_log_n,
+                     nvbench::complexity::n_squared})
+  {
+    auto result = ::fit_function(ns, times, ::get_builtin_function(model));
+    if (!std::isfinite(result.rms))
+    {
+      continue;
+    }
+    if (!best || result.rms < best->rms)
+    {
+      result.model = model;
+      result.big_o = nvbench::complexity_to_string(model);
+      best         = std::move(result);
+    }
+  }
+
+  NVBENCH_THROW_IF(!best,
+                   std::runtime_error,
+                   "No complexity model could be fit to '{}'.",
+                   fit.axis_name);
+  return std::move(best).value();
+}
+
+void add_complexity_summaries(nvbench::benchmark_base &bench)
+{
+  auto printer_opt_ref = bench.get_printer();
+  auto log             = [&printer_opt_ref](nvbench::log_level level, const std::string &msg) {
+    if (printer_opt_ref.has_value())
+    {
+      printer_opt_ref.value().get().log(level, msg);
+    }
+  };
+
+  for (const auto &fit : bench.get_complexity_fits())
+  {
+    try
+    {
+      // Throws if the axis doesn't exist or is not an int64 axis:
+      [[maybe_unused]] const auto &axis = bench.get_axes().get_int64_axis(fit.axis_name);
+    }
+    catch (std::exception &e)
+    {
+      log(nvbench::log_level::warn,
+          fmt::format("{}: Cannot fit complexity of '{}': {}",
+                      bench.get_name(),
+                      fit.axis_name,
+                      e.what()));
+      continue;
+    }
+
+    // States that differ only in `fit.axis_name` are fit together:
+    const auto groups = group_states(bench, {fit.axis_name});
+
+    for (const auto &group : groups)
+    {
+      std::vector<nvbench::int64_t> ns;
+      std::vector<nvbench::float64_t> times;
+      for (const auto *exec_state : group.states)
+      {
+        ns.push_back(exec_state->get_axis_values().get_int64(fit.axis_name));
+        times.push_back(find_summary(*exec_state, group.time_tag)->get_float64("value"));
+      }
+
+      nvbench::complexity_fit_result result;
+      try
+      {
+        result = nvbench::detail::fit_complexity(ns, times, fit);
+      }
+      catch (std::exception &e)
+      {
+        log(nvbench::log_level::warn,
+            fmt::format("{}: Cannot fit complexity of '{}': {}",
+                        bench.get_name(),
+                        fit.axis_name,
+                        e.what()));
+        continue;
+      }
+
+      auto &summ_group = bench.add_summary_group(group.device, group.axis_values);
+      {
+        auto &summ = summ_group.add_summary(fmt::format("nv/complexity/{}/big_o", fit.axis_name));
+        summ.set_string("name", fmt::format("BigO({})", fit.axis_name));
+        summ.set_string("description",
+                        fmt::format("Complexity model that best fits '{}' as a function of '{}'",
+                                    group.time_tag,
+                                    fit.axis_name));
+        summ.set_string("time_tag", group.time_tag);
+        summ.set_string("value", result.big_o);
+      }
+      {
+        auto &summ =
+          summ_group.add_summary(fmt::format("nv/complexity/{}/coefficient", fit.axis_name));
+        summ.set_string("name", fmt::format("Coef({})", fit.axis_name));
+        summ.set_string("hint", "duration");
+        summ.set_string("description",
+                        "Least-squares coefficient c in `time = c * f(n)` for the chosen model");
+        summ.set_float64("value", result.coefficient);
+      }
+      {
+        auto &summ = summ_group.add_summary(fmt::format("nv/complexity/{}/rms", fit.axis_name));
+        summ.set_string("name", fmt::format("RMS({})", fit.axis_name));
+        summ.set_string("hint", "percentage");
+        summ.set_string("description",
+                        "Root-mean-square error of the complexity fit, relative to the mean "
+                        "time");
+        summ.set_float64("value", result.rms);
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+} // namespace nvbench
@@ -20,6 +20,8 @@
 
 #include <nvbench/types.cuh>
 
+#include <cuda_runtime_api.h> // __forceinline__
+
 #include <chrono>
 
 namespace nvbench
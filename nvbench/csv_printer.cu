@@ -50,6 +50,76 @@ void csv_printer::do_print_benchmark_results(const benchmark_vector &benches)
   // Prepare table:
   nvbench::internal::table_builder table;
   std::size_t row = 0;
+
+  auto add_axis_cells = [&table, &format_visitor](std::size_t row,
+                                                  const nvbench::axes_metadata &axes,
+                                                  const nvbench::named_values &axis_values) {
+    for (const auto &name : axis_values.get_names())
+    {
+      // Handle power-of-two int64 axes differently:
+      if (axis_values.get_type(name) == named_values::type::int64 &&
+          axes.get_int64_axis(name).is_power_of_two())
+      {
+        const nvbench::int64_t value    = axis_values.get_int64(name);
+        const nvbench::int64_t exponent = int64_axis::compute_log2(value);
+        table.add_cell(row,
+                       name + "_axis_pow2_pretty",
+                       name + " (pow2)",
+                       fmt::format("2^{}", exponent));
+        table.add_cell(row, name + "_axis_plain", fmt::format("{}", name), fmt::to_string(value));
+      }
+      else
+      {
+        std::string value = std::visit(format_visitor, axis_values.get_value(name));
+        table.add_cell(row, name + "_axis", name, std::move(value));
+      }
+    }
+  };
+
+  auto add_summary_cells = [&table,
+                            &format_visitor](std::size_t row,
+                                             const std::vector<nvbench::summary> &summaries) {
+    for (const auto &summ : summaries)
+    {
+      if (summ.is_hidden())
+      {
+        continue;
+      }
+      const std::string &tag    = summ.get_tag();
+      const std::string &header = summ.get_name();
+
+      const std::string &hint = summ.get_hint();
+      std::string value       = std::visit(format_visitor, summ.get_value("value"));
+      if (hint == "duration")
+      {
+        table.add_cell(row, tag, header + " (sec)", std::move(value));
+      }
+      else if (hint == "item_rate")
+      {
+        table.add_cell(row, tag, header + " (elem/sec)", std::move(value));
+      }
+      else if (hint == "bytes")
+      {
+        table.add_cell(row, tag, header + " (bytes)", std::move(value));
+      }
+      else if (hint == "byte_rate")
+      {
+        table.add_cell(row, tag, header + " (bytes/sec)", std::move(value));
+      }
+      else if (hint == "sample_size")
+      {
+        table.add_cell(row, tag, header, std::move(value));
+      }
+      else if (hint == "percentage")
+      {
+        table.add_cell(row, tag, header, std::move(value));
+      }
+      else
+      {
+        table.add_cell(row, tag, header, std::move(value));
+      }
+    }
+  };
   for (const auto &bench_ptr : benches)
   {
     const auto &bench = *bench_ptr;
@@ -68,27 +138,7 @@ void csv_printer::do_print_benchmark_results(const benchmark_vector &benches)
       table.add_cell(row, "_device_id", "Device", std::move(device_id));
       table.add_cell(row, "_device_name", "Device Name", std::move(device_name));
 
-      const auto &axis_values = cur_state.get_axis_values();
-      for (const auto &name : axis_values.get_names())
-      {
-        // Handle power-of-two int64 axes differently:
-        if (axis_values.get_type(name) == named_values::type::int64 &&
-            axes.get_int64_axis(name).is_power_of_two())
-        {
-          const nvbench::int64_t value    = axis_values.get_int64(name);
-          const nvbench::int64_t exponent = int64_axis::compute_log2(value);
-          table.add_cell(row,
-                         name + "_axis_pow2_pretty",
-                         name + " (pow2)",
-                         fmt::format("2^{}", exponent));
-          table.add_cell(row, name + "_axis_plain", fmt::format("{}", name), fmt::to_string(value));
-        }
-        else
-        {
-          std::string value = std::visit(format_visitor, axis_values.get_value(name));
-          table.add_cell(row, name + "_axis", name, std::move(value));
-        }
-      }
+      add_axis_cells(row, axes, cur_state.get_axis_values());
 
       if (cur_state.is_skipped())
       {
@@ -99,46 +149,24 @@ void csv_printer::do_print_benchmark_results(const benchmark_vector &benches)
 
       table.add_cell(row, "_skip_reason", "Skipped", "No");
 
-      for (const auto &summ : cur_state.get_summaries())
-      {
-        if (summ.has_value("hide"))
-        {
-          continue;
-        }
-        const std::string &tag    = summ.get_tag();
-        const std::string &header = summ.has_value("name") ? summ.get_string("name") : tag;
-
-        const std::string hint = summ.has_value("hint") ? summ.get_string("hint") : std::string{};
-        std::string value      = std::visit(format_visitor, summ.get_value("value"));
-        if (hint == "duration")
-        {
-          table.add_cell(row, tag, header + " (sec)", std::move(value));
-        }
-        else if (hint == "item_rate")
-        {
-          table.add_cell(row, tag, header + " (elem/sec)", std::move(value));
-        }
-        else if (hint == "bytes")
-        {
-          table.add_cell(row, tag, header + " (bytes)", std::move(value));
-        }
-        else if (hint == "byte_rate")
-        {
-          table.add_cell(row, tag, header + " (bytes/sec)", std::move(value));
-        }
-        else if (hint == "sample_size")
-        {
-          table.add_cell(row, tag, header, std::move(value));
-        }
-        else if (hint == "percentage")
-        {
-          table.add_cell(row, tag, header, std::move(value));
-        }
-        else
-        {
-          table.add_cell(row, tag, header, std::move(value));
-        }
-      }
+      add_summary_cells(row, cur_state.get_summaries());
+      row++;
+    }
+
+    // Benchmark-level summaries, e.g. complexity fits:
+    for (const auto &group : bench.get_summary_groups())
+    {
+      const auto &device = group.get_device();
+
+      std::string device_id   = device ? fmt::to_string(device->get_id()) : std::string{};
+      std::string device_name = device ? std::string{device->get_name()} : std::string{};
+
+      table.add_cell(row, "_bench_name", "Benchmark", bench_name);
+      table.add_cell(row, "_device_id", "Device", std::move(device_id));
+      table.add_cell(row, "_device_name", "Device Name", std::move(device_name));
+
+      add_axis_cells(row, axes, group.get_axis_values());
+      add_summary_cells(row, group.get_summaries());
       row++;
     }
   }
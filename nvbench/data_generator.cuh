@@ -0,0 +1,316 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/detail/philox.cuh>
+#include <nvbench/types.cuh>
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace nvbench
+{
+
+namespace detail
+{
+
+/// Calls `body(begin, end)` on disjoint chunks of `[0, count)` using up to
+/// `num_threads` threads (0: one per hardware thread).
+void parallel_for(std::size_t count,
+                  unsigned num_threads,
+                  const std::function<void(std::size_t, std::size_t)> &body);
+
+/// Zipf distribution over the ranks `[1, num_values]` by rejection-inversion
+/// (Hörmann and Derflinger, 1996), which needs O(1) time and memory per
+/// sample for any number of values.
+struct zipf_sampler
+{
+  zipf_sampler(nvbench::uint64_t num_values, nvbench::float64_t exponent);
+
+  /// Returns the rank for `u` in [0, 1), or 0 if `u` is rejected.
+  [[nodiscard]] nvbench::uint64_t sample(nvbench::float64_t u) const;
+
+private:
+  [[nodiscard]] nvbench::float64_t h(nvbench::float64_t x) const;
+  [[nodiscard]] nvbench::float64_t h_integral(nvbench::float64_t x) const;
+  [[nodiscard]] nvbench::float64_t h_integral_inverse(nvbench::float64_t x) const;
+
+  nvbench::float64_t m_num_values;
+  nvbench::float64_t m_exponent;
+  nvbench::float64_t m_h_integral_x1;
+  nvbench::float64_t m_h_integral_num_values;
+  nvbench::float64_t m_s;
+};
+
+} // namespace detail
+
+/**
+ * Fast, reproducible host-side generation of benchmark inputs.
+ *
+ * Every value is computed from the seed, the stream and the value's index with
+ * the counter-based Philox4x32-10 generator, so the output does not depend on
+ * the number of threads and any sub-range can be regenerated independently.
+ * Work is split across all hardware threads.
+ *
+ * Generators for a state are obtained from `nvbench::state::get_data_generator`,
+ * which derives the seed from the benchmark's data seed and the state's axis
+ * values. Use different streams for independent arrays, e.g. keys and values:
+ *
+ * ```cpp
+ * std::vector<nvbench::uint32_t> keys(n);
+ * state.get_data_generator().uniform(keys.data(), n, 0u, 1000u);
+ *
+ * std::vector<float> values(n);
+ * state.get_data_generator(1).normal(values.data(), n, 0., 1.);
+ * ```
+ *
+ * Integer outputs may be any integral type; floating point outputs `float`
+ * or `double`.
+ */
+struct data_generator
+{
+  explicit data_generator(nvbench::uint64_t seed,
+                          nvbench::uint32_t stream = 0,
+                          unsigned num_threads     = 0)
+      : m_seed{seed}
+      , m_stream{stream}
+      , m_num_threads{num_threads}
+  {}
+
+  [[nodiscard]] nvbench::uint64_t get_seed() const { return m_seed; }
+  [[nodiscard]] nvbench::uint32_t get_stream() const { return m_stream; }
+
+  /// Uniformly distributed values in [min, max] for integers, [min, max) for
+  /// floating point types.
+  template <typename T>
+  void uniform(T *data, std::size_t count, T min, T max) const
+  {
+    static_assert(std::is_arithmetic_v<T>, "Expected an integral or floating point type.");
+    this->for_each(data, count, [this, min, max](std::size_t index) {
+      if constexpr (std::is_integral_v<T>)
+      {
+        // Subtract as unsigned, `max - min` overflows for full-range signed
+        // bounds. A range of 0 is the full 64-bit range:
+        using unsigned_t   = std::make_unsigned_t<T>;
+        const auto span    = static_cast<unsigned_t>(static_cast<unsigned_t>(max) -
+                                                     static_cast<unsigned_t>(min));
+        const auto range   = nvbench::uint64_t{span} + 1;
+        const auto r       = this->get_bits(index);
+        const auto offset  = range == 0 ? r : scale(r, range);
+        return static_cast<T>(static_cast<unsigned_t>(min) + static_cast<unsigned_t>(offset));
+      }
+      else
+      {
+        return uniform_real(min, max, this->get_unit(index));
+      }
+    });
+  }
+
+  /// Maps `unit` in [0, 1) to [min, max). The value is computed in `T` and
+  /// kept below `max`, since rounding `unit` to `T` may otherwise reach it.
+  template <typename T>
+  [[nodiscard]] static T uniform_real(T min, T max, nvbench::float64_t unit)
+  {
+    static_assert(std::is_floating_point_v<T>, "Expected a floating point type.");
+    const T value = min + (max - min) * static_cast<T>(unit);
+    const T limit = std::nextafter(max, min);
+    return value < limit ? value : limit;
+  }
+
+  /// Normally distributed values; integers are rounded to the nearest value.
+  template <typename T>
+  void normal(T *data, std::size_t count, nvbench::float64_t mean, nvbench::float64_t stddev) const
+  {
+    static_assert(std::is_arithmetic_v<T>, "Expected an integral or floating point type.");
+    this->for_each(data, count, [this, mean, stddev](std::size_t index) {
+      // Box-Muller; 1 - u is in (0, 1]:
+      constexpr auto two_pi = 6.283185307179586;
+      const auto u0         = 1. - this->get_unit(index, 0);
+      const auto u1         = this->get_unit(index, 1);
+      const auto value = mean + stddev * std::sqrt(-2. * std::log(u0)) * std::cos(two_pi * u1);
+      if constexpr (std::is_integral_v<T>)
+      {
+        return static_cast<T>(std::llround(value));
+      }
+      else
+      {
+        return static_cast<T>(value);
+      }
+    });
+  }
+
+  /// Zipf distributed values in [0, num_values), where the probability of `k`
+  /// is proportional to `1 / (k + 1)^exponent`. `exponent` must be positive.
+  template <typename T>
+  void zipf(T *data,
+            std::size_t count,
+            nvbench::uint64_t num_values,
+            nvbench::float64_t exponent = 1.) const
+  {
+    static_assert(std::is_arithmetic_v<T>, "Expected an integral or floating point type.");
+    const detail::zipf_sampler sampler{num_values, exponent};
+    this->for_each(data, count, [this, &sampler](std::size_t index) {
+      for (nvbench::uint32_t attempt = 0;; ++attempt)
+      {
+        if (const auto rank = sampler.sample(this->get_unit(index, attempt)); rank != 0)
+        {
+          return static_cast<T>(rank - 1);
+        }
+      }
+    });
+  }
+
+  /// Non-decreasing values spread evenly over [min, max]. Each value is
+  /// replaced by a uniformly distributed one with probability
+  /// `unsorted_fraction`, producing nearly sorted input.
+  template <typename T>
+  void sorted(T *data,
+              std::size_t count,
+              T min,
+              T max,
+              nvbench::float64_t unsorted_fraction = 0.) const
+  {
+    static_assert(std::is_arithmetic_v<T>, "Expected an integral or floating point type.");
+    const auto lo   = static_cast<long double>(min);
+    const auto span = static_cast<long double>(max) - lo + (std::is_integral_v<T> ? 1 : 0);
+    this->for_each(data, count, [this, lo, span, count, unsorted_fraction](std::size_t index) {
+      if (unsorted_fraction > 0. && this->get_unit(index, 1) < unsorted_fraction)
+      {
+        if constexpr (std::is_integral_v<T>)
+        {
+          return static_cast<T>(std::floor(lo + span * this->get_unit(index, 2)));
+        }
+        else
+        {
+          return static_cast<T>(lo + span * this->get_unit(index, 2));
+        }
+      }
+      const auto position = static_cast<long double>(index) / static_cast<long double>(count);
+      if constexpr (std::is_integral_v<T>)
+      {
+        return static_cast<T>(std::floor(lo + span * position));
+      }
+      else
+      {
+        return static_cast<T>(lo + span * position);
+      }
+    });
+  }
+
+  /// Integers whose bits are set with probability 2^-k, the bitwise AND of
+  /// k uniform values, as in the CUB benchmarks. `entropy` is the Shannon
+  /// entropy per bit and selects the nearest of 1 (k = 1), 0.811 (k = 2),
+  /// 0.544 (k = 3), 0.337 (k = 4) and 0.201 (k = 5); 0 produces all zeros.
+  template <typename T>
+  void entropy_bits(T *data, std::size_t count, nvbench::float64_t entropy) const
+  {
+    static_assert(std::is_integral_v<T>, "Expected an integral type.");
+    const auto num_ands = get_entropy_and_count(entropy);
+    this->for_each(data, count, [this, num_ands](std::size_t index) {
+      if (num_ands == 0)
+      {
+        return T{};
+      }
+      auto bits = this->get_bits(index, 0);
+      for (nvbench::uint32_t i = 1; i < num_ands; ++i)
+      {
+        bits &= this->get_bits(index, i);
+      }
+      return static_cast<T>(bits);
+    });
+  }
+
+  /// Convenience overloads that return a new vector. @{
+  template <typename T>
+  [[nodiscard]] std::vector<T> uniform(std::size_t count, T min, T max) const
+  {
+    std::vector<T> result(count);
+    this->uniform(result.data(), count, min, max);
+    return result;
+  }
+
+  template <typename T>
+  [[nodiscard]] std::vector<T>
+  normal(std::size_t count, nvbench::float64_t mean, nvbench::float64_t stddev) const
+  {
+    std::vector<T> result(count);
+    this->normal(result.data(), count, mean, stddev);
+    return result;
+  }
+  /// @}
+
+  /// The number of uniform values ANDed together for `entropy`; 0 for zero
+  /// entropy.
+  [[nodiscard]] static nvbench::uint32_t get_entropy_and_count(nvbench::float64_t entropy);
+
+  /// 64 random bits for `index`. `attempt` selects further independent draws
+  /// for the same index.
+  [[nodiscard]] nvbench::uint64_t get_bits(std::size_t index, nvbench::uint32_t attempt = 0) const
+  {
+    const auto index_64 = static_cast<nvbench::uint64_t>(index);
+    const auto words =
+      detail::philox4x32::generate({static_cast<nvbench::uint32_t>(index_64),
+                                    static_cast<nvbench::uint32_t>(index_64 >> 32),
+                                    m_stream,
+                                    attempt},
+                                   {static_cast<nvbench::uint32_t>(m_seed),
+                                    static_cast<nvbench::uint32_t>(m_seed >> 32)});
+    return (nvbench::uint64_t{words[0]} << 32) | words[1];
+  }
+
+  /// A uniform value in [0, 1) with 53 random bits.
+  [[nodiscard]] nvbench::float64_t get_unit(std::size_t index, nvbench::uint32_t attempt = 0) const
+  {
+    return static_cast<nvbench::float64_t>(this->get_bits(index, attempt) >> 11) * 0x1.0p-53;
+  }
+
+private:
+  // Maps 64 random bits to [0, range) without a division where possible:
+  [[nodiscard]] static nvbench::uint64_t scale(nvbench::uint64_t bits, nvbench::uint64_t range)
+  {
+#ifdef __SIZEOF_INT128__
+    return static_cast<nvbench::uint64_t>((static_cast<unsigned __int128>(bits) * range) >> 64);
+#else
+    return bits % range;
+#endif
+  }
+
+  template <typename T, typename ValueFn>
+  void for_each(T *data, std::size_t count, ValueFn value_fn) const
+  {
+    detail::parallel_for(count,
+                         m_num_threads,
+                         [data, &value_fn](std::size_t begin, std::size_t end) {
+                           for (std::size_t index = begin; index < end; ++index)
+                           {
+                             data[index] = value_fn(index);
+                           }
+                         });
+  }
+
+  nvbench::uint64_t m_seed;
+  nvbench::uint32_t m_stream;
+  unsigned m_num_threads;
+};
+
+} // namespace nvbench
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/data_generator.cuh>
+#include <nvbench/detail/throw.cuh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// Spawning threads isn't worth it for less work than this:
+constexpr std::size_t min_chunk_size = std::size_t{1} << 16;
+
+// Shannon entropy per bit of the AND of `k` uniform bits:
+nvbench::float64_t get_bit_entropy(nvbench::uint32_t k)
+{
+  const auto p = std::ldexp(1., -static_cast<int>(k));
+  return p >= 1. ? 0. : -p * std::log2(p) - (1. - p) * std::log2(1. - p);
+}
+
+// log1p(x) / x and expm1(x) / x, accurate near 0:
+nvbench::float64_t helper_1(nvbench::float64_t x)
+{
+  return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1. - x * (0.5 - x * (1. / 3. - 0.25 * x));
+}
+
+nvbench::float64_t helper_2(nvbench::float64_t x)
+{
+  return std::abs(x) > 1e-8 ? std::expm1(x) / x
+                            : 1. + x * 0.5 * (1. + x * (1. / 3.) * (1. + 0.25 * x));
+}
+
+} // namespace
+
+namespace nvbench
+{
+
+nvbench::uint32_t data_generator::get_entropy_and_count(nvbench::float64_t entropy)
+{
+  NVBENCH_THROW_IF(!(entropy >= 0. && entropy <= 1.),
+                   std::runtime_error,
+                   "Bit entropy must be in [0, 1], got {}.",
+                   entropy);
+  if (entropy == 0.)
+  {
+    return 0;
+  }
+
+  nvbench::uint32_t best = 1;
+  for (nvbench::uint32_t k = 2; k <= 5; ++k)
+  {
+    if (std::abs(get_bit_entropy(k) - entropy) < std::abs(get_bit_entropy(best) - entropy))
+    {
+      best = k;
+    }
+  }
+  return best;
+}
+
+namespace detail
+{
+
+void parallel_for(std::size_t count,
+                  unsigned num_threads,
+                  const std::function<void(std::size_t, std::size_t)> &body)
+{
+  if (num_threads == 0)
+  {
+    num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  const auto max_chunks = std::max(count / min_chunk_size, std::size_t{1});
+  const auto num_chunks = std::min(static_cast<std::size_t>(num_threads), max_chunks);
+  if (num_chunks <= 1)
+  {
+    body(0, count);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(num_chunks);
+  std::vector<std::thread> threads;
+  threads.reserve(num_chunks - 1);
+  auto run_chunk = [&](std::size_t chunk) {
+    try
+    {
+      body(count * chunk / num_chunks, count * (chunk + 1) / num_chunks);
+    }
+    catch (...)
+    {
+      errors[chunk] = std::current_exception();
+    }
+  };
+  for (std::size_t chunk = 1; chunk < num_chunks; ++chunk)
+  {
+    threads.emplace_back(run_chunk, chunk);
+  }
+  run_chunk(0);
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const auto &error : errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+zipf_sampler::zipf_sampler(nvbench::uint64_t num_values, nvbench::float64_t exponent)
+    : m_num_values{static_cast<nvbench::float64_t>(num_values)}
+    , m_exponent{exponent}
+{
+  NVBENCH_THROW_IF(num_values == 0, std::runtime_error, "{}", "Zipf needs at least one value.");
+  NVBENCH_THROW_IF(!(exponent > 0.),
+                   std::runtime_error,
+                   "Zipf exponent must be positive, got {}.",
+                   exponent);
+
+  m_h_integral_x1         = this->h_integral(1.5) - 1.;
+  m_h_integral_num_values = this->h_integral(m_num_values + 0.5);
+  m_s                     = 2. - this->h_integral_inverse(this->h_integral(2.5) - this->h(2.));
+}
+
+nvbench::uint64_t zipf_sampler::sample(nvbench::float64_t u) const
+{
+  const auto v = m_h_integral_num_values + u * (m_h_integral_x1 - m_h_integral_num_values);
+  const auto x = this->h_integral_inverse(v);
+  const auto k = std::clamp(std::floor(x + 0.5), 1., m_num_values);
+  if (k - x <= m_s || v >= this->h_integral(k + 0.5) - this->h(k))
+  {
+    return static_cast<nvbench::uint64_t>(k);
+  }
+  return 0;
+}
+
+nvbench::float64_t zipf_sampler::h(nvbench::float64_t x) const
+{
+  return std::exp(-m_exponent * std::log(x));
+}
+
+nvbench::float64_t zipf_sampler::h_integral(nvbench::float64_t x) const
+{
+  const auto log_x = std::log(x);
+  return helper_2((1. - m_exponent) * log_x) * log_x;
+}
+
+nvbench::float64_t zipf_sampler::h_integral_inverse(nvbench::float64_t x) const
+{
+  const auto t = std::max(x * (1. - m_exponent), -1.);
+  return std::exp(helper_1(t) * x);
+}
+
+} // namespace detail
+} // namespace nvbench
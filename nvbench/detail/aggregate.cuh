@@ -0,0 +1,43 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+namespace nvbench
+{
+struct benchmark_base;
+}
+
+namespace nvbench::detail
+{
+
+/**
+ * Computes the aggregates requested with `benchmark_base::add_aggregate` and
+ * stores them in `bench.get_summary_groups()`.
+ *
+ * Each aggregate reports the number of states, the geometric mean of their
+ * mean times (cold GPU, CPU-only or batch GPU, as for complexity fits), the
+ * harmonic means of their item and global memory rates when every state has
+ * them, and the geometric mean of their ratios to the baseline for states
+ * that were compared with `--baseline`. The worst state is the one that
+ * regressed the most from the baseline, or else the one with the lowest item
+ * rate, or else the slowest.
+ */
+void add_aggregate_summaries(nvbench::benchmark_base &bench);
+
+} // namespace nvbench::detail
@@ -0,0 +1,264 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/aggregate.cuh>
+#include <nvbench/detail/state_group.cuh>
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::optional<nvbench::float64_t> find_value(const nvbench::state &state, const std::string &tag)
+{
+  const auto *summ = nvbench::detail::find_summary(state, tag);
+  return summ && summ->has_value("value") ? std::make_optional(summ->get_float64("value"))
+                                           : std::nullopt;
+}
+
+// "Device=0 Elements=2^20 T=I32" -> "Elements=2^20" for `axis_names` {"Elements"}.
+// All axes are kept if `axis_names` is empty.
+std::string format_axis_values(const nvbench::state &state,
+                               const std::vector<std::string> &axis_names)
+{
+  const auto full          = state.get_axis_values_as_string();
+  const auto &axis_values  = state.get_axis_values();
+  const auto is_axis_start = [&axis_values](const std::string &token) {
+    const auto eq_pos = token.find('=');
+    return eq_pos != std::string::npos && axis_values.has_value(token.substr(0, eq_pos));
+  };
+  const auto is_kept = [&axis_names](const std::string &token) {
+    return axis_names.empty() ||
+           std::find(axis_names.cbegin(), axis_names.cend(), token.substr(0, token.find('='))) !=
+             axis_names.cend();
+  };
+
+  std::string result;
+  bool keep         = false;
+  std::size_t begin = 0;
+  while (begin < full.size())
+  {
+    const auto end   = std::min(full.find(' ', begin), full.size());
+    const auto token = full.substr(begin, end - begin);
+    begin            = end + 1;
+
+    // Tokens that don't start an axis belong to the previous value, e.g. a
+    // string with spaces, or are the device id:
+    if (is_axis_start(token))
+    {
+      keep = is_kept(token);
+    }
+    if (keep)
+    {
+      result += result.empty() ? "" : " ";
+      result += token;
+    }
+  }
+  return result;
+}
+
+void add_group_summaries(nvbench::summary_group &summ_group,
+                         const nvbench::detail::state_group &group,
+                         const std::vector<std::string> &axis_names)
+{
+  // "nv/cold/time/gpu/mean" -> "nv/cold/"
+  const auto prefix = group.time_tag.substr(0, group.time_tag.find("/time/") + 1);
+  const auto num_states = static_cast<nvbench::float64_t>(group.states.size());
+
+  nvbench::float64_t sum_log_time{};
+  std::optional<nvbench::float64_t> sum_inv_item_rate{0.};
+  std::optional<nvbench::float64_t> sum_inv_byte_rate{0.};
+  nvbench::float64_t sum_log_base_ratio{};
+  nvbench::int64_t num_base_states{};
+
+  const nvbench::state *worst_state{};
+  nvbench::float64_t worst_score = -std::numeric_limits<nvbench::float64_t>::infinity();
+  enum class worst_by
+  {
+    time,
+    item_rate,
+    baseline
+  } worst_kind = worst_by::time;
+
+  for (const auto *state : group.states)
+  {
+    const auto time = ::find_value(*state, group.time_tag).value_or(0.);
+    sum_log_time += std::log(time);
+
+    const auto item_rate = ::find_value(*state, prefix + "bw/item_rate");
+    const auto byte_rate = ::find_value(*state, prefix + "bw/global/bytes_per_second");
+    const auto base_diff = ::find_value(*state, "nv/baseline/diff");
+
+    sum_inv_item_rate = sum_inv_item_rate && item_rate && *item_rate > 0.
+                          ? std::make_optional(*sum_inv_item_rate + 1. / *item_rate)
+                          : std::nullopt;
+    sum_inv_byte_rate = sum_inv_byte_rate && byte_rate && *byte_rate > 0.
+                          ? std::make_optional(*sum_inv_byte_rate + 1. / *byte_rate)
+                          : std::nullopt;
+    if (base_diff && *base_diff > -1.)
+    {
+      sum_log_base_ratio += std::log1p(*base_diff);
+      ++num_base_states;
+    }
+
+    // Higher scores are worse. Stronger criteria replace weaker ones:
+    auto kind  = worst_by::time;
+    auto score = time;
+    if (base_diff)
+    {
+      kind  = worst_by::baseline;
+      score = *base_diff;
+    }
+    else if (item_rate)
+    {
+      kind  = worst_by::item_rate;
+      score = -*item_rate;
+    }
+    if (kind > worst_kind || (kind == worst_kind && score > worst_score))
+    {
+      worst_kind  = kind;
+      worst_score = score;
+      worst_state = state;
+    }
+  }
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/aggregate/num_states", "States", {}, "Number of states that were aggregated"});
+    auto &summ = summ_group.add_summary(desc);
+    summ.set_int64("value", static_cast<nvbench::int64_t>(group.states.size()));
+  }
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/aggregate/time/geomean",
+       "GeoMean Time",
+       "duration",
+       "Geometric mean of the mean times of the aggregated states"});
+    auto &summ = summ_group.add_summary(desc);
+    summ.set_string("time_tag", group.time_tag);
+    summ.set_float64("value", std::exp(sum_log_time / num_states));
+  }
+  if (sum_inv_item_rate)
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/aggregate/bw/item_rate/hmean",
+       "HMean Elem/s",
+       "item_rate",
+       "Harmonic mean of the item rates of the aggregated states"});
+    auto &summ = summ_group.add_summary(desc);
+    summ.set_float64("value", num_states / *sum_inv_item_rate);
+  }
+  if (sum_inv_byte_rate)
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/aggregate/bw/global/bytes_per_second/hmean",
+       "HMean GlobalMem BW",
+       "byte_rate",
+       "Harmonic mean of the global memory bandwidths of the aggregated states"});
+    auto &summ = summ_group.add_summary(desc);
+    summ.set_float64("value", num_states / *sum_inv_byte_rate);
+  }
+  if (num_base_states != 0)
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/aggregate/baseline/diff",
+       "GeoMean Δ%",
+       "percentage",
+       "Geometric mean of the time ratios to the baseline, minus one, over the aggregated "
+       "states found in the baseline"});
+    auto &summ = summ_group.add_summary(desc);
+    summ.set_float64("value",
+                     std::expm1(sum_log_base_ratio / static_cast<nvbench::float64_t>(
+                                                       num_base_states)));
+  }
+  if (worst_state != nullptr)
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/aggregate/worst_state",
+       "Worst",
+       {},
+       "The aggregated state that regressed the most from the baseline, or else the one with "
+       "the lowest item rate, or else the slowest"});
+    auto &summ = summ_group.add_summary(desc);
+    summ.set_string("value", ::format_axis_values(*worst_state, axis_names));
+  }
+}
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+void add_aggregate_summaries(nvbench::benchmark_base &bench)
+{
+  for (const auto &axis_names : bench.get_aggregates())
+  {
+    const auto missing =
+      std::find_if(axis_names.cbegin(), axis_names.cend(), [&bench](const auto &name) {
+        const auto &axes = bench.get_axes().get_axes();
+        return std::none_of(axes.cbegin(), axes.cend(), [&name](const auto &axis) {
+          return axis->get_name() == name;
+        });
+      });
+    if (missing != axis_names.cend())
+    {
+      if (auto printer_opt_ref = bench.get_printer(); printer_opt_ref.has_value())
+      {
+        printer_opt_ref.value().get().log(
+          nvbench::log_level::warn,
+          fmt::format("{}: Cannot aggregate over '{}': No such axis.", bench.get_name(), *missing));
+      }
+      continue;
+    }
+
+    // States that differ only in `axis_names` are aggregated together. No
+    // names aggregate over all axes:
+    std::vector<std::string> grouped_names = axis_names;
+    if (grouped_names.empty())
+    {
+      for (const auto &axis : bench.get_axes().get_axes())
+      {
+        grouped_names.push_back(axis->get_name());
+      }
+    }
+    const auto groups = group_states(bench, grouped_names, [](const nvbench::state &exec_state) {
+      const auto *time_summ = find_time_summary(exec_state);
+      return time_summ->has_value("value") && time_summ->get_float64("value") > 0.;
+    });
+
+    for (const auto &group : groups)
+    {
+      auto &summ_group = bench.add_summary_group(group.device, group.axis_values);
+      ::add_group_summaries(summ_group, group, axis_names);
+    }
+  }
+}
+
+} // namespace nvbench::detail
@@ -0,0 +1,42 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+namespace nvbench
+{
+struct state;
+}
+
+namespace nvbench::detail
+{
+
+/**
+ * Compares a completed state with the state of the same name in its
+ * benchmark's baseline results, if any.
+ *
+ * The first mean time found among the cold, CPU-only and batch measurements
+ * is compared. The state gains the baseline time, the relative difference and
+ * a verdict: "SAME" if the difference is within the smaller of the two
+ * relative standard deviations, "FAST" or "SLOW" otherwise, and "????" if
+ * neither noise is known. Significant regressions larger than the benchmark's
+ * baseline threshold are logged as warnings.
+ */
+void add_baseline_summaries(nvbench::state &state);
+
+} // namespace nvbench::detail
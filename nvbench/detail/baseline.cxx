@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/baseline.cuh>
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/results.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+
+namespace
+{
+
+// "<measurement>/time/<clock>/mean" -> "<measurement>/time/<clock>/stdev/relative"
+std::string get_noise_tag(const std::string &time_tag)
+{
+  return time_tag.substr(0, time_tag.rfind('/')) + "/stdev/relative";
+}
+
+// Too few samples are reported as infinite noise:
+std::optional<nvbench::float64_t> as_noise(nvbench::float64_t noise)
+{
+  return std::isfinite(noise) ? std::make_optional(noise) : std::nullopt;
+}
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+void add_baseline_summaries(nvbench::state &state)
+{
+  const auto &bench    = state.get_benchmark();
+  const auto *baseline = bench.get_baseline();
+  if (baseline == nullptr || state.is_skipped())
+  {
+    return;
+  }
+
+  const auto *base_bench = baseline->find_benchmark(bench.get_name());
+  const auto *base_state =
+    base_bench ? base_bench->find_state(state.get_axis_values_as_string()) : nullptr;
+  if (base_state == nullptr || base_state->is_skipped())
+  {
+    return;
+  }
+
+  for (const std::string time_tag : preferred_time_tags)
+  {
+    const auto *time_summ = find_summary(state, time_tag);
+    const auto *base_summ = base_state->find_summary(time_tag);
+    if (time_summ == nullptr || base_summ == nullptr || !base_summ->has_value("value"))
+    {
+      continue;
+    }
+
+    const auto time      = time_summ->get_float64("value");
+    const auto base_time = base_summ->get_float64("value");
+    if (!(base_time > 0.))
+    {
+      continue;
+    }
+    const auto frac_diff = time / base_time - 1.;
+
+    const auto noise_tag = ::get_noise_tag(time_tag);
+    std::optional<nvbench::float64_t> noise;
+    std::optional<nvbench::float64_t> base_noise;
+    if (const auto *summ = find_summary(state, noise_tag); summ && summ->has_value("value"))
+    {
+      noise = ::as_noise(summ->get_float64("value"));
+    }
+    if (const auto *summ = base_state->find_summary(noise_tag); summ && summ->has_value("value"))
+    {
+      base_noise = ::as_noise(summ->get_float64("value"));
+    }
+
+    // Same rule as scripts/nvbench_compare.py:
+    const auto min_noise  = noise && base_noise ? std::make_optional(std::min(*noise, *base_noise))
+                                                : noise ? noise : base_noise;
+
+    const char *verdict = "????";
+    if (min_noise)
+    {
+      verdict = std::abs(frac_diff) <= *min_noise ? "SAME" : frac_diff < 0. ? "FAST" : "SLOW";
+    }
+
+    {
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/baseline/time",
+         "Base Time",
+         "duration",
+         "Mean time of the matching state in the baseline results"});
+      auto &summ = state.add_summary(desc);
+      summ.set_string("time_tag", time_tag);
+      summ.set_float64("value", base_time);
+    }
+    {
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/baseline/diff",
+         "Δ%",
+         "percentage",
+         "Relative difference of the mean time from the baseline"});
+      auto &summ = state.add_summary(desc);
+      summ.set_float64("value", frac_diff);
+    }
+    {
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/baseline/verdict",
+         "Verdict",
+         {},
+         "SAME if the difference from the baseline is within the noise, otherwise FAST or "
+         "SLOW; ???? if the noise is unknown"});
+      auto &summ = state.add_summary(desc);
+      summ.set_string("value", verdict);
+    }
+
+    if (std::string_view{verdict} == "SLOW" && frac_diff > bench.get_baseline_threshold())
+    {
+      if (auto printer_opt_ref = bench.get_printer(); printer_opt_ref.has_value())
+      {
+        auto &printer = printer_opt_ref.value().get();
+        printer.log(nvbench::log_level::warn,
+                    fmt::format("Regressed {:.2f}% from baseline ({:.4g}s -> {:.4g}s, noise "
+                                "{:.2f}%)",
+                                frac_diff * 100.,
+                                base_time,
+                                time,
+                                min_noise.value_or(0.) * 100.));
+      }
+    }
+    break;
+  }
+}
+
+} // namespace nvbench::detail
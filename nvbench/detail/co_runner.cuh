@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nvbench
+{
+struct benchmark_base;
+}
+
+namespace nvbench::detail
+{
+
+/**
+ * Background load started on another core while CPU-only trials run, so that
+ * benchmarks can report their sensitivity to noisy neighbors.
+ *
+ * Specs have the form `<kind>[@<cpu>]`:
+ *
+ * - `none`: No background load.
+ * - `membw`: Streams through a buffer much larger than the last-level cache,
+ *   consuming memory bandwidth.
+ * - `llc`: Repeatedly writes every cache line of a buffer the size of the
+ *   last-level cache, evicting the benchmark's working set.
+ * - `smt`: Spins on integer arithmetic on the SMT sibling of the measuring
+ *   thread's core. The measuring thread is pinned to its current CPU while the
+ *   co-runner is active.
+ *
+ * `@<cpu>` pins the co-runner to a CPU. By default, `membw` and `llc` are not
+ * pinned. Only supported on Linux.
+ */
+struct co_runner
+{
+  enum class kind
+  {
+    none,
+    memory_bandwidth,
+    cache_thrash,
+    smt_spin
+  };
+
+  /// Name of the string axis added by `benchmark_base::add_co_runner_axis`.
+  static constexpr const char *axis_name = "CoRunner";
+
+  /// Throws if `spec` is malformed.
+  explicit co_runner(const std::string &spec);
+  ~co_runner();
+
+  // Owns a thread that references members:
+  co_runner(const co_runner &)            = delete;
+  co_runner(co_runner &&)                 = delete;
+  co_runner &operator=(const co_runner &) = delete;
+  co_runner &operator=(co_runner &&)      = delete;
+
+  /// Returns once the background load is running.
+  void start();
+  void stop();
+
+  [[nodiscard]] kind get_kind() const { return m_kind; }
+  /// The CPU the co-runner is pinned to, or -1.
+  [[nodiscard]] int get_cpu() const { return m_cpu; }
+  /// Bytes of memory touched per pass over the co-runner's buffer.
+  [[nodiscard]] std::size_t get_buffer_size() const { return m_buffer.size(); }
+
+  [[nodiscard]] static std::string kind_to_string(kind k);
+  [[nodiscard]] static kind kind_from_string(const std::string &str);
+
+private:
+  void run();
+
+  kind m_kind{kind::none};
+  int m_cpu{-1};
+
+  // Set while the measuring thread is pinned for `smt`:
+  bool m_restore_affinity{false};
+  std::vector<unsigned char> m_saved_affinity;
+
+  std::vector<unsigned char> m_buffer;
+  std::thread m_thread;
+  std::atomic<bool> m_go{false};
+  std::atomic<bool> m_started{false};
+  std::atomic<bool> m_stop{false};
+};
+
+/// For each state measured with a co-runner, adds the slowdown relative to the
+/// state with the same axis values and no co-runner.
+void add_co_runner_summaries(nvbench::benchmark_base &bench);
+
+} // namespace nvbench::detail
@@ -0,0 +1,399 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/co_runner.cuh>
+#include <nvbench/detail/state_group.cuh>
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/host_caches.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+constexpr std::size_t cache_line_size = 64;
+
+constexpr const char *cpu_time_tag = "nv/cpu_only/time/cpu/mean";
+
+std::size_t get_llc_size()
+{
+  if (const auto size = nvbench::host_caches::get().get_llc_size(); size > 0)
+  {
+    return static_cast<std::size_t>(size);
+  }
+  return std::size_t{32} << 20;
+}
+
+#ifdef __linux__
+// Parses a sysfs cpu list such as "0,64" or "0-1":
+std::vector<int> parse_cpu_list(const std::string &list)
+{
+  std::vector<int> cpus;
+  std::stringstream stream{list};
+  std::string range;
+  while (std::getline(stream, range, ','))
+  {
+    const auto dash  = range.find('-');
+    const int first  = std::stoi(range.substr(0, dash));
+    const int last   = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu)
+    {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+int find_smt_sibling(int cpu)
+{
+  const auto path =
+    fmt::format("/sys/devices/system/cpu/cpu{}/topology/thread_siblings_list", cpu);
+  std::ifstream file{path};
+  std::string list;
+  NVBENCH_THROW_IF(!std::getline(file, list),
+                   std::runtime_error,
+                   "Cannot read SMT siblings of CPU {} from {}.",
+                   cpu,
+                   path);
+
+  for (const int sibling : parse_cpu_list(list))
+  {
+    if (sibling != cpu)
+    {
+      return sibling;
+    }
+  }
+  NVBENCH_THROW(std::runtime_error, "CPU {} has no SMT sibling.", cpu);
+}
+#endif
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+std::string co_runner::kind_to_string(kind k)
+{
+  switch (k)
+  {
+    case kind::memory_bandwidth:
+      return "membw";
+    case kind::cache_thrash:
+      return "llc";
+    case kind::smt_spin:
+      return "smt";
+    case kind::none:
+    default:
+      return "none";
+  }
+}
+
+co_runner::kind co_runner::kind_from_string(const std::string &str)
+{
+  for (const auto k : {kind::none, kind::memory_bandwidth, kind::cache_thrash, kind::smt_spin})
+  {
+    if (str == kind_to_string(k))
+    {
+      return k;
+    }
+  }
+  NVBENCH_THROW(std::runtime_error,
+                "Unknown co-runner '{}'. Expected one of none, membw, llc or smt.",
+                str);
+}
+
+co_runner::co_runner(const std::string &spec)
+{
+  const auto at = spec.find('@');
+  m_kind        = kind_from_string(spec.substr(0, at));
+  if (at != std::string::npos)
+  {
+    const auto cpu_str = spec.substr(at + 1);
+    std::size_t end{};
+    try
+    {
+      m_cpu = std::stoi(cpu_str, &end);
+    }
+    catch (...)
+    {
+      end = 0;
+    }
+    NVBENCH_THROW_IF(end == 0 || end != cpu_str.size() || m_cpu < 0,
+                     std::runtime_error,
+                     "Invalid CPU in co-runner '{}'. Expected '<kind>[@<cpu>]'.",
+                     spec);
+    NVBENCH_THROW_IF(m_kind == kind::smt_spin,
+                     std::runtime_error,
+                     "Co-runner '{}': the 'smt' co-runner always uses the SMT sibling.",
+                     spec);
+  }
+}
+
+co_runner::~co_runner() { this->stop(); }
+
+void co_runner::start()
+{
+  if (m_kind == kind::none || m_thread.joinable())
+  {
+    return;
+  }
+
+#ifdef __linux__
+  if (m_kind == kind::smt_spin)
+  {
+    // Keep the measuring thread on its current core while its sibling spins:
+    const int cpu = sched_getcpu();
+    NVBENCH_THROW_IF(cpu < 0, std::runtime_error, "{}", "Cannot determine the current CPU.");
+    m_cpu = ::find_smt_sibling(cpu);
+
+    cpu_set_t saved;
+    NVBENCH_THROW_IF(sched_getaffinity(0, sizeof(saved), &saved) != 0,
+                     std::runtime_error,
+                     "Cannot query CPU affinity: {}",
+                     std::strerror(errno));
+    m_saved_affinity.resize(sizeof(saved));
+    std::memcpy(m_saved_affinity.data(), &saved, sizeof(saved));
+
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(cpu, &pinned);
+    NVBENCH_THROW_IF(sched_setaffinity(0, sizeof(pinned), &pinned) != 0,
+                     std::runtime_error,
+                     "Cannot pin the measuring thread to CPU {}: {}",
+                     cpu,
+                     std::strerror(errno));
+    m_restore_affinity = true;
+  }
+
+  switch (m_kind)
+  {
+    case kind::memory_bandwidth:
+      m_buffer.assign(std::max(4 * ::get_llc_size(), std::size_t{64} << 20), 0);
+      break;
+    case kind::cache_thrash:
+      m_buffer.assign(::get_llc_size(), 0);
+      break;
+    default:
+      m_buffer.clear();
+      break;
+  }
+
+  m_go      = false;
+  m_started = false;
+  m_stop    = false;
+
+  // Block signals in the co-runner so that they are delivered to the
+  // benchmark's threads, e.g. SIGPROF for the sampling profiler:
+  sigset_t all_signals;
+  sigset_t saved_signals;
+  sigfillset(&all_signals);
+  pthread_sigmask(SIG_SETMASK, &all_signals, &saved_signals);
+  try
+  {
+    m_thread = std::thread{[this]() { this->run(); }};
+  }
+  catch (...)
+  {
+    pthread_sigmask(SIG_SETMASK, &saved_signals, nullptr);
+    this->stop();
+    throw;
+  }
+  pthread_sigmask(SIG_SETMASK, &saved_signals, nullptr);
+
+  if (m_cpu >= 0)
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(m_cpu, &cpus);
+    const int result = pthread_setaffinity_np(m_thread.native_handle(), sizeof(cpus), &cpus);
+    if (result != 0)
+    {
+      this->stop();
+      NVBENCH_THROW(std::runtime_error,
+                    "Cannot pin co-runner to CPU {}: {}",
+                    m_cpu,
+                    std::strerror(result));
+    }
+  }
+
+  m_go = true;
+  while (!m_started.load())
+  {
+    std::this_thread::yield();
+  }
+#else
+  NVBENCH_THROW(std::runtime_error, "{}", "Co-runners are only supported on Linux.");
+#endif
+}
+
+void co_runner::stop()
+{
+  m_stop = true;
+  m_go   = true;
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+
+#ifdef __linux__
+  if (m_restore_affinity)
+  {
+    cpu_set_t saved;
+    std::memcpy(&saved, m_saved_affinity.data(), sizeof(saved));
+    sched_setaffinity(0, sizeof(saved), &saved);
+    m_restore_affinity = false;
+  }
+#endif
+}
+
+void co_runner::run()
+{
+  while (!m_go.load())
+  {
+    std::this_thread::yield();
+  }
+
+  unsigned char *const data = m_buffer.data();
+  const std::size_t size    = m_buffer.size();
+  bool started              = false;
+
+  while (!m_stop.load(std::memory_order_relaxed))
+  {
+    switch (m_kind)
+    {
+      case kind::memory_bandwidth: {
+        // Read and write every byte, checking for stop requests every 1 MiB:
+        auto *words                 = reinterpret_cast<nvbench::uint64_t *>(data);
+        const std::size_t num_words = size / sizeof(nvbench::uint64_t);
+        constexpr std::size_t chunk = (std::size_t{1} << 20) / sizeof(nvbench::uint64_t);
+        for (std::size_t begin = 0; begin < num_words; begin += chunk)
+        {
+          const std::size_t end = std::min(begin + chunk, num_words);
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            words[i] += 1;
+          }
+          if (m_stop.load(std::memory_order_relaxed))
+          {
+            break;
+          }
+        }
+        break;
+      }
+
+      case kind::cache_thrash: {
+        // Dirty each cache line:
+        for (std::size_t i = 0; i < size; i += cache_line_size)
+        {
+          data[i] = static_cast<unsigned char>(data[i] + 1);
+        }
+        break;
+      }
+
+      case kind::smt_spin: {
+        // Keep the shared core's integer pipelines busy:
+        nvbench::uint64_t x = 0x9E3779B97F4A7C15ull;
+        for (int i = 0; i < 4096; ++i)
+        {
+          x = x * 6364136223846793005ull + 1442695040888963407ull;
+          x ^= x >> 29;
+        }
+        volatile nvbench::uint64_t sink = x;
+        static_cast<void>(sink);
+        break;
+      }
+
+      case kind::none:
+      default:
+        break;
+    }
+
+    if (!started)
+    {
+      started   = true;
+      m_started = true;
+    }
+  }
+
+  m_started = true;
+}
+
+void add_co_runner_summaries(nvbench::benchmark_base &bench)
+{
+  // Each state with a co-runner is compared to the state without one that
+  // differs only in the co-runner axis:
+  const auto groups =
+    group_states(bench, {co_runner::axis_name}, [](const nvbench::state &exec_state) {
+      return exec_state.get_axis_values().has_value(co_runner::axis_name) &&
+             find_summary(exec_state, cpu_time_tag) != nullptr;
+    });
+  for (const auto &group : groups)
+  {
+    const auto is_baseline = [](const nvbench::state *exec_state) {
+      return exec_state->get_axis_values().get_string(co_runner::axis_name) == "none";
+    };
+    const auto baseline = std::find_if(group.states.cbegin(), group.states.cend(), is_baseline);
+    if (baseline == group.states.cend())
+    {
+      continue;
+    }
+    const auto baseline_time = find_summary(**baseline, cpu_time_tag)->get_float64("value");
+    if (baseline_time <= 0.)
+    {
+      continue;
+    }
+
+    for (auto *exec_state : group.states)
+    {
+      if (is_baseline(exec_state))
+      {
+        continue;
+      }
+      const auto time = find_summary(*exec_state, cpu_time_tag)->get_float64("value");
+
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/co_runner/slowdown",
+         "Slowdown",
+         "percentage",
+         "Increase in mean CPU time relative to the same state without a co-runner"});
+      auto &summ = exec_state->add_summary(desc);
+      summ.set_float64("value", time / baseline_time - 1.);
+      summ.set_float64("baseline", baseline_time);
+    }
+  }
+}
+
+} // namespace nvbench::detail
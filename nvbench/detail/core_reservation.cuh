@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <string>
+#include <vector>
+
+namespace nvbench::detail
+{
+
+/**
+ * Cooperative reservation of CPU cores between nvbench processes on a host.
+ *
+ * Each logical CPU has a lock file in a shared directory, `/dev/shm/nvbench-cores`
+ * by default or `$NVBENCH_RESERVATION_DIR`. A process claims a CPU by taking an
+ * exclusive `flock` on its file, and always claims all SMT siblings of a core
+ * together. The kernel drops the locks when the holder exits for any reason,
+ * so the cores of a crashed or killed process are free again immediately.
+ * Each lock file contains the pid of its holder for diagnostics.
+ *
+ * The reservation spec is one of:
+ * - `none` or empty: no reservation.
+ * - `<count>`: any `count` free physical cores.
+ * - `numa`: all cores of a free NUMA node.
+ *
+ * Only CPUs in the calling thread's affinity mask are considered. While the
+ * reservation exists, the calling thread and any threads it creates are
+ * restricted to the reserved CPUs. Only supported on Linux.
+ */
+struct core_reservation
+{
+  enum class kind
+  {
+    none,
+    cores,
+    numa
+  };
+
+  struct spec
+  {
+    /// Throws `std::runtime_error` on unrecognized input.
+    [[nodiscard]] static spec parse(const std::string &spec_str);
+
+    /// "none", "<count>" or "numa".
+    [[nodiscard]] std::string to_string() const;
+
+    kind m_kind{kind::none};
+    nvbench::int64_t m_count{};
+  };
+
+  [[nodiscard]] static bool is_supported();
+
+  /// `$NVBENCH_RESERVATION_DIR`, or `/dev/shm/nvbench-cores`.
+  [[nodiscard]] static std::string get_default_directory();
+
+  /// Claims the cores described by `spec_str`, waiting up to `timeout`
+  /// seconds for them to become free, and pins the calling thread to them.
+  /// Throws if they are not available in time.
+  core_reservation(const std::string &spec_str,
+                   nvbench::float64_t timeout,
+                   std::string directory = get_default_directory());
+
+  /// Releases the cores and restores the calling thread's affinity.
+  ~core_reservation();
+
+  // Owns file descriptors:
+  core_reservation(const core_reservation &)            = delete;
+  core_reservation(core_reservation &&)                 = delete;
+  core_reservation &operator=(const core_reservation &) = delete;
+  core_reservation &operator=(core_reservation &&)      = delete;
+
+  /// The reserved logical CPUs, in ascending order.
+  [[nodiscard]] const std::vector<int> &get_cpus() const { return m_cpus; }
+
+  /// The reserved CPUs as a list of ranges, e.g. "2-3,10-11".
+  [[nodiscard]] std::string get_cpus_as_string() const;
+
+  /// Seconds spent waiting for the cores to become free.
+  [[nodiscard]] nvbench::float64_t get_wait_time() const { return m_wait_time; }
+
+private:
+  // Claims `count` cores, or one NUMA node if `count` is zero. Returns false
+  // and holds no locks if they are not all free.
+  bool try_claim(const std::vector<std::vector<int>> &cores,
+                 const std::vector<std::vector<int>> &nodes,
+                 nvbench::int64_t count);
+
+  bool try_lock_core(const std::vector<int> &core);
+  void release();
+
+  std::string m_directory;
+  std::vector<int> m_cpus;
+  std::vector<int> m_lock_fds;
+  nvbench::float64_t m_wait_time{};
+
+  std::vector<unsigned char> m_saved_affinity;
+  bool m_restore_affinity{false};
+};
+
+} // namespace nvbench::detail
@@ -0,0 +1,432 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/core_reservation.cuh>
+#include <nvbench/detail/throw.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+#ifdef __linux__
+// Parses a sysfs cpu list such as "0,64" or "0-1":
+std::vector<int> parse_cpu_list(const std::string &list)
+{
+  std::vector<int> cpus;
+  std::stringstream stream{list};
+  std::string range;
+  while (std::getline(stream, range, ','))
+  {
+    if (range.empty() || range == "\n")
+    {
+      continue;
+    }
+    const auto dash = range.find('-');
+    const int first = std::stoi(range.substr(0, dash));
+    const int last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu)
+    {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::vector<int> read_cpu_list(const std::string &path)
+{
+  std::ifstream file{path};
+  std::string list;
+  if (!std::getline(file, list))
+  {
+    return {};
+  }
+  return parse_cpu_list(list);
+}
+
+// The physical cores with at least one allowed CPU, each as all of its SMT
+// siblings, so that processes with different affinities lock the same files:
+std::vector<std::vector<int>> get_cores(const std::vector<int> &allowed)
+{
+  std::vector<std::vector<int>> cores;
+  for (const int cpu : allowed)
+  {
+    auto siblings = read_cpu_list(
+      fmt::format("/sys/devices/system/cpu/cpu{}/topology/thread_siblings_list", cpu));
+    if (std::find(siblings.cbegin(), siblings.cend(), cpu) == siblings.cend())
+    {
+      siblings.push_back(cpu);
+    }
+    std::sort(siblings.begin(), siblings.end());
+    cores.push_back(std::move(siblings));
+  }
+  std::sort(cores.begin(), cores.end());
+  cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+  return cores;
+}
+
+// The cores of each NUMA node, or of one node if the topology is unknown:
+std::vector<std::vector<int>> get_nodes(const std::vector<int> &allowed)
+{
+  std::vector<std::vector<int>> nodes;
+  if (DIR *dir = opendir("/sys/devices/system/node"); dir != nullptr)
+  {
+    while (const dirent *entry = readdir(dir))
+    {
+      const std::string name = entry->d_name;
+      if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+          name.find_first_not_of("0123456789", 4) != std::string::npos)
+      {
+        continue;
+      }
+
+      std::vector<int> cpus;
+      for (const int cpu : read_cpu_list("/sys/devices/system/node/" + name + "/cpulist"))
+      {
+        if (std::binary_search(allowed.cbegin(), allowed.cend(), cpu))
+        {
+          cpus.push_back(cpu);
+        }
+      }
+      if (!cpus.empty())
+      {
+        std::sort(cpus.begin(), cpus.end());
+        nodes.push_back(std::move(cpus));
+      }
+    }
+    closedir(dir);
+  }
+  if (nodes.empty())
+  {
+    nodes.push_back(allowed);
+  }
+  std::sort(nodes.begin(), nodes.end());
+  return nodes;
+}
+#endif
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+core_reservation::spec core_reservation::spec::parse(const std::string &spec_str)
+{
+  spec result;
+  if (spec_str.empty() || spec_str == "none")
+  {
+    result.m_kind = kind::none;
+  }
+  else if (spec_str == "numa")
+  {
+    result.m_kind = kind::numa;
+  }
+  else
+  {
+    std::size_t num_chars = 0;
+    try
+    {
+      result.m_count = std::stoll(spec_str, &num_chars);
+    }
+    catch (std::exception &)
+    {
+      num_chars = 0;
+    }
+    NVBENCH_THROW_IF(num_chars == 0 || num_chars != spec_str.size() || result.m_count <= 0,
+                     std::runtime_error,
+                     "Invalid core reservation '{}'. Expected 'none', 'numa' or a positive "
+                     "number of cores.",
+                     spec_str);
+    result.m_kind = kind::cores;
+  }
+  return result;
+}
+
+std::string core_reservation::spec::to_string() const
+{
+  switch (m_kind)
+  {
+    case kind::cores:
+      return fmt::format("{}", m_count);
+    case kind::numa:
+      return "numa";
+    case kind::none:
+    default:
+      return "none";
+  }
+}
+
+bool core_reservation::is_supported()
+{
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::string core_reservation::get_default_directory()
+{
+  if (const char *dir = std::getenv("NVBENCH_RESERVATION_DIR"); dir != nullptr && dir[0] != '\0')
+  {
+    return dir;
+  }
+  return "/dev/shm/nvbench-cores";
+}
+
+core_reservation::core_reservation([[maybe_unused]] const std::string &spec_str,
+                                   [[maybe_unused]] nvbench::float64_t timeout,
+                                   std::string directory)
+    : m_directory{std::move(directory)}
+{
+#ifdef __linux__
+  const auto reservation = spec::parse(spec_str);
+  if (reservation.m_kind == kind::none)
+  {
+    return;
+  }
+
+  // Shared by all users of the host:
+  if (mkdir(m_directory.c_str(), 01777) == 0)
+  {
+    chmod(m_directory.c_str(), 01777);
+  }
+  else
+  {
+    NVBENCH_THROW_IF(errno != EEXIST,
+                     std::runtime_error,
+                     "Cannot create the core reservation directory '{}': {}",
+                     m_directory,
+                     std::strerror(errno));
+  }
+
+  cpu_set_t saved;
+  NVBENCH_THROW_IF(sched_getaffinity(0, sizeof(saved), &saved) != 0,
+                   std::runtime_error,
+                   "Cannot query CPU affinity: {}",
+                   std::strerror(errno));
+
+  std::vector<int> allowed;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &saved))
+    {
+      allowed.push_back(cpu);
+    }
+  }
+
+  const auto cores = ::get_cores(allowed);
+  const auto nodes = ::get_nodes(allowed);
+  const auto count = reservation.m_kind == kind::cores ? reservation.m_count : 0;
+  NVBENCH_THROW_IF(count > static_cast<nvbench::int64_t>(cores.size()),
+                   std::runtime_error,
+                   "Cannot reserve {} cores: only {} are available to this process.",
+                   count,
+                   cores.size());
+
+  using clock_type = std::chrono::steady_clock;
+  const auto start = clock_type::now();
+  const auto deadline =
+    start + std::chrono::duration_cast<clock_type::duration>(
+              std::chrono::duration<nvbench::float64_t>(std::max(timeout, 0.)));
+  while (!this->try_claim(cores, nodes, count))
+  {
+    NVBENCH_THROW_IF(clock_type::now() >= deadline,
+                     std::runtime_error,
+                     "Timed out after {}s waiting for {} to be free in '{}'.",
+                     timeout,
+                     count > 0 ? fmt::format("{} cores", count) : std::string{"a NUMA node"},
+                     m_directory);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  m_wait_time = std::chrono::duration<nvbench::float64_t>(clock_type::now() - start).count();
+  std::sort(m_cpus.begin(), m_cpus.end());
+
+  // Siblings outside of the original affinity are reserved but not used:
+  cpu_set_t pinned;
+  CPU_ZERO(&pinned);
+  for (const int cpu : m_cpus)
+  {
+    if (CPU_ISSET(cpu, &saved))
+    {
+      CPU_SET(cpu, &pinned);
+    }
+  }
+  if (sched_setaffinity(0, sizeof(pinned), &pinned) != 0)
+  {
+    const int error = errno;
+    this->release();
+    NVBENCH_THROW(std::runtime_error,
+                  "Cannot pin to the reserved CPUs {}: {}",
+                  this->get_cpus_as_string(),
+                  std::strerror(error));
+  }
+  m_saved_affinity.resize(sizeof(saved));
+  std::memcpy(m_saved_affinity.data(), &saved, sizeof(saved));
+  m_restore_affinity = true;
+#else
+  NVBENCH_THROW(std::runtime_error, "{}", "Core reservation is only supported on Linux.");
+#endif
+}
+
+core_reservation::~core_reservation()
+{
+#ifdef __linux__
+  if (m_restore_affinity)
+  {
+    cpu_set_t saved;
+    std::memcpy(&saved, m_saved_affinity.data(), sizeof(saved));
+    sched_setaffinity(0, sizeof(saved), &saved);
+  }
+#endif
+  this->release();
+}
+
+std::string core_reservation::get_cpus_as_string() const
+{
+  std::string result;
+  for (std::size_t i = 0; i < m_cpus.size();)
+  {
+    // Extend the range while the CPUs are consecutive:
+    std::size_t last = i;
+    while (last + 1 < m_cpus.size() && m_cpus[last + 1] == m_cpus[last] + 1)
+    {
+      ++last;
+    }
+    result += result.empty() ? "" : ",";
+    result += last == i ? fmt::format("{}", m_cpus[i])
+                        : fmt::format("{}-{}", m_cpus[i], m_cpus[last]);
+    i = last + 1;
+  }
+  return result;
+}
+
+bool core_reservation::try_claim(const std::vector<std::vector<int>> &cores,
+                                 const std::vector<std::vector<int>> &nodes,
+                                 nvbench::int64_t count)
+{
+  if (count > 0)
+  {
+    // Any free cores will do:
+    nvbench::int64_t num_claimed = 0;
+    for (const auto &core : cores)
+    {
+      if (this->try_lock_core(core) && ++num_claimed == count)
+      {
+        return true;
+      }
+    }
+  }
+  else
+  {
+    // Every core of the node must be free:
+    for (const auto &node : nodes)
+    {
+      const bool claimed =
+        std::all_of(cores.cbegin(), cores.cend(), [this, &node](const auto &core) {
+          const bool in_node = std::any_of(core.cbegin(), core.cend(), [&node](int cpu) {
+            return std::binary_search(node.cbegin(), node.cend(), cpu);
+          });
+          return !in_node || this->try_lock_core(core);
+        });
+      if (claimed && !m_cpus.empty())
+      {
+        return true;
+      }
+      this->release();
+    }
+  }
+
+  this->release();
+  return false;
+}
+
+bool core_reservation::try_lock_core([[maybe_unused]] const std::vector<int> &core)
+{
+#ifdef __linux__
+  std::vector<int> fds;
+  for (const int cpu : core)
+  {
+    const auto path = fmt::format("{}/cpu{}.lock", m_directory, cpu);
+    const int fd    = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if (fd == -1)
+    {
+      const int error = errno;
+      std::for_each(fds.cbegin(), fds.cend(), close);
+      NVBENCH_THROW(std::runtime_error,
+                    "Cannot open the core reservation file '{}': {}",
+                    path,
+                    std::strerror(error));
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0)
+    {
+      close(fd);
+      std::for_each(fds.cbegin(), fds.cend(), close);
+      return false;
+    }
+
+    // Let other users of the host lock the file too:
+    fchmod(fd, 0666);
+    const auto holder = fmt::format("{}\n", getpid());
+    if (ftruncate(fd, 0) == 0)
+    {
+      [[maybe_unused]] const auto num_written = write(fd, holder.data(), holder.size());
+    }
+    fds.push_back(fd);
+  }
+
+  m_lock_fds.insert(m_lock_fds.end(), fds.cbegin(), fds.cend());
+  m_cpus.insert(m_cpus.end(), core.cbegin(), core.cend());
+  return true;
+#else
+  return false;
+#endif
+}
+
+void core_reservation::release()
+{
+#ifdef __linux__
+  for (const int fd : m_lock_fds)
+  {
+    close(fd);
+  }
+#endif
+  m_lock_fds.clear();
+  m_cpus.clear();
+}
+
+} // namespace nvbench::detail
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/cpu_timer.cuh>
+#include <nvbench/types.cuh>
+
+#include <string>
+
+namespace nvbench::detail
+{
+
+/**
+ * Counts CPU cycles and retired instructions on the calling thread.
+ *
+ * On Linux, hardware perf events are used when permitted by
+ * `perf_event_paranoid`. Otherwise, on x86, cycles fall back to the
+ * time-stamp counter, which ticks at the nominal (reference) frequency and
+ * provides no instruction count. If neither is available, nothing is counted.
+ */
+struct cpu_counters
+{
+  enum class source
+  {
+    none,
+    perf,
+    tsc
+  };
+
+  cpu_counters();
+  ~cpu_counters();
+
+  // Owns file descriptors:
+  cpu_counters(const cpu_counters &)            = delete;
+  cpu_counters(cpu_counters &&)                 = delete;
+  cpu_counters &operator=(const cpu_counters &) = delete;
+  cpu_counters &operator=(cpu_counters &&)      = delete;
+
+  void start();
+  void stop();
+
+  [[nodiscard]] source get_source() const { return m_source; }
+  [[nodiscard]] std::string get_source_as_string() const;
+
+  [[nodiscard]] bool has_cycles() const { return m_source != source::none; }
+  [[nodiscard]] bool has_instructions() const { return m_source == source::perf; }
+
+  /// Whether the counters could be read at both ends of the most recent
+  /// start/stop interval. The counts are 0 otherwise.
+  [[nodiscard]] bool is_valid() const { return m_valid; }
+
+  /// Counts for the most recent start/stop interval. @{
+  [[nodiscard]] nvbench::int64_t get_cycles() const { return m_cycles; }
+  [[nodiscard]] nvbench::int64_t get_instructions() const { return m_instructions; }
+  /// @}
+
+private:
+  // Returns false if the counters couldn't be read:
+  [[nodiscard]] bool read_counters(nvbench::uint64_t &cycles,
+                                   nvbench::uint64_t &instructions) const;
+
+  source m_source{source::none};
+
+  // perf_event group; the cycles event is the leader:
+  int m_group_fd{-1};
+  int m_instructions_fd{-1};
+
+  nvbench::uint64_t m_start_cycles{};
+  nvbench::uint64_t m_start_instructions{};
+  bool m_start_valid{false};
+
+  bool m_valid{false};
+
+  nvbench::int64_t m_cycles{};
+  nvbench::int64_t m_instructions{};
+};
+
+/**
+ * Timer adaptor that samples `cpu_counters` around the region timed by a
+ * `cpu_timer`, so that `exec_tag::timer` benchmarks only count the code
+ * between `timer.start()` and `timer.stop()`.
+ */
+struct counting_cpu_timer
+{
+  counting_cpu_timer(nvbench::cpu_timer &timer, cpu_counters &counters)
+      : m_timer{timer}
+      , m_counters{counters}
+  {}
+
+  __forceinline__ void start()
+  {
+    m_counters.start();
+    m_timer.start();
+  }
+
+  __forceinline__ void stop()
+  {
+    m_timer.stop();
+    m_counters.stop();
+  }
+
+  [[nodiscard]] __forceinline__ nvbench::float64_t get_duration()
+  {
+    return m_timer.get_duration();
+  }
+
+private:
+  nvbench::cpu_timer &m_timer;
+  cpu_counters &m_counters;
+};
+
+} // namespace nvbench::detail
@@ -0,0 +1,169 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/cpu_counters.cuh>
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define NVBENCH_HAS_TSC 1
+#endif
+
+namespace
+{
+
+#ifdef __linux__
+int open_perf_event(nvbench::uint64_t config, int group_fd)
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.config         = config;
+  attr.disabled       = group_fd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  attr.read_format    = PERF_FORMAT_GROUP;
+
+  // Count the calling thread on any CPU:
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+cpu_counters::cpu_counters()
+{
+#ifdef __linux__
+  m_group_fd = ::open_perf_event(PERF_COUNT_HW_CPU_CYCLES, -1);
+  if (m_group_fd != -1)
+  {
+    m_instructions_fd = ::open_perf_event(PERF_COUNT_HW_INSTRUCTIONS, m_group_fd);
+    if (m_instructions_fd != -1 &&
+        ioctl(m_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) == 0 &&
+        ioctl(m_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == 0)
+    {
+      m_source = source::perf;
+      return;
+    }
+
+    if (m_instructions_fd != -1)
+    {
+      close(m_instructions_fd);
+      m_instructions_fd = -1;
+    }
+    close(m_group_fd);
+    m_group_fd = -1;
+  }
+#endif
+
+#ifdef NVBENCH_HAS_TSC
+  m_source = source::tsc;
+#endif
+}
+
+cpu_counters::~cpu_counters()
+{
+#ifdef __linux__
+  if (m_instructions_fd != -1)
+  {
+    close(m_instructions_fd);
+  }
+  if (m_group_fd != -1)
+  {
+    close(m_group_fd);
+  }
+#endif
+}
+
+std::string cpu_counters::get_source_as_string() const
+{
+  switch (m_source)
+  {
+    case source::perf:
+      return "perf";
+    case source::tsc:
+      return "tsc";
+    case source::none:
+    default:
+      return "none";
+  }
+}
+
+void cpu_counters::start()
+{
+  m_start_valid = this->read_counters(m_start_cycles, m_start_instructions);
+}
+
+void cpu_counters::stop()
+{
+  nvbench::uint64_t cycles{};
+  nvbench::uint64_t instructions{};
+  m_valid = this->read_counters(cycles, instructions) && m_start_valid;
+  if (!m_valid)
+  {
+    // Don't report the difference to a value that was never read:
+    m_cycles       = 0;
+    m_instructions = 0;
+    return;
+  }
+  m_cycles       = static_cast<nvbench::int64_t>(cycles - m_start_cycles);
+  m_instructions = static_cast<nvbench::int64_t>(instructions - m_start_instructions);
+}
+
+bool cpu_counters::read_counters(nvbench::uint64_t &cycles, nvbench::uint64_t &instructions) const
+{
+  switch (m_source)
+  {
+#ifdef __linux__
+    case source::perf: {
+      // PERF_FORMAT_GROUP layout: { nr, values[nr] }
+      nvbench::uint64_t buffer[3]{};
+      if (read(m_group_fd, buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)))
+      {
+        return false;
+      }
+      cycles       = buffer[1];
+      instructions = buffer[2];
+      return true;
+    }
+#endif
+
+#ifdef NVBENCH_HAS_TSC
+    case source::tsc:
+      cycles = __rdtsc();
+      return true;
+#endif
+
+    default:
+      return false;
+  }
+}
+
+} // namespace nvbench::detail
@@ -32,6 +32,7 @@ class entropy_criterion final : public stopping_criterion_base
   // state
   nvbench::int64_t m_total_samples{};
   nvbench::float64_t m_total_cuda_time{};
+  nvbench::float64_t m_resolution{};
   std::vector<std::pair<nvbench::float64_t, nvbench::int64_t>> m_freq_tracker;
 
   // TODO The window size should be user-configurable
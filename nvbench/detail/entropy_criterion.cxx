@@ -25,7 +25,8 @@ namespace nvbench::detail
 {
 
 entropy_criterion::entropy_criterion()
-    : stopping_criterion_base{"entropy", {{"max-angle", 0.048}, {"min-r2", 0.36}}}
+    : stopping_criterion_base{"entropy",
+                              {{"max-angle", 0.048}, {"min-r2", 0.36}, {"timer-resolution", 0.}}}
 {
   m_freq_tracker.reserve(m_entropy_tracker.capacity() * 2);
   m_probabilities.reserve(m_entropy_tracker.capacity() * 2);
@@ -37,6 +38,7 @@ void entropy_criterion::do_initialize()
   m_total_cuda_time = 0.0;
   m_entropy_tracker.clear();
   m_freq_tracker.clear();
+  m_resolution = m_params.get_float64("timer-resolution");
 }
 
 nvbench::float64_t entropy_criterion::compute_entropy()
@@ -69,15 +71,11 @@ void entropy_criterion::do_add_measurement(nvbench::float64_t measurement)
   m_total_cuda_time += measurement;
 
   {
-    auto key                = measurement;
-    constexpr bool bin_keys = false;
-
-    if (bin_keys)
+    // Times that differ by less than a tick of the timer are the same measurement:
+    auto key = measurement;
+    if (m_resolution > 0.)
     {
-      const auto resolution_us = 0.5;
-      const auto resulution_s  = resolution_us / 1000000;
-      const auto epsilon       = resulution_s * 2;
-      key                      = std::round(key / epsilon) * epsilon;
+      key = std::round(key / m_resolution) * m_resolution;
     }
 
     // This approach is about 3x faster than `std::{unordered_,}map`
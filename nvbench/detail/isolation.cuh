@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace nvbench
+{
+struct benchmark_base;
+struct state;
+} // namespace nvbench
+
+namespace nvbench::detail
+{
+
+/**
+ * How the states of a benchmark are isolated from each other.
+ *
+ * - `none`: all states run in the benchmark process (the default), so each
+ *   state inherits heap fragmentation, warm caches, static caches and leaked
+ *   threads from the states before it.
+ * - `fork` or `fork:state`: each state runs in its own child process.
+ * - `fork:benchmark`: one child process runs all states of the benchmark,
+ *   isolating the benchmark from the others. A child that crashes or is
+ *   killed is replaced for the remaining states.
+ *
+ * See nvbench::detail::fork_server.
+ */
+struct isolation
+{
+  enum class kind
+  {
+    none,
+    state,
+    benchmark
+  };
+
+  /// Throws `std::runtime_error` on unrecognized input.
+  [[nodiscard]] static isolation parse(const std::string &spec);
+
+  /// "none", "fork:state" or "fork:benchmark".
+  [[nodiscard]] std::string to_string() const;
+
+  kind m_kind{kind::none};
+};
+
+/**
+ * Runs states in child processes forked from a pre-initialized zygote.
+ *
+ * The zygote is forked from the benchmark process when the server is
+ * created, after options are parsed and states are generated, so that each
+ * worker starts from the same clean snapshot without repeating that setup.
+ * For each batch of states, the zygote forks a worker that runs them exactly
+ * as the runner would in-process, including the printer's log output, and
+ * streams each state's summaries back over a pipe. Bulk data, such as sample
+ * times, is passed to the benchmark process's printer, which writes any files
+ * for it.
+ *
+ * The benchmark process acts as a watchdog: a worker whose current state runs
+ * longer than `benchmark_base::get_hard_timeout()` is killed. States of a
+ * worker that is killed or crashes are skipped with the reason.
+ *
+ * CUDA cannot be used in a child once the parent has initialized it, so this
+ * is limited to CPU-only benchmarks. Only supported on Linux.
+ */
+struct fork_server
+{
+  using state_runner = std::function<void(nvbench::state &)>;
+
+  [[nodiscard]] static bool is_supported();
+
+  /// Forks the zygote. `run_state` runs a state in a worker.
+  fork_server(nvbench::benchmark_base &bench, state_runner run_state);
+  ~fork_server();
+
+  // Owns a child process and its socket:
+  fork_server(const fork_server &)            = delete;
+  fork_server(fork_server &&)                 = delete;
+  fork_server &operator=(const fork_server &) = delete;
+  fork_server &operator=(fork_server &&)      = delete;
+
+  /// Runs `states` in order, in one worker per state or per batch depending
+  /// on the benchmark's isolation, and copies the results into `states`.
+  void run(const std::vector<nvbench::state *> &states);
+
+  /// Hard time limit for each of `states`, in seconds.
+  [[nodiscard]] nvbench::float64_t
+  get_hard_timeout(const std::vector<nvbench::state *> &states) const;
+
+private:
+  // Runs `states` in a new worker. Returns the number of states that were
+  // completed or skipped; the worker may die before it reaches the others.
+  std::size_t run_worker(const std::vector<nvbench::state *> &states);
+
+  [[noreturn]] void zygote_main(int socket_fd);
+  [[noreturn]] void worker_main(int result_fd,
+                                nvbench::int64_t completed_states,
+                                const std::vector<nvbench::int64_t> &state_indices,
+                                const std::vector<nvbench::float64_t> &timeouts);
+
+  nvbench::benchmark_base &m_benchmark;
+  state_runner m_run_state;
+  isolation m_isolation;
+
+  nvbench::int64_t m_zygote_pid{-1};
+  int m_socket_fd{-1};
+};
+
+} // namespace nvbench::detail
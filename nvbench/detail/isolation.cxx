@@ -0,0 +1,946 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/isolation.cuh>
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+#ifdef __linux__
+
+// Message types sent by workers:
+constexpr nvbench::uint64_t state_begin = 1;
+constexpr nvbench::uint64_t state_end   = 2;
+constexpr nvbench::uint64_t bulk_data   = 3;
+
+// Workers and the benchmark process run the same executable, so values are
+// serialized in native byte order:
+struct writer
+{
+  void put_u64(nvbench::uint64_t value)
+  {
+    m_data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+  void put_i64(nvbench::int64_t value) { this->put_u64(static_cast<nvbench::uint64_t>(value)); }
+  void put_f64(nvbench::float64_t value)
+  {
+    nvbench::uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    this->put_u64(bits);
+  }
+  void put_string(const std::string &value)
+  {
+    this->put_u64(value.size());
+    m_data.append(value);
+  }
+
+  std::string m_data;
+};
+
+struct reader
+{
+  explicit reader(const std::string &data)
+      : m_data{data}
+  {}
+
+  nvbench::uint64_t get_u64()
+  {
+    nvbench::uint64_t value{};
+    this->get_bytes(&value, sizeof(value));
+    return value;
+  }
+  nvbench::int64_t get_i64() { return static_cast<nvbench::int64_t>(this->get_u64()); }
+  nvbench::float64_t get_f64()
+  {
+    const auto bits = this->get_u64();
+    nvbench::float64_t value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+  std::string get_string()
+  {
+    const auto size = this->get_u64();
+    this->check_size(size);
+    std::string value = m_data.substr(m_pos, size);
+    m_pos += size;
+    return value;
+  }
+
+private:
+  void check_size(nvbench::uint64_t size) const
+  {
+    NVBENCH_THROW_IF(size > m_data.size() - m_pos,
+                     std::runtime_error,
+                     "{}",
+                     "Truncated message from a worker process.");
+  }
+
+  void get_bytes(void *dst, std::size_t size)
+  {
+    this->check_size(size);
+    std::memcpy(dst, m_data.data() + m_pos, size);
+    m_pos += size;
+  }
+
+  const std::string &m_data;
+  std::size_t m_pos{};
+};
+
+std::string serialize_results(const nvbench::state &exec_state)
+{
+  writer out;
+  out.put_string(exec_state.get_skip_reason());
+  out.put_u64(exec_state.get_element_count());
+  out.put_u64(exec_state.get_global_memory_rw_bytes());
+
+  const auto &summaries = exec_state.get_summaries();
+  out.put_u64(summaries.size());
+  for (const auto &summ : summaries)
+  {
+    // Registered metadata isn't stored in the values:
+    if (const auto *desc = summ.get_descriptor(); desc != nullptr)
+    {
+      out.put_u64(1);
+      out.put_string(desc->tag);
+      out.put_string(desc->name);
+      out.put_string(desc->hint);
+      out.put_string(desc->description);
+      out.put_string(desc->hide);
+    }
+    else
+    {
+      out.put_u64(0);
+      out.put_string(summ.get_tag());
+    }
+
+    const auto names = summ.get_names();
+    out.put_u64(names.size());
+    for (const auto &name : names)
+    {
+      const auto &value = summ.get_value(name);
+      out.put_string(name);
+      out.put_u64(value.index());
+      std::visit(
+        [&out](const auto &val) {
+          using T = std::decay_t<decltype(val)>;
+          if constexpr (std::is_same_v<T, nvbench::int64_t>)
+          {
+            out.put_i64(val);
+          }
+          else if constexpr (std::is_same_v<T, nvbench::float64_t>)
+          {
+            out.put_f64(val);
+          }
+          else
+          {
+            out.put_string(val);
+          }
+        },
+        value);
+    }
+  }
+
+  return std::move(out.m_data);
+}
+
+void deserialize_results(const std::string &data, nvbench::state &exec_state)
+{
+  reader in{data};
+  exec_state.skip(in.get_string());
+  exec_state.set_element_count(static_cast<std::size_t>(in.get_u64()));
+  exec_state.set_global_memory_rw_bytes(static_cast<std::size_t>(in.get_u64()));
+
+  auto &summaries = exec_state.get_summaries();
+  summaries.clear();
+
+  const auto num_summaries = in.get_u64();
+  for (nvbench::uint64_t i = 0; i < num_summaries; ++i)
+  {
+    nvbench::summary summ;
+    if (in.get_u64() != 0)
+    {
+      auto tag         = in.get_string();
+      auto name        = in.get_string();
+      auto hint        = in.get_string();
+      auto description = in.get_string();
+      auto hide        = in.get_string();
+
+      // Returns the parent's descriptor if the tag is already registered:
+      const auto &desc = nvbench::summary_registry::get().add({std::move(tag),
+                                                               std::move(name),
+                                                               std::move(hint),
+                                                               std::move(description),
+                                                               std::move(hide)});
+      summ = nvbench::summary{desc};
+    }
+    else
+    {
+      summ = nvbench::summary{in.get_string()};
+    }
+
+    const auto num_values = in.get_u64();
+    for (nvbench::uint64_t j = 0; j < num_values; ++j)
+    {
+      auto name = in.get_string();
+      switch (in.get_u64())
+      {
+        case 0:
+          summ.set_int64(std::move(name), in.get_i64());
+          break;
+        case 1:
+          summ.set_float64(std::move(name), in.get_f64());
+          break;
+        default:
+          summ.set_string(std::move(name), in.get_string());
+          break;
+      }
+    }
+    exec_state.add_summary(std::move(summ));
+  }
+}
+
+struct bulk_data_entry
+{
+  std::string tag;
+  std::string hint;
+  std::vector<nvbench::float64_t> data;
+};
+
+std::string serialize_bulk_data(const bulk_data_entry &entry)
+{
+  writer out;
+  out.put_string(entry.tag);
+  out.put_string(entry.hint);
+  out.put_u64(entry.data.size());
+  for (const auto value : entry.data)
+  {
+    out.put_f64(value);
+  }
+  return std::move(out.m_data);
+}
+
+bulk_data_entry deserialize_bulk_data(const std::string &data)
+{
+  reader in{data};
+  bulk_data_entry entry;
+  entry.tag  = in.get_string();
+  entry.hint = in.get_string();
+  entry.data.resize(static_cast<std::size_t>(in.get_u64()));
+  for (auto &value : entry.data)
+  {
+    value = in.get_f64();
+  }
+  return entry;
+}
+
+// Forwards everything to the benchmark's printer in a worker, except bulk
+// data. That is sent to the benchmark process, whose printer writes any
+// files for it: a worker's copy of the printer doesn't know which files
+// other workers have written.
+struct bulk_data_capture : nvbench::printer_base
+{
+  explicit bulk_data_capture(nvbench::printer_base &printer)
+      : printer_base{std::cerr}
+      , m_printer{printer}
+  {}
+
+  void set_completed_state_count(std::size_t states) override
+  {
+    m_printer.set_completed_state_count(states);
+  }
+  void add_completed_state() override { m_printer.add_completed_state(); }
+  [[nodiscard]] std::size_t get_completed_state_count() const override
+  {
+    return m_printer.get_completed_state_count();
+  }
+
+  void set_total_state_count(std::size_t states) override
+  {
+    m_printer.set_total_state_count(states);
+  }
+  [[nodiscard]] std::size_t get_total_state_count() const override
+  {
+    return m_printer.get_total_state_count();
+  }
+
+  std::vector<bulk_data_entry> m_bulk_data;
+
+protected:
+  void do_log_argv(const std::vector<std::string> &argv) override { m_printer.log_argv(argv); }
+  void do_print_device_info() override { m_printer.print_device_info(); }
+  void do_print_log_preamble() override { m_printer.print_log_preamble(); }
+  void do_print_log_epilogue() override { m_printer.print_log_epilogue(); }
+  void do_log(nvbench::log_level level, const std::string &msg) override
+  {
+    m_printer.log(level, msg);
+  }
+  void do_log_run_state(const nvbench::state &exec_state) override
+  {
+    m_printer.log_run_state(exec_state);
+  }
+  void do_process_bulk_data_float64(nvbench::state &,
+                                    const std::string &tag,
+                                    const std::string &hint,
+                                    const std::vector<nvbench::float64_t> &data) override
+  {
+    m_bulk_data.push_back({tag, hint, data});
+  }
+  void do_print_benchmark_list(const benchmark_vector &benches) override
+  {
+    m_printer.print_benchmark_list(benches);
+  }
+  void do_print_benchmark_results(const benchmark_vector &benches) override
+  {
+    m_printer.print_benchmark_results(benches);
+  }
+  void do_flush() override { m_printer.flush(); }
+
+private:
+  nvbench::printer_base &m_printer;
+};
+
+// Both ends of the process are about to share these buffers:
+void flush_output(const nvbench::benchmark_base &bench)
+{
+  if (auto printer_opt_ref = bench.get_printer(); printer_opt_ref.has_value())
+  {
+    printer_opt_ref.value().get().flush();
+  }
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+}
+
+void write_all(int fd, const void *data, std::size_t size, bool is_socket = false)
+{
+  const auto *bytes = static_cast<const char *>(data);
+  while (size > 0)
+  {
+    // Sockets report a dead peer with EPIPE instead of a signal:
+    const auto num_written = is_socket ? send(fd, bytes, size, MSG_NOSIGNAL)
+                                       : write(fd, bytes, size);
+    if (num_written == -1 && errno == EINTR)
+    {
+      continue;
+    }
+    NVBENCH_THROW_IF(num_written == -1,
+                     std::runtime_error,
+                     "Failed to write to a worker process: {}",
+                     std::strerror(errno));
+    bytes += num_written;
+    size -= static_cast<std::size_t>(num_written);
+  }
+}
+
+// Returns false if the end of the stream is reached before any data is read.
+bool read_all(int fd, void *data, std::size_t size)
+{
+  auto *bytes          = static_cast<char *>(data);
+  std::size_t received = 0;
+  while (received < size)
+  {
+    const auto num_read = read(fd, bytes + received, size - received);
+    if (num_read == -1 && errno == EINTR)
+    {
+      continue;
+    }
+    NVBENCH_THROW_IF(num_read == -1,
+                     std::runtime_error,
+                     "Failed to read from worker process: {}",
+                     std::strerror(errno));
+    if (num_read == 0)
+    {
+      NVBENCH_THROW_IF(received != 0,
+                       std::runtime_error,
+                       "{}",
+                       "Truncated message from a worker process.");
+      return false;
+    }
+    received += static_cast<std::size_t>(num_read);
+  }
+  return true;
+}
+
+void write_message(int fd, nvbench::uint64_t type, nvbench::int64_t index, const std::string &data)
+{
+  writer out;
+  out.put_u64(type);
+  out.put_i64(index);
+  out.put_u64(data.size());
+  out.m_data.append(data);
+  write_all(fd, out.m_data.data(), out.m_data.size());
+}
+
+// Returns false at the end of the stream.
+bool read_message(int fd, nvbench::uint64_t &type, nvbench::int64_t &index, std::string &data)
+{
+  nvbench::uint64_t header[3]{};
+  if (!read_all(fd, header, sizeof(header)))
+  {
+    return false;
+  }
+  type  = header[0];
+  index = static_cast<nvbench::int64_t>(header[1]);
+  data.resize(header[2]);
+  if (!data.empty() && !read_all(fd, data.data(), data.size()))
+  {
+    NVBENCH_THROW(std::runtime_error, "{}", "Truncated message from a worker process.");
+  }
+  return true;
+}
+
+nvbench::int64_t read_reply(int fd)
+{
+  nvbench::int64_t value{};
+  NVBENCH_THROW_IF(!read_all(fd, &value, sizeof(value)),
+                   std::runtime_error,
+                   "{}",
+                   "The zygote process exited unexpectedly.");
+  return value;
+}
+
+// Commands pass the write end of the worker's result pipe along with the
+// size of the payload that follows:
+void send_command(int socket_fd, int result_fd, const std::string &payload)
+{
+  nvbench::uint64_t size = payload.size();
+  iovec iov{&size, sizeof(size)};
+
+  char control[CMSG_SPACE(sizeof(int))]{};
+  msghdr msg{};
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control;
+  msg.msg_controllen = sizeof(control);
+
+  cmsghdr *cmsg    = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type  = SCM_RIGHTS;
+  cmsg->cmsg_len   = CMSG_LEN(sizeof(int));
+  std::memcpy(CMSG_DATA(cmsg), &result_fd, sizeof(int));
+
+  ssize_t num_sent{};
+  do
+  {
+    num_sent = sendmsg(socket_fd, &msg, MSG_NOSIGNAL);
+  } while (num_sent == -1 && errno == EINTR);
+  NVBENCH_THROW_IF(num_sent == -1,
+                   std::runtime_error,
+                   "Failed to send a command to the zygote process: {}",
+                   std::strerror(errno));
+
+  const auto *rest = reinterpret_cast<const char *>(&size) + num_sent;
+  write_all(socket_fd, rest, sizeof(size) - static_cast<std::size_t>(num_sent), true);
+  write_all(socket_fd, payload.data(), payload.size(), true);
+}
+
+// Returns false at the end of the stream.
+bool receive_command(int socket_fd, int &result_fd, std::string &payload)
+{
+  nvbench::uint64_t size{};
+  iovec iov{&size, sizeof(size)};
+
+  char control[CMSG_SPACE(sizeof(int))]{};
+  msghdr msg{};
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t num_read{};
+  do
+  {
+    num_read = recvmsg(socket_fd, &msg, MSG_CMSG_CLOEXEC);
+  } while (num_read == -1 && errno == EINTR);
+  if (num_read <= 0)
+  {
+    return false;
+  }
+
+  cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  NVBENCH_THROW_IF(cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS,
+                   std::runtime_error,
+                   "{}",
+                   "Command without a result pipe.");
+  std::memcpy(&result_fd, CMSG_DATA(cmsg), sizeof(int));
+
+  auto *rest = reinterpret_cast<char *>(&size) + num_read;
+  if (static_cast<std::size_t>(num_read) < sizeof(size) &&
+      !read_all(socket_fd, rest, sizeof(size) - static_cast<std::size_t>(num_read)))
+  {
+    return false;
+  }
+  payload.resize(size);
+  return payload.empty() || read_all(socket_fd, payload.data(), payload.size());
+}
+
+std::string describe_exit_status(nvbench::int64_t status)
+{
+  const int wstatus = static_cast<int>(status);
+  if (WIFSIGNALED(wstatus))
+  {
+    const int sig = WTERMSIG(wstatus);
+    return fmt::format("Worker process was terminated by signal {} ({}).", sig, strsignal(sig));
+  }
+  if (WIFEXITED(wstatus))
+  {
+    return fmt::format("Worker process exited with status {}.", WEXITSTATUS(wstatus));
+  }
+  return fmt::format("Worker process failed with wait status {}.", wstatus);
+}
+
+#endif // __linux__
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+isolation isolation::parse(const std::string &spec)
+{
+  isolation result;
+  if (spec == "none")
+  {
+    result.m_kind = kind::none;
+  }
+  else if (spec == "fork" || spec == "fork:state")
+  {
+    result.m_kind = kind::state;
+  }
+  else if (spec == "fork:benchmark")
+  {
+    result.m_kind = kind::benchmark;
+  }
+  else
+  {
+    NVBENCH_THROW(std::runtime_error,
+                  "Invalid isolation '{}'. Expected 'none', 'fork[:state]' or 'fork:benchmark'.",
+                  spec);
+  }
+  return result;
+}
+
+std::string isolation::to_string() const
+{
+  switch (m_kind)
+  {
+    case kind::state:
+      return "fork:state";
+    case kind::benchmark:
+      return "fork:benchmark";
+    case kind::none:
+    default:
+      return "none";
+  }
+}
+
+bool fork_server::is_supported()
+{
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+fork_server::fork_server(nvbench::benchmark_base &bench, state_runner run_state)
+    : m_benchmark{bench}
+    , m_run_state{std::move(run_state)}
+    , m_isolation{isolation::parse(bench.get_isolation())}
+{
+#ifdef __linux__
+  int fds[2];
+  NVBENCH_THROW_IF(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == -1,
+                   std::runtime_error,
+                   "Failed to create the zygote socket: {}",
+                   std::strerror(errno));
+
+  flush_output(m_benchmark);
+  const pid_t pid = fork();
+  if (pid == -1)
+  {
+    const int error = errno;
+    close(fds[0]);
+    close(fds[1]);
+    NVBENCH_THROW(std::runtime_error,
+                  "Failed to fork the zygote process: {}",
+                  std::strerror(error));
+  }
+  if (pid == 0)
+  {
+    close(fds[0]);
+    this->zygote_main(fds[1]);
+  }
+
+  close(fds[1]);
+  m_socket_fd  = fds[0];
+  m_zygote_pid = pid;
+#else
+  NVBENCH_THROW(std::runtime_error, "{}", "Fork isolation is only supported on Linux.");
+#endif
+}
+
+fork_server::~fork_server()
+{
+#ifdef __linux__
+  // The zygote exits at the end of its command stream:
+  if (m_socket_fd != -1)
+  {
+    close(m_socket_fd);
+  }
+  if (m_zygote_pid > 0)
+  {
+    while (waitpid(static_cast<pid_t>(m_zygote_pid), nullptr, 0) == -1 && errno == EINTR)
+    {}
+  }
+#endif
+}
+
+nvbench::float64_t
+fork_server::get_hard_timeout(const std::vector<nvbench::state *> &states) const
+{
+  const auto hard_timeout = m_benchmark.get_hard_timeout();
+  if (hard_timeout > 0.)
+  {
+    return hard_timeout;
+  }
+  nvbench::float64_t timeout = m_benchmark.get_timeout();
+  for (const nvbench::state *cur_state : states)
+  {
+    timeout = std::max(timeout, cur_state->get_timeout());
+  }
+  return 10. * timeout + m_benchmark.get_soak_duration();
+}
+
+void fork_server::run(const std::vector<nvbench::state *> &states)
+{
+  if (m_isolation.m_kind == isolation::kind::state)
+  {
+    for (nvbench::state *cur_state : states)
+    {
+      this->run_worker({cur_state});
+    }
+    return;
+  }
+
+  // Replace the worker until all states have run:
+  auto first = states.cbegin();
+  while (first != states.cend())
+  {
+    first += static_cast<std::ptrdiff_t>(this->run_worker({first, states.cend()}));
+  }
+}
+
+std::size_t fork_server::run_worker([[maybe_unused]] const std::vector<nvbench::state *> &states)
+{
+#ifdef __linux__
+  auto printer_opt_ref = m_benchmark.get_printer();
+  const auto &bench_states = m_benchmark.get_states();
+
+  writer command;
+  command.put_u64(printer_opt_ref ? printer_opt_ref.value().get().get_completed_state_count() : 0);
+  command.put_u64(states.size());
+  for (const nvbench::state *cur_state : states)
+  {
+    command.put_i64(cur_state - bench_states.data());
+    // The zygote's snapshot predates any escalated retry timeout:
+    command.put_f64(cur_state->get_timeout());
+  }
+
+  int fds[2];
+  NVBENCH_THROW_IF(pipe2(fds, O_CLOEXEC) == -1,
+                   std::runtime_error,
+                   "Failed to create a worker pipe: {}",
+                   std::strerror(errno));
+
+  flush_output(m_benchmark);
+  try
+  {
+    send_command(m_socket_fd, fds[1], command.m_data);
+  }
+  catch (...)
+  {
+    close(fds[0]);
+    close(fds[1]);
+    throw;
+  }
+  // The worker holds the only write end, so its exit ends the stream:
+  close(fds[1]);
+  const int result_fd = fds[0];
+
+  const auto pid = read_reply(m_socket_fd);
+  if (pid <= 0)
+  {
+    close(result_fd);
+    NVBENCH_THROW(std::runtime_error,
+                  "Failed to fork a worker process: {}",
+                  std::strerror(static_cast<int>(-pid)));
+  }
+
+  using clock_type        = std::chrono::steady_clock;
+  const auto hard_timeout = this->get_hard_timeout(states);
+  const auto timeout      = std::chrono::duration_cast<clock_type::duration>(
+    std::chrono::duration<nvbench::float64_t>(hard_timeout));
+
+  std::size_t num_done      = 0;
+  nvbench::state *cur_state = nullptr;
+  bool killed               = false;
+  auto deadline             = clock_type::now() + timeout;
+  std::vector<bulk_data_entry> bulk_data_entries;
+  std::string error;
+  try
+  {
+    for (;;)
+    {
+      if (!killed)
+      {
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline -
+                                                                            clock_type::now());
+        if (remaining.count() <= 0)
+        {
+          kill(static_cast<pid_t>(pid), SIGKILL);
+          killed = true;
+          continue;
+        }
+
+        pollfd pfd{result_fd, POLLIN, 0};
+        const auto wait_ms =
+          static_cast<int>(std::min<nvbench::int64_t>(remaining.count(), INT_MAX));
+        if (poll(&pfd, 1, wait_ms) <= 0)
+        {
+          continue;
+        }
+      }
+
+      nvbench::uint64_t type{};
+      nvbench::int64_t index{};
+      std::string data;
+      if (!read_message(result_fd, type, index, data))
+      {
+        break;
+      }
+
+      NVBENCH_THROW_IF(num_done >= states.size() ||
+                         index != states[num_done] - bench_states.data(),
+                       std::runtime_error,
+                       "{}",
+                       "Unexpected state from a worker process.");
+      if (type == state_begin)
+      {
+        cur_state = states[num_done];
+        bulk_data_entries.clear();
+      }
+      else if (type == bulk_data)
+      {
+        bulk_data_entries.push_back(deserialize_bulk_data(data));
+      }
+      else
+      {
+        deserialize_results(data, *states[num_done]);
+        if (printer_opt_ref)
+        {
+          // After the summaries are replaced, so that the printer can add to them:
+          auto &printer = printer_opt_ref.value().get();
+          for (const auto &entry : bulk_data_entries)
+          {
+            printer.process_bulk_data(*states[num_done], entry.tag, entry.hint, entry.data);
+          }
+          printer.add_completed_state();
+        }
+        bulk_data_entries.clear();
+        cur_state = nullptr;
+        ++num_done;
+      }
+      deadline = clock_type::now() + timeout;
+    }
+  }
+  catch (std::exception &e)
+  {
+    // Still reap the worker below:
+    kill(static_cast<pid_t>(pid), SIGKILL);
+    error = e.what();
+  }
+  close(result_fd);
+
+  const auto status = read_reply(m_socket_fd);
+  NVBENCH_THROW_IF(!error.empty(), std::runtime_error, "{}", error);
+
+  // A worker that dies before starting a state is blamed on that state, so
+  // that the caller always makes progress:
+  if (cur_state != nullptr || num_done == 0)
+  {
+    const auto reason =
+      killed ? fmt::format("Worker process was killed after exceeding the hard timeout ({}s).",
+                           hard_timeout)
+             : describe_exit_status(status);
+
+    if (cur_state == nullptr)
+    {
+      cur_state = states.front();
+    }
+    if (printer_opt_ref)
+    {
+      auto &printer = printer_opt_ref.value().get();
+      printer.log(nvbench::log_level::fail, reason);
+      printer.add_completed_state();
+    }
+    cur_state->skip(reason);
+    ++num_done;
+  }
+
+  return num_done;
+#else
+  return states.size();
+#endif
+}
+
+void fork_server::zygote_main([[maybe_unused]] int socket_fd)
+{
+#ifdef __linux__
+  try
+  {
+    int result_fd = -1;
+    std::string payload;
+    while (receive_command(socket_fd, result_fd, payload))
+    {
+      reader in{payload};
+      const auto completed_states = in.get_i64();
+      std::vector<nvbench::int64_t> state_indices(static_cast<std::size_t>(in.get_u64()));
+      std::vector<nvbench::float64_t> timeouts(state_indices.size());
+      for (std::size_t i = 0; i < state_indices.size(); ++i)
+      {
+        state_indices[i] = in.get_i64();
+        timeouts[i]      = in.get_f64();
+      }
+
+      const pid_t pid = fork();
+      if (pid == 0)
+      {
+        close(socket_fd);
+        this->worker_main(result_fd, completed_states, state_indices, timeouts);
+      }
+      const nvbench::int64_t reply = pid == -1 ? -nvbench::int64_t{errno} : pid;
+      close(result_fd);
+      write_all(socket_fd, &reply, sizeof(reply));
+
+      if (pid != -1)
+      {
+        int wstatus = 0;
+        while (waitpid(pid, &wstatus, 0) == -1 && errno == EINTR)
+        {}
+        const nvbench::int64_t status = wstatus;
+        write_all(socket_fd, &status, sizeof(status));
+      }
+    }
+  }
+  catch (std::exception &e)
+  {
+    std::fprintf(stderr, "NVBench zygote process failed: %s\n", e.what());
+    std::fflush(stderr);
+    _exit(1);
+  }
+  _exit(0);
+#else
+  std::abort();
+#endif
+}
+
+void fork_server::worker_main([[maybe_unused]] int result_fd,
+                              [[maybe_unused]] nvbench::int64_t completed_states,
+                              [[maybe_unused]] const std::vector<nvbench::int64_t> &state_indices,
+                              [[maybe_unused]] const std::vector<nvbench::float64_t> &timeouts)
+{
+#ifdef __linux__
+  // Outlives the flushes below:
+  std::unique_ptr<bulk_data_capture> capture;
+  try
+  {
+    // Keep the progress display of the benchmark process:
+    if (auto printer_opt_ref = m_benchmark.get_printer(); printer_opt_ref.has_value())
+    {
+      capture = std::make_unique<bulk_data_capture>(printer_opt_ref.value().get());
+      capture->set_completed_state_count(static_cast<std::size_t>(completed_states));
+      m_benchmark.set_printer(*capture);
+    }
+
+    auto &states = m_benchmark.get_states();
+    for (std::size_t i = 0; i < state_indices.size(); ++i)
+    {
+      const auto index = state_indices[i];
+      auto &cur_state  = states.at(static_cast<std::size_t>(index));
+      cur_state.set_timeout(timeouts[i]);
+      write_message(result_fd, state_begin, index, {});
+      m_run_state(cur_state);
+      flush_output(m_benchmark);
+      if (capture)
+      {
+        for (const auto &entry : capture->m_bulk_data)
+        {
+          write_message(result_fd, bulk_data, index, serialize_bulk_data(entry));
+        }
+        capture->m_bulk_data.clear();
+      }
+      write_message(result_fd, state_end, index, serialize_results(cur_state));
+    }
+  }
+  catch (std::exception &e)
+  {
+    std::fprintf(stderr, "NVBench worker process failed: %s\n", e.what());
+    flush_output(m_benchmark);
+    _exit(1);
+  }
+  flush_output(m_benchmark);
+  _exit(0);
+#else
+  std::abort();
+#endif
+}
+
+} // namespace nvbench::detail
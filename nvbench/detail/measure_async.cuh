@@ -0,0 +1,276 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/async_completion.cuh>
+#include <nvbench/cpu_timer.cuh>
+#include <nvbench/launch.cuh>
+#include <nvbench/stopping_criterion.cuh>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace nvbench
+{
+
+struct state;
+
+namespace detail
+{
+
+// non-templated code goes here:
+struct measure_async_base
+{
+  explicit measure_async_base(nvbench::state &exec_state);
+  measure_async_base(const measure_async_base &)            = delete;
+  measure_async_base(measure_async_base &&)                 = delete;
+  measure_async_base &operator=(const measure_async_base &) = delete;
+  measure_async_base &operator=(measure_async_base &&)      = delete;
+
+protected:
+  using clock = nvbench::detail::async_completion_queue::clock;
+
+  void check();
+  void initialize();
+  void run_trials_prologue();
+  bool is_finished();
+  void run_trials_epilogue();
+  void generate_summaries();
+
+  void check_skip_time(nvbench::float64_t warmup_time);
+
+  /// Whether another operation may be started now. Input pools are refreshed
+  /// only while no operations are in flight.
+  [[nodiscard]] bool can_submit();
+
+  /// Claims a free slot and returns the completion for the operation that is
+  /// about to start in it.
+  [[nodiscard]] nvbench::async_completion begin_operation();
+
+  /// Reports the completion of the operation in `slot`, for launchers that
+  /// return a handle instead of calling the completion.
+  void complete(std::size_t slot);
+
+  /// Waits for at least one operation to complete and records the latencies
+  /// of all completed operations. Throws if none completes in time.
+  void wait_for_completions();
+
+  [[nodiscard]] clock::time_point get_wait_deadline() const;
+  [[noreturn]] void throw_wait_timeout() const;
+
+  nvbench::state &m_state;
+
+  // Required to satisfy the KernelLauncher interface:
+  nvbench::launch m_launch;
+
+  nvbench::cpu_timer m_walltime_timer;
+
+  nvbench::criterion_params m_criterion_params;
+  nvbench::stopping_criterion_base &m_stopping_criterion;
+
+  bool m_run_once{false};
+
+  nvbench::int64_t m_min_samples{};
+  nvbench::int64_t m_depth{};
+
+  nvbench::float64_t m_skip_time{};
+  nvbench::float64_t m_timeout{};
+
+  struct slot
+  {
+    bool in_flight{};
+    nvbench::uint64_t sequence{};
+    clock::time_point submit_time;
+  };
+
+  std::shared_ptr<nvbench::detail::async_completion_queue> m_queue;
+  std::vector<slot> m_slots;
+  std::vector<nvbench::detail::async_completion_queue::entry> m_completed;
+  std::size_t m_in_flight{};
+  std::size_t m_last_slot{};
+  nvbench::uint64_t m_next_sequence{};
+  nvbench::int64_t m_launches_before_refresh{};
+
+  // Latencies are only recorded during the trials:
+  bool m_recording{};
+  bool m_stop_submitting{};
+  nvbench::float64_t m_last_latency{};
+
+  nvbench::int64_t m_total_samples{};
+  nvbench::float64_t m_min_latency{};
+  nvbench::float64_t m_max_latency{};
+  nvbench::float64_t m_total_latency{};
+  std::vector<nvbench::float64_t> m_latencies;
+
+  std::optional<clock::time_point> m_first_submit;
+  clock::time_point m_last_completion;
+
+  bool m_max_time_exceeded{};
+};
+
+/**
+ * Measures the latency and throughput of asynchronous operations for
+ * `nvbench::exec_tag::async`.
+ *
+ * The launcher starts one operation per call and reports its completion in
+ * one of two ways:
+ *
+ * - `launcher(nvbench::launch &, nvbench::async_completion done)` calls
+ *   `done()` from any thread once the operation has completed.
+ * - `launcher(nvbench::launch &)` returns a handle such as `std::future`,
+ *   whose `wait_for` is polled by the measuring thread.
+ *
+ * Up to `benchmark_base::get_async_depth()` operations are kept in flight.
+ */
+template <typename KernelLauncher>
+struct measure_async : public measure_async_base
+{
+  static constexpr bool uses_completion =
+    std::is_invocable_v<KernelLauncher &, nvbench::launch &, nvbench::async_completion>;
+
+  measure_async(nvbench::state &state, KernelLauncher &kernel_launcher)
+      : measure_async_base(state)
+      , m_kernel_launcher{kernel_launcher}
+  {}
+
+  void operator()()
+  {
+    this->check();
+    this->initialize();
+    this->run_warmup();
+
+    this->run_trials_prologue();
+    this->run_trials();
+    this->run_trials_epilogue();
+
+    this->generate_summaries();
+  }
+
+private:
+  // Run one operation, measuring its latency. If under skip_time, skip the
+  // measurement.
+  void run_warmup()
+  {
+    if (m_run_once)
+    { // Skip warmups
+      return;
+    }
+
+    this->submit();
+    this->drain();
+    this->check_skip_time(m_last_latency);
+  }
+
+  void run_trials()
+  {
+    do
+    {
+      while (this->can_submit())
+      {
+        this->submit();
+      }
+      this->wait();
+    } while (!this->is_finished());
+
+    // Completions of operations that are still in flight are recorded too:
+    this->drain();
+  }
+
+  void submit()
+  {
+    auto done = this->begin_operation();
+    if constexpr (uses_completion)
+    {
+      m_kernel_launcher(m_launch, std::move(done));
+    }
+    else
+    {
+      static_assert(std::is_invocable_v<KernelLauncher &, nvbench::launch &>,
+                    "Launchers for `nvbench::exec_tag::async` must accept "
+                    "(nvbench::launch &, nvbench::async_completion) or return a handle.");
+      m_handles.resize(m_slots.size());
+      m_handles[m_last_slot].emplace(m_kernel_launcher(m_launch));
+    }
+  }
+
+  void wait()
+  {
+    if constexpr (!uses_completion)
+    {
+      this->poll_handles();
+    }
+    this->wait_for_completions();
+  }
+
+  void drain()
+  {
+    while (m_in_flight > 0)
+    {
+      this->wait();
+    }
+  }
+
+  // Completes the operations whose handles are ready, waiting for at least
+  // one of them.
+  void poll_handles()
+  {
+    const auto deadline = this->get_wait_deadline();
+    for (;;)
+    {
+      bool any_ready = false;
+      for (std::size_t i = 0; i < m_handles.size(); ++i)
+      {
+        auto &handle = m_handles[i];
+        if (handle && handle->wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+        {
+          handle.reset();
+          this->complete(i);
+          any_ready = true;
+        }
+      }
+      if (any_ready)
+      {
+        return;
+      }
+      if (clock::now() > deadline)
+      {
+        this->throw_wait_timeout();
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  using handle_type = typename std::conditional_t<
+    uses_completion,
+    std::common_type<void>,
+    std::invoke_result<KernelLauncher &, nvbench::launch &>>::type;
+
+  // Handles of the operations in flight, by slot:
+  std::vector<std::optional<std::conditional_t<uses_completion, int, handle_type>>> m_handles;
+
+  KernelLauncher &m_kernel_launcher;
+};
+
+} // namespace detail
+} // namespace nvbench
@@ -0,0 +1,431 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/criterion_manager.cuh>
+#include <nvbench/detail/measure_async.cuh>
+#include <nvbench/detail/statistics.cuh>
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+// Nearest-rank percentile of `values`, which must not be empty:
+nvbench::float64_t percentile(std::vector<nvbench::float64_t> values, nvbench::float64_t p)
+{
+  const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(values.size())));
+  const auto index = static_cast<std::ptrdiff_t>(std::max(rank, std::size_t{1}) - 1);
+  const auto iter  = values.begin() + index;
+  std::nth_element(values.begin(), iter, values.end());
+  return *iter;
+}
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+measure_async_base::measure_async_base(state &exec_state)
+    : m_state{exec_state}
+    , m_launch(m_state.get_cuda_stream())
+    , m_criterion_params{exec_state.get_criterion_params()}
+    , m_stopping_criterion{nvbench::criterion_manager::get().get_criterion(
+        exec_state.get_stopping_criterion())}
+    , m_run_once{exec_state.get_run_once()}
+    , m_min_samples{exec_state.get_min_samples()}
+    , m_depth{exec_state.get_benchmark().get_async_depth()}
+    , m_skip_time{exec_state.get_skip_time()}
+    , m_timeout{exec_state.get_timeout()}
+{
+  if (m_min_samples > 0)
+  {
+    m_latencies.reserve(static_cast<std::size_t>(m_min_samples));
+  }
+}
+
+void measure_async_base::check()
+{
+  NVBENCH_THROW_IF(m_depth < 1,
+                   std::runtime_error,
+                   "The async depth must be at least 1, got {}.",
+                   m_depth);
+}
+
+void measure_async_base::initialize()
+{
+  // Operations abandoned by a previous measurement report to the old queue:
+  m_queue = std::make_shared<nvbench::detail::async_completion_queue>();
+  m_slots.assign(m_run_once ? 1 : static_cast<std::size_t>(m_depth), slot{});
+  m_in_flight               = 0;
+  m_launches_before_refresh = 0;
+
+  m_recording       = false;
+  m_stop_submitting = false;
+
+  m_min_latency   = std::numeric_limits<nvbench::float64_t>::max();
+  m_max_latency   = std::numeric_limits<nvbench::float64_t>::lowest();
+  m_total_latency = 0.;
+  m_total_samples = 0;
+  m_latencies.clear();
+  m_first_submit.reset();
+  m_max_time_exceeded = false;
+
+  m_stopping_criterion.initialize(m_criterion_params);
+}
+
+void measure_async_base::run_trials_prologue()
+{
+  m_recording = true;
+  m_walltime_timer.start();
+}
+
+bool measure_async_base::can_submit()
+{
+  if (m_stop_submitting || m_in_flight == m_slots.size())
+  {
+    return false;
+  }
+
+  if (m_launches_before_refresh == 0)
+  {
+    // Refreshing would overwrite inputs that are still in use:
+    if (m_in_flight > 0)
+    {
+      return false;
+    }
+    m_launches_before_refresh = m_state.prepare_input_pools(static_cast<nvbench::int64_t>(
+      m_slots.size()));
+  }
+  return true;
+}
+
+nvbench::async_completion measure_async_base::begin_operation()
+{
+  const auto iter = std::find_if(m_slots.begin(), m_slots.end(), [](const slot &s) {
+    return !s.in_flight;
+  });
+  m_last_slot = static_cast<std::size_t>(iter - m_slots.begin());
+
+  --m_launches_before_refresh;
+  ++m_in_flight;
+
+  auto &cur_slot     = *iter;
+  cur_slot.in_flight = true;
+  cur_slot.sequence  = m_next_sequence++;
+  if (m_run_once)
+  {
+    m_stop_submitting = true;
+  }
+
+  // The operation starts when the launcher is called:
+  cur_slot.submit_time = clock::now();
+  if (m_recording && !m_first_submit)
+  {
+    m_first_submit = cur_slot.submit_time;
+  }
+  return nvbench::async_completion{m_queue, m_last_slot, cur_slot.sequence};
+}
+
+void measure_async_base::complete(std::size_t slot_index)
+{
+  m_queue->push(slot_index, m_slots[slot_index].sequence);
+}
+
+void measure_async_base::wait_for_completions()
+{
+  if (!m_queue->pop_all(m_completed, this->get_wait_deadline()))
+  {
+    this->throw_wait_timeout();
+  }
+
+  for (const auto &entry : m_completed)
+  {
+    auto &cur_slot = m_slots[entry.slot];
+    NVBENCH_THROW_IF(!cur_slot.in_flight || cur_slot.sequence != entry.sequence,
+                     std::runtime_error,
+                     "{}",
+                     "An nvbench::async_completion was called more than once.");
+    cur_slot.in_flight = false;
+    --m_in_flight;
+
+    const auto latency =
+      std::chrono::duration<nvbench::float64_t>(entry.time - cur_slot.submit_time).count();
+    m_last_latency    = latency;
+    m_last_completion = std::max(m_last_completion, entry.time);
+
+    if (m_recording)
+    {
+      m_min_latency = std::min(m_min_latency, latency);
+      m_max_latency = std::max(m_max_latency, latency);
+      m_total_latency += latency;
+      m_latencies.push_back(latency);
+      ++m_total_samples;
+
+      m_stopping_criterion.add_measurement(latency);
+    }
+  }
+}
+
+measure_async_base::clock::time_point measure_async_base::get_wait_deadline() const
+{
+  return clock::now() + std::chrono::duration_cast<clock::duration>(
+                          std::chrono::duration<nvbench::float64_t>(m_timeout));
+}
+
+void measure_async_base::throw_wait_timeout() const
+{
+  NVBENCH_THROW(std::runtime_error,
+                "{} asynchronous operation(s) did not complete within the timeout ({:0.2f}s).",
+                m_in_flight,
+                m_timeout);
+}
+
+bool measure_async_base::is_finished()
+{
+  if (m_run_once)
+  {
+    return true;
+  }
+
+  // Check that we've gathered enough samples:
+  if (m_total_samples > m_min_samples)
+  {
+    if (m_stopping_criterion.is_finished())
+    {
+      m_stop_submitting = true;
+      return true;
+    }
+  }
+
+  // Check for timeouts:
+  m_walltime_timer.stop();
+  if (m_walltime_timer.get_duration() > m_timeout)
+  {
+    m_max_time_exceeded = true;
+    m_stop_submitting   = true;
+    return true;
+  }
+
+  return false;
+}
+
+void measure_async_base::run_trials_epilogue()
+{
+  m_recording = false;
+  m_walltime_timer.stop();
+}
+
+void measure_async_base::generate_summaries()
+{
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/sample_size", "Samples", "sample_size", "Number of completed operations"});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_int64("value", m_total_samples);
+  }
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/depth",
+       "Depth",
+       {},
+       "Maximum number of operations in flight",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_int64("value", static_cast<nvbench::int64_t>(m_slots.size()));
+  }
+
+  if (m_total_samples == 0)
+  {
+    return;
+  }
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/time/latency/min",
+       "Min Latency",
+       "duration",
+       "Fastest submission-to-completion time",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_float64("value", m_min_latency);
+  }
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/time/latency/max",
+       "Max Latency",
+       "duration",
+       "Slowest submission-to-completion time",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_float64("value", m_max_latency);
+  }
+
+  const auto d_samples    = static_cast<nvbench::float64_t>(m_total_samples);
+  const auto latency_mean = m_total_latency / d_samples;
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/time/latency/mean",
+       "Latency",
+       "duration",
+       "Mean submission-to-completion time"});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_float64("value", latency_mean);
+  }
+
+  const auto latency_stdev =
+    nvbench::detail::statistics::standard_deviation(m_latencies.cbegin(),
+                                                    m_latencies.cend(),
+                                                    latency_mean);
+  const auto latency_noise = latency_stdev / latency_mean;
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/time/latency/stdev/relative",
+       "Noise",
+       "percentage",
+       "Relative standard deviation of the latencies"});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_float64("value", latency_noise);
+  }
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/time/latency/p50",
+       "p50 Latency",
+       "duration",
+       "Median submission-to-completion time",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_float64("value", ::percentile(m_latencies, 0.5));
+  }
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/async/time/latency/p99",
+       "p99 Latency",
+       "duration",
+       "99th percentile of the submission-to-completion times"});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_float64("value", ::percentile(m_latencies, 0.99));
+  }
+
+  // Completed operations per second between the first submission and the
+  // last completion of the trials:
+  const auto trial_time =
+    m_first_submit
+      ? std::chrono::duration<nvbench::float64_t>(m_last_completion - *m_first_submit).count()
+      : 0.;
+  if (trial_time > 0.)
+  {
+    const auto ops_rate = d_samples / trial_time;
+    {
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/async/throughput",
+         "Ops/s",
+         "item_rate",
+         "Completed operations per second of walltime"});
+      auto &summ = m_state.add_summary(desc);
+      summ.set_float64("value", ops_rate);
+    }
+
+    if (const auto items = m_state.get_element_count(); items != 0)
+    {
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/async/bw/item_rate",
+         "Elem/s",
+         "item_rate",
+         "Number of input elements processed per second"});
+      auto &summ = m_state.add_summary(desc);
+      summ.set_float64("value", static_cast<double>(items) * ops_rate);
+    }
+  }
+
+  // Log if a printer exists:
+  if (auto printer_opt_ref = m_state.get_benchmark().get_printer(); printer_opt_ref.has_value())
+  {
+    auto &printer = printer_opt_ref.value().get();
+
+    if (m_max_time_exceeded)
+    {
+      const auto timeout = m_walltime_timer.get_duration();
+
+      std::optional<nvbench::float64_t> max_noise;
+      if (m_criterion_params.has_value("max-noise"))
+      {
+        max_noise = m_criterion_params.get_float64("max-noise");
+      }
+
+      if (max_noise && latency_noise > *max_noise)
+      {
+        printer.log(nvbench::log_level::warn,
+                    fmt::format("Current measurement timed out ({:0.2f}s) "
+                                "while over noise threshold ({:0.2f}% > "
+                                "{:0.2f}%)",
+                                timeout,
+                                latency_noise * 100,
+                                *max_noise * 100));
+      }
+      if (m_total_samples < m_min_samples)
+      {
+        printer.log(nvbench::log_level::warn,
+                    fmt::format("Current measurement timed out ({:0.2f}s) "
+                                "before accumulating min_samples ({} < {})",
+                                timeout,
+                                m_total_samples,
+                                m_min_samples));
+      }
+    }
+
+    // Log to stdout:
+    printer.log(nvbench::log_level::pass,
+                fmt::format("Async: {:0.6f}ms mean latency, {:0.2f}s total wall, {}x, "
+                            "depth {}",
+                            latency_mean * 1e3,
+                            m_walltime_timer.get_duration(),
+                            m_total_samples,
+                            m_slots.size()));
+
+    printer.process_bulk_data(m_state, "nv/async/sample_times", "sample_times", m_latencies);
+  }
+}
+
+void measure_async_base::check_skip_time(nvbench::float64_t warmup_time)
+{
+  if (m_skip_time > 0. && warmup_time < m_skip_time)
+  {
+    auto reason = fmt::format("Warmup time did not meet skip_time limit: "
+                              "{:0.3f}us < {:0.3f}us.",
+                              warmup_time * 1e6,
+                              m_skip_time * 1e6);
+
+    m_state.skip(reason);
+    NVBENCH_THROW(std::runtime_error, "{}", std::move(reason));
+  }
+}
+
+} // namespace nvbench::detail
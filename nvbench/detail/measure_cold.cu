@@ -42,6 +42,7 @@ measure_cold_base::measure_cold_base(state &exec_state)
     , m_criterion_params{exec_state.get_criterion_params()}
     , m_stopping_criterion{nvbench::criterion_manager::get().get_criterion(
         exec_state.get_stopping_criterion())}
+    , m_soak{exec_state.get_benchmark()}
     , m_disable_blocking_kernel{exec_state.get_disable_blocking_kernel()}
     , m_run_once{exec_state.get_run_once()}
     , m_check_throttling(!exec_state.get_run_once() && exec_state.get_throttle_threshold() > 0.f)
@@ -150,16 +151,25 @@ void measure_cold_base::record_measurements()
   m_min_cuda_time = std::min(m_min_cuda_time, cur_cuda_time);
   m_max_cuda_time = std::max(m_max_cuda_time, cur_cuda_time);
   m_total_cuda_time += cur_cuda_time;
-  m_cuda_times.push_back(cur_cuda_time);
+  m_soak.keep_sample(m_cuda_times, cur_cuda_time, m_total_samples);
 
   m_min_cpu_time = std::min(m_min_cpu_time, cur_cpu_time);
   m_max_cpu_time = std::max(m_max_cpu_time, cur_cpu_time);
   m_total_cpu_time += cur_cpu_time;
-  m_cpu_times.push_back(cur_cpu_time);
+  m_soak.keep_sample(m_cpu_times, cur_cpu_time, m_total_samples);
 
   ++m_total_samples;
 
-  m_stopping_criterion.add_measurement(cur_cuda_time);
+  // Soak runs ignore the stopping criterion, whose cost grows with the samples:
+  if (m_soak.is_enabled())
+  {
+    m_walltime_timer.stop();
+    m_soak.add_sample(cur_cuda_time, m_walltime_timer.get_duration());
+  }
+  else
+  {
+    m_stopping_criterion.add_measurement(cur_cuda_time);
+  }
 }
 
 bool measure_cold_base::is_finished()
@@ -169,6 +179,13 @@ bool measure_cold_base::is_finished()
     return true;
   }
 
+  // Soak runs ignore the stopping criterion and timeout:
+  if (m_soak.is_enabled())
+  {
+    m_walltime_timer.stop();
+    return m_soak.is_finished(m_walltime_timer.get_duration());
+  }
+
   // Check that we've gathered enough samples:
   if (m_total_samples > m_min_samples)
   {
@@ -193,45 +210,47 @@ void measure_cold_base::run_trials_epilogue() { m_walltime_timer.stop(); }
 
 void measure_cold_base::generate_summaries()
 {
+  nvbench::detail::soak_tracker::restore_order(m_cuda_times, m_total_samples);
+  nvbench::detail::soak_tracker::restore_order(m_cpu_times, m_total_samples);
+
   {
-    auto &summ = m_state.add_summary("nv/cold/sample_size");
-    summ.set_string("name", "Samples");
-    summ.set_string("hint", "sample_size");
-    summ.set_string("description", "Number of isolated kernel executions");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/sample_size", "Samples", "sample_size", "Number of isolated kernel executions"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_int64("value", m_total_samples);
   }
 
   {
-    auto &summ = m_state.add_summary("nv/cold/time/cpu/min");
-    summ.set_string("name", "Min CPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description",
-                    "Fastest isolated kernel execution time "
-                    "(measured on host CPU)");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/cpu/min",
+       "Min CPU Time",
+       "duration",
+       "Fastest isolated kernel execution time (measured on host CPU)",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_min_cpu_time);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   {
-    auto &summ = m_state.add_summary("nv/cold/time/cpu/max");
-    summ.set_string("name", "Max CPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description",
-                    "Slowest isolated kernel execution time "
-                    "(measured on host CPU)");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/cpu/max",
+       "Max CPU Time",
+       "duration",
+       "Slowest isolated kernel execution time (measured on host CPU)",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_max_cpu_time);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   const auto d_samples = static_cast<double>(m_total_samples);
   const auto cpu_mean  = m_total_cpu_time / d_samples;
   {
-    auto &summ = m_state.add_summary("nv/cold/time/cpu/mean");
-    summ.set_string("name", "CPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description",
-                    "Mean isolated kernel execution time "
-                    "(measured on host CPU)");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/cpu/mean",
+       "CPU Time",
+       "duration",
+       "Mean isolated kernel execution time (measured on host CPU)"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cpu_mean);
   }
 
@@ -239,53 +258,57 @@ void measure_cold_base::generate_summaries()
                                                                          m_cpu_times.cend(),
                                                                          cpu_mean);
   {
-    auto &summ = m_state.add_summary("nv/cold/time/cpu/stdev/absolute");
-    summ.set_string("name", "Noise");
-    summ.set_string("hint", "percentage");
-    summ.set_string("description", "Standard deviation of isolated CPU times");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/cpu/stdev/absolute",
+       "Noise",
+       "percentage",
+       "Standard deviation of isolated CPU times",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cpu_stdev);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   const auto cpu_noise = cpu_stdev / cpu_mean;
   {
-    auto &summ = m_state.add_summary("nv/cold/time/cpu/stdev/relative");
-    summ.set_string("name", "Noise");
-    summ.set_string("hint", "percentage");
-    summ.set_string("description", "Relative standard deviation of isolated CPU times");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/cpu/stdev/relative",
+       "Noise",
+       "percentage",
+       "Relative standard deviation of isolated CPU times"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cpu_noise);
   }
 
   {
-    auto &summ = m_state.add_summary("nv/cold/time/gpu/min");
-    summ.set_string("name", "Min GPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description",
-                    "Fastest isolated kernel execution time "
-                    "(measured with CUDA events)");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/gpu/min",
+       "Min GPU Time",
+       "duration",
+       "Fastest isolated kernel execution time (measured with CUDA events)",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_min_cuda_time);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   {
-    auto &summ = m_state.add_summary("nv/cold/time/gpu/max");
-    summ.set_string("name", "Max GPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description",
-                    "Slowest isolated kernel execution time "
-                    "(measured with CUDA events)");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/gpu/max",
+       "Max GPU Time",
+       "duration",
+       "Slowest isolated kernel execution time (measured with CUDA events)",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_max_cuda_time);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   const auto cuda_mean = m_total_cuda_time / d_samples;
   {
-    auto &summ = m_state.add_summary("nv/cold/time/gpu/mean");
-    summ.set_string("name", "GPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description",
-                    "Mean isolated kernel execution time "
-                    "(measured with CUDA events)");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/gpu/mean",
+       "GPU Time",
+       "duration",
+       "Mean isolated kernel execution time (measured with CUDA events)"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cuda_mean);
   }
 
@@ -293,29 +316,35 @@ void measure_cold_base::generate_summaries()
                                                                           m_cuda_times.cend(),
                                                                           cuda_mean);
   {
-    auto &summ = m_state.add_summary("nv/cold/time/gpu/stdev/absolute");
-    summ.set_string("name", "Noise");
-    summ.set_string("hint", "percentage");
-    summ.set_string("description", "Relative standard deviation of isolated GPU times");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/gpu/stdev/absolute",
+       "Noise",
+       "percentage",
+       "Relative standard deviation of isolated GPU times",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cuda_stdev);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   const auto cuda_noise = cuda_stdev / cuda_mean;
   {
-    auto &summ = m_state.add_summary("nv/cold/time/gpu/stdev/relative");
-    summ.set_string("name", "Noise");
-    summ.set_string("hint", "percentage");
-    summ.set_string("description", "Relative standard deviation of isolated GPU times");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/time/gpu/stdev/relative",
+       "Noise",
+       "percentage",
+       "Relative standard deviation of isolated GPU times"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cuda_noise);
   }
 
   if (const auto items = m_state.get_element_count(); items != 0)
   {
-    auto &summ = m_state.add_summary("nv/cold/bw/item_rate");
-    summ.set_string("name", "Elem/s");
-    summ.set_string("hint", "item_rate");
-    summ.set_string("description", "Number of input elements processed per second");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/bw/item_rate",
+       "Elem/s",
+       "item_rate",
+       "Number of input elements processed per second"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", static_cast<double>(items) / cuda_mean);
   }
 
@@ -323,12 +352,12 @@ void measure_cold_base::generate_summaries()
   {
     const auto avg_used_gmem_bw = static_cast<double>(bytes) / cuda_mean;
     {
-      auto &summ = m_state.add_summary("nv/cold/bw/global/bytes_per_second");
-      summ.set_string("name", "GlobalMem BW");
-      summ.set_string("hint", "byte_rate");
-      summ.set_string("description",
-                      "Number of bytes read/written per second to the CUDA "
-                      "device's global memory");
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/cold/bw/global/bytes_per_second",
+         "GlobalMem BW",
+         "byte_rate",
+         "Number of bytes read/written per second to the CUDA device's global memory"});
+      auto &summ = m_state.add_summary(desc);
       summ.set_float64("value", avg_used_gmem_bw);
     }
 
@@ -336,35 +365,41 @@ void measure_cold_base::generate_summaries()
       const auto peak_gmem_bw =
         static_cast<double>(m_state.get_device()->get_global_memory_bus_bandwidth());
 
-      auto &summ = m_state.add_summary("nv/cold/bw/global/utilization");
-      summ.set_string("name", "BWUtil");
-      summ.set_string("hint", "percentage");
-      summ.set_string("description",
-                      "Global device memory utilization as a percentage of the "
-                      "device's peak bandwidth");
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/cold/bw/global/utilization",
+         "BWUtil",
+         "percentage",
+         "Global device memory utilization as a percentage of the device's peak bandwidth"});
+      auto &summ = m_state.add_summary(desc);
       summ.set_float64("value", avg_used_gmem_bw / peak_gmem_bw);
     }
   } // bandwidth
 
   {
-    auto &summ = m_state.add_summary("nv/cold/walltime");
-    summ.set_string("name", "Walltime");
-    summ.set_string("hint", "duration");
-    summ.set_string("description", "Walltime used for isolated measurements");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cold/walltime",
+       "Walltime",
+       "duration",
+       "Walltime used for isolated measurements",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_walltime_timer.get_duration());
-    summ.set_string("hide", "Hidden by default.");
   }
 
+  m_soak.add_summaries(m_state, "nv/cold/time/gpu/mean");
+
   if (m_sm_clock_rate_accumulator != 0.)
   {
     const auto clock_mean = m_sm_clock_rate_accumulator / d_samples;
 
     {
-      auto &summ = m_state.add_summary("nv/cold/sm_clock_rate/mean");
-      summ.set_string("name", "Clock Rate");
-      summ.set_string("hint", "frequency");
-      summ.set_string("description", "Mean SM clock rate");
-      summ.set_string("hide", "Hidden by default.");
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/cold/sm_clock_rate/mean",
+         "Clock Rate",
+         "frequency",
+         "Mean SM clock rate",
+         "Hidden by default."});
+      auto &summ = m_state.add_summary(desc);
       summ.set_float64("value", clock_mean);
     }
 
@@ -372,11 +407,13 @@ void measure_cold_base::generate_summaries()
       const auto default_clock_rate =
         static_cast<nvbench::float64_t>(m_state.get_device()->get_sm_default_clock_rate());
 
-      auto &summ = m_state.add_summary("nv/cold/sm_clock_rate/scaling/percent");
-      summ.set_string("name", "Clock Scaling");
-      summ.set_string("hint", "percentage");
-      summ.set_string("description", "Mean SM clock rate as a percentage of default clock rate.");
-      summ.set_string("hide", "Hidden by default.");
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/cold/sm_clock_rate/scaling/percent",
+         "Clock Scaling",
+         "percentage",
+         "Mean SM clock rate as a percentage of default clock rate.",
+         "Hidden by default."});
+      auto &summ = m_state.add_summary(desc);
       summ.set_float64("value", clock_mean / default_clock_rate);
     }
   }
@@ -462,6 +499,8 @@ void measure_cold_base::check_skip_time(nvbench::float64_t warmup_time)
   }
 }
 
+void measure_cold_base::prepare_inputs() { m_state.prepare_input_pools(1); }
+
 void measure_cold_base::block_stream()
 {
   m_blocker.block(m_launch.get_stream(), m_state.get_blocking_kernel_timeout());
@@ -25,6 +25,7 @@
 #include <nvbench/detail/gpu_frequency.cuh>
 #include <nvbench/detail/kernel_launcher_timer_wrapper.cuh>
 #include <nvbench/detail/l2flush.cuh>
+#include <nvbench/detail/soak.cuh>
 #include <nvbench/detail/statistics.cuh>
 #include <nvbench/device_info.cuh>
 #include <nvbench/exec_tag.cuh>
@@ -70,6 +71,7 @@ protected:
   void gpu_frequency_stop() { m_gpu_frequency.stop(m_launch.get_stream()); }
 
   void check_skip_time(nvbench::float64_t warmup_time);
+  void prepare_inputs();
 
   __forceinline__ void flush_device_l2() { m_l2flush.flush(m_launch.get_stream()); }
 
@@ -94,6 +96,7 @@ protected:
   nvbench::criterion_params m_criterion_params;
   nvbench::stopping_criterion_base &m_stopping_criterion;
   nvbench::detail::gpu_frequency m_gpu_frequency;
+  nvbench::detail::soak_tracker m_soak;
 
   bool m_disable_blocking_kernel{false};
   bool m_run_once{false};
@@ -229,6 +232,7 @@ private:
     constexpr bool disable_blocking_kernel = true;
     kernel_launch_timer timer(*this, disable_blocking_kernel, m_run_once);
 
+    this->prepare_inputs();
     this->launch_kernel(timer);
     this->check_skip_time(m_cuda_timer.get_duration());
   }
@@ -241,6 +245,7 @@ private:
     kernel_launch_timer timer(*this, disable_blocking_kernel, m_run_once);
     do
     {
+      this->prepare_inputs();
       this->launch_kernel(timer);
       this->record_measurements();
     } while (!this->is_finished());
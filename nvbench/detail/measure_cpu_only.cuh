@@ -19,12 +19,16 @@
 #pragma once
 
 #include <nvbench/cpu_timer.cuh>
+#include <nvbench/detail/cpu_counters.cuh>
 #include <nvbench/detail/kernel_launcher_timer_wrapper.cuh>
+#include <nvbench/detail/sanity_check.cuh>
+#include <nvbench/detail/soak.cuh>
 #include <nvbench/detail/statistics.cuh>
 #include <nvbench/exec_tag.cuh>
 #include <nvbench/launch.cuh>
 #include <nvbench/stopping_criterion.cuh>
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -36,10 +40,15 @@ struct state;
 namespace detail
 {
 
+struct co_runner;
+struct perf_ctl;
+struct sampling_profiler;
+
 // non-templated code goes here:
 struct measure_cpu_only_base
 {
   explicit measure_cpu_only_base(nvbench::state &exec_state);
+  ~measure_cpu_only_base();
   measure_cpu_only_base(const measure_cpu_only_base &)            = delete;
   measure_cpu_only_base(measure_cpu_only_base &&)                 = delete;
   measure_cpu_only_base &operator=(const measure_cpu_only_base &) = delete;
@@ -55,6 +64,8 @@ protected:
   void generate_summaries();
 
   void check_skip_time(nvbench::float64_t warmup_time);
+  void prepare_inputs();
+  void generate_profile_summaries();
 
   nvbench::state &m_state;
 
@@ -64,9 +75,27 @@ protected:
   nvbench::cpu_timer m_cpu_timer;
   nvbench::cpu_timer m_walltime_timer;
 
+  // Cycles / instructions spent inside the timed region:
+  nvbench::detail::cpu_counters m_cpu_counters;
+  nvbench::detail::counting_cpu_timer m_counting_timer{m_cpu_timer, m_cpu_counters};
+
   nvbench::criterion_params m_criterion_params;
   nvbench::stopping_criterion_base &m_stopping_criterion;
 
+  // Non-null while a `perf record` session is enabled for the trials:
+  nvbench::detail::perf_ctl *m_perf_ctl{};
+
+  // Only allocated when the state has a "CoRunner" axis value other than "none":
+  std::unique_ptr<nvbench::detail::co_runner> m_co_runner;
+
+  // Only allocated when the benchmark requests a CPU profile:
+  std::unique_ptr<nvbench::detail::sampling_profiler> m_profiler;
+
+  nvbench::detail::soak_tracker m_soak;
+
+  // Cost of an empty timed region, to detect work that was optimized away:
+  nvbench::detail::sanity_check::empty_launch m_empty_launch;
+
   bool m_run_once{false};
 
   nvbench::int64_t m_min_samples{};
@@ -80,6 +109,11 @@ protected:
   nvbench::float64_t m_max_cpu_time{};
   nvbench::float64_t m_total_cpu_time{};
 
+  nvbench::int64_t m_total_cycles{};
+  nvbench::int64_t m_total_instructions{};
+  // Whether the counters were read successfully for every sample:
+  bool m_counters_valid{true};
+
   std::vector<nvbench::float64_t> m_cpu_times;
 
   bool m_max_time_exceeded{};
@@ -116,6 +150,7 @@ private:
       return;
     }
 
+    this->prepare_inputs();
     this->launch_kernel(m_cpu_timer);
     this->check_skip_time(m_cpu_timer.get_duration());
   }
@@ -124,7 +159,8 @@ private:
   {
     do
     {
-      this->launch_kernel(m_cpu_timer);
+      this->prepare_inputs();
+      this->launch_kernel(m_counting_timer);
       this->record_measurements();
     } while (!this->is_finished());
   }
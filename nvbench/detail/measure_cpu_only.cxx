@@ -18,8 +18,13 @@
 
 #include <nvbench/benchmark_base.cuh>
 #include <nvbench/criterion_manager.cuh>
+#include <nvbench/detail/co_runner.cuh>
 #include <nvbench/detail/measure_cpu_only.cuh>
+#include <nvbench/detail/perf_ctl.cuh>
+#include <nvbench/detail/sampling_profiler.cuh>
+#include <nvbench/detail/sanity_check.cuh>
 #include <nvbench/detail/throw.cuh>
+#include <nvbench/detail/timer_resolution.cuh>
 #include <nvbench/printer_base.cuh>
 #include <nvbench/state.cuh>
 #include <nvbench/summary.cuh>
@@ -27,6 +32,8 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cctype>
+#include <filesystem>
 #include <limits>
 
 namespace nvbench::detail
@@ -38,6 +45,7 @@ measure_cpu_only_base::measure_cpu_only_base(state &exec_state)
     , m_criterion_params{exec_state.get_criterion_params()}
     , m_stopping_criterion{nvbench::criterion_manager::get().get_criterion(
         exec_state.get_stopping_criterion())}
+    , m_soak{exec_state.get_benchmark()}
     , m_run_once{exec_state.get_run_once()}
     , m_min_samples{exec_state.get_min_samples()}
     , m_skip_time{exec_state.get_skip_time()}
@@ -47,6 +55,28 @@ measure_cpu_only_base::measure_cpu_only_base(state &exec_state)
   {
     m_cpu_times.reserve(static_cast<std::size_t>(m_min_samples));
   }
+
+  // Lets the entropy criterion bin samples to the ticks of a coarse CPU timer:
+  if (nvbench::detail::timer_resolution::is_cpu_coarse() &&
+      !m_criterion_params.has_value("timer-resolution"))
+  {
+    m_criterion_params.set_float64("timer-resolution",
+                                   nvbench::detail::timer_resolution::get_cpu());
+  }
+}
+
+measure_cpu_only_base::~measure_cpu_only_base()
+{
+  // Don't leave perf recording if the trials were interrupted by an exception:
+  if (m_perf_ctl != nullptr)
+  {
+    try
+    {
+      m_perf_ctl->disable();
+    }
+    catch (...)
+    {}
+  }
 }
 
 void measure_cpu_only_base::check()
@@ -57,18 +87,51 @@ void measure_cpu_only_base::check()
 void measure_cpu_only_base::initialize()
 {
 
-  m_min_cpu_time      = std::numeric_limits<nvbench::float64_t>::max();
-  m_max_cpu_time      = std::numeric_limits<nvbench::float64_t>::lowest();
-  m_total_cpu_time    = 0.;
-  m_total_samples     = 0;
-  m_max_time_exceeded = false;
+  m_min_cpu_time       = std::numeric_limits<nvbench::float64_t>::max();
+  m_max_cpu_time       = std::numeric_limits<nvbench::float64_t>::lowest();
+  m_total_cpu_time     = 0.;
+  m_total_cycles       = 0;
+  m_total_instructions = 0;
+  m_counters_valid     = true;
+  m_total_samples      = 0;
+  m_max_time_exceeded  = false;
 
   m_cpu_times.clear();
 
   m_stopping_criterion.initialize(m_criterion_params);
+
+  // Too few samples to compare with when running once:
+  if (!m_run_once)
+  {
+    m_empty_launch = nvbench::detail::sanity_check::calibrate(m_counting_timer);
+  }
 }
 
-void measure_cpu_only_base::run_trials_prologue() { m_walltime_timer.start(); }
+void measure_cpu_only_base::run_trials_prologue()
+{
+  if (const auto &axis_values = m_state.get_axis_values();
+      axis_values.has_value(nvbench::detail::co_runner::axis_name))
+  {
+    const auto &spec = axis_values.get_string(nvbench::detail::co_runner::axis_name);
+    m_co_runner      = std::make_unique<nvbench::detail::co_runner>(spec);
+    m_co_runner->start();
+  }
+
+  if (!m_state.get_benchmark().get_cpu_profile_directory().empty())
+  {
+    m_profiler = std::make_unique<nvbench::detail::sampling_profiler>();
+    m_profiler->start();
+  }
+
+  if (const auto &spec = m_state.get_benchmark().get_perf_ctl(); !spec.empty())
+  {
+    auto &ctl = nvbench::detail::perf_ctl::get(spec);
+    ctl.enable();
+    m_perf_ctl = &ctl;
+  }
+
+  m_walltime_timer.start();
+}
 
 void measure_cpu_only_base::record_measurements()
 {
@@ -78,11 +141,25 @@ void measure_cpu_only_base::record_measurements()
   m_min_cpu_time = std::min(m_min_cpu_time, cur_cpu_time);
   m_max_cpu_time = std::max(m_max_cpu_time, cur_cpu_time);
   m_total_cpu_time += cur_cpu_time;
-  m_cpu_times.push_back(cur_cpu_time);
+  m_soak.keep_sample(m_cpu_times, cur_cpu_time, m_total_samples);
+
+  // A single failed read would skew the means:
+  m_counters_valid = m_counters_valid && m_cpu_counters.is_valid();
+  m_total_cycles += m_cpu_counters.get_cycles();
+  m_total_instructions += m_cpu_counters.get_instructions();
 
   ++m_total_samples;
 
-  m_stopping_criterion.add_measurement(cur_cpu_time);
+  // Soak runs ignore the stopping criterion, whose cost grows with the samples:
+  if (m_soak.is_enabled())
+  {
+    m_walltime_timer.stop();
+    m_soak.add_sample(cur_cpu_time, m_walltime_timer.get_duration());
+  }
+  else
+  {
+    m_stopping_criterion.add_measurement(cur_cpu_time);
+  }
 }
 
 bool measure_cpu_only_base::is_finished()
@@ -92,6 +169,13 @@ bool measure_cpu_only_base::is_finished()
     return true;
   }
 
+  // Soak runs ignore the stopping criterion and timeout:
+  if (m_soak.is_enabled())
+  {
+    m_walltime_timer.stop();
+    return m_soak.is_finished(m_walltime_timer.get_duration());
+  }
+
   // Check that we've gathered enough samples:
   if (m_total_samples > m_min_samples)
   {
@@ -112,43 +196,73 @@ bool measure_cpu_only_base::is_finished()
   return false;
 }
 
-void measure_cpu_only_base::run_trials_epilogue() { m_walltime_timer.stop(); }
+void measure_cpu_only_base::run_trials_epilogue()
+{
+  m_walltime_timer.stop();
+
+  if (m_perf_ctl != nullptr)
+  {
+    auto &ctl  = *m_perf_ctl;
+    m_perf_ctl = nullptr;
+    ctl.disable();
+  }
+
+  if (m_profiler)
+  {
+    m_profiler->stop();
+  }
+
+  if (m_co_runner)
+  {
+    m_co_runner->stop();
+  }
+}
 
 void measure_cpu_only_base::generate_summaries()
 {
+  nvbench::detail::soak_tracker::restore_order(m_cpu_times, m_total_samples);
+
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/sample_size");
-    summ.set_string("name", "Samples");
-    summ.set_string("hint", "sample_size");
-    summ.set_string("description", "Number of isolated kernel executions");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/sample_size",
+       "Samples",
+       "sample_size",
+       "Number of isolated kernel executions"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_int64("value", m_total_samples);
   }
 
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/time/cpu/min");
-    summ.set_string("name", "Min CPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description", "Fastest CPU time of isolated kernel executions");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/cpu/min",
+       "Min CPU Time",
+       "duration",
+       "Fastest CPU time of isolated kernel executions",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_min_cpu_time);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/time/cpu/max");
-    summ.set_string("name", "Max CPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description", "Slowest CPU time of isolated kernel executions");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/cpu/max",
+       "Max CPU Time",
+       "duration",
+       "Slowest CPU time of isolated kernel executions",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_max_cpu_time);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   const auto d_samples = static_cast<nvbench::float64_t>(m_total_samples);
   const auto cpu_mean  = m_total_cpu_time / d_samples;
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/time/cpu/mean");
-    summ.set_string("name", "CPU Time");
-    summ.set_string("hint", "duration");
-    summ.set_string("description", "Mean CPU time of isolated kernel executions");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/cpu/mean",
+       "CPU Time",
+       "duration",
+       "Mean CPU time of isolated kernel executions"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cpu_mean);
   }
 
@@ -156,29 +270,48 @@ void measure_cpu_only_base::generate_summaries()
                                                                          m_cpu_times.cend(),
                                                                          cpu_mean);
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/time/cpu/stdev/absolute");
-    summ.set_string("name", "Noise");
-    summ.set_string("hint", "percentage");
-    summ.set_string("description", "Relative standard deviation of isolated CPU times");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/cpu/stdev/absolute",
+       "Noise",
+       "percentage",
+       "Relative standard deviation of isolated CPU times",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cpu_stdev);
-    summ.set_string("hide", "Hidden by default.");
   }
 
   const auto cpu_noise = cpu_stdev / cpu_mean;
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/time/cpu/stdev/relative");
-    summ.set_string("name", "Noise");
-    summ.set_string("hint", "percentage");
-    summ.set_string("description", "Relative standard deviation of isolated CPU times");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/cpu/stdev/relative",
+       "Noise",
+       "percentage",
+       "Relative standard deviation of isolated CPU times"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", cpu_noise);
   }
 
+  if (m_empty_launch.samples > 0)
+  {
+    nvbench::detail::sanity_check::add_empty_launch_summaries(m_state,
+                                                              m_empty_launch,
+                                                              cpu_mean,
+                                                              cpu_stdev,
+                                                              m_total_samples);
+  }
+
+  nvbench::detail::timer_resolution::add_summaries(m_state,
+                                                   nvbench::detail::timer_resolution::get_cpu(),
+                                                   cpu_mean);
+
   if (const auto items = m_state.get_element_count(); items != 0)
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/bw/item_rate");
-    summ.set_string("name", "Elem/s");
-    summ.set_string("hint", "item_rate");
-    summ.set_string("description", "Number of input elements processed per second");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/bw/item_rate",
+       "Elem/s",
+       "item_rate",
+       "Number of input elements processed per second"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", static_cast<double>(items) / cpu_mean);
   }
 
@@ -186,23 +319,120 @@ void measure_cpu_only_base::generate_summaries()
   {
     const auto avg_used_gmem_bw = static_cast<double>(bytes) / cpu_mean;
     {
-      auto &summ = m_state.add_summary("nv/cpu_only/bw/global/bytes_per_second");
-      summ.set_string("name", "GlobalMem BW");
-      summ.set_string("hint", "byte_rate");
-      summ.set_string("description", "Number of bytes read/written per second.");
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/cpu_only/bw/global/bytes_per_second",
+         "GlobalMem BW",
+         "byte_rate",
+         "Number of bytes read/written per second."});
+      auto &summ = m_state.add_summary(desc);
       summ.set_float64("value", avg_used_gmem_bw);
     }
   } // bandwidth
 
+  if (m_cpu_counters.has_cycles() && m_counters_valid)
+  {
+    const auto cycles_mean = static_cast<nvbench::float64_t>(m_total_cycles) / d_samples;
+    const auto instructions_mean =
+      static_cast<nvbench::float64_t>(m_total_instructions) / d_samples;
+    const auto source = m_cpu_counters.get_source_as_string();
+    // The descriptions assume hardware cycles; override them for the TSC:
+    const bool is_tsc = m_cpu_counters.get_source() == cpu_counters::source::tsc;
+
+    if (const auto items = m_state.get_element_count(); items != 0)
+    {
+      {
+        static const auto &desc = nvbench::summary_registry::get().add(
+          {"nv/cpu_only/cycles_per_item",
+           "Cycles/Elem",
+           "normalized_count",
+           "Mean number of CPU cycles per input element"});
+        auto &summ = m_state.add_summary(desc);
+        if (is_tsc)
+        {
+          summ.set_string("description",
+                          "Mean number of time-stamp counter (reference) cycles per input element");
+        }
+        summ.set_string("source", source);
+        summ.set_float64("value", cycles_mean / static_cast<nvbench::float64_t>(items));
+      }
+
+      if (m_cpu_counters.has_instructions())
+      {
+        static const auto &desc = nvbench::summary_registry::get().add(
+          {"nv/cpu_only/instructions_per_item",
+           "Instr/Elem",
+           "normalized_count",
+           "Mean number of retired instructions per input element"});
+        auto &summ = m_state.add_summary(desc);
+        summ.set_string("source", source);
+        summ.set_float64("value", instructions_mean / static_cast<nvbench::float64_t>(items));
+      }
+    }
+
+    if (const auto bytes = m_state.get_global_memory_rw_bytes(); bytes != 0)
+    {
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/cpu_only/cycles_per_byte",
+         "Cycles/Byte",
+         "normalized_count",
+         "Mean number of CPU cycles per byte read/written"});
+      auto &summ = m_state.add_summary(desc);
+      if (is_tsc)
+      {
+        summ.set_string("description",
+                        "Mean number of time-stamp counter (reference) cycles per byte "
+                        "read/written");
+      }
+      summ.set_string("source", source);
+      summ.set_float64("value", cycles_mean / static_cast<nvbench::float64_t>(bytes));
+    }
+  }
+
+  if (m_profiler)
+  {
+    this->generate_profile_summaries();
+  }
+
+  if (m_co_runner && m_co_runner->get_kind() != nvbench::detail::co_runner::kind::none)
   {
-    auto &summ = m_state.add_summary("nv/cpu_only/walltime");
-    summ.set_string("name", "Walltime");
-    summ.set_string("hint", "duration");
-    summ.set_string("description", "Walltime used for isolated measurements");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/co_runner",
+       "Co-Runner",
+       "",
+       "Background load running during the trials",
+       "Shown in the CoRunner axis."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_string("value", nvbench::detail::co_runner::kind_to_string(m_co_runner->get_kind()));
+    summ.set_int64("cpu", m_co_runner->get_cpu());
+    summ.set_int64("buffer_size", static_cast<nvbench::int64_t>(m_co_runner->get_buffer_size()));
+  }
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/walltime",
+       "Walltime",
+       "duration",
+       "Walltime used for isolated measurements",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_walltime_timer.get_duration());
-    summ.set_string("hide", "Hidden by default.");
   }
 
+  if (m_max_time_exceeded)
+  {
+    // Marks the state for nvbench::detail::retry_pass:
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/timed_out",
+       "Timed Out",
+       "duration",
+       "Timeout reached before the stopping criterion was met",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_float64("value", m_timeout);
+  }
+
+  m_soak.add_summaries(m_state, "nv/cpu_only/time/cpu/mean");
+
   // Log if a printer exists:
   if (auto printer_opt_ref = m_state.get_benchmark().get_printer(); printer_opt_ref.has_value())
   {
@@ -269,6 +499,86 @@ void measure_cpu_only_base::generate_summaries()
   }
 }
 
+void measure_cpu_only_base::generate_profile_summaries()
+{
+  const auto num_samples = m_profiler->get_sample_count();
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/profile/sample_size",
+       "Profile Samples",
+       "sample_size",
+       "Number of stacks sampled by the CPU profiler",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_int64("value", num_samples);
+    summ.set_int64("dropped", m_profiler->get_dropped_count());
+  }
+
+  const auto top_functions = m_profiler->get_top_functions(10);
+  for (std::size_t i = 0; i < top_functions.size(); ++i)
+  {
+    const auto &function = top_functions[i];
+
+    auto &summ = m_state.add_summary(fmt::format("nv/cpu_only/profile/top/{}", i));
+    summ.set_string("name", fmt::format("Top Function #{}", i));
+    summ.set_string("description",
+                    "Function with the most samples as the innermost frame during the trials");
+    summ.set_string("value", function.name);
+    summ.set_int64("self_samples", function.self_samples);
+    summ.set_int64("total_samples", function.total_samples);
+    summ.set_string("hide", "Not needed in table.");
+  }
+
+  // Folded stacks, one file per state:
+  std::string filename = fmt::format("{}_{}",
+                                     m_state.get_benchmark().get_name(),
+                                     m_state.get_axis_values_as_string());
+  std::replace_if(
+    filename.begin(),
+    filename.end(),
+    [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.'; },
+    '_');
+  std::filesystem::path path{m_state.get_benchmark().get_cpu_profile_directory()};
+  path /= filename + ".folded";
+
+  auto printer_opt_ref = m_state.get_benchmark().get_printer();
+  try
+  {
+    std::filesystem::create_directories(path.parent_path());
+    m_profiler->write_folded_stacks(path.string());
+
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/profile/folded_stacks",
+       "Folded Stacks File",
+       "file/folded_stacks",
+       "Sampled stacks in the folded format used by flamegraph.pl",
+       "Not needed in table."});
+    auto &summ = m_state.add_summary(desc);
+    summ.set_string("filename", path.string());
+  }
+  catch (std::exception &e)
+  {
+    if (printer_opt_ref.has_value())
+    {
+      printer_opt_ref.value().get().log(
+        nvbench::log_level::warn,
+        fmt::format("Error writing CPU profile to {}: {}", path.string(), e.what()));
+    }
+  }
+
+  if (printer_opt_ref.has_value() && !top_functions.empty() && num_samples > 0)
+  {
+    const auto &hottest = top_functions.front();
+    printer_opt_ref.value().get().log(
+      nvbench::log_level::info,
+      fmt::format("Hottest function: {} ({:0.1f}% of {} samples)",
+                  hottest.name,
+                  100. * static_cast<nvbench::float64_t>(hottest.self_samples) /
+                    static_cast<nvbench::float64_t>(num_samples),
+                  num_samples));
+  }
+}
+
 void measure_cpu_only_base::check_skip_time(nvbench::float64_t warmup_time)
 {
   if (m_skip_time > 0. && warmup_time < m_skip_time)
@@ -283,4 +593,34 @@ void measure_cpu_only_base::check_skip_time(nvbench::float64_t warmup_time)
   }
 }
 
+void measure_cpu_only_base::prepare_inputs()
+{
+  if (!m_state.needs_input_pool_refresh(1))
+  {
+    return;
+  }
+
+  // Refreshes run the benchmark's input generators, which are not part of the
+  // profiled work:
+  if (m_profiler)
+  {
+    m_profiler->pause();
+  }
+  if (m_perf_ctl != nullptr)
+  {
+    m_perf_ctl->disable();
+  }
+
+  m_state.prepare_input_pools(1);
+
+  if (m_perf_ctl != nullptr)
+  {
+    m_perf_ctl->enable();
+  }
+  if (m_profiler)
+  {
+    m_profiler->resume();
+  }
+}
+
 } // namespace nvbench::detail
@@ -192,6 +192,8 @@ void measure_cupti_base::check()
   }
 }
 
+void measure_cupti_base::prepare_inputs() { m_state.prepare_input_pools(1); }
+
 namespace
 {
 
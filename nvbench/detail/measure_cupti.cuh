@@ -59,6 +59,7 @@ protected:
 
   void check();
   void generate_summaries();
+  void prepare_inputs();
 
   __forceinline__ void flush_device_l2() { m_l2flush.flush(m_launch.get_stream()); }
 
@@ -137,6 +138,8 @@ private:
 
     do
     {
+      // Every replay pass must see the same input:
+      this->prepare_inputs();
       m_kernel_launcher(m_launch, timer);
       ++m_total_samples;
     } while (m_cupti.is_replay_required());
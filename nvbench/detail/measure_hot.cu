@@ -84,31 +84,32 @@ void measure_hot_base::generate_summaries()
 {
   const auto d_samples = static_cast<double>(m_total_samples);
   {
-    auto &summ = m_state.add_summary("nv/batch/sample_size");
-    summ.set_string("name", "Samples");
-    summ.set_string("hint", "sample_size");
-    summ.set_string("description", "Number of batch kernel executions");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/batch/sample_size", "Samples", "sample_size", "Number of batch kernel executions"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_int64("value", m_total_samples);
   }
 
   const auto avg_cuda_time = m_total_cuda_time / d_samples;
   {
-    auto &summ = m_state.add_summary("nv/batch/time/gpu/mean");
-    summ.set_string("name", "Batch GPU");
-    summ.set_string("hint", "duration");
-    summ.set_string("description",
-                    "Mean batch kernel execution time "
-                    "(measured by CUDA events)");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/batch/time/gpu/mean",
+       "Batch GPU",
+       "duration",
+       "Mean batch kernel execution time (measured by CUDA events)"});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", avg_cuda_time);
   }
 
   {
-    auto &summ = m_state.add_summary("nv/batch/walltime");
-    summ.set_string("name", "Walltime");
-    summ.set_string("hint", "duration");
-    summ.set_string("description", "Walltime used for batch measurements");
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/batch/walltime",
+       "Walltime",
+       "duration",
+       "Walltime used for batch measurements",
+       "Hidden by default."});
+    auto &summ = m_state.add_summary(desc);
     summ.set_float64("value", m_walltime_timer.get_duration());
-    summ.set_string("hide", "Hidden by default.");
   }
 
   // Log if a printer exists:
@@ -167,6 +168,11 @@ void measure_hot_base::check_skip_time(nvbench::float64_t warmup_time)
   }
 }
 
+nvbench::int64_t measure_hot_base::prepare_inputs(nvbench::int64_t launches)
+{
+  return m_state.prepare_input_pools(launches);
+}
+
 void measure_hot_base::block_stream()
 {
   m_blocker.block(m_launch.get_stream(), m_state.get_blocking_kernel_timeout());
@@ -60,6 +60,8 @@ protected:
 
   void check_skip_time(nvbench::float64_t warmup_time);
 
+  nvbench::int64_t prepare_inputs(nvbench::int64_t launches);
+
   void block_stream();
 
   __forceinline__ void unblock_stream() { m_blocker.unblock(); }
@@ -106,6 +108,8 @@ private:
   // measurement.
   void run_warmup()
   {
+    this->prepare_inputs(1);
+
     m_cuda_timer.start(m_launch.get_stream());
     this->launch_kernel();
     m_cuda_timer.stop(m_launch.get_stream());
@@ -129,6 +133,9 @@ private:
     {
       batch_size = std::max(batch_size, nvbench::int64_t{1});
 
+      // Refresh mutated inputs before timing; a batch can't outlast the pools:
+      batch_size = std::min(batch_size, this->prepare_inputs(batch_size));
+
       if (!m_disable_blocking_kernel)
       {
         // Block stream until some work is queued.
@@ -0,0 +1,67 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace nvbench::detail
+{
+
+/**
+ * Drives `perf record --control=fifo:<ctl>[,<ack>]`.
+ *
+ * The spec passed to `get` has the same form as perf's option: the path of
+ * the control fifo, optionally followed by a comma and the path of the
+ * acknowledgement fifo. When an ack fifo is given, `enable` and `disable`
+ * block until perf has processed the command.
+ *
+ * Run perf with `--delay=-1` so that nothing is recorded until the first
+ * `enable`. One controller exists per spec and the fifos are opened on first
+ * use. Only supported on Linux.
+ */
+struct perf_ctl
+{
+  /// Returns the controller for `spec`, creating it if needed.
+  static perf_ctl &get(const std::string &spec);
+
+  ~perf_ctl();
+
+  // Owns file descriptors:
+  perf_ctl(const perf_ctl &)            = delete;
+  perf_ctl(perf_ctl &&)                 = delete;
+  perf_ctl &operator=(const perf_ctl &) = delete;
+  perf_ctl &operator=(perf_ctl &&)      = delete;
+
+  void enable() { this->send("enable"); }
+  void disable() { this->send("disable"); }
+
+private:
+  explicit perf_ctl(std::string spec);
+
+  void open_fifos();
+  void send(const char *command);
+
+  std::string m_ctl_path;
+  std::string m_ack_path;
+
+  int m_ctl_fd{-1};
+  int m_ack_fd{-1};
+};
+
+} // namespace nvbench::detail
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/perf_ctl.cuh>
+#include <nvbench/detail/throw.cuh>
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace nvbench::detail
+{
+
+perf_ctl &perf_ctl::get(const std::string &spec)
+{
+  static std::mutex mutex;
+  static std::map<std::string, std::unique_ptr<perf_ctl>> controllers;
+
+  std::lock_guard<std::mutex> lock{mutex};
+  auto &ctl = controllers[spec];
+  if (!ctl)
+  {
+    ctl.reset(new perf_ctl{spec});
+  }
+  return *ctl;
+}
+
+perf_ctl::perf_ctl(std::string spec)
+{
+#ifndef __linux__
+  NVBENCH_THROW(std::runtime_error, "{}", "perf control fifos are only supported on Linux.");
+#endif
+
+  const auto comma = spec.find(',');
+  m_ctl_path       = spec.substr(0, comma);
+  if (comma != std::string::npos)
+  {
+    m_ack_path = spec.substr(comma + 1);
+  }
+
+  NVBENCH_THROW_IF(m_ctl_path.empty(),
+                   std::runtime_error,
+                   "Invalid perf control spec '{}'. Expected '<ctl fifo>[,<ack fifo>]'.",
+                   spec);
+}
+
+perf_ctl::~perf_ctl()
+{
+#ifdef __linux__
+  if (m_ctl_fd != -1)
+  {
+    close(m_ctl_fd);
+  }
+  if (m_ack_fd != -1)
+  {
+    close(m_ack_fd);
+  }
+#endif
+}
+
+void perf_ctl::open_fifos()
+{
+#ifdef __linux__
+  // Blocks until perf has opened the other end of each fifo.
+  if (m_ctl_fd == -1)
+  {
+    m_ctl_fd = open(m_ctl_path.c_str(), O_WRONLY | O_CLOEXEC);
+    NVBENCH_THROW_IF(m_ctl_fd == -1,
+                     std::runtime_error,
+                     "Failed to open perf control fifo '{}': {}",
+                     m_ctl_path,
+                     std::strerror(errno));
+  }
+  if (!m_ack_path.empty() && m_ack_fd == -1)
+  {
+    m_ack_fd = open(m_ack_path.c_str(), O_RDONLY | O_CLOEXEC);
+    NVBENCH_THROW_IF(m_ack_fd == -1,
+                     std::runtime_error,
+                     "Failed to open perf ack fifo '{}': {}",
+                     m_ack_path,
+                     std::strerror(errno));
+  }
+#endif
+}
+
+void perf_ctl::send([[maybe_unused]] const char *command)
+{
+#ifdef __linux__
+  this->open_fifos();
+
+  const std::string msg = std::string{command} + "\n";
+  NVBENCH_THROW_IF(write(m_ctl_fd, msg.data(), msg.size()) != static_cast<ssize_t>(msg.size()),
+                   std::runtime_error,
+                   "Failed to write '{}' to perf control fifo '{}': {}",
+                   command,
+                   m_ctl_path,
+                   std::strerror(errno));
+
+  if (m_ack_fd != -1)
+  {
+    // perf replies with "ack\n" once the command has been applied:
+    char ack[5]{};
+    std::size_t received = 0;
+    while (received < 4)
+    {
+      const auto num_read = read(m_ack_fd, ack + received, 4 - received);
+      NVBENCH_THROW_IF(num_read <= 0,
+                       std::runtime_error,
+                       "Failed to read from perf ack fifo '{}': {}",
+                       m_ack_path,
+                       num_read == 0 ? "end of file" : std::strerror(errno));
+      received += static_cast<std::size_t>(num_read);
+    }
+    NVBENCH_THROW_IF(std::strncmp(ack, "ack\n", 4) != 0,
+                     std::runtime_error,
+                     "Unexpected reply from perf ack fifo '{}'.",
+                     m_ack_path);
+  }
+#endif
+}
+
+} // namespace nvbench::detail
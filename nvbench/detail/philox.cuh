@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <array>
+
+namespace nvbench::detail
+{
+
+/**
+ * The Philox4x32-10 counter-based random number generator (Salmon et al.,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11), as used by
+ * Random123 and cuRAND.
+ *
+ * Each (counter, key) pair maps to four independent 32-bit words, so any
+ * element of a random sequence can be computed directly from its index. This
+ * makes parallel generation trivially deterministic and free of shared state.
+ */
+struct philox4x32
+{
+  using counter_type = std::array<nvbench::uint32_t, 4>;
+  using key_type     = std::array<nvbench::uint32_t, 2>;
+
+  static constexpr int rounds = 10;
+
+  [[nodiscard]] static constexpr counter_type generate(counter_type counter, key_type key)
+  {
+    for (int round = 0; round < rounds; ++round)
+    {
+      if (round > 0)
+      {
+        key[0] += weyl_0;
+        key[1] += weyl_1;
+      }
+
+      const auto product_0 = nvbench::uint64_t{multiplier_0} * counter[0];
+      const auto product_1 = nvbench::uint64_t{multiplier_1} * counter[2];
+      const auto hi_0      = static_cast<nvbench::uint32_t>(product_0 >> 32);
+      const auto lo_0      = static_cast<nvbench::uint32_t>(product_0);
+      const auto hi_1      = static_cast<nvbench::uint32_t>(product_1 >> 32);
+      const auto lo_1      = static_cast<nvbench::uint32_t>(product_1);
+
+      counter = {hi_1 ^ counter[1] ^ key[0], lo_1, hi_0 ^ counter[3] ^ key[1], lo_0};
+    }
+    return counter;
+  }
+
+private:
+  static constexpr nvbench::uint32_t multiplier_0 = 0xD2511F53;
+  static constexpr nvbench::uint32_t multiplier_1 = 0xCD9E8D57;
+  static constexpr nvbench::uint32_t weyl_0       = 0x9E3779B9;
+  static constexpr nvbench::uint32_t weyl_1       = 0xBB67AE85;
+};
+
+} // namespace nvbench::detail
@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/summary.cuh>
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <vector>
+
+namespace nvbench
+{
+struct benchmark_base;
+struct state;
+} // namespace nvbench
+
+namespace nvbench::detail
+{
+
+/**
+ * Measures the CPU-only states of a benchmark that timed out a second time.
+ *
+ * A state times out when it reaches its timeout before the stopping criterion
+ * is met, e.g. because its noise stayed above `max-noise`; its results are
+ * then less reliable than those of its neighbours. Once all states have run,
+ * constructing a `retry_pass` selects the timed-out states, sets their first
+ * pass results aside and multiplies their timeout by the benchmark's retry
+ * factor. The caller runs `get_states()` again, then calls `finish()`.
+ *
+ * The retry's results replace the first pass, unless the benchmark combines
+ * passes and the mean times of both passes are statistically compatible, in
+ * which case the samples of both passes are pooled. Every retried state gains
+ * an `nv/retry` summary describing the outcome, shown in the "Retry" column.
+ * If the retry fails, the first pass is restored.
+ */
+struct retry_pass
+{
+  /// Passes whose means differ by more than this many standard errors
+  /// (Welch's t-statistic) are not combined.
+  static constexpr nvbench::float64_t max_t_stat = 3.;
+
+  explicit retry_pass(nvbench::benchmark_base &bench);
+
+  [[nodiscard]] const std::vector<nvbench::state *> &get_states() const { return m_states; }
+
+  /// Adds the results of the first pass back once `get_states()` have run.
+  void finish();
+
+  /// Welch's t-statistic comparing the CPU-only mean times of two passes, or
+  /// NaN if either pass lacks them.
+  [[nodiscard]] static nvbench::float64_t get_t_stat(const std::vector<nvbench::summary> &first,
+                                                     const std::vector<nvbench::summary> &second);
+
+  /// Pools the CPU-only samples of `first` into the summaries of `second`.
+  static void combine(const std::vector<nvbench::summary> &first,
+                      std::vector<nvbench::summary> &second);
+
+private:
+  struct first_pass
+  {
+    std::vector<nvbench::summary> summaries;
+    std::size_t element_count{};
+    std::size_t global_memory_rw_bytes{};
+  };
+
+  nvbench::benchmark_base &m_benchmark;
+  std::vector<nvbench::state *> m_states;
+  std::vector<first_pass> m_first_passes;
+};
+
+} // namespace nvbench::detail
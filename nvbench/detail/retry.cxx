@@ -0,0 +1,282 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/baseline.cuh>
+#include <nvbench/detail/retry.cuh>
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+std::optional<nvbench::float64_t> find_value(const std::vector<nvbench::summary> &summaries,
+                                             const std::string &tag)
+{
+  const auto *summ = nvbench::detail::find_summary(summaries, tag);
+  if (summ == nullptr || !summ->has_value("value"))
+  {
+    return std::nullopt;
+  }
+  return tag == "nv/cpu_only/sample_size"
+           ? static_cast<nvbench::float64_t>(summ->get_int64("value"))
+           : summ->get_float64("value");
+}
+
+// `set_*` appends, so drop the old value first:
+void replace_value(std::vector<nvbench::summary> &summaries,
+                   const std::string &tag,
+                   nvbench::float64_t value)
+{
+  if (auto *summ = nvbench::detail::find_summary(summaries, tag); summ != nullptr)
+  {
+    summ->remove_value("value");
+    summ->set_float64("value", value);
+  }
+}
+
+struct cpu_only_pass
+{
+  nvbench::float64_t samples{};
+  nvbench::float64_t mean{};
+  nvbench::float64_t stdev{};
+};
+
+std::optional<cpu_only_pass> get_cpu_only_pass(const std::vector<nvbench::summary> &summaries)
+{
+  const auto samples = ::find_value(summaries, "nv/cpu_only/sample_size");
+  const auto mean    = ::find_value(summaries, "nv/cpu_only/time/cpu/mean");
+  const auto stdev   = ::find_value(summaries, "nv/cpu_only/time/cpu/stdev/absolute");
+  if (!samples || !mean || !stdev || !(*samples > 1.) || !std::isfinite(*stdev))
+  {
+    return std::nullopt;
+  }
+  return cpu_only_pass{*samples, *mean, *stdev};
+}
+
+bool is_timed_out(const std::vector<nvbench::summary> &summaries)
+{
+  return nvbench::detail::find_summary(summaries, "nv/cpu_only/timed_out") != nullptr;
+}
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+retry_pass::retry_pass(nvbench::benchmark_base &bench)
+    : m_benchmark{bench}
+{
+  const auto factor = bench.get_retry_factor();
+  if (!(factor > 0.))
+  {
+    return;
+  }
+
+  for (auto &cur_state : bench.get_states())
+  {
+    if (cur_state.is_skipped() || !::is_timed_out(cur_state.get_summaries()))
+    {
+      continue;
+    }
+
+    // The generator adds the element and byte counts again:
+    m_first_passes.push_back({std::move(cur_state.get_summaries()),
+                              cur_state.get_element_count(),
+                              cur_state.get_global_memory_rw_bytes()});
+    cur_state.get_summaries().clear();
+    cur_state.set_element_count(0);
+    cur_state.set_global_memory_rw_bytes(0);
+    cur_state.set_timeout(cur_state.get_timeout() * factor);
+    m_states.push_back(&cur_state);
+  }
+
+  if (m_states.empty())
+  {
+    return;
+  }
+
+  if (auto printer_opt_ref = bench.get_printer(); printer_opt_ref.has_value())
+  {
+    auto &printer = printer_opt_ref.value().get();
+    printer.set_total_state_count(printer.get_total_state_count() + m_states.size());
+    printer.log(nvbench::log_level::info,
+                fmt::format("Retrying {} timed out state{} with {}x the timeout",
+                            m_states.size(),
+                            m_states.size() == 1 ? "" : "s",
+                            factor));
+  }
+}
+
+void retry_pass::finish()
+{
+  auto printer_opt_ref = m_benchmark.get_printer();
+
+  for (std::size_t i = 0; i < m_states.size(); ++i)
+  {
+    auto &cur_state = *m_states[i];
+    auto &first     = m_first_passes[i];
+    auto &summaries = cur_state.get_summaries();
+
+    std::string outcome;
+    nvbench::float64_t t_stat = std::numeric_limits<nvbench::float64_t>::quiet_NaN();
+    if (cur_state.is_skipped())
+    {
+      if (printer_opt_ref.has_value())
+      {
+        printer_opt_ref.value().get().log(
+          nvbench::log_level::warn,
+          fmt::format("Retry of {} failed, keeping the first pass: {}",
+                      cur_state.get_short_description(),
+                      cur_state.get_skip_reason()));
+      }
+      outcome   = "failed";
+      summaries = std::move(first.summaries);
+      cur_state.set_element_count(first.element_count);
+      cur_state.set_global_memory_rw_bytes(first.global_memory_rw_bytes);
+      cur_state.skip({});
+    }
+    else
+    {
+      outcome = ::is_timed_out(summaries) ? "timed out" : "converged";
+      t_stat  = retry_pass::get_t_stat(first.summaries, summaries);
+      if (m_benchmark.get_retry_combine() && t_stat <= max_t_stat)
+      {
+        retry_pass::combine(first.summaries, summaries);
+        outcome += ", combined";
+
+        // The baseline comparison was made with the retry alone:
+        summaries.erase(std::remove_if(summaries.begin(),
+                                       summaries.end(),
+                                       [](const auto &summ) {
+                                         return summ.get_tag().rfind("nv/baseline/", 0) == 0;
+                                       }),
+                        summaries.end());
+        nvbench::detail::add_baseline_summaries(cur_state);
+      }
+    }
+
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/retry",
+       "Retry",
+       "",
+       "Outcome of measuring a timed out state again with a longer timeout"});
+    auto &summ = cur_state.add_summary(desc);
+    summ.set_string("value", outcome);
+    summ.set_float64("timeout", cur_state.get_timeout());
+    if (std::isfinite(t_stat))
+    {
+      summ.set_float64("t_stat", t_stat);
+    }
+  }
+}
+
+nvbench::float64_t retry_pass::get_t_stat(const std::vector<nvbench::summary> &first,
+                                          const std::vector<nvbench::summary> &second)
+{
+  const auto pass1 = ::get_cpu_only_pass(first);
+  const auto pass2 = ::get_cpu_only_pass(second);
+  if (!pass1 || !pass2)
+  {
+    return std::numeric_limits<nvbench::float64_t>::quiet_NaN();
+  }
+
+  const auto diff      = std::abs(pass1->mean - pass2->mean);
+  const auto std_error = std::sqrt(pass1->stdev * pass1->stdev / pass1->samples +
+                                   pass2->stdev * pass2->stdev / pass2->samples);
+  if (!(std_error > 0.))
+  {
+    return diff == 0. ? 0. : std::numeric_limits<nvbench::float64_t>::infinity();
+  }
+  return diff / std_error;
+}
+
+void retry_pass::combine(const std::vector<nvbench::summary> &first,
+                         std::vector<nvbench::summary> &second)
+{
+  const auto pass1 = ::get_cpu_only_pass(first);
+  const auto pass2 = ::get_cpu_only_pass(second);
+  if (!pass1 || !pass2)
+  {
+    return;
+  }
+
+  // Exact pooled moments of the union of both sets of samples:
+  const auto samples = pass1->samples + pass2->samples;
+  const auto mean    = (pass1->samples * pass1->mean + pass2->samples * pass2->mean) / samples;
+  const auto sum_sq  = [mean](const cpu_only_pass &pass) {
+    const auto diff = pass.mean - mean;
+    return (pass.samples - 1.) * pass.stdev * pass.stdev + pass.samples * diff * diff;
+  };
+  const auto stdev = std::sqrt((sum_sq(*pass1) + sum_sq(*pass2)) / (samples - 1.));
+
+  if (auto *summ = find_summary(second, "nv/cpu_only/sample_size"); summ != nullptr)
+  {
+    summ->remove_value("value");
+    summ->set_int64("value", static_cast<nvbench::int64_t>(samples));
+  }
+  ::replace_value(second, "nv/cpu_only/time/cpu/mean", mean);
+  ::replace_value(second, "nv/cpu_only/time/cpu/stdev/absolute", stdev);
+  ::replace_value(second, "nv/cpu_only/time/cpu/stdev/relative", stdev / mean);
+
+  const auto combine_values = [&first, &second](const std::string &tag, auto op) {
+    const auto value1 = ::find_value(first, tag);
+    const auto value2 = ::find_value(second, tag);
+    if (value1 && value2)
+    {
+      ::replace_value(second, tag, op(*value1, *value2));
+    }
+  };
+  combine_values("nv/cpu_only/time/cpu/min", [](auto v1, auto v2) { return std::min(v1, v2); });
+  combine_values("nv/cpu_only/time/cpu/max", [](auto v1, auto v2) { return std::max(v1, v2); });
+  combine_values("nv/cpu_only/walltime", [](auto v1, auto v2) { return v1 + v2; });
+
+  // Rates are inversely proportional to the mean time:
+  const auto rate_scale = pass2->mean / mean;
+  for (const std::string tag :
+       {"nv/cpu_only/bw/item_rate", "nv/cpu_only/bw/global/bytes_per_second"})
+  {
+    combine_values(tag, [rate_scale](auto, auto v2) { return v2 * rate_scale; });
+  }
+
+  // Counter means are weighted by sample count:
+  const auto weight1 = pass1->samples / samples;
+  const auto weight2 = pass2->samples / samples;
+  for (const std::string tag : {"nv/cpu_only/cycles_per_item",
+                                 "nv/cpu_only/instructions_per_item",
+                                 "nv/cpu_only/cycles_per_byte"})
+  {
+    combine_values(tag, [weight1, weight2](auto v1, auto v2) {
+      return weight1 * v1 + weight2 * v2;
+    });
+  }
+}
+
+} // namespace nvbench::detail
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace nvbench::detail
+{
+
+/**
+ * The order in which the states of a benchmark are dispatched on each device.
+ *
+ * Slow drift, e.g. from heating or background load, correlates with the axis
+ * that varies slowest in the canonical order and shows up as a fake trend.
+ * Other orders break that correlation; the results are still reported in
+ * canonical order.
+ *
+ * - `canonical`: generation order (the default).
+ * - `reverse`: reversed generation order.
+ * - `interleave`: bit-reversed generation order, so that consecutive states
+ *   are far apart and every part of the run covers the whole sweep.
+ * - `random[:<seed>]`: a random permutation. The seed is drawn from
+ *   `std::random_device` if omitted.
+ * - `grouped`: states that share fixtures (see
+ *   `benchmark_base::set_fixture_axes`) run back to back, so that each
+ *   fixture is generated once. Applied by the runner, which knows the axis
+ *   values; `get_permutation` returns the canonical order.
+ */
+struct run_order
+{
+  enum class kind
+  {
+    canonical,
+    reverse,
+    interleave,
+    random,
+    grouped
+  };
+
+  /// Throws `std::runtime_error` on unrecognized input.
+  [[nodiscard]] static run_order parse(const std::string &spec);
+
+  /// e.g. "random:1234". Always includes the seed of random orders.
+  [[nodiscard]] std::string to_string() const;
+
+  /// Returns the order in which to run `count` states. Each `stream`, e.g. the
+  /// index of the device, is shuffled independently.
+  [[nodiscard]] std::vector<std::size_t> get_permutation(std::size_t count,
+                                                         std::size_t stream = 0) const;
+
+  kind m_kind{kind::canonical};
+  nvbench::uint64_t m_seed{};
+};
+
+} // namespace nvbench::detail
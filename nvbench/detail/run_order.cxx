@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/run_order.cuh>
+#include <nvbench/detail/throw.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nvbench::detail
+{
+
+run_order run_order::parse(const std::string &spec)
+{
+  run_order order;
+  if (spec == "canonical")
+  {
+    order.m_kind = kind::canonical;
+  }
+  else if (spec == "reverse")
+  {
+    order.m_kind = kind::reverse;
+  }
+  else if (spec == "interleave")
+  {
+    order.m_kind = kind::interleave;
+  }
+  else if (spec == "grouped")
+  {
+    order.m_kind = kind::grouped;
+  }
+  else if (spec == "random")
+  {
+    order.m_kind = kind::random;
+    std::random_device rd;
+    order.m_seed = (nvbench::uint64_t{rd()} << 32) | rd();
+  }
+  else if (spec.rfind("random:", 0) == 0)
+  {
+    order.m_kind          = kind::random;
+    const auto seed       = spec.substr(7);
+    std::size_t num_chars = 0;
+    try
+    {
+      order.m_seed = std::stoull(seed, &num_chars);
+    }
+    catch (std::exception &)
+    {
+      num_chars = 0;
+    }
+    NVBENCH_THROW_IF(seed.empty() || num_chars != seed.size() || seed[0] == '-',
+                     std::runtime_error,
+                     "Invalid seed '{}'. Expected a non-negative integer.",
+                     seed);
+  }
+  else
+  {
+    NVBENCH_THROW(std::runtime_error,
+                  "Unrecognized run order '{}'. "
+                  "Expected one of: canonical, reverse, interleave, random[:<seed>], grouped.",
+                  spec);
+  }
+  return order;
+}
+
+std::string run_order::to_string() const
+{
+  switch (m_kind)
+  {
+    case kind::reverse:
+      return "reverse";
+    case kind::interleave:
+      return "interleave";
+    case kind::random:
+      return fmt::format("random:{}", m_seed);
+    case kind::grouped:
+      return "grouped";
+    case kind::canonical:
+    default:
+      return "canonical";
+  }
+}
+
+std::vector<std::size_t> run_order::get_permutation(std::size_t count, std::size_t stream) const
+{
+  std::vector<std::size_t> order(count);
+  std::iota(order.begin(), order.end(), std::size_t{});
+
+  switch (m_kind)
+  {
+    case kind::reverse:
+      std::reverse(order.begin(), order.end());
+      break;
+
+    case kind::interleave: {
+      std::size_t num_bits = 0;
+      while ((std::size_t{1} << num_bits) < count)
+      {
+        ++num_bits;
+      }
+      order.clear();
+      for (std::size_t i = 0; i < (std::size_t{1} << num_bits); ++i)
+      {
+        std::size_t reversed = 0;
+        for (std::size_t bit = 0; bit < num_bits; ++bit)
+        {
+          reversed |= ((i >> bit) & 1) << (num_bits - 1 - bit);
+        }
+        if (reversed < count)
+        {
+          order.push_back(reversed);
+        }
+      }
+      break;
+    }
+
+    case kind::random: {
+      // std::shuffle and the standard distributions are implementation-defined;
+      // a hand-rolled Fisher-Yates shuffle reproduces the same order for a seed
+      // on every platform:
+      std::seed_seq seq{static_cast<std::uint32_t>(m_seed),
+                        static_cast<std::uint32_t>(m_seed >> 32),
+                        static_cast<std::uint32_t>(stream)};
+      std::mt19937_64 rng{seq};
+      for (std::size_t i = count; i > 1; --i)
+      {
+        // Rejection sampling avoids modulo bias:
+        const auto bound = static_cast<nvbench::uint64_t>(i);
+        const auto limit = std::mt19937_64::max() - std::mt19937_64::max() % bound;
+        nvbench::uint64_t r;
+        do
+        {
+          r = rng();
+        } while (r >= limit);
+        std::swap(order[i - 1], order[static_cast<std::size_t>(r % bound)]);
+      }
+      break;
+    }
+
+    case kind::grouped:
+    case kind::canonical:
+    default:
+      break;
+  }
+  return order;
+}
+
+} // namespace nvbench::detail
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nvbench::detail
+{
+
+/**
+ * Statistical CPU profiler driven by `SIGPROF`.
+ *
+ * While started, the process CPU-time interval timer interrupts whichever
+ * thread is running every `period_us` microseconds of CPU time and the signal
+ * handler records the call stack into a preallocated, lock-free buffer.
+ * Stacks are symbolized with `dladdr` only after `stop()`, outside of the
+ * measured region. Executables need `-rdynamic` (`ENABLE_EXPORTS`) for their
+ * own functions to be named; unresolved frames are reported as
+ * `module+offset`.
+ *
+ * Only one profiler may run at a time. Only supported on Linux.
+ */
+struct sampling_profiler
+{
+  struct function_stats
+  {
+    std::string name;
+    // Samples where the function was the innermost frame:
+    nvbench::int64_t self_samples{};
+    // Samples where the function appears anywhere in the stack:
+    nvbench::int64_t total_samples{};
+  };
+
+  static constexpr std::size_t max_depth = 64;
+
+  [[nodiscard]] static bool is_supported();
+
+  explicit sampling_profiler(std::size_t max_samples = 16384);
+  ~sampling_profiler();
+
+  // The signal handler holds a pointer to the buffer:
+  sampling_profiler(const sampling_profiler &)            = delete;
+  sampling_profiler(sampling_profiler &&)                 = delete;
+  sampling_profiler &operator=(const sampling_profiler &) = delete;
+  sampling_profiler &operator=(sampling_profiler &&)      = delete;
+
+  void start(nvbench::int64_t period_us = 1000);
+  void stop();
+
+  /// Stops and restarts sampling without releasing the signal handler, to
+  /// leave work such as input generation out of the profile. No-ops unless
+  /// running.
+  void pause();
+  void resume();
+
+  [[nodiscard]] nvbench::int64_t get_sample_count() const;
+  [[nodiscard]] nvbench::int64_t get_dropped_count() const;
+
+  /// The `count` functions with the most self samples.
+  [[nodiscard]] std::vector<function_stats> get_top_functions(std::size_t count) const;
+
+  /// Writes stacks in the "folded" format used by flamegraph.pl:
+  /// `outer;...;inner <count>` per line.
+  void write_folded_stacks(const std::string &filename) const;
+
+  // Used by the signal handler:
+  struct buffer
+  {
+    explicit buffer(std::size_t max_samples)
+        : frames(max_samples * max_depth)
+        , depths(max_samples)
+    {}
+
+    std::vector<void *> frames;
+    std::vector<std::uint32_t> depths;
+    std::atomic<std::size_t> next{0};
+    std::atomic<nvbench::int64_t> dropped{0};
+  };
+
+private:
+  std::unique_ptr<buffer> m_buffer;
+  nvbench::int64_t m_period_us{};
+  bool m_running{false};
+  bool m_paused{false};
+};
+
+} // namespace nvbench::detail
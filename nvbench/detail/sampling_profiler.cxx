@@ -0,0 +1,356 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/sampling_profiler.cuh>
+#include <nvbench/detail/throw.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+namespace
+{
+
+// Frames belonging to the signal handler and the kernel's signal trampoline:
+constexpr std::size_t num_handler_frames = 2;
+
+std::atomic<nvbench::detail::sampling_profiler::buffer *> active_buffer{nullptr};
+
+#ifdef __linux__
+struct sigaction previous_action;
+
+// A period of 0 disarms the timer:
+bool set_profiling_timer(nvbench::int64_t period_us)
+{
+  itimerval timer{};
+  timer.it_interval.tv_sec  = static_cast<time_t>(period_us / 1000000);
+  timer.it_interval.tv_usec = static_cast<suseconds_t>(period_us % 1000000);
+  timer.it_value            = timer.it_interval;
+  return setitimer(ITIMER_PROF, &timer, nullptr) == 0;
+}
+
+void handle_sigprof(int, siginfo_t *, void *)
+{
+  const int saved_errno = errno;
+
+  auto *buf = active_buffer.load(std::memory_order_acquire);
+  if (buf != nullptr)
+  {
+    const auto index = buf->next.fetch_add(1, std::memory_order_relaxed);
+    if (index < buf->depths.size())
+    {
+      using profiler   = nvbench::detail::sampling_profiler;
+      void **frames    = &buf->frames[index * profiler::max_depth];
+      const int depth  = backtrace(frames, static_cast<int>(profiler::max_depth));
+      buf->depths[index] = static_cast<std::uint32_t>(depth);
+    }
+    else
+    {
+      buf->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  errno = saved_errno;
+}
+
+std::string demangle(const char *name)
+{
+  int status{};
+  char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status != 0 || demangled == nullptr)
+  {
+    return name;
+  }
+  std::string result{demangled};
+  std::free(demangled);
+  return result;
+}
+#endif
+
+struct symbolizer
+{
+  const std::string &operator()(void *address, bool is_return_address)
+  {
+    // Return addresses point after the call, which may be past the end of the
+    // calling function:
+    auto lookup = reinterpret_cast<std::uintptr_t>(address) - (is_return_address ? 1 : 0);
+
+    auto iter = m_cache.find(lookup);
+    if (iter != m_cache.end())
+    {
+      return iter->second;
+    }
+
+    std::string name;
+#ifdef __linux__
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void *>(lookup), &info) != 0)
+    {
+      if (info.dli_sname != nullptr)
+      {
+        name = ::demangle(info.dli_sname);
+      }
+      else if (info.dli_fname != nullptr)
+      {
+        std::string module{info.dli_fname};
+        module = module.substr(module.find_last_of('/') + 1);
+        name   = fmt::format("{}+0x{:x}",
+                           module,
+                           lookup - reinterpret_cast<std::uintptr_t>(info.dli_fbase));
+      }
+    }
+#endif
+    if (name.empty())
+    {
+      name = fmt::format("0x{:x}", lookup);
+    }
+
+    // ';' separates frames in folded stacks:
+    std::replace(name.begin(), name.end(), ';', ':');
+
+    return m_cache.emplace(lookup, std::move(name)).first->second;
+  }
+
+private:
+  std::unordered_map<std::uintptr_t, std::string> m_cache;
+};
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+bool sampling_profiler::is_supported()
+{
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+sampling_profiler::sampling_profiler(std::size_t max_samples)
+    : m_buffer{std::make_unique<buffer>(max_samples)}
+{}
+
+sampling_profiler::~sampling_profiler()
+{
+  if (m_running)
+  {
+    this->stop();
+  }
+}
+
+void sampling_profiler::start([[maybe_unused]] nvbench::int64_t period_us)
+{
+#ifdef __linux__
+  NVBENCH_THROW_IF(m_running, std::runtime_error, "{}", "Sampling profiler is already running.");
+
+  // backtrace() loads libgcc on first use, which is not async-signal-safe:
+  void *warmup[1];
+  backtrace(warmup, 1);
+
+  buffer *expected = nullptr;
+  NVBENCH_THROW_IF(!active_buffer.compare_exchange_strong(expected, m_buffer.get()),
+                   std::runtime_error,
+                   "{}",
+                   "Another sampling profiler is already running.");
+
+  struct sigaction action{};
+  action.sa_sigaction = handle_sigprof;
+  action.sa_flags     = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &previous_action) != 0)
+  {
+    active_buffer.store(nullptr);
+    NVBENCH_THROW(std::runtime_error, "Failed to install SIGPROF handler (errno {}).", errno);
+  }
+
+  if (!::set_profiling_timer(period_us))
+  {
+    sigaction(SIGPROF, &previous_action, nullptr);
+    active_buffer.store(nullptr);
+    NVBENCH_THROW(std::runtime_error, "Failed to start profiling timer (errno {}).", errno);
+  }
+
+  m_period_us = period_us;
+  m_running   = true;
+  m_paused    = false;
+#else
+  NVBENCH_THROW(std::runtime_error, "{}", "The sampling profiler is only supported on Linux.");
+#endif
+}
+
+void sampling_profiler::stop()
+{
+#ifdef __linux__
+  if (!m_running)
+  {
+    return;
+  }
+
+  ::set_profiling_timer(0);
+  active_buffer.store(nullptr, std::memory_order_release);
+  sigaction(SIGPROF, &previous_action, nullptr);
+
+  m_running = false;
+#endif
+}
+
+void sampling_profiler::pause()
+{
+#ifdef __linux__
+  if (m_running && !m_paused)
+  {
+    ::set_profiling_timer(0);
+    m_paused = true;
+  }
+#endif
+}
+
+void sampling_profiler::resume()
+{
+#ifdef __linux__
+  if (m_running && m_paused)
+  {
+    if (!::set_profiling_timer(m_period_us))
+    {
+      NVBENCH_THROW(std::runtime_error, "Failed to restart profiling timer (errno {}).", errno);
+    }
+    m_paused = false;
+  }
+#endif
+}
+
+nvbench::int64_t sampling_profiler::get_sample_count() const
+{
+  const auto num_slots = std::min(m_buffer->next.load(), m_buffer->depths.size());
+  return static_cast<nvbench::int64_t>(
+    std::count_if(m_buffer->depths.cbegin(),
+                  m_buffer->depths.cbegin() + static_cast<std::ptrdiff_t>(num_slots),
+                  [](std::uint32_t depth) { return depth > num_handler_frames; }));
+}
+
+nvbench::int64_t sampling_profiler::get_dropped_count() const { return m_buffer->dropped.load(); }
+
+std::vector<sampling_profiler::function_stats>
+sampling_profiler::get_top_functions(std::size_t count) const
+{
+  symbolizer symbolize;
+  std::map<std::string, function_stats> stats;
+
+  const auto num_slots = std::min(m_buffer->next.load(), m_buffer->depths.size());
+  for (std::size_t i = 0; i < num_slots; ++i)
+  {
+    const std::size_t depth = m_buffer->depths[i];
+    if (depth <= num_handler_frames)
+    {
+      continue;
+    }
+
+    // Count recursive functions once per sample:
+    std::set<std::string> seen;
+    for (std::size_t frame = num_handler_frames; frame < depth; ++frame)
+    {
+      const bool is_leaf = frame == num_handler_frames;
+      const auto &name   = symbolize(m_buffer->frames[i * max_depth + frame], !is_leaf);
+
+      auto &entry = stats[name];
+      if (is_leaf)
+      {
+        ++entry.self_samples;
+      }
+      if (seen.insert(name).second)
+      {
+        ++entry.total_samples;
+      }
+    }
+  }
+
+  std::vector<function_stats> result;
+  result.reserve(stats.size());
+  for (auto &[name, entry] : stats)
+  {
+    entry.name = name;
+    result.push_back(std::move(entry));
+  }
+
+  std::stable_sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.self_samples != rhs.self_samples ? lhs.self_samples > rhs.self_samples
+                                                : lhs.total_samples > rhs.total_samples;
+  });
+  if (result.size() > count)
+  {
+    result.resize(count);
+  }
+  return result;
+}
+
+void sampling_profiler::write_folded_stacks(const std::string &filename) const
+{
+  symbolizer symbolize;
+  std::map<std::string, nvbench::int64_t> stacks;
+
+  const auto num_slots = std::min(m_buffer->next.load(), m_buffer->depths.size());
+  for (std::size_t i = 0; i < num_slots; ++i)
+  {
+    const std::size_t depth = m_buffer->depths[i];
+    if (depth <= num_handler_frames)
+    {
+      continue;
+    }
+
+    // Outermost frame first:
+    std::string stack;
+    for (std::size_t frame = depth; frame-- > num_handler_frames;)
+    {
+      const bool is_leaf = frame == num_handler_frames;
+      if (!stack.empty())
+      {
+        stack.push_back(';');
+      }
+      stack += symbolize(m_buffer->frames[i * max_depth + frame], !is_leaf);
+    }
+    ++stacks[stack];
+  }
+
+  std::ofstream out;
+  out.exceptions(out.exceptions() | std::ios::failbit | std::ios::badbit);
+  out.open(filename);
+  for (const auto &[stack, samples] : stacks)
+  {
+    out << stack << ' ' << samples << '\n';
+  }
+}
+
+} // namespace nvbench::detail
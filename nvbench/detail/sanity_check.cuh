@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/detail/cpu_counters.cuh>
+#include <nvbench/types.cuh>
+
+namespace nvbench
+{
+struct benchmark_base;
+struct state;
+} // namespace nvbench
+
+namespace nvbench::detail
+{
+
+/**
+ * Checks that benchmarks measure the work they are meant to. Compilers
+ * happily delete CPU work whose result is never used, which shows up as
+ * impossible throughputs. See nvbench::do_not_optimize.
+ */
+struct sanity_check
+{
+  /// Statistics of empty timed regions, i.e. the cost of the harness itself.
+  struct empty_launch
+  {
+    nvbench::float64_t mean{};
+    nvbench::float64_t stdev{};
+    nvbench::int64_t samples{};
+  };
+
+  /// A state is flagged if its mean time exceeds the empty launch time by
+  /// less than this many standard errors...
+  static constexpr nvbench::float64_t significant_t_stat = 3.;
+  /// ...or by less than this fraction of the empty launch time.
+  static constexpr nvbench::float64_t min_relative_work = 0.1;
+
+  /// A size axis is flagged if the largest element count is at least
+  /// `min_size_ratio` times the smallest, but the time grew slower than
+  /// `size^max_size_exponent`. @{
+  static constexpr nvbench::float64_t min_size_ratio    = 4.;
+  static constexpr nvbench::float64_t max_size_exponent = 0.1;
+  /// @}
+
+  /// Times `samples` empty regions with the timer used for CPU-only trials.
+  [[nodiscard]] static empty_launch calibrate(nvbench::detail::counting_cpu_timer &timer,
+                                              nvbench::int64_t samples = 1000);
+
+  /// Whether a mean time of `mean` over `samples` trials with standard
+  /// deviation `stdev` can't be told apart from `empty`.
+  [[nodiscard]] static bool is_empty(const empty_launch &empty,
+                                     nvbench::float64_t mean,
+                                     nvbench::float64_t stdev,
+                                     nvbench::int64_t samples);
+
+  /// Records the empty launch time in `state` and flags the state if its
+  /// CPU time is indistinguishable from it.
+  static void add_empty_launch_summaries(nvbench::state &state,
+                                         const empty_launch &empty,
+                                         nvbench::float64_t mean,
+                                         nvbench::float64_t stdev,
+                                         nvbench::int64_t samples);
+
+  /// Flags groups of CPU-only states that differ only in an int64 axis that
+  /// changes their element counts, but whose time doesn't grow with it.
+  static void add_size_scaling_summaries(nvbench::benchmark_base &bench);
+};
+
+} // namespace nvbench::detail
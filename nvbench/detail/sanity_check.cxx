@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/sanity_check.cuh>
+#include <nvbench/detail/state_group.cuh>
+#include <nvbench/detail/statistics.cuh>
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/do_not_optimize.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr const char *cpu_time_tag = "nv/cpu_only/time/cpu/mean";
+
+void log_warning(const nvbench::benchmark_base &bench, const std::string &msg)
+{
+  if (auto printer_opt_ref = bench.get_printer(); printer_opt_ref.has_value())
+  {
+    printer_opt_ref.value().get().log(nvbench::log_level::warn, msg);
+  }
+}
+
+// Adds `warning` to the state's sanity column:
+void add_warning(nvbench::state &state, const std::string &warning)
+{
+  if (auto *summ = nvbench::detail::find_summary(state.get_summaries(), "nv/sanity/warning"))
+  {
+    auto value = fmt::format("{}, {}", summ->get_string("value"), warning);
+    summ->remove_value("value");
+    summ->set_string("value", std::move(value));
+    return;
+  }
+
+  static const auto &desc = nvbench::summary_registry::get().add(
+    {"nv/sanity/warning",
+     "Sanity",
+     {},
+     "Reasons to suspect that the work of the state was optimized away"});
+  auto &summ = state.add_summary(desc);
+  summ.set_string("value", warning);
+}
+
+} // namespace
+
+namespace nvbench::detail
+{
+
+sanity_check::empty_launch sanity_check::calibrate(nvbench::detail::counting_cpu_timer &timer,
+                                                   nvbench::int64_t samples)
+{
+  std::vector<nvbench::float64_t> times;
+  times.reserve(static_cast<std::size_t>(samples));
+
+  // The first iterations warm up the caches and the counters:
+  constexpr nvbench::int64_t warmup = 10;
+  for (nvbench::int64_t i = 0; i < warmup + samples; ++i)
+  {
+    timer.start();
+    nvbench::clobber_memory();
+    timer.stop();
+    if (i >= warmup)
+    {
+      times.push_back(timer.get_duration());
+    }
+  }
+
+  empty_launch result;
+  result.samples = samples;
+  if (!times.empty())
+  {
+    result.mean  = nvbench::detail::statistics::compute_mean(times.cbegin(), times.cend());
+    result.stdev = nvbench::detail::statistics::standard_deviation(times.cbegin(),
+                                                                   times.cend(),
+                                                                   result.mean);
+  }
+  return result;
+}
+
+bool sanity_check::is_empty(const empty_launch &empty,
+                            nvbench::float64_t mean,
+                            nvbench::float64_t stdev,
+                            nvbench::int64_t samples)
+{
+  if (empty.samples < 2 || samples < 2)
+  {
+    return false;
+  }
+
+  const auto work      = mean - empty.mean;
+  const auto std_error = std::sqrt(stdev * stdev / static_cast<nvbench::float64_t>(samples) +
+                                   empty.stdev * empty.stdev /
+                                     static_cast<nvbench::float64_t>(empty.samples));
+  return work <= significant_t_stat * std_error || work <= min_relative_work * empty.mean;
+}
+
+void sanity_check::add_empty_launch_summaries(nvbench::state &state,
+                                              const empty_launch &empty,
+                                              nvbench::float64_t mean,
+                                              nvbench::float64_t stdev,
+                                              nvbench::int64_t samples)
+{
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/empty/mean",
+       "Empty Time",
+       "duration",
+       "Mean CPU time of an empty timed region, measured before the trials",
+       "Hidden by default."});
+    auto &summ = state.add_summary(desc);
+    summ.set_int64("samples", empty.samples);
+    summ.set_float64("stdev", empty.stdev);
+    summ.set_float64("value", empty.mean);
+  }
+
+  if (sanity_check::is_empty(empty, mean, stdev, samples))
+  {
+    ::add_warning(state, "no work");
+    ::log_warning(state.get_benchmark(),
+                  fmt::format("{}: Mean CPU time ({:.4g}s) is indistinguishable from an empty "
+                              "launch ({:.4g}s). Use nvbench::do_not_optimize to keep the "
+                              "compiler from removing the work.",
+                              state.get_short_description(),
+                              mean,
+                              empty.mean));
+  }
+}
+
+void sanity_check::add_size_scaling_summaries(nvbench::benchmark_base &bench)
+{
+  for (const auto &axis : bench.get_axes().get_axes())
+  {
+    if (axis->get_type() != nvbench::axis_type::int64)
+    {
+      continue;
+    }
+    const auto &axis_name = axis->get_name();
+
+    // States that differ only in `axis_name`:
+    const auto groups = group_states(bench, {axis_name}, [](const nvbench::state &exec_state) {
+      return exec_state.get_element_count() != 0 &&
+             find_summary(exec_state, cpu_time_tag) != nullptr;
+    });
+
+    for (const auto &group : groups)
+    {
+      const auto [smallest, largest] =
+        std::minmax_element(group.states.cbegin(),
+                            group.states.cend(),
+                            [](const nvbench::state *lhs, const nvbench::state *rhs) {
+                              return lhs->get_element_count() < rhs->get_element_count();
+                            });
+      const auto size_ratio = static_cast<nvbench::float64_t>((*largest)->get_element_count()) /
+                              static_cast<nvbench::float64_t>((*smallest)->get_element_count());
+      if (size_ratio < min_size_ratio)
+      {
+        continue;
+      }
+
+      const auto min_time   = find_summary(**smallest, cpu_time_tag)->get_float64("value");
+      const auto max_time   = find_summary(**largest, cpu_time_tag)->get_float64("value");
+      const auto time_ratio = max_time / min_time;
+      if (!(time_ratio < std::pow(size_ratio, max_size_exponent)))
+      {
+        continue;
+      }
+
+      for (auto *exec_state : group.states)
+      {
+        ::add_warning(*exec_state, fmt::format("flat in {}", axis_name));
+      }
+      ::log_warning(bench,
+                    fmt::format("{}: Mean CPU time changed {:.3g}x while the element count "
+                                "grew {:.4g}x along '{}' ({}). The work may have been "
+                                "optimized away.",
+                                bench.get_name(),
+                                time_ratio,
+                                size_ratio,
+                                axis_name,
+                                (*smallest)->get_axis_values_as_string()));
+    }
+  }
+}
+
+} // namespace nvbench::detail
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace nvbench
+{
+struct benchmark_base;
+struct state;
+} // namespace nvbench
+
+namespace nvbench::detail
+{
+
+/**
+ * Tracks a soak run: a measurement that runs for a fixed duration and / or
+ * number of samples instead of until it converges, to expose slow
+ * degradations such as leaks, fragmentation or cache pollution.
+ *
+ * The run is split into equal windows of walltime (or of samples, if only a
+ * sample count is given). The trend of the per-window mean times is fit with
+ * a linear regression and reported as the relative change from the first to
+ * the last window.
+ */
+struct soak_tracker
+{
+  struct trend
+  {
+    // Mean time of the first and last non-empty windows:
+    nvbench::float64_t first{};
+    nvbench::float64_t last{};
+    // Change of the fitted time over all windows, relative to its start:
+    nvbench::float64_t drift{};
+    // t-statistic of the fitted slope:
+    nvbench::float64_t t_stat{};
+    // "DEGRADED" or "IMPROVED" if the drift is significant and larger than
+    // the threshold, otherwise "STABLE":
+    std::string verdict;
+  };
+
+  /// A drift is significant if its t-statistic exceeds this value.
+  static constexpr nvbench::float64_t significant_t_stat = 3.;
+
+  /// Soak runs only keep the most recent sample times, so that memory doesn't
+  /// grow with the duration of the run.
+  static constexpr std::size_t max_kept_samples = std::size_t{1} << 16;
+
+  explicit soak_tracker(const nvbench::benchmark_base &bench);
+
+  [[nodiscard]] bool is_enabled() const { return m_duration > 0. || m_iterations > 0; }
+
+  void add_sample(nvbench::float64_t time, nvbench::float64_t walltime);
+  [[nodiscard]] bool is_finished(nvbench::float64_t walltime) const;
+
+  /// Records `time`, the `index`th sample, in `times`. Soak runs overwrite
+  /// the oldest time once `max_kept_samples` are kept.
+  void keep_sample(std::vector<nvbench::float64_t> &times,
+                   nvbench::float64_t time,
+                   nvbench::int64_t index) const;
+
+  /// Puts the times recorded by `keep_sample` back in the order they were
+  /// taken, given the total number of samples.
+  static void restore_order(std::vector<nvbench::float64_t> &times, nvbench::int64_t count);
+
+  /// Mean time of each window; NaN for windows without samples.
+  [[nodiscard]] std::vector<nvbench::float64_t> get_window_means() const;
+
+  /// Adds the soak summaries of `time_tag`'s measurement to `state` and logs
+  /// degradations as failures.
+  void add_summaries(nvbench::state &state, const std::string &time_tag) const;
+
+  /// Fits the trend of `window_means`, ignoring NaN entries.
+  [[nodiscard]] static trend compute_trend(const std::vector<nvbench::float64_t> &window_means,
+                                           nvbench::float64_t threshold);
+
+private:
+  nvbench::float64_t m_duration{};
+  nvbench::int64_t m_iterations{};
+  nvbench::float64_t m_threshold{};
+
+  nvbench::int64_t m_samples{};
+  std::vector<nvbench::int64_t> m_window_samples;
+  std::vector<nvbench::float64_t> m_window_times;
+};
+
+} // namespace nvbench::detail
@@ -0,0 +1,275 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/soak.cuh>
+#include <nvbench/detail/statistics.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace nvbench::detail
+{
+
+soak_tracker::soak_tracker(const nvbench::benchmark_base &bench)
+    : m_duration{bench.get_soak_duration()}
+    , m_iterations{bench.get_soak_iterations()}
+    , m_threshold{bench.get_soak_threshold()}
+{
+  if (this->is_enabled())
+  {
+    const auto num_windows = static_cast<std::size_t>(std::max(bench.get_soak_windows(),
+                                                               nvbench::int64_t{3}));
+    m_window_samples.resize(num_windows);
+    m_window_times.resize(num_windows);
+  }
+}
+
+void soak_tracker::add_sample(nvbench::float64_t time, nvbench::float64_t walltime)
+{
+  if (!this->is_enabled())
+  {
+    return;
+  }
+
+  // Fraction of the run completed before this sample:
+  nvbench::float64_t progress = 0.;
+  if (m_duration > 0.)
+  {
+    progress = std::max(progress, (walltime - time) / m_duration);
+  }
+  if (m_iterations > 0)
+  {
+    progress = std::max(progress,
+                        static_cast<nvbench::float64_t>(m_samples) /
+                          static_cast<nvbench::float64_t>(m_iterations));
+  }
+
+  const auto num_windows = m_window_samples.size();
+  const auto scaled      = std::max(progress, 0.) * static_cast<nvbench::float64_t>(num_windows);
+  const auto window      = std::min(static_cast<std::size_t>(scaled), num_windows - 1);
+  ++m_window_samples[window];
+  m_window_times[window] += time;
+  ++m_samples;
+}
+
+void soak_tracker::keep_sample(std::vector<nvbench::float64_t> &times,
+                               nvbench::float64_t time,
+                               nvbench::int64_t index) const
+{
+  if (!this->is_enabled() || times.size() < max_kept_samples)
+  {
+    times.push_back(time);
+  }
+  else
+  {
+    times[static_cast<std::size_t>(index) % max_kept_samples] = time;
+  }
+}
+
+void soak_tracker::restore_order(std::vector<nvbench::float64_t> &times, nvbench::int64_t count)
+{
+  if (times.empty() || static_cast<std::size_t>(count) <= times.size())
+  {
+    return;
+  }
+  // The oldest time was overwritten last:
+  const auto oldest = static_cast<std::size_t>(count) % times.size();
+  std::rotate(times.begin(), times.begin() + static_cast<std::ptrdiff_t>(oldest), times.end());
+}
+
+bool soak_tracker::is_finished(nvbench::float64_t walltime) const
+{
+  return (m_duration > 0. && walltime >= m_duration) ||
+         (m_iterations > 0 && m_samples >= m_iterations);
+}
+
+std::vector<nvbench::float64_t> soak_tracker::get_window_means() const
+{
+  std::vector<nvbench::float64_t> means(m_window_samples.size(),
+                                        std::numeric_limits<nvbench::float64_t>::quiet_NaN());
+  for (std::size_t i = 0; i < means.size(); ++i)
+  {
+    if (m_window_samples[i] > 0)
+    {
+      means[i] = m_window_times[i] / static_cast<nvbench::float64_t>(m_window_samples[i]);
+    }
+  }
+  return means;
+}
+
+soak_tracker::trend
+soak_tracker::compute_trend(const std::vector<nvbench::float64_t> &window_means,
+                            nvbench::float64_t threshold)
+{
+  std::vector<nvbench::float64_t> means;
+  std::copy_if(window_means.cbegin(),
+               window_means.cend(),
+               std::back_inserter(means),
+               [](auto mean) { return !std::isnan(mean); });
+
+  trend result;
+  result.verdict = "STABLE";
+  if (means.empty())
+  {
+    return result;
+  }
+  result.first = means.front();
+  result.last  = means.back();
+  if (means.size() < 3)
+  {
+    return result;
+  }
+
+  const auto [slope, intercept] =
+    nvbench::detail::statistics::compute_linear_regression(means.cbegin(), means.cend());
+  const auto n = static_cast<nvbench::float64_t>(means.size());
+  if (!(intercept > 0.))
+  {
+    return result;
+  }
+  result.drift = slope * (n - 1.) / intercept;
+
+  // Standard error of the slope for x = 0, 1, ..., n - 1:
+  nvbench::float64_t sum_sq_residuals{};
+  for (std::size_t i = 0; i < means.size(); ++i)
+  {
+    const auto residual = means[i] - (intercept + slope * static_cast<nvbench::float64_t>(i));
+    sum_sq_residuals += residual * residual;
+  }
+  const auto sum_sq_x  = n * (n * n - 1.) / 12.;
+  const auto std_error = std::sqrt(sum_sq_residuals / (n - 2.) / sum_sq_x);
+  if (std_error > 0.)
+  {
+    result.t_stat = std::abs(slope) / std_error;
+  }
+  else if (slope != 0.)
+  {
+    result.t_stat = std::numeric_limits<nvbench::float64_t>::infinity();
+  }
+
+  if (result.t_stat > significant_t_stat && std::abs(result.drift) > threshold)
+  {
+    result.verdict = result.drift > 0. ? "DEGRADED" : "IMPROVED";
+  }
+  return result;
+}
+
+void soak_tracker::add_summaries(nvbench::state &state, const std::string &time_tag) const
+{
+  if (!this->is_enabled())
+  {
+    return;
+  }
+
+  const auto window_means = this->get_window_means();
+  const auto result       = compute_trend(window_means, m_threshold);
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/soak/time/first",
+       "First Window",
+       "duration",
+       "Mean time of the first window of the soak run"});
+    auto &summ = state.add_summary(desc);
+    summ.set_string("time_tag", time_tag);
+    summ.set_float64("value", result.first);
+  }
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/soak/time/last",
+       "Last Window",
+       "duration",
+       "Mean time of the last window of the soak run"});
+    auto &summ = state.add_summary(desc);
+    summ.set_float64("value", result.last);
+  }
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/soak/degradation",
+       "Degradation",
+       "percentage",
+       "Relative increase of the mean time from the first to the last window"});
+    auto &summ = state.add_summary(desc);
+    summ.set_float64("value", result.first > 0. ? result.last / result.first - 1. : 0.);
+  }
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/soak/drift",
+       "Drift",
+       "percentage",
+       "Change of the linear fit of the window mean times over the soak run, relative to its "
+       "start"});
+    auto &summ = state.add_summary(desc);
+    summ.set_float64("t_stat", result.t_stat);
+    summ.set_float64("value", result.drift);
+  }
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/soak/verdict",
+       "Soak",
+       {},
+       "DEGRADED or IMPROVED if the drift is significant and exceeds the soak threshold, "
+       "otherwise STABLE"});
+    auto &summ = state.add_summary(desc);
+    summ.set_string("value", result.verdict);
+  }
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/soak/window_times",
+       "Window Times",
+       {},
+       "Mean time of each window of the soak run, as `time/<window>` values",
+       "Hidden by default."});
+    auto &summ = state.add_summary(desc);
+    summ.set_int64("value", static_cast<nvbench::int64_t>(window_means.size()));
+    for (std::size_t i = 0; i < window_means.size(); ++i)
+    {
+      if (!std::isnan(window_means[i]))
+      {
+        summ.set_float64(fmt::format("time/{}", i), window_means[i]);
+      }
+    }
+  }
+
+  if (result.verdict == "DEGRADED")
+  {
+    if (auto printer_opt_ref = state.get_benchmark().get_printer(); printer_opt_ref.has_value())
+    {
+      auto &printer = printer_opt_ref.value().get();
+      printer.log(nvbench::log_level::fail,
+                  fmt::format("Performance degraded by {:.2f}% during the soak run "
+                              "({:.4g}s -> {:.4g}s, t = {:.1f})",
+                              result.drift * 100.,
+                              result.first,
+                              result.last,
+                              result.t_stat));
+    }
+  }
+}
+
+} // namespace nvbench::detail
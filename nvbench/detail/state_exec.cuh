@@ -25,6 +25,7 @@
 
 #include <nvbench/config.cuh>
 #include <nvbench/detail/kernel_launcher_timer_wrapper.cuh>
+#include <nvbench/detail/measure_async.cuh>
 #include <nvbench/detail/measure_cold.cuh>
 #include <nvbench/detail/measure_cpu_only.cuh>
 #include <nvbench/detail/measure_hot.cuh>
@@ -120,7 +121,15 @@ void state::exec(ExecTags tags, KernelLauncher &&kernel_launcher)
     {
       static_assert(!(tags & gpu), "CPU-only measurement doesn't support the `gpu` exec_tag.");
 
-      if constexpr (tags & timer)
+      if constexpr (tags & async)
+      {
+        static_assert(!(tags & timer), "Async measurement doesn't support the `timer` exec_tag.");
+
+        using measure_t = nvbench::detail::measure_async<KL>;
+        measure_t measure{*this, kernel_launcher};
+        measure();
+      }
+      else if constexpr (tags & timer)
       {
         using measure_t = nvbench::detail::measure_cpu_only<KL>;
         measure_t measure{*this, kernel_launcher};
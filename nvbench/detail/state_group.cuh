@@ -0,0 +1,61 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/device_info.cuh>
+#include <nvbench/named_values.cuh>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nvbench
+{
+struct benchmark_base;
+struct state;
+} // namespace nvbench
+
+namespace nvbench::detail
+{
+
+/// States of a benchmark that differ only in the values of some axes.
+struct state_group
+{
+  std::optional<nvbench::device_info> device;
+  /// The axis values the states share, without the grouped axes.
+  nvbench::named_values axis_values;
+  /// The tag of the states' time summary, see `find_time_summary`.
+  std::string time_tag;
+  /// In the order of `benchmark_base::get_states()`.
+  std::vector<nvbench::state *> states;
+};
+
+/**
+ * Groups the states of `bench` by device, time summary and the values of all
+ * axes except `axis_names`. Skipped states, states without a time summary and
+ * states rejected by `filter` are left out. Groups are in order of their first
+ * state.
+ */
+[[nodiscard]] std::vector<state_group>
+group_states(nvbench::benchmark_base &bench,
+             const std::vector<std::string> &axis_names,
+             const std::function<bool(const nvbench::state &)> &filter = {});
+
+} // namespace nvbench::detail
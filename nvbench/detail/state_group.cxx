@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/state_group.cuh>
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/state.cuh>
+
+#include <algorithm>
+#include <iterator>
+
+namespace nvbench::detail
+{
+
+std::vector<state_group> group_states(nvbench::benchmark_base &bench,
+                                      const std::vector<std::string> &axis_names,
+                                      const std::function<bool(const nvbench::state &)> &filter)
+{
+  std::vector<state_group> groups;
+  for (auto &exec_state : bench.get_states())
+  {
+    if (exec_state.is_skipped())
+    {
+      continue;
+    }
+    const nvbench::summary *time_summ = find_time_summary(exec_state);
+    if (time_summ == nullptr || (filter && !filter(exec_state)))
+    {
+      continue;
+    }
+
+    nvbench::named_values axis_values = exec_state.get_axis_values();
+    for (const auto &name : axis_names)
+    {
+      axis_values.remove_value(name);
+    }
+
+    auto iter = std::find_if(groups.begin(), groups.end(), [&](const state_group &group) {
+      return group.device == exec_state.get_device() && group.axis_values == axis_values &&
+             group.time_tag == time_summ->get_tag();
+    });
+    if (iter == groups.end())
+    {
+      groups.push_back(
+        {exec_state.get_device(), std::move(axis_values), time_summ->get_tag(), {}});
+      iter = std::prev(groups.end());
+    }
+    iter->states.push_back(&exec_state);
+  }
+  return groups;
+}
+
+} // namespace nvbench::detail
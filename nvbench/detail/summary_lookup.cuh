@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace nvbench
+{
+struct state;
+struct summary;
+} // namespace nvbench
+
+namespace nvbench::detail
+{
+
+/// Mean time summaries of the measurements, in order of preference. Passes
+/// that compare or combine states use the first one a state has.
+inline constexpr const char *preferred_time_tags[] = {"nv/cold/time/gpu/mean",
+                                                      "nv/cpu_only/time/cpu/mean",
+                                                      "nv/async/time/latency/mean",
+                                                      "nv/batch/time/gpu/mean"};
+
+/// The first summary with `tag`, or nullptr. Unlike `state::get_summary`, this
+/// doesn't throw for missing summaries. @{
+[[nodiscard]] const nvbench::summary *find_summary(const nvbench::state &state,
+                                                   std::string_view tag);
+[[nodiscard]] const nvbench::summary *
+find_summary(const std::vector<nvbench::summary> &summaries, std::string_view tag);
+[[nodiscard]] nvbench::summary *find_summary(std::vector<nvbench::summary> &summaries,
+                                             std::string_view tag);
+/// @}
+
+/// The summary of the first of `preferred_time_tags` that `state` has, or
+/// nullptr.
+[[nodiscard]] const nvbench::summary *find_time_summary(const nvbench::state &state);
+
+} // namespace nvbench::detail
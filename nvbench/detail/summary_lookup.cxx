@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary.cuh>
+
+#include <algorithm>
+
+namespace nvbench::detail
+{
+
+const nvbench::summary *find_summary(const nvbench::state &state, std::string_view tag)
+{
+  return find_summary(state.get_summaries(), tag);
+}
+
+const nvbench::summary *find_summary(const std::vector<nvbench::summary> &summaries,
+                                     std::string_view tag)
+{
+  const auto iter = std::find_if(summaries.cbegin(), summaries.cend(), [tag](const auto &summ) {
+    return summ.get_tag() == tag;
+  });
+  return iter == summaries.cend() ? nullptr : &*iter;
+}
+
+nvbench::summary *find_summary(std::vector<nvbench::summary> &summaries, std::string_view tag)
+{
+  const auto &const_summaries = summaries;
+  return const_cast<nvbench::summary *>(find_summary(const_summaries, tag));
+}
+
+const nvbench::summary *find_time_summary(const nvbench::state &state)
+{
+  for (const char *tag : preferred_time_tags)
+  {
+    if (const auto *summ = find_summary(state, tag))
+    {
+      return summ;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace nvbench::detail
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <functional>
+
+namespace nvbench
+{
+struct state;
+} // namespace nvbench
+
+namespace nvbench::detail
+{
+
+/**
+ * Effective resolution of the clock used by nvbench::cpu_timer.
+ *
+ * A clock is coarse if consecutive readings repeat; its resolution is then the
+ * smallest step between two consecutive distinct readings. Otherwise the clock
+ * advances between any two reads and its own period is reported, since the
+ * steps only measure the cost of a read.
+ *
+ * Times within a few ticks are quantized, so a mean of fewer than
+ * `min_ticks` ticks is flagged. The entropy stopping criterion bins its
+ * samples to the resolution of coarse clocks.
+ */
+struct timer_resolution
+{
+  /// CPU-only states whose mean time is less than this many ticks are flagged.
+  static constexpr nvbench::float64_t min_ticks = 100.;
+
+  /// nvbench::cpu_timer reports whole nanoseconds.
+  static constexpr nvbench::float64_t cpu_timer_precision = 1e-9;
+
+  /// In seconds. Measured on first use and cached for the process.
+  [[nodiscard]] static nvbench::float64_t get_cpu();
+
+  /// Whether the CPU timer is coarser than `cpu_timer_precision`.
+  [[nodiscard]] static bool is_cpu_coarse() { return get_cpu() > cpu_timer_precision; }
+
+  /// Measures the resolution of nvbench::cpu_timer's clock. See `measure`.
+  [[nodiscard]] static nvbench::float64_t measure_cpu(nvbench::int64_t max_steps = 100,
+                                                      nvbench::float64_t max_time = 0.01);
+
+  /// Measures the resolution of a clock whose readings in nanoseconds are
+  /// returned by `read_ns` and whose nominal period is `period` seconds.
+  /// Coarse clocks are measured from up to `max_steps` steps, taking no more
+  /// than about `max_time` seconds unless the clock is coarser.
+  [[nodiscard]] static nvbench::float64_t
+  measure(const std::function<nvbench::int64_t()> &read_ns,
+          nvbench::float64_t period,
+          nvbench::int64_t max_steps  = 100,
+          nvbench::float64_t max_time = 0.01);
+
+  /// Records `resolution` in `state` and flags the state if its mean CPU time
+  /// is less than `min_ticks` times the resolution.
+  static void add_summaries(nvbench::state &state,
+                            nvbench::float64_t resolution,
+                            nvbench::float64_t mean);
+};
+
+} // namespace nvbench::detail
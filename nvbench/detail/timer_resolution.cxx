@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/timer_resolution.cuh>
+#include <nvbench/printer_base.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace nvbench::detail
+{
+
+nvbench::float64_t timer_resolution::get_cpu()
+{
+  static const nvbench::float64_t resolution = timer_resolution::measure_cpu();
+  return resolution;
+}
+
+nvbench::float64_t timer_resolution::measure_cpu(nvbench::int64_t max_steps,
+                                                 nvbench::float64_t max_time)
+{
+  // Same clock and truncation to nanoseconds as nvbench::cpu_timer:
+  using clock        = std::chrono::high_resolution_clock;
+  const auto read_ns = []() {
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock::now().time_since_epoch());
+    return static_cast<nvbench::int64_t>(now.count());
+  };
+  const auto period = std::max(static_cast<nvbench::float64_t>(clock::period::num) /
+                                 static_cast<nvbench::float64_t>(clock::period::den),
+                               cpu_timer_precision);
+
+  return timer_resolution::measure(read_ns, period, max_steps, max_time);
+}
+
+nvbench::float64_t timer_resolution::measure(const std::function<nvbench::int64_t()> &read_ns,
+                                             nvbench::float64_t period,
+                                             nvbench::int64_t max_steps,
+                                             nvbench::float64_t max_time)
+{
+  const auto deadline = read_ns() + static_cast<nvbench::int64_t>(max_time * 1e9);
+
+  // Fine-grained clocks advance between any two reads:
+  {
+    constexpr int max_reads = 1000;
+
+    bool repeated = false;
+    auto prev     = read_ns();
+    for (int i = 0; i < max_reads && !repeated && prev < deadline; ++i)
+    {
+      const auto now = read_ns();
+      repeated       = now == prev;
+      prev           = now;
+    }
+    if (!repeated)
+    {
+      return period;
+    }
+  }
+
+  const auto wait_for_change = [&read_ns](nvbench::int64_t from) {
+    auto now = read_ns();
+    while (now == from)
+    {
+      now = read_ns();
+    }
+    return now;
+  };
+
+  auto min_step = std::numeric_limits<nvbench::int64_t>::max();
+  for (nvbench::int64_t i = 0; i < max_steps; ++i)
+  {
+    // The first change lands at an arbitrary point within a tick; only the
+    // step to the next change is a whole one:
+    const auto edge = wait_for_change(read_ns());
+    const auto next = wait_for_change(edge);
+
+    min_step = std::min(min_step, next - edge);
+
+    if (i > 0 && next >= deadline)
+    {
+      break;
+    }
+  }
+
+  return std::max(static_cast<nvbench::float64_t>(min_step) * 1e-9, period);
+}
+
+void timer_resolution::add_summaries(nvbench::state &state,
+                                     nvbench::float64_t resolution,
+                                     nvbench::float64_t mean)
+{
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/resolution",
+       "Timer Resolution",
+       "duration",
+       "Effective resolution of the CPU timer, measured at startup",
+       "Hidden by default."});
+    auto &summ = state.add_summary(desc);
+    summ.set_float64("value", resolution);
+  }
+
+  if (resolution <= 0. || mean >= min_ticks * resolution)
+  {
+    return;
+  }
+
+  const auto ticks = static_cast<nvbench::int64_t>(std::floor(mean / resolution));
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/cpu_only/time/ticks",
+       "Timer Ticks",
+       {},
+       "Mean CPU time in timer ticks; only reported when too few to time accurately"});
+    auto &summ = state.add_summary(desc);
+    summ.set_int64("value", ticks);
+  }
+
+  if (auto printer_opt_ref = state.get_benchmark().get_printer(); printer_opt_ref.has_value())
+  {
+    printer_opt_ref.value().get().log(
+      nvbench::log_level::warn,
+      fmt::format("{}: Mean CPU time ({:.4g}s) is only {}x the timer resolution ({:.4g}s), so the "
+                  "samples are quantized. Time more work per sample for accurate results.",
+                  state.get_short_description(),
+                  mean,
+                  ticks,
+                  resolution));
+  }
+}
+
+} // namespace nvbench::detail
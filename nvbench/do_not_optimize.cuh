@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime_api.h> // __forceinline__
+
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace nvbench
+{
+
+#if defined(_MSC_VER) && !defined(__clang__)
+namespace detail
+{
+// Storing an address here forces the value to be materialized in memory:
+inline const volatile void *volatile do_not_optimize_sink{};
+} // namespace detail
+#endif
+
+/**
+ * Optimization barriers for CPU-only benchmarks.
+ *
+ * `do_not_optimize(value)` forces `value` to be computed and treats it as
+ * read and possibly modified, so the compiler can neither drop the work that
+ * produced it nor hoist that work out of the timed region. Pass the result
+ * of each timed operation, or the object it modified.
+ *
+ * `clobber_memory()` forces all pending writes to memory to be performed, for
+ * benchmarks whose only effect is writing to a buffer.
+ *
+ * Neither emits any instructions; they only constrain the compiler. States
+ * whose time can't be distinguished from an empty launch are reported by the
+ * runner, see the "Optimization Barriers" section of the docs.
+ * @{
+ */
+template <typename T>
+__forceinline__ void do_not_optimize(const T &value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  nvbench::detail::do_not_optimize_sink = &value;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+template <typename T>
+__forceinline__ void do_not_optimize(T &value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  nvbench::detail::do_not_optimize_sink = &value;
+  _ReadWriteBarrier();
+#else
+  if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(T *))
+  {
+    asm volatile("" : "+r"(value) : : "memory");
+  }
+  else
+  {
+    asm volatile("" : "+m"(value) : : "memory");
+  }
+#endif
+}
+
+__forceinline__ void clobber_memory()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : : "memory");
+#endif
+}
+/** @} */
+
+} // namespace nvbench
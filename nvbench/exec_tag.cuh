@@ -37,6 +37,7 @@ enum class exec_flag : std::uint16_t
   gpu           = 0x04, // Don't instantiate `measure_cpu_only`.
   no_gpu        = 0x08, // No GPU measurements should be instantiated.
   no_batch      = 0x10, // `measure_hot` will not be used.
+  async         = 0x20, // KernelLauncher reports completion asynchronously
   modifier_mask = 0xFF,
 
   // Measurement types to instantiate. Derived from modifiers.
@@ -100,6 +101,7 @@ using sync_t          = tag<nvbench::detail::exec_flag::sync>;
 using gpu_t           = tag<nvbench::detail::exec_flag::gpu>;
 using no_gpu_t        = tag<nvbench::detail::exec_flag::no_gpu>;
 using no_batch_t      = tag<nvbench::detail::exec_flag::no_batch>;
+using async_t         = tag<nvbench::detail::exec_flag::async>;
 using modifier_mask_t = tag<nvbench::detail::exec_flag::modifier_mask>;
 
 using hot_t          = tag<nvbench::detail::exec_flag::hot>;
@@ -113,6 +115,7 @@ constexpr inline sync_t sync;
 constexpr inline gpu_t gpu;
 constexpr inline no_gpu_t no_gpu;
 constexpr inline no_batch_t no_batch;
+constexpr inline async_t async;
 constexpr inline modifier_mask_t modifier_mask;
 
 constexpr inline cold_t cold;
@@ -147,4 +150,14 @@ constexpr inline auto no_gpu = nvbench::exec_tag::impl::no_gpu;
 /// measurement code from being instantiated.
 constexpr inline auto gpu = nvbench::exec_tag::impl::gpu;
 
+/// Modifier for CPU-only benchmarks whose launchers start asynchronous
+/// operations, such as thread pool tasks, I/O or coroutines. The launcher
+/// either takes an `nvbench::async_completion` and calls it from any thread
+/// when the operation completes, or returns a `std::future`-like handle.
+/// Reports the submission-to-completion latency and the throughput with up to
+/// `benchmark_base::set_async_depth` operations in flight.
+constexpr inline auto async = nvbench::exec_tag::impl::async | //
+                              nvbench::exec_tag::impl::no_batch |
+                              nvbench::exec_tag::impl::no_gpu;
+
 } // namespace nvbench::exec_tag
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace nvbench
+{
+
+/**
+ * Customization point for the size of fixtures stored in the
+ * `nvbench::fixture_cache`. Containers with a `size()` member and a
+ * `value_type` (`std::vector`, `thrust::device_vector`, ...) report
+ * `size() * sizeof(value_type)`; other types report `sizeof(T)`. Specialize
+ * this for types that own memory in other ways.
+ */
+template <typename T, typename = void>
+struct fixture_traits
+{
+  [[nodiscard]] static std::size_t get_bytes(const T &) { return sizeof(T); }
+};
+
+template <typename T>
+struct fixture_traits<
+  T,
+  std::void_t<typename T::value_type, decltype(std::declval<const T &>().size())>>
+{
+  [[nodiscard]] static std::size_t get_bytes(const T &value)
+  {
+    return static_cast<std::size_t>(value.size()) * sizeof(typename T::value_type);
+  }
+};
+
+/**
+ * Memoizes benchmark fixtures, such as large randomly generated inputs,
+ * across the states of a benchmark. Use it through
+ * `nvbench::state::get_fixture`, which builds the key from the fixture's
+ * name and type, the state's device and type configuration and the values of
+ * the benchmark's fixture axes.
+ *
+ * Entries are evicted in least-recently-used order to keep the total size
+ * within the budget passed to `insert`. Evicted fixtures that are still used
+ * by the running state stay alive until it finishes. The runner clears the
+ * cache after each benchmark.
+ */
+struct fixture_cache
+{
+  [[nodiscard]] static fixture_cache &get();
+
+  fixture_cache(const fixture_cache &)            = delete;
+  fixture_cache(fixture_cache &&)                 = delete;
+  fixture_cache &operator=(const fixture_cache &) = delete;
+  fixture_cache &operator=(fixture_cache &&)      = delete;
+
+  /// Returns the entry for `key` and marks it as most recently used, or
+  /// nullptr if there is none.
+  [[nodiscard]] std::shared_ptr<void> find(const std::string &key);
+
+  /// Caches `value`, evicting the least recently used entries until the total
+  /// size is within `budget` bytes. Values larger than `budget` are not
+  /// cached.
+  void insert(const std::string &key,
+              std::shared_ptr<void> value,
+              std::size_t bytes,
+              std::size_t budget);
+
+  /// Removes all entries and resets the statistics.
+  void clear();
+
+  [[nodiscard]] std::size_t get_size() const;
+  [[nodiscard]] std::size_t get_bytes() const;
+
+  /// Statistics since the last `clear()`. @{
+  [[nodiscard]] nvbench::int64_t get_hits() const;
+  [[nodiscard]] nvbench::int64_t get_misses() const;
+  [[nodiscard]] nvbench::int64_t get_evictions() const;
+  /// @}
+
+private:
+  fixture_cache() = default;
+
+  struct entry
+  {
+    std::string key;
+    std::shared_ptr<void> value;
+    std::size_t bytes;
+  };
+
+  void evict(std::size_t budget);
+
+  mutable std::mutex m_mutex;
+
+  // Most recently used first:
+  std::list<entry> m_entries;
+  std::unordered_map<std::string, std::list<entry>::iterator> m_index;
+  std::size_t m_bytes{};
+
+  nvbench::int64_t m_hits{};
+  nvbench::int64_t m_misses{};
+  nvbench::int64_t m_evictions{};
+};
+
+} // namespace nvbench
@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/fixture_cache.cuh>
+
+#include <utility>
+
+namespace nvbench
+{
+
+fixture_cache &fixture_cache::get()
+{
+  static fixture_cache the_cache;
+  return the_cache;
+}
+
+std::shared_ptr<void> fixture_cache::find(const std::string &key)
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  auto iter = m_index.find(key);
+  if (iter == m_index.end())
+  {
+    ++m_misses;
+    return {};
+  }
+
+  ++m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, iter->second);
+  return iter->second->value;
+}
+
+void fixture_cache::insert(const std::string &key,
+                           std::shared_ptr<void> value,
+                           std::size_t bytes,
+                           std::size_t budget)
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  if (auto iter = m_index.find(key); iter != m_index.end())
+  {
+    m_bytes -= iter->second->bytes;
+    m_entries.erase(iter->second);
+    m_index.erase(iter);
+  }
+
+  if (bytes > budget)
+  {
+    return;
+  }
+
+  this->evict(budget - bytes);
+  m_entries.push_front({key, std::move(value), bytes});
+  m_index.emplace(key, m_entries.begin());
+  m_bytes += bytes;
+}
+
+void fixture_cache::evict(std::size_t budget)
+{
+  while (m_bytes > budget && !m_entries.empty())
+  {
+    const auto &lru = m_entries.back();
+    m_bytes -= lru.bytes;
+    m_index.erase(lru.key);
+    m_entries.pop_back();
+    ++m_evictions;
+  }
+}
+
+void fixture_cache::clear()
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_index.clear();
+  m_entries.clear();
+  m_bytes     = 0;
+  m_hits      = 0;
+  m_misses    = 0;
+  m_evictions = 0;
+}
+
+std::size_t fixture_cache::get_size() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_entries.size();
+}
+
+std::size_t fixture_cache::get_bytes() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_bytes;
+}
+
+nvbench::int64_t fixture_cache::get_hits() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_hits;
+}
+
+nvbench::int64_t fixture_cache::get_misses() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_misses;
+}
+
+nvbench::int64_t fixture_cache::get_evictions() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_evictions;
+}
+
+} // namespace nvbench
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nvbench
+{
+
+/**
+ * Page-backed host memory for benchmarks that are sensitive to TLB misses
+ * and page faults. Use it through `nvbench::state::allocate_host_buffer`.
+ *
+ * Buffers are aligned as requested and are always pre-faulted, so the first
+ * timed pass doesn't pay for page faults. Depending on the page mode they are
+ * backed by:
+ *
+ * - `none`: Base pages.
+ * - `transparent`: Transparent huge pages, requested with
+ *   `madvise(MADV_HUGEPAGE)` on a region aligned to the huge page size.
+ * - `hugetlb`: Pages from the hugetlbfs pool (`MAP_HUGETLB`). Falls back to
+ *   `transparent` if no huge pages are reserved.
+ *
+ * The kernel may not honor the request, so the page size actually obtained
+ * is read back from `/proc/self/smaps` and reported with each buffer.
+ *
+ * Released buffers are kept and handed out again for requests that fit, so
+ * that the states of a benchmark don't pay for mapping and faulting the same
+ * memory repeatedly. Recycled buffers keep their previous contents. The
+ * runner clears the pool after each benchmark.
+ *
+ * Huge pages are only supported on Linux. Elsewhere, buffers come from the
+ * aligned `operator new` and are reported with a page size of zero.
+ */
+struct host_buffer_pool
+{
+  enum class page_mode
+  {
+    none,
+    transparent,
+    hugetlb
+  };
+
+  struct buffer
+  {
+    void *data{};
+    // Usable size, which may exceed the requested size:
+    std::size_t capacity{};
+    std::size_t alignment{};
+    page_mode mode{page_mode::none};
+    // Smallest page size backing the buffer, or 0 if unknown:
+    std::size_t page_size{};
+    // Whether `data` was mapped with mmap or allocated with operator new:
+    bool is_mapped{};
+  };
+
+  [[nodiscard]] static host_buffer_pool &get();
+
+  /// Parses "none", "transparent" or "hugetlb". @{
+  [[nodiscard]] static page_mode parse_page_mode(const std::string &mode);
+  [[nodiscard]] static std::string to_string(page_mode mode);
+  /// @}
+
+  host_buffer_pool(const host_buffer_pool &)            = delete;
+  host_buffer_pool(host_buffer_pool &&)                 = delete;
+  host_buffer_pool &operator=(const host_buffer_pool &) = delete;
+  host_buffer_pool &operator=(host_buffer_pool &&)      = delete;
+
+  /// Returns the smallest free buffer with the same mode that holds `bytes`
+  /// with the requested alignment, or a new pre-faulted buffer if there is
+  /// none. `alignment` must be a power of two.
+  [[nodiscard]] buffer acquire(std::size_t bytes, std::size_t alignment, page_mode mode);
+
+  /// Returns `buf` to the pool for reuse.
+  void release(buffer buf);
+
+  /// Frees all buffers in the pool and resets the statistics.
+  void clear();
+
+  [[nodiscard]] std::size_t get_size() const;
+  [[nodiscard]] std::size_t get_bytes() const;
+
+  /// Statistics since the last `clear()`. @{
+  [[nodiscard]] nvbench::int64_t get_reused() const;
+  [[nodiscard]] nvbench::int64_t get_allocated() const;
+  /// @}
+
+  /// Frees the memory of a buffer that isn't in the pool.
+  static void free(buffer &buf);
+
+private:
+  host_buffer_pool() = default;
+  ~host_buffer_pool();
+
+  mutable std::mutex m_mutex;
+  std::vector<buffer> m_free;
+
+  nvbench::int64_t m_reused{};
+  nvbench::int64_t m_allocated{};
+};
+
+} // namespace nvbench
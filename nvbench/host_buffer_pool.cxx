@@ -0,0 +1,393 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/host_buffer_pool.cuh>
+
+#include <nvbench/detail/throw.cuh>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+using page_mode = nvbench::host_buffer_pool::page_mode;
+
+constexpr std::size_t default_huge_page_size = std::size_t{2} << 20;
+
+std::size_t round_up(std::size_t value, std::size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+std::size_t get_base_page_size()
+{
+#ifdef __linux__
+  static const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+#else
+  return 4096;
+#endif
+}
+
+#ifdef __linux__
+
+// Size of transparent huge pages:
+std::size_t get_thp_size()
+{
+  static const std::size_t size = [] {
+    std::ifstream file{"/sys/kernel/mm/transparent_hugepage/hpage_pmd_size"};
+    std::size_t value{};
+    return (file >> value) && value > 0 ? value : default_huge_page_size;
+  }();
+  return size;
+}
+
+// Default size of hugetlbfs pages:
+std::size_t get_hugetlb_size()
+{
+  static const std::size_t size = [] {
+    std::ifstream file{"/proc/meminfo"};
+    std::string line;
+    while (std::getline(file, line))
+    {
+      std::size_t kib{};
+      if (std::sscanf(line.c_str(), "Hugepagesize: %zu kB", &kib) == 1 && kib > 0)
+      {
+        return kib * 1024;
+      }
+    }
+    return default_huge_page_size;
+  }();
+  return size;
+}
+
+// Maps `size` bytes aligned to `alignment`. Both must be multiples of
+// `granule`, the unit that munmap accepts for this mapping.
+void *map_aligned(std::size_t size, std::size_t alignment, std::size_t granule, int extra_flags)
+{
+  const auto padding      = alignment > granule ? alignment - granule : 0;
+  const auto mapping_size = size + padding;
+  void *mapping           = mmap(nullptr,
+                       mapping_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | extra_flags,
+                       -1,
+                       0);
+  if (mapping == MAP_FAILED)
+  {
+    return nullptr;
+  }
+
+  // Trim the unaligned head and the excess tail:
+  const auto begin   = reinterpret_cast<std::uintptr_t>(mapping);
+  const auto aligned = round_up(begin, alignment);
+  const auto head    = aligned - begin;
+  const auto tail    = mapping_size - head - size;
+  if (head > 0)
+  {
+    munmap(mapping, head);
+  }
+  if (tail > 0)
+  {
+    munmap(reinterpret_cast<void *>(aligned + size), tail);
+  }
+  return reinterpret_cast<void *>(aligned);
+}
+
+// Reads the page size backing [data, data + size) from /proc/self/smaps.
+// Transparent huge pages are only reported if they back the whole mapping.
+std::size_t read_page_size(const void *data)
+{
+  const auto address = reinterpret_cast<std::uintptr_t>(data);
+
+  std::ifstream file{"/proc/self/smaps"};
+  std::string line;
+  bool found{false};
+  std::size_t vma_size{};
+  std::size_t kernel_page_kib{};
+  std::size_t anon_huge_kib{};
+  while (std::getline(file, line))
+  {
+    unsigned long begin{};
+    unsigned long end{};
+    std::size_t kib{};
+    if (std::sscanf(line.c_str(), "%lx-%lx ", &begin, &end) == 2 &&
+        line.find(':') > line.find(' '))
+    {
+      // Header of the next mapping:
+      if (found)
+      {
+        break;
+      }
+      found    = address >= begin && address < end;
+      vma_size = end - begin;
+    }
+    else if (!found)
+    {
+      continue;
+    }
+    else if (std::sscanf(line.c_str(), "KernelPageSize: %zu kB", &kib) == 1)
+    {
+      kernel_page_kib = kib;
+    }
+    else if (std::sscanf(line.c_str(), "AnonHugePages: %zu kB", &kib) == 1)
+    {
+      anon_huge_kib = kib;
+    }
+  }
+
+  if (!found || kernel_page_kib == 0)
+  {
+    return 0;
+  }
+  if (kernel_page_kib * 1024 > get_base_page_size())
+  {
+    return kernel_page_kib * 1024; // hugetlbfs
+  }
+  if (anon_huge_kib * 1024 >= vma_size)
+  {
+    return get_thp_size();
+  }
+  return kernel_page_kib * 1024;
+}
+
+#endif // __linux__
+
+nvbench::host_buffer_pool::buffer allocate(std::size_t bytes, std::size_t alignment, page_mode mode)
+{
+  nvbench::host_buffer_pool::buffer buf;
+  buf.mode = mode;
+
+  const auto base_page = get_base_page_size();
+
+#ifdef __linux__
+  if (mode == page_mode::hugetlb)
+  {
+    const auto huge_page = get_hugetlb_size();
+    buf.alignment        = std::max(alignment, huge_page);
+    buf.capacity         = round_up(bytes, huge_page);
+    buf.data             = map_aligned(buf.capacity, buf.alignment, huge_page, MAP_HUGETLB);
+  }
+  if (mode == page_mode::transparent || (mode == page_mode::hugetlb && !buf.data))
+  {
+    // Aligning to the huge page size lets every page of the buffer be huge:
+    const auto huge_page = get_thp_size();
+    buf.alignment        = std::max(alignment, huge_page);
+    buf.capacity         = round_up(bytes, huge_page);
+    buf.data             = map_aligned(buf.capacity, buf.alignment, base_page, 0);
+    if (buf.data)
+    {
+      // Not fatal; the kernel may have THP disabled:
+      madvise(buf.data, buf.capacity, MADV_HUGEPAGE);
+    }
+  }
+  if (mode == page_mode::none)
+  {
+    buf.alignment = std::max(alignment, base_page);
+    buf.capacity  = round_up(bytes, base_page);
+    buf.data      = map_aligned(buf.capacity, buf.alignment, base_page, 0);
+  }
+  NVBENCH_THROW_IF(buf.data == nullptr,
+                   std::runtime_error,
+                   "Failed to map a {} byte host buffer: {}",
+                   buf.capacity,
+                   std::strerror(errno));
+  buf.is_mapped = true;
+#else
+  buf.alignment = alignment;
+  buf.capacity  = round_up(bytes, alignment);
+  buf.data      = ::operator new(buf.capacity, std::align_val_t{buf.alignment});
+#endif
+
+  // Fault in every page now so that the first timed pass doesn't:
+  auto *bytes_ptr = static_cast<volatile unsigned char *>(buf.data);
+  for (std::size_t offset = 0; offset < buf.capacity; offset += base_page)
+  {
+    bytes_ptr[offset] = 0;
+  }
+
+#ifdef __linux__
+  buf.page_size = read_page_size(buf.data);
+#endif
+
+  return buf;
+}
+
+} // namespace
+
+namespace nvbench
+{
+
+host_buffer_pool &host_buffer_pool::get()
+{
+  static host_buffer_pool the_pool;
+  return the_pool;
+}
+
+host_buffer_pool::page_mode host_buffer_pool::parse_page_mode(const std::string &mode)
+{
+  if (mode == "none")
+  {
+    return page_mode::none;
+  }
+  else if (mode == "transparent")
+  {
+    return page_mode::transparent;
+  }
+  else if (mode == "hugetlb")
+  {
+    return page_mode::hugetlb;
+  }
+  NVBENCH_THROW(std::runtime_error,
+                "Invalid huge page mode '{}'. Expected 'none', 'transparent' or 'hugetlb'.",
+                mode);
+}
+
+std::string host_buffer_pool::to_string(page_mode mode)
+{
+  switch (mode)
+  {
+    case page_mode::transparent:
+      return "transparent";
+    case page_mode::hugetlb:
+      return "hugetlb";
+    case page_mode::none:
+    default:
+      return "none";
+  }
+}
+
+host_buffer_pool::~host_buffer_pool() { this->clear(); }
+
+host_buffer_pool::buffer
+host_buffer_pool::acquire(std::size_t bytes, std::size_t alignment, page_mode mode)
+{
+  NVBENCH_THROW_IF(alignment == 0 || (alignment & (alignment - 1)) != 0,
+                   std::runtime_error,
+                   "Host buffer alignment must be a power of two, got {}.",
+                   alignment);
+  bytes = std::max(bytes, std::size_t{1});
+
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto best = m_free.end();
+    for (auto iter = m_free.begin(); iter != m_free.end(); ++iter)
+    {
+      if (iter->mode == mode && iter->capacity >= bytes && iter->alignment >= alignment &&
+          (best == m_free.end() || iter->capacity < best->capacity))
+      {
+        best = iter;
+      }
+    }
+    if (best != m_free.end())
+    {
+      auto buf = *best;
+      m_free.erase(best);
+      ++m_reused;
+      return buf;
+    }
+    ++m_allocated;
+  }
+
+  // Mapping and faulting may take a while, so don't hold the lock:
+  return ::allocate(bytes, alignment, mode);
+}
+
+void host_buffer_pool::release(buffer buf)
+{
+  if (buf.data)
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_free.push_back(buf);
+  }
+}
+
+void host_buffer_pool::clear()
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  for (auto &buf : m_free)
+  {
+    host_buffer_pool::free(buf);
+  }
+  m_free.clear();
+  m_reused    = 0;
+  m_allocated = 0;
+}
+
+std::size_t host_buffer_pool::get_size() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_free.size();
+}
+
+std::size_t host_buffer_pool::get_bytes() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  std::size_t bytes{};
+  for (const auto &buf : m_free)
+  {
+    bytes += buf.capacity;
+  }
+  return bytes;
+}
+
+nvbench::int64_t host_buffer_pool::get_reused() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_reused;
+}
+
+nvbench::int64_t host_buffer_pool::get_allocated() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_allocated;
+}
+
+void host_buffer_pool::free(buffer &buf)
+{
+  if (!buf.data)
+  {
+    return;
+  }
+#ifdef __linux__
+  if (buf.is_mapped)
+  {
+    munmap(buf.data, buf.capacity);
+  }
+  else
+#endif
+  {
+    ::operator delete(buf.data, std::align_val_t{buf.alignment});
+  }
+  buf.data = nullptr;
+}
+
+} // namespace nvbench
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace nvbench
+{
+
+/**
+ * Sizes of the host's data caches, used to place working-set sizes relative
+ * to the cache hierarchy instead of hard-coding them per machine.
+ *
+ * On Linux, the data and unified caches of CPU 0 are read from sysfs, falling
+ * back to `sysconf`. Instruction caches are ignored. Elsewhere, or if nothing
+ * is found, no cache is known and resolving a cache-relative size throws.
+ */
+struct host_caches
+{
+  /// The caches of this host, detected on first use.
+  [[nodiscard]] static const host_caches &get();
+
+  /// `sizes[i]` is the size in bytes of the level `i + 1` cache, or 0 if
+  /// unknown.
+  explicit host_caches(std::vector<nvbench::int64_t> sizes);
+
+  /// Size of the level `level` cache in bytes, or 0 if unknown.
+  [[nodiscard]] nvbench::int64_t get_size(std::size_t level) const;
+
+  /// Level of the last-level cache, or 0 if no cache is known.
+  [[nodiscard]] std::size_t get_llc_level() const;
+  [[nodiscard]] nvbench::int64_t get_llc_size() const;
+
+  /// Resolves a size in bytes: `<factor>x<cache>` or `<factor>*<cache>`,
+  /// where `<cache>` is `L1`, `L2`, `L3`, `L4` or `LLC`, e.g. "0.5xL1" or
+  /// "4xLLC". The factor may be omitted, and a plain number is a size in
+  /// bytes. Throws `std::runtime_error` for invalid input or unknown caches.
+  [[nodiscard]] nvbench::int64_t resolve(const std::string &spec) const;
+
+  /// Summary of the known caches, e.g. "L1=48KiB L2=2MiB L3=300MiB".
+  [[nodiscard]] std::string to_string() const;
+
+private:
+  std::vector<nvbench::int64_t> m_sizes;
+};
+
+/// `count` sizes in bytes from `start` to `end`, spaced geometrically, where
+/// both are resolved with `host_caches::get().resolve()`, e.g.
+/// `cache_range("0.5xL1", "4xLLC", 16)`. See also `nvbench::geometric_range`.
+[[nodiscard]] std::vector<nvbench::int64_t>
+cache_range(const std::string &start, const std::string &end, std::size_t count);
+
+} // namespace nvbench
@@ -0,0 +1,244 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/host_caches.cuh>
+#include <nvbench/range.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <regex>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+#ifdef __linux__
+// Parses sysfs sizes such as "48K" or "300M":
+nvbench::int64_t parse_sysfs_size(const std::string &size)
+{
+  std::size_t pos{};
+  const auto value = std::stoll(size, &pos);
+  switch (pos < size.size() ? std::toupper(static_cast<unsigned char>(size[pos])) : 0)
+  {
+    case 'K':
+      return value << 10;
+    case 'M':
+      return value << 20;
+    case 'G':
+      return value << 30;
+    default:
+      return value;
+  }
+}
+
+std::vector<nvbench::int64_t> read_sysfs_sizes()
+{
+  std::vector<nvbench::int64_t> sizes;
+  for (int index = 0;; ++index)
+  {
+    const auto dir = fmt::format("/sys/devices/system/cpu/cpu0/cache/index{}/", index);
+    std::ifstream level_file{dir + "level"};
+    std::ifstream type_file{dir + "type"};
+    std::ifstream size_file{dir + "size"};
+    std::size_t level{};
+    std::string type;
+    std::string size;
+    if (!(level_file >> level) || !(type_file >> type) || !(size_file >> size))
+    {
+      break;
+    }
+    if (type == "Instruction" || level == 0)
+    {
+      continue;
+    }
+    try
+    {
+      sizes.resize(std::max(sizes.size(), level));
+      sizes[level - 1] = ::parse_sysfs_size(size);
+    }
+    catch (std::exception &)
+    {}
+  }
+  return sizes;
+}
+
+std::vector<nvbench::int64_t> read_sysconf_sizes()
+{
+  std::vector<nvbench::int64_t> sizes;
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+  for (const int name : {_SC_LEVEL1_DCACHE_SIZE,
+                         _SC_LEVEL2_CACHE_SIZE,
+                         _SC_LEVEL3_CACHE_SIZE,
+                         _SC_LEVEL4_CACHE_SIZE})
+  {
+    const long size = sysconf(name);
+    sizes.push_back(size > 0 ? size : 0);
+  }
+#endif
+  return sizes;
+}
+#endif
+
+std::vector<nvbench::int64_t> detect_sizes()
+{
+  std::vector<nvbench::int64_t> sizes;
+#ifdef __linux__
+  sizes = ::read_sysfs_sizes();
+  if (sizes.empty())
+  {
+    sizes = ::read_sysconf_sizes();
+  }
+#endif
+  return sizes;
+}
+
+std::string format_size(nvbench::int64_t bytes)
+{
+  if (bytes >= (nvbench::int64_t{1} << 20) && bytes % (nvbench::int64_t{1} << 20) == 0)
+  {
+    return fmt::format("{}MiB", bytes >> 20);
+  }
+  if (bytes >= (nvbench::int64_t{1} << 10) && bytes % (nvbench::int64_t{1} << 10) == 0)
+  {
+    return fmt::format("{}KiB", bytes >> 10);
+  }
+  return fmt::format("{}B", bytes);
+}
+
+} // namespace
+
+namespace nvbench
+{
+
+const host_caches &host_caches::get()
+{
+  static const host_caches caches{::detect_sizes()};
+  return caches;
+}
+
+host_caches::host_caches(std::vector<nvbench::int64_t> sizes)
+    : m_sizes{std::move(sizes)}
+{}
+
+nvbench::int64_t host_caches::get_size(std::size_t level) const
+{
+  return level >= 1 && level <= m_sizes.size() ? m_sizes[level - 1] : 0;
+}
+
+std::size_t host_caches::get_llc_level() const
+{
+  for (std::size_t level = m_sizes.size(); level >= 1; --level)
+  {
+    if (m_sizes[level - 1] > 0)
+    {
+      return level;
+    }
+  }
+  return 0;
+}
+
+nvbench::int64_t host_caches::get_llc_size() const
+{
+  return this->get_size(this->get_llc_level());
+}
+
+nvbench::int64_t host_caches::resolve(const std::string &spec) const
+{
+  static const std::regex cache_regex{"^\\s*"
+                                      "(?:([^xX*\\s]+)\\s*[xX*]\\s*)?" // Factor
+                                      "(L[1-4]|LLC)"                   // Cache
+                                      "\\s*$",
+                                      std::regex::icase};
+
+  auto parse_number = [&spec](const std::string &input) {
+    std::size_t pos{};
+    nvbench::float64_t value{};
+    try
+    {
+      value = std::stod(input, &pos);
+    }
+    catch (std::exception &)
+    {}
+    while (pos < input.size() && std::isspace(static_cast<unsigned char>(input[pos])))
+    {
+      ++pos;
+    }
+    NVBENCH_THROW_IF(pos == 0 || pos != input.size() || !(value > 0.),
+                     std::runtime_error,
+                     "Invalid cache-relative size '{}'. Expected e.g. '0.5xL1', '4xLLC' or a "
+                     "number of bytes.",
+                     spec);
+    return value;
+  };
+
+  std::smatch match;
+  if (!std::regex_match(spec, match, cache_regex))
+  {
+    return static_cast<nvbench::int64_t>(std::llround(parse_number(spec)));
+  }
+
+  const auto factor = match[1].matched ? parse_number(match[1].str()) : 1.;
+  const auto cache  = match[2].str();
+  const auto level  = std::toupper(static_cast<unsigned char>(cache[1])) == 'L'
+                        ? this->get_llc_level()
+                        : static_cast<std::size_t>(cache[1] - '0');
+  const auto size   = this->get_size(level);
+  NVBENCH_THROW_IF(size == 0,
+                   std::runtime_error,
+                   "Cache {} of '{}' was not detected on this host. Known caches: {}",
+                   cache,
+                   spec,
+                   this->to_string());
+  const auto bytes = factor * static_cast<nvbench::float64_t>(size);
+  return static_cast<nvbench::int64_t>(std::llround(bytes));
+}
+
+std::string host_caches::to_string() const
+{
+  std::string result;
+  for (std::size_t level = 1; level <= m_sizes.size(); ++level)
+  {
+    if (m_sizes[level - 1] > 0)
+    {
+      result += fmt::format("{}L{}={}",
+                            result.empty() ? "" : " ",
+                            level,
+                            ::format_size(m_sizes[level - 1]));
+    }
+  }
+  return result.empty() ? "none" : result;
+}
+
+std::vector<nvbench::int64_t>
+cache_range(const std::string &start, const std::string &end, std::size_t count)
+{
+  const auto &caches = nvbench::host_caches::get();
+  return nvbench::geometric_range(caches.resolve(start), caches.resolve(end), count);
+}
+
+} // namespace nvbench
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace nvbench
+{
+
+/**
+ * Type-erased part of `nvbench::input_pool`. The measurements use this
+ * interface to refresh consumed copies between trials or batches, outside of
+ * the timed region.
+ */
+struct input_pool_base
+{
+  explicit input_pool_base(std::size_t size);
+  virtual ~input_pool_base();
+
+  // Copies are handed out by reference:
+  input_pool_base(const input_pool_base &)            = delete;
+  input_pool_base(input_pool_base &&)                 = delete;
+  input_pool_base &operator=(const input_pool_base &) = delete;
+  input_pool_base &operator=(input_pool_base &&)      = delete;
+
+  /// Number of copies in the pool.
+  [[nodiscard]] std::size_t get_size() const { return m_size; }
+
+  /// Number of copies that may be taken before the next refresh.
+  [[nodiscard]] std::size_t get_remaining() const { return m_size - m_next; }
+
+  /// Number of times the consumed copies have been regenerated.
+  [[nodiscard]] nvbench::int64_t get_refresh_count() const { return m_refresh_count; }
+
+  /// Regenerates the copies taken since the last refresh.
+  void refresh();
+
+protected:
+  [[nodiscard]] std::size_t take()
+  {
+    if (m_next == m_size)
+    {
+      this->throw_exhausted();
+    }
+    return m_next++;
+  }
+
+  void generate_all();
+
+private:
+  virtual void generate(std::size_t index) = 0;
+
+  [[noreturn]] void throw_exhausted() const;
+
+  std::size_t m_size;
+  std::size_t m_next{};
+  nvbench::int64_t m_refresh_count{};
+};
+
+/**
+ * A pool of independently generated copies of a benchmark's input, for
+ * benchmarks that modify their input in place (in-place sorts, hash table
+ * insertions, ...).
+ *
+ * Each call to `next()` returns a fresh copy. The measurements regenerate
+ * consumed copies with the user's generator between trials and between hot
+ * batches, outside of the timed region, so every timed invocation sees
+ * unmodified input. Hot batches are limited to the pool size; larger pools
+ * allow longer batches at the cost of memory.
+ *
+ * Create pools with `nvbench::state::add_input_pool`:
+ *
+ * ```cpp
+ * thrust::device_vector<int> keys = make_random_keys(n);
+ * auto &pool = state.add_input_pool<thrust::device_vector<int>>(
+ *   16,
+ *   [&keys](thrust::device_vector<int> &copy, std::size_t) { copy = keys; });
+ *
+ * state.exec([&pool](nvbench::launch &launch) {
+ *   auto &input = pool.next();
+ *   thrust::sort(thrust::device.on(launch.get_stream()), input.begin(), input.end());
+ * });
+ * ```
+ *
+ * The generator receives the copy to overwrite and its index in the pool. Its
+ * work must be complete when it returns. Each launch should call `next()` at
+ * most once per pool; an exception is thrown if the pool runs out of copies.
+ */
+template <typename T>
+struct input_pool final : input_pool_base
+{
+  using value_type     = T;
+  using generator_type = std::function<void(T &copy, std::size_t index)>;
+
+  input_pool(std::size_t size, generator_type generator)
+      : input_pool_base{size}
+      , m_copies(size)
+      , m_generator{std::move(generator)}
+  {
+    this->generate_all();
+  }
+
+  /// Returns the next unused copy.
+  [[nodiscard]] T &next() { return m_copies[this->take()]; }
+
+private:
+  void generate(std::size_t index) override { m_generator(m_copies[index], index); }
+
+  std::vector<T> m_copies;
+  generator_type m_generator;
+};
+
+} // namespace nvbench
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/input_pool.cuh>
+
+#include <stdexcept>
+
+namespace nvbench
+{
+
+input_pool_base::input_pool_base(std::size_t size)
+    : m_size{size}
+{
+  NVBENCH_THROW_IF(size == 0, std::runtime_error, "{}", "An input pool needs at least one copy.");
+}
+
+input_pool_base::~input_pool_base() = default;
+
+void input_pool_base::refresh()
+{
+  if (m_next == 0)
+  {
+    return;
+  }
+
+  for (std::size_t index = 0; index < m_next; ++index)
+  {
+    this->generate(index);
+  }
+  m_next = 0;
+  ++m_refresh_count;
+}
+
+void input_pool_base::generate_all()
+{
+  for (std::size_t index = 0; index < m_size; ++index)
+  {
+    this->generate(index);
+  }
+}
+
+void input_pool_base::throw_exhausted() const
+{
+  NVBENCH_THROW(std::runtime_error,
+                "All {} copies of an input pool were used before it was refreshed. Each launch "
+                "may take at most one copy from each pool.",
+                m_size);
+}
+
+} // namespace nvbench
@@ -20,6 +20,7 @@
 #include <nvbench/benchmark_base.cuh>
 #include <nvbench/config.cuh>
 #include <nvbench/detail/throw.cuh>
+#include <nvbench/detail/timer_resolution.cuh>
 #include <nvbench/device_info.cuh>
 #include <nvbench/device_manager.cuh>
 #include <nvbench/git_revision.cuh>
@@ -32,6 +33,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <iterator>
@@ -106,6 +108,78 @@ void write_named_values(JsonNode &node, const nvbench::named_values &values)
   } // end foreach value name
 }
 
+// Summaries created from a registered descriptor only write their tag, a
+// "descriptor" marker and their values; the descriptor is listed once in the
+// file's "summary_descriptors". The marker keeps ad-hoc summaries that reuse a
+// registered tag from picking up its metadata.
+template <typename JsonNode>
+void write_summaries(JsonNode &node,
+                     const std::vector<nvbench::summary> &summaries,
+                     std::vector<const nvbench::summary_descriptor *> &descriptors)
+{
+  for (const auto &exec_summ : summaries)
+  {
+    auto &summ  = node.emplace_back();
+    summ["tag"] = exec_summ.get_tag();
+
+    if (const auto *descriptor = exec_summ.get_descriptor(); descriptor != nullptr)
+    {
+      summ["descriptor"] = true;
+      if (std::find(descriptors.cbegin(), descriptors.cend(), descriptor) == descriptors.cend())
+      {
+        descriptors.push_back(descriptor);
+      }
+    }
+
+    // Write out the expected values as simple key/value pairs. Keys set on
+    // the summary override its descriptor:
+    nvbench::named_values summary_values = exec_summ;
+    for (const char *key : {"name", "description", "hint", "hide"})
+    {
+      if (summary_values.has_value(key))
+      {
+        summ[key] = summary_values.get_string(key);
+        summary_values.remove_value(key);
+      }
+    }
+
+    // Write any additional values generically in
+    // ["data"] = [{name,type,value}, ...]:
+    if (summary_values.get_size() != 0)
+    {
+      ::write_named_values(summ["data"], summary_values);
+    }
+  }
+}
+
+template <typename JsonNode>
+void write_summary_descriptors(JsonNode &node,
+                               const std::vector<const nvbench::summary_descriptor *> &descriptors)
+{
+  node = nlohmann::json::array();
+  for (const auto *descriptor : descriptors)
+  {
+    auto &desc  = node.emplace_back();
+    desc["tag"] = descriptor->tag;
+    if (!descriptor->name.empty())
+    {
+      desc["name"] = descriptor->name;
+    }
+    if (!descriptor->description.empty())
+    {
+      desc["description"] = descriptor->description;
+    }
+    if (!descriptor->hint.empty())
+    {
+      desc["hint"] = descriptor->hint;
+    }
+    if (!descriptor->hide.empty())
+    {
+      desc["hide"] = descriptor->hide;
+    }
+  }
+}
+
 template <std::size_t buffer_nbytes>
 void write_out_values(std::ofstream &out, const std::vector<nvbench::float64_t> &data)
 {
@@ -159,7 +233,7 @@ json_printer::version_t json_printer::get_json_file_version()
   // Major version: backwards incompatible changes
   // Minor version: backwards compatible additions
   // Patch version: backwards compatible bugfixes/patches
-  return {1, 0, 0};
+  return {1, 5, 0};
 }
 
 std::string json_printer::version_t::get_string() const
@@ -321,10 +395,21 @@ void json_printer::do_print_benchmark_results(const benchmark_vector &benches)
 #endif
       } // "nvbench"
     } // "version"
+
+    {
+      auto &host = metadata["host"];
+
+      host["cpu_timer_resolution"] = nvbench::detail::timer_resolution::get_cpu();
+    } // "host"
   } // "meta"
 
   add_devices_section(root);
 
+  // Filled in once all summaries have been written. Reserve the key so that
+  // the descriptors precede the benchmarks in the file:
+  root["summary_descriptors"] = nlohmann::json::array();
+  std::vector<const nvbench::summary_descriptor *> descriptors;
+
   {
     auto &benchmarks = root["benchmarks"];
     for (const auto &bench_ptr : benches)
@@ -338,6 +423,7 @@ void json_printer::do_print_benchmark_results(const benchmark_vector &benches)
       bench["min_samples"] = bench_ptr->get_min_samples();
       bench["skip_time"]   = bench_ptr->get_skip_time();
       bench["timeout"]     = bench_ptr->get_timeout();
+      bench["run_order"]   = bench_ptr->get_run_order();
 
       auto &devices = bench["devices"];
       for (const auto &dev_info : bench_ptr->get_devices())
@@ -396,7 +482,14 @@ void json_printer::do_print_benchmark_results(const benchmark_vector &benches)
         st["skip_time"]   = exec_state.get_skip_time();
         st["timeout"]     = exec_state.get_timeout();
 
-        st["device"]            = exec_state.get_device()->get_id();
+        if (const auto &device = exec_state.get_device(); device)
+        {
+          st["device"] = device->get_id();
+        }
+        else
+        {
+          st["device"] = nullptr;
+        }
         st["type_config_index"] = exec_state.get_type_config_index();
 
         // TODO I'd like to replace this with:
@@ -405,42 +498,7 @@ void json_printer::do_print_benchmark_results(const benchmark_vector &benches)
         // that information through.
         ::write_named_values(st["axis_values"], exec_state.get_axis_values());
 
-        auto &summaries = st["summaries"];
-        for (const auto &exec_summ : exec_state.get_summaries())
-        {
-          auto &summ  = summaries.emplace_back();
-          summ["tag"] = exec_summ.get_tag();
-
-          // Write out the expected values as simple key/value pairs
-          nvbench::named_values summary_values = exec_summ;
-          if (summary_values.has_value("name"))
-          {
-            summ["name"] = summary_values.get_string("name");
-            summary_values.remove_value("name");
-          }
-          if (summary_values.has_value("description"))
-          {
-            summ["description"] = summary_values.get_string("description");
-            summary_values.remove_value("description");
-          }
-          if (summary_values.has_value("hint"))
-          {
-            summ["hint"] = summary_values.get_string("hint");
-            summary_values.remove_value("hint");
-          }
-          if (summary_values.has_value("hide"))
-          {
-            summ["hide"] = summary_values.get_string("hide");
-            summary_values.remove_value("hide");
-          }
-
-          // Write any additional values generically in
-          // ["data"] = [{name,type,value}, ...]:
-          if (summary_values.get_size() != 0)
-          {
-            ::write_named_values(summ["data"], summary_values);
-          }
-        }
+        ::write_summaries(st["summaries"], exec_state.get_summaries(), descriptors);
 
         st["is_skipped"] = exec_state.is_skipped();
         if (exec_state.is_skipped())
@@ -449,9 +507,35 @@ void json_printer::do_print_benchmark_results(const benchmark_vector &benches)
           continue;
         }
       } // end foreach exec_state
+
+      // Benchmark-level summaries, e.g. complexity fits:
+      if (!bench_ptr->get_summary_groups().empty())
+      {
+        auto &groups = bench["summary_groups"];
+        for (const auto &summ_group : bench_ptr->get_summary_groups())
+        {
+          auto &group = groups.emplace_back();
+
+          if (const auto &device = summ_group.get_device(); device)
+          {
+            group["device"] = device->get_id();
+          }
+          else
+          {
+            group["device"] = nullptr;
+          }
+
+          // Only axes shared by all states in the group are listed:
+          group["axis_values"] = nlohmann::json::array();
+          ::write_named_values(group["axis_values"], summ_group.get_axis_values());
+          ::write_summaries(group["summaries"], summ_group.get_summaries(), descriptors);
+        } // end foreach summary group
+      }
     } // end foreach benchmark
   } // "benchmarks"
 
+  ::write_summary_descriptors(root["summary_descriptors"], descriptors);
+
   m_ostream << root.dump(2) << "\n";
 }
 
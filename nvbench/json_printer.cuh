@@ -30,6 +30,13 @@ namespace nvbench
 /*!
  * JSON output format.
  *
+ * Summaries created from a registered nvbench::summary_descriptor only store
+ * their tag, `"descriptor": true` and their data. Their metadata is listed once
+ * per file in the top-level "summary_descriptors" array;
+ * `scripts/nvbench_json/reader.py` merges it back into the marked summaries
+ * when reading. Files before version 1.5.0 have no marker and match
+ * descriptors by tag alone.
+ *
  * All modifications to the output file should increment the semantic version
  * of the json files appropriately (see json_printer::get_json_file_version()).
  */
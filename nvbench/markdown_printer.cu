@@ -17,6 +17,7 @@
  */
 
 #include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/timer_resolution.cuh>
 #include <nvbench/device_manager.cuh>
 #include <nvbench/internal/markdown_table.cuh>
 #include <nvbench/markdown_printer.cuh>
@@ -89,6 +90,13 @@ void markdown_printer::do_print_device_info()
                    device.get_ecc_state() ? "Yes" : "No");
     fmt::format_to(std::back_inserter(buffer), "\n");
   }
+
+  fmt::format_to(std::back_inserter(buffer), "# Host\n\n");
+  fmt::format_to(std::back_inserter(buffer),
+                 "* CPU Timer Resolution: {:.4g} ns\n",
+                 nvbench::detail::timer_resolution::get_cpu() * 1e9);
+  fmt::format_to(std::back_inserter(buffer), "\n");
+
   m_ostream << fmt::to_string(buffer);
 }
 
@@ -224,6 +232,80 @@ void markdown_printer::do_print_benchmark_results(const printer_base::benchmark_
     return fmt::format("{}", v);
   };
 
+  auto add_axis_cells = [&format_visitor](nvbench::internal::markdown_table &table,
+                                           std::size_t row,
+                                           const nvbench::axes_metadata &axes,
+                                           const nvbench::named_values &axis_values) {
+    for (const auto &name : axis_values.get_names())
+    {
+      // Handle power-of-two int64 axes differently:
+      if (axis_values.get_type(name) == named_values::type::int64 &&
+          axes.get_int64_axis(name).is_power_of_two())
+      {
+        const nvbench::int64_t value    = axis_values.get_int64(name);
+        const nvbench::int64_t exponent = int64_axis::compute_log2(value);
+        table.add_cell(row, name, name, fmt::format("2^{} = {}", exponent, value));
+      }
+      else
+      {
+        std::string value = std::visit(format_visitor, axis_values.get_value(name));
+        table.add_cell(row, name + "_axis", name, std::move(value));
+      }
+    }
+  };
+
+  auto add_summary_cells = [this](nvbench::internal::markdown_table &table,
+                                  std::size_t row,
+                                  const std::vector<nvbench::summary> &summaries) {
+    for (const auto &summ : summaries)
+    {
+      if (summ.is_hidden())
+      {
+        continue;
+      }
+      const std::string &tag    = summ.get_tag();
+      const std::string &header = summ.get_name();
+
+      const std::string &hint = summ.get_hint();
+      if (hint == "duration")
+      {
+        table.add_cell(row, tag, header, this->do_format_duration(summ));
+      }
+      else if (hint == "item_rate")
+      {
+        table.add_cell(row, tag, header, this->do_format_item_rate(summ));
+      }
+      else if (hint == "frequency")
+      {
+        table.add_cell(row, tag, header, this->do_format_frequency(summ));
+      }
+      else if (hint == "bytes")
+      {
+        table.add_cell(row, tag, header, this->do_format_bytes(summ));
+      }
+      else if (hint == "byte_rate")
+      {
+        table.add_cell(row, tag, header, this->do_format_byte_rate(summ));
+      }
+      else if (hint == "sample_size")
+      {
+        table.add_cell(row, tag, header, this->do_format_sample_size(summ));
+      }
+      else if (hint == "percentage")
+      {
+        table.add_cell(row, tag, header, this->do_format_percentage(summ));
+      }
+      else if (hint == "normalized_count")
+      {
+        table.add_cell(row, tag, header, this->do_format_normalized_count(summ));
+      }
+      else
+      {
+        table.add_cell(row, tag, header, this->do_format_default(summ));
+      }
+    }
+  };
+
   // Start printing benchmarks
   fmt::memory_buffer buffer;
   fmt::format_to(std::back_inserter(buffer), "# Benchmark Results\n");
@@ -265,67 +347,8 @@ void markdown_printer::do_print_benchmark_results(const printer_base::benchmark_
 
         if (cur_state.get_device() == device)
         {
-          const auto &axis_values = cur_state.get_axis_values();
-          for (const auto &name : axis_values.get_names())
-          {
-            // Handle power-of-two int64 axes differently:
-            if (axis_values.get_type(name) == named_values::type::int64 &&
-                axes.get_int64_axis(name).is_power_of_two())
-            {
-              const nvbench::int64_t value    = axis_values.get_int64(name);
-              const nvbench::int64_t exponent = int64_axis::compute_log2(value);
-              table.add_cell(row, name, name, fmt::format("2^{} = {}", exponent, value));
-            }
-            else
-            {
-              std::string value = std::visit(format_visitor, axis_values.get_value(name));
-              table.add_cell(row, name + "_axis", name, std::move(value));
-            }
-          }
-
-          for (const auto &summ : cur_state.get_summaries())
-          {
-            if (summ.has_value("hide"))
-            {
-              continue;
-            }
-            const std::string &tag    = summ.get_tag();
-            const std::string &header = summ.has_value("name") ? summ.get_string("name") : tag;
-
-            std::string hint = summ.has_value("hint") ? summ.get_string("hint") : std::string{};
-            if (hint == "duration")
-            {
-              table.add_cell(row, tag, header, this->do_format_duration(summ));
-            }
-            else if (hint == "item_rate")
-            {
-              table.add_cell(row, tag, header, this->do_format_item_rate(summ));
-            }
-            else if (hint == "frequency")
-            {
-              table.add_cell(row, tag, header, this->do_format_frequency(summ));
-            }
-            else if (hint == "bytes")
-            {
-              table.add_cell(row, tag, header, this->do_format_bytes(summ));
-            }
-            else if (hint == "byte_rate")
-            {
-              table.add_cell(row, tag, header, this->do_format_byte_rate(summ));
-            }
-            else if (hint == "sample_size")
-            {
-              table.add_cell(row, tag, header, this->do_format_sample_size(summ));
-            }
-            else if (hint == "percentage")
-            {
-              table.add_cell(row, tag, header, this->do_format_percentage(summ));
-            }
-            else
-            {
-              table.add_cell(row, tag, header, this->do_format_default(summ));
-            }
-          }
+          add_axis_cells(table, row, axes, cur_state.get_axis_values());
+          add_summary_cells(table, row, cur_state.get_summaries());
           row++;
         }
       }
@@ -335,6 +358,26 @@ void markdown_printer::do_print_benchmark_results(const printer_base::benchmark_
                      "{}",
                      table_str.empty() ? "No data -- check log.\n" : std::move(table_str));
     } // end foreach device_pass
+
+    // Benchmark-level summaries, e.g. complexity fits:
+    if (!bench.get_summary_groups().empty())
+    {
+      fmt::format_to(std::back_inserter(buffer), "\n### Summary\n\n");
+
+      std::size_t row = 0;
+      nvbench::internal::markdown_table table{m_color};
+      for (const auto &group : bench.get_summary_groups())
+      {
+        if (const auto &device = group.get_device(); device)
+        {
+          table.add_cell(row, "_device", "Device", fmt::to_string(device->get_id()));
+        }
+        add_axis_cells(table, row, axes, group.get_axis_values());
+        add_summary_cells(table, row, group.get_summaries());
+        row++;
+      }
+      fmt::format_to(std::back_inserter(buffer), "{}", table.to_string());
+    }
   }
 
   m_ostream << fmt::to_string(buffer);
@@ -493,4 +536,25 @@ std::string markdown_printer::do_format_percentage(const summary &data)
   return fmt::format("{:.2f}%", percentage * 100.);
 }
 
+std::string markdown_printer::do_format_normalized_count(const summary &data)
+{
+  const auto count = data.get_float64("value");
+  if (count >= 1e9)
+  {
+    return fmt::format("{:0.3f}G", count * 1e-9);
+  }
+  else if (count >= 1e6)
+  {
+    return fmt::format("{:0.3f}M", count * 1e-6);
+  }
+  else if (count >= 1e3)
+  {
+    return fmt::format("{:0.3f}K", count * 1e-3);
+  }
+  else
+  {
+    return fmt::format("{:0.3f}", count);
+  }
+}
+
 } // namespace nvbench
@@ -69,6 +69,7 @@ protected:
   virtual std::string do_format_byte_rate(const nvbench::summary &bytes_per_sec);
   virtual std::string do_format_sample_size(const nvbench::summary &count);
   virtual std::string do_format_percentage(const nvbench::summary &percentage);
+  virtual std::string do_format_normalized_count(const nvbench::summary &count);
 
   bool m_color{false};
 };
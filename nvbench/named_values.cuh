@@ -65,6 +65,11 @@ struct named_values
 
   void remove_value(const std::string &name);
 
+  /// True if both objects hold the same names and values in the same order. @{
+  [[nodiscard]] bool operator==(const named_values &other) const;
+  [[nodiscard]] bool operator!=(const named_values &other) const { return !(*this == other); }
+  /// @}
+
 private:
   struct named_value
   {
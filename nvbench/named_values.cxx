@@ -37,6 +37,17 @@ void named_values::append(const named_values &other)
 
 void named_values::clear() { m_storage.clear(); }
 
+bool named_values::operator==(const named_values &other) const
+{
+  return std::equal(m_storage.cbegin(),
+                    m_storage.cend(),
+                    other.m_storage.cbegin(),
+                    other.m_storage.cend(),
+                    [](const auto &lhs, const auto &rhs) {
+                      return lhs.name == rhs.name && lhs.value == rhs.value;
+                    });
+}
+
 std::size_t named_values::get_size() const { return m_storage.size(); }
 
 std::vector<std::string> named_values::get_names() const
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <nvbench/async_completion.cuh>
 #include <nvbench/benchmark.cuh>
 #include <nvbench/benchmark_base.cuh>
 #include <nvbench/benchmark_manager.cuh>
@@ -29,8 +30,11 @@
 #include <nvbench/cuda_call.cuh>
 #include <nvbench/cuda_stream.cuh>
 #include <nvbench/cuda_timer.cuh>
+#include <nvbench/do_not_optimize.cuh>
 #include <nvbench/enum_type_list.cuh>
 #include <nvbench/exec_tag.cuh>
+#include <nvbench/host_caches.cuh>
+#include <nvbench/input_pool.cuh>
 #include <nvbench/launch.cuh>
 #include <nvbench/main.cuh>
 #include <nvbench/range.cuh>
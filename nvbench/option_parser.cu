@@ -18,16 +18,24 @@
 
 #include <nvbench/benchmark_base.cuh>
 #include <nvbench/benchmark_manager.cuh>
+#include <nvbench/complexity.cuh>
 #include <nvbench/criterion_manager.cuh>
 #include <nvbench/csv_printer.cuh>
+#include <nvbench/detail/co_runner.cuh>
+#include <nvbench/detail/core_reservation.cuh>
+#include <nvbench/detail/isolation.cuh>
+#include <nvbench/detail/run_order.cuh>
 #include <nvbench/detail/throw.cuh>
 #include <nvbench/device_manager.cuh>
 #include <nvbench/git_revision.cuh>
+#include <nvbench/host_buffer_pool.cuh>
+#include <nvbench/host_caches.cuh>
 #include <nvbench/json_printer.cuh>
 #include <nvbench/markdown_printer.cuh>
 #include <nvbench/option_parser.cuh>
 #include <nvbench/printer_base.cuh>
 #include <nvbench/range.cuh>
+#include <nvbench/results.cuh>
 #include <nvbench/version.cuh>
 
 // These are generated from the markdown docs by CMake in the build directory:
@@ -143,12 +151,11 @@ std::vector<T> parse_list_values(std::string_view list_spec)
   return result;
 }
 
-// Parses a range specification "<start> : <stop> [ : <stride> ]" and returns
-// a vector filled with the specified range.
-template <typename T>
-std::vector<T> parse_range_values(std::string_view range_spec, nvbench::wrapped_type<T>)
+// Splits a range specification "<start> : <stop> [ : <stride> ]" into its
+// parameters:
+std::vector<std::string_view> split_range_params(std::string_view range_spec)
 {
-  std::vector<T> range_params;
+  std::vector<std::string_view> range_params;
 
   static const std::regex value_regex{
     "\\s*"     // Whitespace
@@ -161,8 +168,19 @@ std::vector<T> parse_range_values(std::string_view range_spec, nvbench::wrapped_
   auto values_end   = sv_regex_iterator{};
   for (; values_begin != values_end; ++values_begin)
   {
-    auto match          = *values_begin;
-    std::string_view sv = submatch_to_sv(match[1]);
+    range_params.push_back(submatch_to_sv((*values_begin)[1]));
+  }
+  return range_params;
+}
+
+// Parses a range specification "<start> : <stop> [ : <stride> ]" and returns
+// a vector filled with the specified range.
+template <typename T>
+std::vector<T> parse_range_values(std::string_view range_spec, nvbench::wrapped_type<T>)
+{
+  std::vector<T> range_params;
+  for (const auto sv : split_range_params(range_spec))
+  {
     T val;
     parse(sv, val);
     range_params.push_back(std::move(val));
@@ -254,6 +272,73 @@ std::vector<T> parse_values(std::string_view value_spec)
   }
 }
 
+// Returns the parameters of a bracketed range "[<a> : <b> [ : <c> ]]", or an
+// empty vector if `value_spec` is not a range:
+std::vector<std::string_view> match_range_params(std::string_view value_spec)
+{
+  static const std::regex range_regex{"^"                 // Start of string
+                                      "\\s*\\[\\s*"       // Literal [
+                                      "("                 // Start value capture
+                                      "[^\\]]+?:[^\\]]+?" // "not ]", ':', "not ]"
+                                      ")"                 // End value capture
+                                      "\\s*\\]\\s*"       // Literal ]
+                                      "$"};               // EOS
+
+  sv_match match;
+  if (!std::regex_search(value_spec.cbegin(), value_spec.cend(), match, range_regex))
+  {
+    return {};
+  }
+  return split_range_params(submatch_to_sv(match[1]));
+}
+
+// Parses "[<start> : <stop> : <points per decade>]" into a log range:
+template <typename T>
+std::vector<T> parse_log_range_values(std::string_view value_spec)
+{
+  const auto params = match_range_params(value_spec);
+  NVBENCH_THROW_IF(params.size() != 3,
+                   std::runtime_error,
+                   "Expected `[<start> : <stop> : <points per decade>]` for a log axis: {}",
+                   value_spec);
+
+  nvbench::float64_t start{};
+  nvbench::float64_t stop{};
+  nvbench::int64_t points_per_decade{};
+  parse(params[0], start);
+  parse(params[1], stop);
+  parse(params[2], points_per_decade);
+  return nvbench::log_range<nvbench::float64_t, T>(start, stop, points_per_decade);
+}
+
+// Parses cache-relative sizes: "[<start> : <stop> : <count>]" for a
+// geometric range, or a single value or list such as "[L1, L2, 2xLLC]":
+std::vector<nvbench::int64_t> parse_cache_values(std::string_view value_spec)
+{
+  if (const auto params = match_range_params(value_spec); !params.empty())
+  {
+    NVBENCH_THROW_IF(params.size() != 3,
+                     std::runtime_error,
+                     "Expected `[<start> : <stop> : <count>]` for a cache axis: {}",
+                     value_spec);
+
+    nvbench::int64_t count{};
+    parse(params[2], count);
+    NVBENCH_THROW_IF(count < 1, std::runtime_error, "Invalid count in cache axis: {}", value_spec);
+    return nvbench::cache_range(std::string{params[0]},
+                                std::string{params[1]},
+                                static_cast<std::size_t>(count));
+  }
+
+  const auto &caches = nvbench::host_caches::get();
+  std::vector<nvbench::int64_t> result;
+  for (const auto &spec : parse_values<std::string>(value_spec))
+  {
+    result.push_back(caches.resolve(spec));
+  }
+  return result;
+}
+
 std::vector<nvbench::device_info> parse_devices(std::string_view devices)
 {
   auto &dev_mgr = nvbench::device_manager::get();
@@ -462,11 +547,76 @@ void option_parser::parse_range(option_parser::arg_iterator_t first,
       this->set_stopping_criterion(first[1]);
       first += 2;
     }
+    else if (arg == "--order")
+    {
+      check_params(1);
+      this->set_run_order(first[1]);
+      first += 2;
+    }
+    else if (arg == "--huge-pages")
+    {
+      check_params(1);
+      this->set_huge_pages(first[1]);
+      first += 2;
+    }
+    else if (arg == "--isolate")
+    {
+      check_params(1);
+      this->set_isolation(first[1]);
+      first += 2;
+    }
+    else if (arg == "--reserve-cores")
+    {
+      check_params(1);
+      this->set_reserve_cores(first[1]);
+      first += 2;
+    }
+    else if (arg == "--retry-combine")
+    {
+      this->enable_retry_combine();
+      first += 1;
+    }
     else if (arg == "--profile")
     {
       this->enable_profile();
       first += 1;
     }
+    else if (arg == "--perf-ctl")
+    {
+      check_params(1);
+      this->set_perf_ctl(first[1]);
+      first += 2;
+    }
+    else if (arg == "--cpu-profile")
+    {
+      check_params(1);
+      this->set_cpu_profile_directory(first[1]);
+      first += 2;
+    }
+    else if (arg == "--baseline")
+    {
+      check_params(1);
+      this->set_baseline(first[1]);
+      first += 2;
+    }
+    else if (arg == "--complexity")
+    {
+      check_params(1);
+      this->add_complexity_fit(first[1]);
+      first += 2;
+    }
+    else if (arg == "--aggregate")
+    {
+      check_params(1);
+      this->add_aggregate(first[1]);
+      first += 2;
+    }
+    else if (arg == "--co-runner")
+    {
+      check_params(1);
+      this->add_co_runner_axis(first[1]);
+      first += 2;
+    }
     else if (arg == "--quiet" || arg == "-q")
     {
       // Setting this flag prevents the default stdout printer from being
@@ -521,14 +671,17 @@ void option_parser::parse_range(option_parser::arg_iterator_t first,
       this->update_axis(first[1]);
       first += 2;
     }
-    else if (arg == "--min-samples")
+    else if (arg == "--min-samples" || arg == "--soak-iterations" || arg == "--soak-windows" ||
+             arg == "--async-depth" || arg == "--data-seed")
     {
       check_params(1);
       this->update_int64_prop(first[0], first[1]);
       first += 2;
     }
     else if (arg == "--skip-time" || arg == "--timeout" || arg == "--throttle-threshold" ||
-             arg == "--throttle-recovery-delay")
+             arg == "--throttle-recovery-delay" || arg == "--baseline-threshold" ||
+             arg == "--soak" || arg == "--soak-threshold" || arg == "--fixture-cache" ||
+             arg == "--hard-timeout" || arg == "--reserve-timeout" || arg == "--retry")
     {
       check_params(1);
       this->update_float64_prop(first[0], first[1]);
@@ -727,6 +880,101 @@ catch (std::exception &e)
                 e.what());
 }
 
+void option_parser::set_run_order(const std::string &order)
+try
+{
+  // If no active benchmark, save args as global. The seed of a random order is
+  // drawn now so that all benchmarks share it:
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--order");
+    m_global_benchmark_args.push_back(nvbench::detail::run_order::parse(order).to_string());
+    return;
+  }
+
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_run_order(order);
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error, "Error handling option `--order {}`:\n{}", order, e.what());
+}
+
+void option_parser::set_huge_pages(const std::string &mode)
+try
+{
+  // Validate before deferring to the benchmarks:
+  const auto page_mode = nvbench::host_buffer_pool::parse_page_mode(mode);
+
+  // If no active benchmark, save args as global:
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--huge-pages");
+    m_global_benchmark_args.push_back(nvbench::host_buffer_pool::to_string(page_mode));
+    return;
+  }
+
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_huge_pages(mode);
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error,
+                "Error handling option `--huge-pages {}`:\n{}",
+                mode,
+                e.what());
+}
+
+void option_parser::set_isolation(const std::string &isolation)
+try
+{
+  // Validate before deferring to the benchmarks:
+  const auto spec = nvbench::detail::isolation::parse(isolation).to_string();
+
+  // If no active benchmark, save args as global:
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--isolate");
+    m_global_benchmark_args.push_back(spec);
+    return;
+  }
+
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_isolation(isolation);
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error,
+                "Error handling option `--isolate {}`:\n{}",
+                isolation,
+                e.what());
+}
+
+void option_parser::set_reserve_cores(const std::string &spec)
+try
+{
+  // Validate before deferring to the benchmarks:
+  const auto reservation = nvbench::detail::core_reservation::spec::parse(spec).to_string();
+
+  // If no active benchmark, save args as global:
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--reserve-cores");
+    m_global_benchmark_args.push_back(reservation);
+    return;
+  }
+
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_reserve_cores(spec);
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error,
+                "Error handling option `--reserve-cores {}`:\n{}",
+                spec,
+                e.what());
+}
+
 void option_parser::set_stopping_criterion(const std::string &criterion)
 try
 {
@@ -762,6 +1010,186 @@ void option_parser::enable_profile()
   bench.set_run_once(true);
 }
 
+void option_parser::enable_retry_combine()
+{
+  // If no active benchmark, save args as global
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--retry-combine");
+    return;
+  }
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_retry_combine(true);
+}
+
+void option_parser::set_perf_ctl(const std::string &spec)
+{
+  // If no active benchmark, save args as global
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--perf-ctl");
+    m_global_benchmark_args.push_back(spec);
+    return;
+  }
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_perf_ctl(spec);
+}
+
+void option_parser::set_cpu_profile_directory(const std::string &directory)
+{
+  // If no active benchmark, save args as global
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--cpu-profile");
+    m_global_benchmark_args.push_back(directory);
+    return;
+  }
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_cpu_profile_directory(directory);
+}
+
+void option_parser::set_baseline(const std::string &filename)
+try
+{
+  // If no active benchmark, save args as global
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--baseline");
+    m_global_benchmark_args.push_back(filename);
+    return;
+  }
+
+  auto &baseline = m_baselines[filename];
+  if (!baseline)
+  {
+    baseline = std::make_shared<const nvbench::results::result_file>(
+      nvbench::results::result_file::read(filename));
+  }
+  benchmark_base &bench = *m_benchmarks.back();
+  bench.set_baseline(baseline);
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error,
+                "Error handling option `--baseline {}`:\n{}",
+                filename,
+                e.what());
+}
+
+void option_parser::add_complexity_fit(const std::string &spec)
+try
+{
+  // If no active benchmark, save args as global.
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--complexity");
+    m_global_benchmark_args.push_back(spec);
+    return;
+  }
+
+  // "<axis name>" or "<axis name>=<model>":
+  const auto eq_pos           = spec.find('=');
+  const std::string axis_name = spec.substr(0, eq_pos);
+  const auto model            = eq_pos == std::string::npos
+                                  ? nvbench::complexity::automatic
+                                  : nvbench::complexity_from_string(spec.substr(eq_pos + 1));
+
+  benchmark_base &bench = *m_benchmarks.back();
+
+  // Throws if the axis doesn't exist or is not an int64 axis:
+  [[maybe_unused]] const auto &axis = bench.get_axes().get_int64_axis(axis_name);
+
+  bench.add_complexity_fit(axis_name, model);
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error, "Error handling option `--complexity {}`:\n{}", spec, e.what());
+}
+
+void option_parser::add_aggregate(const std::string &spec)
+try
+{
+  // If no active benchmark, save args as global.
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--aggregate");
+    m_global_benchmark_args.push_back(spec);
+    return;
+  }
+
+  benchmark_base &bench = *m_benchmarks.back();
+
+  // "all" or comma-separated axis names:
+  std::vector<std::string> axis_names;
+  if (spec != "all")
+  {
+    const auto &axes  = bench.get_axes().get_axes();
+    std::size_t begin = 0;
+    while (begin <= spec.size())
+    {
+      const auto end = std::min(spec.find(',', begin), spec.size());
+      auto name      = spec.substr(begin, end - begin);
+      begin          = end + 1;
+
+      NVBENCH_THROW_IF(std::none_of(axes.cbegin(),
+                                    axes.cend(),
+                                    [&name](const auto &axis) { return axis->get_name() == name; }),
+                       std::runtime_error,
+                       "Benchmark '{}' has no axis named '{}'.",
+                       bench.get_name(),
+                       name);
+      axis_names.push_back(std::move(name));
+    }
+  }
+
+  bench.add_aggregate(std::move(axis_names));
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error, "Error handling option `--aggregate {}`:\n{}", spec, e.what());
+}
+
+void option_parser::add_co_runner_axis(const std::string &spec)
+try
+{
+  // If no active benchmark, save args as global.
+  if (m_benchmarks.empty())
+  {
+    m_global_benchmark_args.push_back("--co-runner");
+    m_global_benchmark_args.push_back(spec);
+    return;
+  }
+
+  benchmark_base &bench = *m_benchmarks.back();
+
+  const auto &axes = bench.get_axes().get_axes();
+  NVBENCH_THROW_IF(std::any_of(axes.cbegin(),
+                               axes.cend(),
+                               [](const auto &axis) {
+                                 return axis->get_name() == nvbench::detail::co_runner::axis_name;
+                               }),
+                   std::runtime_error,
+                   "Benchmark '{}' already has a {} axis. Use `--axis` to change its values.",
+                   bench.get_name(),
+                   nvbench::detail::co_runner::axis_name);
+
+  // Comma-separated `<kind>[@<cpu>]` specs:
+  std::vector<std::string> specs;
+  std::size_t begin = 0;
+  while (begin <= spec.size())
+  {
+    const auto end = std::min(spec.find(',', begin), spec.size());
+    specs.push_back(spec.substr(begin, end - begin));
+    begin = end + 1;
+  }
+
+  bench.add_co_runner_axis(std::move(specs));
+}
+catch (std::exception &e)
+{
+  NVBENCH_THROW(std::runtime_error, "Error handling option `--co-runner {}`:\n{}", spec, e.what());
+}
+
 void option_parser::add_benchmark(const std::string &name)
 try
 {
@@ -837,9 +1265,13 @@ try
   // Axis/Flag spec: "<AxisName>" (no flags)
   // Axis/Flag spec: "<AxisName> []" (no flags)
   // Axis/Flag spec: "<AxisName> [pow2]" (flags=`pow2`)
+  // Axis/Flag spec: "<AxisName> [log]" (flags=`log`, log range)
+  // Axis/Flag spec: "<AxisName> [cache]" (flags=`cache`, cache-relative sizes)
   // Value spec: "[ <v1, <v2>, ... ]" <- Explicit values
   // Value spec: "[<start> : <stop>]" <- Range, inclusive start/stop
   // Value spec: "[<start> : <stop> : <stride>]" <- Range, explicit stride
+  // Value spec: "[<start> : <stop> : <points per decade>]" <- With [log]
+  // Value spec: "[0.5xL1 : 4xLLC : <count>]" <- With [cache]
 
   // If no active benchmark, save args as global.
   if (m_benchmarks.empty())
@@ -889,6 +1321,18 @@ void option_parser::update_int64_axis(int64_axis &axis,
                                       std::string_view value_spec,
                                       std::string_view flag_spec)
 {
+  // Generated values:
+  if (flag_spec == "log")
+  {
+    axis.set_inputs(parse_log_range_values<nvbench::int64_t>(value_spec), int64_axis_flags::none);
+    return;
+  }
+  if (flag_spec == "cache")
+  {
+    axis.set_inputs(parse_cache_values(value_spec), int64_axis_flags::none);
+    return;
+  }
+
   // Validate flags:
   int64_axis_flags flags;
   if (flag_spec.empty())
@@ -913,6 +1357,12 @@ void option_parser::update_float64_axis(float64_axis &axis,
                                         std::string_view value_spec,
                                         std::string_view flag_spec)
 {
+  if (flag_spec == "log")
+  {
+    axis.set_inputs(parse_log_range_values<nvbench::float64_t>(value_spec));
+    return;
+  }
+
   // Validate flags:
   if (!flag_spec.empty())
   {
@@ -973,6 +1423,28 @@ try
   {
     bench.set_min_samples(value);
   }
+  else if (prop_arg == "--data-seed")
+  {
+    bench.set_data_seed(static_cast<nvbench::uint64_t>(value));
+  }
+  else if (prop_arg == "--async-depth")
+  {
+    NVBENCH_THROW_IF(value < 1, std::runtime_error, "{}", "The async depth must be at least 1.");
+    bench.set_async_depth(value);
+  }
+  else if (prop_arg == "--soak-iterations")
+  {
+    NVBENCH_THROW_IF(value < 0, std::runtime_error, "{}", "Soak iterations must not be negative.");
+    bench.set_soak_iterations(value);
+  }
+  else if (prop_arg == "--soak-windows")
+  {
+    NVBENCH_THROW_IF(value < 3,
+                     std::runtime_error,
+                     "{}",
+                     "At least 3 soak windows are needed to fit a trend.");
+    bench.set_soak_windows(value);
+  }
   else
   {
     NVBENCH_THROW(std::runtime_error, "Unrecognized property: `{}`", prop_arg);
@@ -1086,6 +1558,24 @@ try
   {
     bench.set_timeout(value);
   }
+  else if (prop_arg == "--retry")
+  {
+    NVBENCH_THROW_IF(value < 0., std::runtime_error, "{}", "Retry factor must not be negative.");
+    bench.set_retry_factor(value);
+  }
+  else if (prop_arg == "--hard-timeout")
+  {
+    NVBENCH_THROW_IF(value < 0., std::runtime_error, "{}", "Hard timeout must not be negative.");
+    bench.set_hard_timeout(value);
+  }
+  else if (prop_arg == "--reserve-timeout")
+  {
+    NVBENCH_THROW_IF(value < 0.,
+                     std::runtime_error,
+                     "{}",
+                     "Reservation timeout must not be negative.");
+    bench.set_reserve_timeout(value);
+  }
   else if (prop_arg == "--throttle-threshold")
   {
     bench.set_throttle_threshold(static_cast<nvbench::float32_t>(value) / 100.0f);
@@ -1094,6 +1584,24 @@ try
   {
     bench.set_throttle_recovery_delay(static_cast<nvbench::float32_t>(value));
   }
+  else if (prop_arg == "--baseline-threshold")
+  {
+    bench.set_baseline_threshold(value / 100.);
+  }
+  else if (prop_arg == "--soak")
+  {
+    NVBENCH_THROW_IF(value < 0., std::runtime_error, "{}", "Soak duration must not be negative.");
+    bench.set_soak_duration(value);
+  }
+  else if (prop_arg == "--soak-threshold")
+  {
+    bench.set_soak_threshold(value / 100.);
+  }
+  else if (prop_arg == "--fixture-cache")
+  {
+    NVBENCH_THROW_IF(value < 0., std::runtime_error, "{}", "Cache size must not be negative.");
+    bench.set_fixture_cache_size(static_cast<std::size_t>(value * 1024. * 1024.));
+  }
   else
   {
     NVBENCH_THROW(std::runtime_error, "Unrecognized property: `{}`", prop_arg);
@@ -23,6 +23,7 @@
 #include <nvbench/stopping_criterion.cuh>
 
 #include <iosfwd>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -30,6 +31,11 @@
 namespace nvbench
 {
 
+namespace results
+{
+struct result_file;
+}
+
 struct benchmark_base;
 struct float64_axis;
 struct int64_axis;
@@ -88,8 +94,20 @@ private:
   void lock_gpu_clocks(const std::string &rate);
 
   void set_stopping_criterion(const std::string &criterion);
+  void set_run_order(const std::string &order);
+  void set_huge_pages(const std::string &mode);
+  void set_isolation(const std::string &isolation);
+  void set_reserve_cores(const std::string &spec);
 
+  void enable_retry_combine();
   void enable_profile();
+  void set_perf_ctl(const std::string &spec);
+  void set_cpu_profile_directory(const std::string &directory);
+  void set_baseline(const std::string &filename);
+
+  void add_complexity_fit(const std::string &spec);
+  void add_aggregate(const std::string &spec);
+  void add_co_runner_axis(const std::string &spec);
 
   void add_benchmark(const std::string &name);
   void replay_global_args();
@@ -135,6 +153,9 @@ private:
   // Manages lifetimes of any ofstreams opened for m_printer.
   std::vector<std::unique_ptr<std::ofstream>> m_ofstream_storage;
 
+  // Baseline result files, loaded once and shared by all benchmarks:
+  std::map<std::string, std::shared_ptr<const nvbench::results::result_file>> m_baselines;
+
   // The main printer to use:
   nvbench::printer_multiplex m_printer;
 
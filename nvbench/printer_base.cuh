@@ -156,6 +156,12 @@ struct printer_base
     this->do_print_benchmark_results(benches);
   }
 
+  /*!
+   * Flush buffered output. Called before forking, so that child processes
+   * don't inherit and repeat pending output.
+   */
+  void flush() { this->do_flush(); }
+
   /*!
    * Used to track progress for interactive progress display:
    *
@@ -199,6 +205,7 @@ protected:
   }
 
   virtual void do_print_benchmark_results(const benchmark_vector &) {}
+  virtual void do_flush();
 
   virtual void do_set_completed_state_count(std::size_t states);
   virtual void do_add_completed_state();
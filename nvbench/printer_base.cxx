@@ -31,6 +31,8 @@ printer_base::printer_base(std::ostream &ostream, std::string stream_name)
 // Defined here to keep <ostream> out of the header
 printer_base::~printer_base() = default;
 
+void printer_base::do_flush() { m_ostream.flush(); }
+
 void printer_base::do_set_completed_state_count(std::size_t states)
 {
   m_completed_state_count = states;
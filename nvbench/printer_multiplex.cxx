@@ -93,6 +93,15 @@ void printer_multiplex::do_print_benchmark_results(const benchmark_vector &bench
     format_ptr->print_benchmark_results(benches);
   }
 }
+
+void printer_multiplex::do_flush()
+{
+  for (auto &format_ptr : m_printers)
+  {
+    format_ptr->flush();
+  }
+}
+
 void printer_multiplex::do_set_completed_state_count(std::size_t states)
 {
   printer_base::do_set_completed_state_count(states);
@@ -18,8 +18,12 @@
 
 #pragma once
 
+#include <nvbench/detail/throw.cuh>
 #include <nvbench/types.cuh>
 
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -31,7 +35,35 @@ namespace detail
 template <typename T>
 using range_output_t =
   std::conditional_t<std::is_floating_point_v<T>, nvbench::float64_t, nvbench::int64_t>;
+
+// `count` values `start * 10^(decades * i / steps)`. Integers are rounded and
+// repeated values dropped:
+template <typename OutT>
+std::vector<OutT> log_series(nvbench::float64_t start,
+                             nvbench::float64_t decades,
+                             nvbench::float64_t steps,
+                             std::size_t count)
+{
+  std::vector<OutT> result;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto value = start * std::pow(10., decades * static_cast<nvbench::float64_t>(i) / steps);
+    if constexpr (std::is_integral_v<OutT>)
+    {
+      const auto rounded = static_cast<OutT>(std::llround(value));
+      if (result.empty() || result.back() != rounded)
+      {
+        result.push_back(rounded);
+      }
+    }
+    else
+    {
+      result.push_back(static_cast<OutT>(value));
+    }
+  }
+  return result;
 }
+} // namespace detail
 
 template <typename InT, typename OutT = nvbench::detail::range_output_t<InT>>
 auto range(InT start, InT end, InT stride = InT{1})
@@ -49,4 +81,52 @@ auto range(InT start, InT end, InT stride = InT{1})
   return result;
 }
 
+/// Values from `start` to at most `end`, evenly spaced on a log scale with
+/// `points_per_decade` values per power of ten, e.g.
+/// `log_range(1, 1000, 2) == {1, 3, 10, 32, 100, 316, 1000}`.
+/// Integer results are rounded to the nearest integer, without duplicates.
+template <typename InT, typename OutT = nvbench::detail::range_output_t<InT>>
+auto log_range(InT start, InT end, nvbench::int64_t points_per_decade)
+{
+  const auto d_start = static_cast<nvbench::float64_t>(start);
+  const auto d_end   = static_cast<nvbench::float64_t>(end);
+  NVBENCH_THROW_IF(!(d_start > 0.) || !(d_end >= d_start) || points_per_decade < 1,
+                   std::invalid_argument,
+                   "Invalid log range: start={}, end={}, points_per_decade={}",
+                   d_start,
+                   d_end,
+                   points_per_decade);
+
+  const auto d_points = static_cast<nvbench::float64_t>(points_per_decade);
+  // Pad end to account for floating point errors:
+  const auto count = static_cast<std::size_t>(std::log10(d_end / d_start) * d_points + 1e-9) + 1;
+  return nvbench::detail::log_series<OutT>(d_start, 1., d_points, count);
+}
+
+/// `count` values from `start` to `end`, both included, where each value is a
+/// constant factor larger than the previous one, e.g.
+/// `geometric_range(2, 162, 5) == {2, 6, 18, 54, 162}`.
+/// Integer results are rounded to the nearest integer, without duplicates.
+template <typename InT, typename OutT = nvbench::detail::range_output_t<InT>>
+auto geometric_range(InT start, InT end, std::size_t count)
+{
+  const auto d_start = static_cast<nvbench::float64_t>(start);
+  const auto d_end   = static_cast<nvbench::float64_t>(end);
+  NVBENCH_THROW_IF(!(d_start > 0.) || !(d_end >= d_start) || count < 1,
+                   std::invalid_argument,
+                   "Invalid geometric range: start={}, end={}, count={}",
+                   d_start,
+                   d_end,
+                   count);
+
+  const auto decades = std::log10(d_end / d_start);
+  const auto steps   = static_cast<nvbench::float64_t>(count > 1 ? count - 1 : 1);
+  auto result        = nvbench::detail::log_series<OutT>(d_start, decades, steps, count);
+  if constexpr (std::is_floating_point_v<OutT>)
+  { // Avoid rounding errors at the end:
+    result.back() = static_cast<OutT>(end);
+  }
+  return result;
+}
+
 } // namespace nvbench
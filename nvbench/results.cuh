@@ -0,0 +1,346 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/*!
+ * @file results.cuh
+ * Reader for the files written by `--json`.
+ *
+ * The `nvbench::results` library (CMake target `nvbench::results`) is a
+ * host-only C++ library that does not depend on CUDA or on the benchmarking
+ * library itself, so that comparison, merge and reporting tools can load
+ * result files without reimplementing `scripts/nvbench_json/reader.py`.
+ *
+ * ```cpp
+ * const auto file   = nvbench::results::result_file::read("results.json");
+ * const auto &bench = file.get_benchmark("my_benchmark");
+ * const auto &state = bench.get_state("Device=0 Elements=2^20");
+ * const auto mean   = state.get_summary("nv/cold/time/gpu/mean").get_float64("value");
+ * const auto times  = file.map_sample_times(state);
+ * ```
+ *
+ * Summary descriptors are expanded while reading, so summaries always report
+ * their full metadata. Lookups of benchmarks by name, states by name and
+ * summaries by tag are constant time.
+ */
+
+namespace nvbench::results
+{
+
+/// A value read from a result file.
+using value_type = std::variant<nvbench::int64_t, nvbench::float64_t, std::string>;
+
+/**
+ * Ordered name/value pairs, e.g. axis values or the data of a summary.
+ * Mirrors the read-only interface of nvbench::named_values.
+ */
+struct named_values
+{
+  [[nodiscard]] std::size_t get_size() const { return m_values.size(); }
+  [[nodiscard]] std::vector<std::string> get_names() const;
+
+  [[nodiscard]] bool has_value(const std::string &name) const;
+  [[nodiscard]] const value_type &get_value(const std::string &name) const;
+
+  [[nodiscard]] nvbench::int64_t get_int64(const std::string &name) const;
+  /// Also converts int64 values.
+  [[nodiscard]] nvbench::float64_t get_float64(const std::string &name) const;
+  [[nodiscard]] const std::string &get_string(const std::string &name) const;
+
+  /// Values in file order.
+  [[nodiscard]] const std::vector<std::pair<std::string, value_type>> &get_values() const
+  {
+    return m_values;
+  }
+
+  void set_value(std::string name, value_type value);
+
+private:
+  std::vector<std::pair<std::string, value_type>> m_values;
+  std::unordered_map<std::string, std::size_t> m_index;
+};
+
+/// A summary of a state or summary group, with its descriptor metadata.
+struct summary : named_values
+{
+  [[nodiscard]] const std::string &get_tag() const { return m_tag; }
+  /// Falls back to the tag for summaries without a name.
+  [[nodiscard]] const std::string &get_name() const { return m_name.empty() ? m_tag : m_name; }
+  [[nodiscard]] const std::string &get_hint() const { return m_hint; }
+  [[nodiscard]] const std::string &get_description() const { return m_description; }
+  [[nodiscard]] const std::string &get_hide() const { return m_hide; }
+  [[nodiscard]] bool is_hidden() const { return m_is_hidden; }
+
+private:
+  friend struct result_file;
+
+  std::string m_tag;
+  std::string m_name;
+  std::string m_hint;
+  std::string m_description;
+  std::string m_hide;
+  bool m_is_hidden{};
+};
+
+/// Summaries in file order, indexed by tag.
+struct summary_list
+{
+  [[nodiscard]] std::size_t size() const { return m_summaries.size(); }
+  [[nodiscard]] bool empty() const { return m_summaries.empty(); }
+  [[nodiscard]] auto begin() const { return m_summaries.cbegin(); }
+  [[nodiscard]] auto end() const { return m_summaries.cend(); }
+  [[nodiscard]] const summary &operator[](std::size_t i) const { return m_summaries[i]; }
+
+  /// Returns nullptr if no summary has `tag`.
+  [[nodiscard]] const summary *find(const std::string &tag) const;
+  /// Throws if no summary has `tag`.
+  [[nodiscard]] const summary &get(const std::string &tag) const;
+
+private:
+  friend struct result_file;
+
+  std::vector<summary> m_summaries;
+  std::unordered_map<std::string, std::size_t> m_index;
+};
+
+struct state
+{
+  /// e.g. "Device=0 Elements=2^20 T=I32". Unique within a benchmark.
+  [[nodiscard]] const std::string &get_name() const { return m_name; }
+  /// std::nullopt for states without a device, e.g. CPU-only benchmarks.
+  [[nodiscard]] std::optional<nvbench::int64_t> get_device() const { return m_device; }
+  [[nodiscard]] nvbench::int64_t get_type_config_index() const { return m_type_config_index; }
+
+  [[nodiscard]] nvbench::int64_t get_min_samples() const { return m_min_samples; }
+  [[nodiscard]] nvbench::float64_t get_skip_time() const { return m_skip_time; }
+  [[nodiscard]] nvbench::float64_t get_timeout() const { return m_timeout; }
+
+  [[nodiscard]] const named_values &get_axis_values() const { return m_axis_values; }
+
+  [[nodiscard]] const summary_list &get_summaries() const { return m_summaries; }
+  [[nodiscard]] const summary *find_summary(const std::string &tag) const
+  {
+    return m_summaries.find(tag);
+  }
+  [[nodiscard]] const summary &get_summary(const std::string &tag) const
+  {
+    return m_summaries.get(tag);
+  }
+
+  [[nodiscard]] bool is_skipped() const { return m_is_skipped; }
+  [[nodiscard]] const std::string &get_skip_reason() const { return m_skip_reason; }
+
+private:
+  friend struct result_file;
+
+  std::string m_name;
+  std::optional<nvbench::int64_t> m_device;
+  nvbench::int64_t m_type_config_index{};
+  nvbench::int64_t m_min_samples{};
+  nvbench::float64_t m_skip_time{};
+  nvbench::float64_t m_timeout{};
+  named_values m_axis_values;
+  summary_list m_summaries;
+  bool m_is_skipped{};
+  std::string m_skip_reason;
+};
+
+/// Benchmark-level summaries, e.g. complexity fits.
+struct summary_group
+{
+  [[nodiscard]] std::optional<nvbench::int64_t> get_device() const { return m_device; }
+  /// Only the axes shared by all states in the group.
+  [[nodiscard]] const named_values &get_axis_values() const { return m_axis_values; }
+  [[nodiscard]] const summary_list &get_summaries() const { return m_summaries; }
+
+private:
+  friend struct result_file;
+
+  std::optional<nvbench::int64_t> m_device;
+  named_values m_axis_values;
+  summary_list m_summaries;
+};
+
+struct axis
+{
+  [[nodiscard]] const std::string &get_name() const { return m_name; }
+  /// "type", "int64", "float64" or "string".
+  [[nodiscard]] const std::string &get_type() const { return m_type; }
+  [[nodiscard]] const std::string &get_flags() const { return m_flags; }
+  /// The values as given on the command line, e.g. "20" for `--axis N[pow2]=20`.
+  [[nodiscard]] const std::vector<std::string> &get_input_strings() const
+  {
+    return m_input_strings;
+  }
+
+private:
+  friend struct result_file;
+
+  std::string m_name;
+  std::string m_type;
+  std::string m_flags;
+  std::vector<std::string> m_input_strings;
+};
+
+struct benchmark
+{
+  [[nodiscard]] const std::string &get_name() const { return m_name; }
+  [[nodiscard]] nvbench::int64_t get_index() const { return m_index; }
+  [[nodiscard]] const std::vector<nvbench::int64_t> &get_devices() const { return m_devices; }
+  [[nodiscard]] const std::vector<axis> &get_axes() const { return m_axes; }
+  /// The order states were run in, e.g. "random:1234"; "canonical" for older files.
+  [[nodiscard]] const std::string &get_run_order() const { return m_run_order; }
+
+  [[nodiscard]] const std::vector<state> &get_states() const { return m_states; }
+  /// Returns nullptr if no state is named `name`.
+  [[nodiscard]] const state *find_state(const std::string &name) const;
+  /// Throws if no state is named `name`.
+  [[nodiscard]] const state &get_state(const std::string &name) const;
+
+  [[nodiscard]] const std::vector<summary_group> &get_summary_groups() const
+  {
+    return m_summary_groups;
+  }
+
+private:
+  friend struct result_file;
+
+  std::string m_name;
+  nvbench::int64_t m_index{};
+  std::vector<nvbench::int64_t> m_devices;
+  std::vector<axis> m_axes;
+  std::string m_run_order;
+  std::vector<state> m_states;
+  std::unordered_map<std::string, std::size_t> m_state_index;
+  std::vector<summary_group> m_summary_groups;
+};
+
+/**
+ * Read-only view of a `.bin` sample-times file written by `--jsonbin`.
+ *
+ * The file is memory-mapped where supported, so only the pages that are
+ * accessed are read. Otherwise, or on big-endian hosts, it is read into
+ * memory.
+ */
+struct sample_times
+{
+  explicit sample_times(const std::string &filename);
+  ~sample_times();
+
+  // Owns the mapping:
+  sample_times(const sample_times &)            = delete;
+  sample_times &operator=(const sample_times &) = delete;
+  sample_times(sample_times &&other) noexcept;
+  sample_times &operator=(sample_times &&other) noexcept;
+
+  [[nodiscard]] const std::string &get_filename() const { return m_filename; }
+
+  [[nodiscard]] std::size_t size() const { return m_size; }
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+  [[nodiscard]] const nvbench::float32_t *data() const { return m_data; }
+  [[nodiscard]] const nvbench::float32_t *begin() const { return m_data; }
+  [[nodiscard]] const nvbench::float32_t *end() const { return m_data + m_size; }
+  [[nodiscard]] nvbench::float32_t operator[](std::size_t i) const { return m_data[i]; }
+
+private:
+  void unmap();
+
+  std::string m_filename;
+  void *m_mapping{};
+  std::size_t m_mapping_nbytes{};
+  std::vector<nvbench::float32_t> m_buffer;
+
+  const nvbench::float32_t *m_data{};
+  std::size_t m_size{};
+};
+
+struct result_file
+{
+  struct version_t
+  {
+    nvbench::int64_t major{};
+    nvbench::int64_t minor{};
+    nvbench::int64_t patch{};
+  };
+
+  struct device
+  {
+    nvbench::int64_t id{};
+    std::string name;
+  };
+
+  /**
+   * Reads a file written by `--json`.
+   *
+   * Throws if the file cannot be parsed or was written with a different major
+   * file version. Files older than the versioned format are read on a
+   * best-effort basis.
+   */
+  [[nodiscard]] static result_file read(const std::string &filename);
+
+  [[nodiscard]] const std::string &get_filename() const { return m_filename; }
+  /// std::nullopt for files older than the versioned format.
+  [[nodiscard]] const std::optional<version_t> &get_version() const { return m_version; }
+  /// The command line of the run that wrote the file.
+  [[nodiscard]] const std::vector<std::string> &get_argv() const { return m_argv; }
+  [[nodiscard]] const std::vector<device> &get_devices() const { return m_devices; }
+
+  [[nodiscard]] const std::vector<benchmark> &get_benchmarks() const { return m_benchmarks; }
+  /// Returns nullptr if no benchmark is named `name`.
+  [[nodiscard]] const benchmark *find_benchmark(const std::string &name) const;
+  /// Throws if no benchmark is named `name`.
+  [[nodiscard]] const benchmark &get_benchmark(const std::string &name) const;
+
+  /**
+   * Maps the sample times recorded for `state`.
+   *
+   * `tag` selects the measurement, e.g. "nv/cold/sample_times"; if empty, the
+   * first sample-times file of the state is used. Relative filenames are
+   * looked up as written and then in the `<json file>-bin` directory next to
+   * this file, so results can be moved together with their bin directory.
+   * Throws if the state has no matching file.
+   */
+  [[nodiscard]] sample_times map_sample_times(const state &state,
+                                              const std::string &tag = {}) const;
+
+  /// Locates a sample-times file recorded in `json_filename` as described for
+  /// map_sample_times. Returns `bin_filename` unchanged if neither path exists.
+  [[nodiscard]] static std::string resolve_bin_filename(const std::string &json_filename,
+                                                        const std::string &bin_filename);
+
+private:
+  std::string m_filename;
+  std::optional<version_t> m_version;
+  std::vector<std::string> m_argv;
+  std::vector<device> m_devices;
+  std::vector<benchmark> m_benchmarks;
+  std::unordered_map<std::string, std::size_t> m_benchmark_index;
+};
+
+} // namespace nvbench::results
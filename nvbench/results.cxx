@@ -0,0 +1,593 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/results.cuh>
+
+#include <nlohmann/json.hpp>
+
+#include <fmt/format.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NVBENCH_RESULTS_HAS_MMAP 1
+#endif
+
+namespace
+{
+
+bool is_little_endian() noexcept
+{
+  const nvbench::uint32_t word = {0xBadDecaf};
+  nvbench::uint8_t bytes[4];
+  std::memcpy(bytes, &word, 4);
+  return bytes[0] == 0xaf;
+}
+
+std::string read_text_file(const std::string &filename)
+{
+  std::ifstream in{filename, std::ios::binary};
+  NVBENCH_THROW_IF(!in, std::runtime_error, "Failed to open result file '{}'.", filename);
+  return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+template <typename JsonNode>
+std::string get_string_or_empty(const JsonNode &node, const char *key)
+{
+  const auto it = node.find(key);
+  return it != node.end() && it->is_string() ? it->template get<std::string>() : std::string{};
+}
+
+template <typename JsonNode>
+std::optional<nvbench::int64_t> get_device(const JsonNode &node)
+{
+  const auto it = node.find("device");
+  if (it == node.end() || !it->is_number_integer())
+  {
+    return std::nullopt;
+  }
+  return it->template get<nvbench::int64_t>();
+}
+
+// Reads [{name, type, value}, ...] as written by json_printer. Numbers are
+// stored as strings to avoid truncating int64s.
+template <typename JsonNode>
+void read_named_values(const JsonNode &node, nvbench::results::named_values &values)
+{
+  if (!node.is_array())
+  {
+    return;
+  }
+
+  for (const auto &value : node)
+  {
+    auto name       = value.at("name").template get<std::string>();
+    const auto type = value.at("type").template get<std::string>();
+    const auto &val = value.at("value");
+
+    if (type == "int64")
+    {
+      values.set_value(std::move(name),
+                       val.is_string() ? std::stoll(val.template get<std::string>())
+                                       : val.template get<nvbench::int64_t>());
+    }
+    else if (type == "float64")
+    {
+      values.set_value(std::move(name),
+                       val.is_string() ? std::stod(val.template get<std::string>())
+                                       : val.template get<nvbench::float64_t>());
+    }
+    else if (type == "string")
+    {
+      values.set_value(std::move(name), val.template get<std::string>());
+    }
+    else
+    {
+      NVBENCH_THROW(std::runtime_error, "Unrecognized value type '{}'.", type);
+    }
+  }
+}
+
+} // namespace
+
+namespace nvbench::results
+{
+
+std::vector<std::string> named_values::get_names() const
+{
+  std::vector<std::string> names;
+  names.reserve(m_values.size());
+  for (const auto &[name, value] : m_values)
+  {
+    names.push_back(name);
+  }
+  return names;
+}
+
+bool named_values::has_value(const std::string &name) const
+{
+  return m_index.find(name) != m_index.cend();
+}
+
+const value_type &named_values::get_value(const std::string &name) const
+{
+  const auto it = m_index.find(name);
+  NVBENCH_THROW_IF(it == m_index.cend(), std::runtime_error, "No value with name '{}'.", name);
+  return m_values[it->second].second;
+}
+
+nvbench::int64_t named_values::get_int64(const std::string &name) const
+{
+  const auto *value = std::get_if<nvbench::int64_t>(&this->get_value(name));
+  NVBENCH_THROW_IF(value == nullptr, std::runtime_error, "Value '{}' is not an int64.", name);
+  return *value;
+}
+
+nvbench::float64_t named_values::get_float64(const std::string &name) const
+{
+  const auto &value = this->get_value(name);
+  if (const auto *int_value = std::get_if<nvbench::int64_t>(&value))
+  {
+    return static_cast<nvbench::float64_t>(*int_value);
+  }
+  const auto *float_value = std::get_if<nvbench::float64_t>(&value);
+  NVBENCH_THROW_IF(float_value == nullptr,
+                   std::runtime_error,
+                   "Value '{}' is not a float64.",
+                   name);
+  return *float_value;
+}
+
+const std::string &named_values::get_string(const std::string &name) const
+{
+  const auto *value = std::get_if<std::string>(&this->get_value(name));
+  NVBENCH_THROW_IF(value == nullptr, std::runtime_error, "Value '{}' is not a string.", name);
+  return *value;
+}
+
+void named_values::set_value(std::string name, value_type value)
+{
+  if (const auto it = m_index.find(name); it != m_index.cend())
+  {
+    m_values[it->second].second = std::move(value);
+    return;
+  }
+  m_index.emplace(name, m_values.size());
+  m_values.emplace_back(std::move(name), std::move(value));
+}
+
+const summary *summary_list::find(const std::string &tag) const
+{
+  const auto it = m_index.find(tag);
+  return it == m_index.cend() ? nullptr : &m_summaries[it->second];
+}
+
+const summary &summary_list::get(const std::string &tag) const
+{
+  const auto *summ = this->find(tag);
+  NVBENCH_THROW_IF(summ == nullptr, std::runtime_error, "No summary with tag '{}'.", tag);
+  return *summ;
+}
+
+const state *benchmark::find_state(const std::string &name) const
+{
+  const auto it = m_state_index.find(name);
+  return it == m_state_index.cend() ? nullptr : &m_states[it->second];
+}
+
+const state &benchmark::get_state(const std::string &name) const
+{
+  const auto *st = this->find_state(name);
+  NVBENCH_THROW_IF(st == nullptr,
+                   std::runtime_error,
+                   "Benchmark '{}' has no state named '{}'.",
+                   m_name,
+                   name);
+  return *st;
+}
+
+sample_times::sample_times(const std::string &filename)
+    : m_filename{filename}
+{
+  constexpr std::size_t value_nbytes = sizeof(nvbench::float32_t);
+
+#ifdef NVBENCH_RESULTS_HAS_MMAP
+  if (::is_little_endian())
+  {
+    const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    NVBENCH_THROW_IF(fd == -1,
+                     std::runtime_error,
+                     "Failed to open sample times file '{}': {}",
+                     filename,
+                     std::strerror(errno));
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0)
+    {
+      const int error = errno;
+      close(fd);
+      NVBENCH_THROW(std::runtime_error,
+                    "Failed to stat sample times file '{}': {}",
+                    filename,
+                    std::strerror(error));
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size) / value_nbytes;
+    if (m_size != 0)
+    {
+      m_mapping_nbytes = m_size * value_nbytes;
+      void *mapping    = mmap(nullptr, m_mapping_nbytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED)
+      {
+        const int error = errno;
+        close(fd);
+        NVBENCH_THROW(std::runtime_error,
+                      "Failed to map sample times file '{}': {}",
+                      filename,
+                      std::strerror(error));
+      }
+      m_mapping = mapping;
+      m_data    = static_cast<const nvbench::float32_t *>(m_mapping);
+    }
+
+    // The mapping stays valid after the descriptor is closed:
+    close(fd);
+    return;
+  }
+#endif
+
+  std::ifstream in{filename, std::ios::binary | std::ios::ate};
+  NVBENCH_THROW_IF(!in, std::runtime_error, "Failed to open sample times file '{}'.", filename);
+  const auto nbytes = static_cast<std::size_t>(in.tellg());
+  in.seekg(0);
+
+  m_buffer.resize(nbytes / value_nbytes);
+  in.read(reinterpret_cast<char *>(m_buffer.data()),
+          static_cast<std::streamsize>(m_buffer.size() * value_nbytes));
+  NVBENCH_THROW_IF(!in, std::runtime_error, "Failed to read sample times file '{}'.", filename);
+
+  if (!::is_little_endian())
+  {
+    for (auto &value : m_buffer)
+    {
+      auto *bytes = reinterpret_cast<char *>(&value);
+      std::swap(bytes[0], bytes[3]);
+      std::swap(bytes[1], bytes[2]);
+    }
+  }
+
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+}
+
+sample_times::~sample_times() { this->unmap(); }
+
+sample_times::sample_times(sample_times &&other) noexcept
+    : m_filename{std::move(other.m_filename)}
+    , m_mapping{std::exchange(other.m_mapping, nullptr)}
+    , m_mapping_nbytes{std::exchange(other.m_mapping_nbytes, 0)}
+    , m_buffer{std::move(other.m_buffer)}
+    , m_data{std::exchange(other.m_data, nullptr)}
+    , m_size{std::exchange(other.m_size, 0)}
+{
+  // Moving a vector keeps its storage, so m_data remains valid.
+}
+
+sample_times &sample_times::operator=(sample_times &&other) noexcept
+{
+  if (this != &other)
+  {
+    this->unmap();
+    m_filename       = std::move(other.m_filename);
+    m_mapping        = std::exchange(other.m_mapping, nullptr);
+    m_mapping_nbytes = std::exchange(other.m_mapping_nbytes, 0);
+    m_buffer         = std::move(other.m_buffer);
+    m_data           = std::exchange(other.m_data, nullptr);
+    m_size           = std::exchange(other.m_size, 0);
+  }
+  return *this;
+}
+
+void sample_times::unmap()
+{
+#ifdef NVBENCH_RESULTS_HAS_MMAP
+  if (m_mapping != nullptr)
+  {
+    munmap(m_mapping, m_mapping_nbytes);
+    m_mapping = nullptr;
+  }
+#endif
+}
+
+result_file result_file::read(const std::string &filename)
+{
+  using json = nlohmann::json;
+
+  json root;
+  try
+  {
+    root = json::parse(::read_text_file(filename));
+  }
+  catch (json::exception &e)
+  {
+    NVBENCH_THROW(std::runtime_error, "Failed to parse result file '{}': {}", filename, e.what());
+  }
+
+  result_file file;
+  file.m_filename = filename;
+
+  try
+  {
+    if (const auto meta = root.find("meta"); meta != root.end())
+    {
+      if (const auto argv = meta->find("argv"); argv != meta->end() && argv->is_array())
+      {
+        file.m_argv = argv->get<std::vector<std::string>>();
+      }
+      if (meta->contains("version") && meta->at("version").contains("json"))
+      {
+        const auto &version = meta->at("version").at("json");
+        file.m_version      = version_t{version.at("major").get<nvbench::int64_t>(),
+                                   version.at("minor").get<nvbench::int64_t>(),
+                                   version.at("patch").get<nvbench::int64_t>()};
+      }
+    }
+
+    // Minor versions only add to the format:
+    NVBENCH_THROW_IF(file.m_version && file.m_version->major != 1,
+                     std::runtime_error,
+                     "Result file '{}' has unsupported JSON file version {}.{}.{}.",
+                     filename,
+                     file.m_version->major,
+                     file.m_version->minor,
+                     file.m_version->patch);
+
+    if (const auto devices = root.find("devices"); devices != root.end() && devices->is_array())
+    {
+      for (const auto &dev : *devices)
+      {
+        file.m_devices.push_back(
+          device{dev.at("id").get<nvbench::int64_t>(), ::get_string_or_empty(dev, "name")});
+      }
+    }
+
+    // Metadata of summaries that were written with only a tag:
+    std::unordered_map<std::string, const json *> descriptors;
+    if (const auto descs = root.find("summary_descriptors");
+        descs != root.end() && descs->is_array())
+    {
+      for (const auto &desc : *descs)
+      {
+        descriptors.emplace(desc.at("tag").get<std::string>(), &desc);
+      }
+    }
+
+    // Since 1.5.0, summaries created from a descriptor are marked so that
+    // ad-hoc summaries reusing its tag don't pick up its metadata:
+    const bool has_markers = file.m_version && file.m_version->minor >= 5;
+
+    const auto read_summaries = [&descriptors, has_markers](const json &node,
+                                                            summary_list &summaries) {
+      if (!node.is_array())
+      {
+        return;
+      }
+
+      summaries.m_summaries.reserve(node.size());
+      for (const auto &summ_node : node)
+      {
+        auto &summ = summaries.m_summaries.emplace_back();
+        summ.m_tag = summ_node.at("tag").get<std::string>();
+
+        // Keys written in the summary take precedence over its descriptor:
+        const auto desc_it      = descriptors.find(summ.m_tag);
+        const bool is_described = !has_markers || summ_node.value("descriptor", false);
+        const json *desc =
+          is_described && desc_it != descriptors.cend() ? desc_it->second : nullptr;
+        const auto lookup  = [&summ_node, desc](const char *key) {
+          auto value = ::get_string_or_empty(summ_node, key);
+          return value.empty() && desc != nullptr ? ::get_string_or_empty(*desc, key) : value;
+        };
+        summ.m_name        = lookup("name");
+        summ.m_hint        = lookup("hint");
+        summ.m_description = lookup("description");
+        summ.m_hide        = lookup("hide");
+        summ.m_is_hidden =
+          summ_node.contains("hide") || (desc != nullptr && desc->contains("hide"));
+
+        if (const auto data = summ_node.find("data"); data != summ_node.end())
+        {
+          ::read_named_values(*data, summ);
+        }
+
+        summaries.m_index.emplace(summ.m_tag, summaries.m_summaries.size() - 1);
+      }
+    };
+
+    const auto &benchmarks = root.at("benchmarks");
+    file.m_benchmarks.reserve(benchmarks.size());
+    for (const auto &bench_node : benchmarks)
+    {
+      auto &bench       = file.m_benchmarks.emplace_back();
+      bench.m_name      = bench_node.at("name").get<std::string>();
+      bench.m_index     = bench_node.at("index").get<nvbench::int64_t>();
+      bench.m_run_order = bench_node.value("run_order", std::string{"canonical"});
+
+      if (const auto devices = bench_node.find("devices");
+          devices != bench_node.end() && devices->is_array())
+      {
+        bench.m_devices = devices->get<std::vector<nvbench::int64_t>>();
+      }
+
+      if (const auto axes = bench_node.find("axes"); axes != bench_node.end())
+      {
+        for (const auto &axis_node : *axes)
+        {
+          auto &ax   = bench.m_axes.emplace_back();
+          ax.m_name  = axis_node.at("name").get<std::string>();
+          ax.m_type  = axis_node.at("type").get<std::string>();
+          ax.m_flags = ::get_string_or_empty(axis_node, "flags");
+          for (const auto &value : axis_node.at("values"))
+          {
+            ax.m_input_strings.push_back(::get_string_or_empty(value, "input_string"));
+          }
+        }
+      }
+
+      if (const auto states = bench_node.find("states"); states != bench_node.end())
+      {
+        bench.m_states.reserve(states->size());
+        for (const auto &state_node : *states)
+        {
+          auto &st               = bench.m_states.emplace_back();
+          st.m_name              = state_node.at("name").get<std::string>();
+          st.m_device            = ::get_device(state_node);
+          st.m_type_config_index = state_node.value("type_config_index", nvbench::int64_t{});
+          st.m_min_samples       = state_node.value("min_samples", nvbench::int64_t{});
+          st.m_skip_time         = state_node.value("skip_time", nvbench::float64_t{});
+          st.m_timeout           = state_node.value("timeout", nvbench::float64_t{});
+          st.m_is_skipped        = state_node.value("is_skipped", false);
+          st.m_skip_reason       = ::get_string_or_empty(state_node, "skip_reason");
+
+          if (const auto values = state_node.find("axis_values"); values != state_node.end())
+          {
+            ::read_named_values(*values, st.m_axis_values);
+          }
+          if (const auto summs = state_node.find("summaries"); summs != state_node.end())
+          {
+            read_summaries(*summs, st.m_summaries);
+          }
+
+          bench.m_state_index.emplace(st.m_name, bench.m_states.size() - 1);
+        }
+      }
+
+      if (const auto groups = bench_node.find("summary_groups"); groups != bench_node.end())
+      {
+        for (const auto &group_node : *groups)
+        {
+          auto &group    = bench.m_summary_groups.emplace_back();
+          group.m_device = ::get_device(group_node);
+          if (const auto values = group_node.find("axis_values"); values != group_node.end())
+          {
+            ::read_named_values(*values, group.m_axis_values);
+          }
+          if (const auto summs = group_node.find("summaries"); summs != group_node.end())
+          {
+            read_summaries(*summs, group.m_summaries);
+          }
+        }
+      }
+
+      file.m_benchmark_index.emplace(bench.m_name, file.m_benchmarks.size() - 1);
+    }
+  }
+  catch (json::exception &e)
+  {
+    NVBENCH_THROW(std::runtime_error, "Failed to read result file '{}': {}", filename, e.what());
+  }
+
+  return file;
+}
+
+const benchmark *result_file::find_benchmark(const std::string &name) const
+{
+  const auto it = m_benchmark_index.find(name);
+  return it == m_benchmark_index.cend() ? nullptr : &m_benchmarks[it->second];
+}
+
+const benchmark &result_file::get_benchmark(const std::string &name) const
+{
+  const auto *bench = this->find_benchmark(name);
+  NVBENCH_THROW_IF(bench == nullptr,
+                   std::runtime_error,
+                   "Result file '{}' has no benchmark named '{}'.",
+                   m_filename,
+                   name);
+  return *bench;
+}
+
+sample_times result_file::map_sample_times(const state &state, const std::string &tag) const
+{
+  const summary *file_summ{};
+  if (tag.empty())
+  {
+    for (const auto &summ : state.get_summaries())
+    {
+      if (summ.get_hint() == "file/sample_times")
+      {
+        file_summ = &summ;
+        break;
+      }
+    }
+  }
+  else
+  {
+    file_summ = state.find_summary(fmt::format("nv/json/bin:{}", tag));
+  }
+
+  NVBENCH_THROW_IF(file_summ == nullptr || !file_summ->has_value("filename"),
+                   std::runtime_error,
+                   "State '{}' has no sample times file{}. Were the results written with "
+                   "--jsonbin?",
+                   state.get_name(),
+                   tag.empty() ? std::string{} : fmt::format(" for '{}'", tag));
+
+  return sample_times{
+    result_file::resolve_bin_filename(m_filename, file_summ->get_string("filename"))};
+}
+
+std::string result_file::resolve_bin_filename(const std::string &json_filename,
+                                              const std::string &bin_filename)
+{
+  // json_printer writes paths relative to the working directory of the run,
+  // as `<json file>-bin/<N>.bin`:
+  const fs::path written{bin_filename};
+  if (fs::exists(written) || !written.is_relative())
+  {
+    return bin_filename;
+  }
+
+  const fs::path json_path{json_filename};
+  const auto moved =
+    json_path.parent_path() / (json_path.filename().string() + "-bin") / written.filename();
+  return fs::exists(moved) ? moved.string() : bin_filename;
+}
+
+} // namespace nvbench::results
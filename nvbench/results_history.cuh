@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/results.cuh>
+#include <nvbench/types.cuh>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nvbench::results
+{
+
+/// One measurement of one state, as stored in a history file.
+struct history_record
+{
+  /// Revision of the benchmarked project, e.g. a git commit hash.
+  std::string revision;
+  std::string host;
+  /// Device name, or "cpu" for states without a device.
+  std::string device;
+  std::string benchmark;
+  std::string state;
+  /// The summary `value` was read from, e.g. "nv/cold/time/gpu/mean".
+  std::string tag;
+  nvbench::float64_t value{};
+  /// Relative standard deviation of the measurement; infinite if unknown.
+  nvbench::float64_t noise{};
+  nvbench::int64_t samples{};
+  /// Seconds since the epoch at which the record was appended.
+  nvbench::int64_t timestamp{};
+};
+
+/**
+ * Extracts one record per non-skipped state of `file`.
+ *
+ * The mean time is taken from the first of the cold GPU, CPU-only, async
+ * latency and batch GPU measurements that the state has (`nv/cold/time/gpu/mean`,
+ * `nv/cpu_only/time/cpu/mean`, `nv/async/time/latency/mean` and
+ * `nv/batch/time/gpu/mean`), matching `--baseline`. States without any of
+ * these are ignored.
+ */
+[[nodiscard]] std::vector<history_record>
+make_history_records(const result_file &file, const std::string &revision, const std::string &host);
+
+/**
+ * Append-only performance history, stored as one JSON object per line.
+ *
+ * Appends of a few records are a single write to a file opened in append
+ * mode, so concurrent writers on a local file system do not interleave
+ * records. Lines that cannot be parsed, e.g. a partial line left by an
+ * interrupted writer, are skipped when reading.
+ */
+struct history_store
+{
+  explicit history_store(std::string filename)
+      : m_filename{std::move(filename)}
+  {}
+
+  [[nodiscard]] const std::string &get_filename() const { return m_filename; }
+
+  void append(const std::vector<history_record> &records) const;
+
+  /// Records in the order they were appended; empty if the file does not exist.
+  [[nodiscard]] std::vector<history_record> read() const;
+
+private:
+  std::string m_filename;
+};
+
+/// Records of one (host, device, benchmark, state, tag), reduced to one value
+/// per revision.
+struct history_series
+{
+  std::string host;
+  std::string device;
+  std::string benchmark;
+  std::string state;
+  std::string tag;
+
+  /// Revisions in the order they first appear in the history.
+  std::vector<std::string> revisions;
+  /// Median of the values recorded for each revision.
+  std::vector<nvbench::float64_t> values;
+};
+
+/// Groups `records` into series, in order of first appearance.
+[[nodiscard]] std::vector<history_series>
+make_history_series(const std::vector<history_record> &records);
+
+/**
+ * Finds step changes in the mean of `values` with PELT (pruned exact linear
+ * time) segmentation.
+ *
+ * The cost of a segment is its sum of squared deviations from its mean,
+ * scaled by a noise estimate derived from the median absolute difference of
+ * consecutive values, so that `penalty` is in units of that noise. Each
+ * change point costs `penalty * log(n)`; larger penalties report fewer,
+ * larger changes. Segments are at least `min_segment_size` values long.
+ *
+ * Returns the index of the first value of each new segment, in increasing
+ * order.
+ */
+[[nodiscard]] std::vector<std::size_t>
+detect_change_points(const std::vector<nvbench::float64_t> &values,
+                     nvbench::float64_t penalty     = 2.,
+                     std::size_t min_segment_size = 2);
+
+} // namespace nvbench::results
@@ -0,0 +1,378 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/summary_lookup.cuh>
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/results.cuh>
+#include <nvbench/results_history.cuh>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define NVBENCH_RESULTS_HAS_POSIX_IO 1
+#endif
+
+namespace
+{
+
+using json = nlohmann::ordered_json;
+
+// "<measurement>/time/<clock>/mean" -> "<measurement>/<suffix>"
+std::string get_measurement_tag(const std::string &time_tag, const char *suffix)
+{
+  return time_tag.substr(0, time_tag.find("/time/") + 1) + suffix;
+}
+
+std::string get_device_name(const nvbench::results::result_file &file,
+                            const nvbench::results::state &state)
+{
+  const auto id = state.get_device();
+  if (!id)
+  {
+    return "cpu";
+  }
+  const auto &devices = file.get_devices();
+  const auto iter     = std::find_if(devices.cbegin(), devices.cend(), [&id](const auto &dev) {
+    return dev.id == *id;
+  });
+  return iter == devices.cend() ? "device " + std::to_string(*id) : iter->name;
+}
+
+nvbench::float64_t median(std::vector<nvbench::float64_t> values)
+{
+  const auto mid = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+  std::nth_element(values.begin(), mid, values.end());
+  if (values.size() % 2 != 0)
+  {
+    return *mid;
+  }
+  return (*mid + *std::max_element(values.begin(), mid)) / 2;
+}
+
+// Prefix sums for constant time segment costs:
+struct segment_cost
+{
+  explicit segment_cost(const std::vector<nvbench::float64_t> &values)
+      : m_sum(values.size() + 1)
+      , m_sum_sq(values.size() + 1)
+  {
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      m_sum[i + 1]    = m_sum[i] + values[i];
+      m_sum_sq[i + 1] = m_sum_sq[i] + values[i] * values[i];
+    }
+  }
+
+  // Sum of squared deviations from the mean of values [begin, end):
+  nvbench::float64_t operator()(std::size_t begin, std::size_t end) const
+  {
+    const auto n      = static_cast<nvbench::float64_t>(end - begin);
+    const auto sum    = m_sum[end] - m_sum[begin];
+    const auto sum_sq = m_sum_sq[end] - m_sum_sq[begin];
+    return std::max(sum_sq - sum * sum / n, 0.);
+  }
+
+private:
+  std::vector<nvbench::float64_t> m_sum;
+  std::vector<nvbench::float64_t> m_sum_sq;
+};
+
+} // namespace
+
+namespace nvbench::results
+{
+
+std::vector<history_record>
+make_history_records(const result_file &file, const std::string &revision, const std::string &host)
+{
+  const auto timestamp = static_cast<nvbench::int64_t>(std::time(nullptr));
+
+  std::vector<history_record> records;
+  for (const auto &bench : file.get_benchmarks())
+  {
+    for (const auto &state : bench.get_states())
+    {
+      if (state.is_skipped())
+      {
+        continue;
+      }
+
+      for (const std::string tag : nvbench::detail::preferred_time_tags)
+      {
+        const auto *mean = state.find_summary(tag);
+        if (mean == nullptr)
+        {
+          continue;
+        }
+
+        history_record record;
+        record.revision  = revision;
+        record.host      = host;
+        record.device    = ::get_device_name(file, state);
+        record.benchmark = bench.get_name();
+        record.state     = state.get_name();
+        record.tag       = tag;
+        record.value     = mean->get_float64("value");
+        record.noise     = std::numeric_limits<nvbench::float64_t>::infinity();
+        record.timestamp = timestamp;
+
+        const auto noise_tag = tag.substr(0, tag.rfind('/')) + "/stdev/relative";
+        if (const auto *noise = state.find_summary(noise_tag))
+        {
+          record.noise = noise->get_float64("value");
+        }
+        if (const auto *size = state.find_summary(::get_measurement_tag(tag, "sample_size")))
+        {
+          record.samples = size->get_int64("value");
+        }
+
+        records.push_back(std::move(record));
+        break;
+      }
+    }
+  }
+  return records;
+}
+
+void history_store::append(const std::vector<history_record> &records) const
+{
+  std::string lines;
+  for (const auto &record : records)
+  {
+    json node;
+    node["revision"]  = record.revision;
+    node["host"]      = record.host;
+    node["device"]    = record.device;
+    node["benchmark"] = record.benchmark;
+    node["state"]     = record.state;
+    node["tag"]       = record.tag;
+    node["value"]     = record.value;
+    // JSON has no infinity:
+    node["noise"]     = std::isfinite(record.noise) ? json(record.noise) : json(nullptr);
+    node["samples"]   = record.samples;
+    node["timestamp"] = record.timestamp;
+    lines += node.dump();
+    lines += '\n';
+  }
+  if (lines.empty())
+  {
+    return;
+  }
+
+#ifdef NVBENCH_RESULTS_HAS_POSIX_IO
+  const int fd = open(m_filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  NVBENCH_THROW_IF(fd == -1,
+                   std::runtime_error,
+                   "Failed to open history file '{}': {}",
+                   m_filename,
+                   std::strerror(errno));
+  const auto written = write(fd, lines.data(), lines.size());
+  const auto error   = errno;
+  close(fd);
+  NVBENCH_THROW_IF(written != static_cast<ssize_t>(lines.size()),
+                   std::runtime_error,
+                   "Failed to write history file '{}': {}",
+                   m_filename,
+                   std::strerror(error));
+#else
+  std::ofstream out{m_filename, std::ios::app | std::ios::binary};
+  out.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+  NVBENCH_THROW_IF(!out, std::runtime_error, "Failed to write history file '{}'.", m_filename);
+#endif
+}
+
+std::vector<history_record> history_store::read() const
+{
+  std::vector<history_record> records;
+
+  std::ifstream in{m_filename};
+  std::string line;
+  while (std::getline(in, line))
+  {
+    const auto node = json::parse(line, nullptr, false);
+    if (node.is_discarded() || !node.is_object())
+    {
+      continue;
+    }
+
+    try
+    {
+      history_record record;
+      record.revision  = node.at("revision").get<std::string>();
+      record.host      = node.at("host").get<std::string>();
+      record.device    = node.at("device").get<std::string>();
+      record.benchmark = node.at("benchmark").get<std::string>();
+      record.state     = node.at("state").get<std::string>();
+      record.tag       = node.at("tag").get<std::string>();
+      record.value     = node.at("value").get<nvbench::float64_t>();
+      record.noise     = node.value("noise", json{}).is_number()
+                           ? node["noise"].get<nvbench::float64_t>()
+                           : std::numeric_limits<nvbench::float64_t>::infinity();
+      record.samples   = node.value("samples", nvbench::int64_t{});
+      record.timestamp = node.value("timestamp", nvbench::int64_t{});
+      records.push_back(std::move(record));
+    }
+    catch (json::exception &)
+    {
+      // Not a history record.
+    }
+  }
+  return records;
+}
+
+std::vector<history_series> make_history_series(const std::vector<history_record> &records)
+{
+  std::vector<history_series> series;
+  std::map<std::tuple<std::string, std::string, std::string, std::string, std::string>,
+           std::size_t>
+    series_index;
+
+  // Values of each revision of each series:
+  std::vector<std::vector<std::vector<nvbench::float64_t>>> values;
+  std::vector<std::unordered_map<std::string, std::size_t>> revision_index;
+
+  for (const auto &record : records)
+  {
+    auto key = std::make_tuple(record.host,
+                               record.device,
+                               record.benchmark,
+                               record.state,
+                               record.tag);
+    const auto [iter, inserted] = series_index.emplace(std::move(key), series.size());
+    if (inserted)
+    {
+      series.push_back(
+        {record.host, record.device, record.benchmark, record.state, record.tag, {}, {}});
+      values.emplace_back();
+      revision_index.emplace_back();
+    }
+
+    const auto s                  = iter->second;
+    const auto [rev_iter, is_new] = revision_index[s].emplace(record.revision,
+                                                              series[s].revisions.size());
+    if (is_new)
+    {
+      series[s].revisions.push_back(record.revision);
+      values[s].emplace_back();
+    }
+    values[s][rev_iter->second].push_back(record.value);
+  }
+
+  for (std::size_t s = 0; s < series.size(); ++s)
+  {
+    for (auto &rev_values : values[s])
+    {
+      series[s].values.push_back(::median(std::move(rev_values)));
+    }
+  }
+  return series;
+}
+
+std::vector<std::size_t> detect_change_points(const std::vector<nvbench::float64_t> &values,
+                                              nvbench::float64_t penalty,
+                                              std::size_t min_segment_size)
+{
+  const auto n = values.size();
+  min_segment_size = std::max(min_segment_size, std::size_t{1});
+  if (n < 2 * min_segment_size)
+  {
+    return {};
+  }
+
+  // Robust noise estimate, insensitive to a few step changes:
+  std::vector<nvbench::float64_t> diffs(n - 1);
+  for (std::size_t i = 1; i < n; ++i)
+  {
+    diffs[i - 1] = std::abs(values[i] - values[i - 1]);
+  }
+  // For normal noise, median(|x_i - x_{i-1}|) = 0.6745 * sqrt(2) * sigma:
+  auto sigma = ::median(std::move(diffs)) / 0.9539;
+  if (!(sigma > 0.))
+  {
+    // Piecewise constant values; any step is real:
+    const auto scale = std::abs(::median(values));
+    sigma            = scale > 0. ? scale * 1e-6 : 1.;
+  }
+
+  std::vector<nvbench::float64_t> scaled(n);
+  std::transform(values.cbegin(), values.cend(), scaled.begin(), [sigma](auto v) {
+    return v / sigma;
+  });
+  const segment_cost cost{scaled};
+  const auto beta = penalty * std::log(static_cast<nvbench::float64_t>(n));
+
+  // best[t]: minimal penalized cost of values [0, t); last[t]: start of its last segment.
+  std::vector<nvbench::float64_t> best(n + 1, std::numeric_limits<nvbench::float64_t>::infinity());
+  std::vector<std::size_t> last(n + 1, 0);
+  best[0] = -beta;
+
+  std::vector<std::size_t> candidates;
+  for (std::size_t t = min_segment_size; t <= n; ++t)
+  {
+    // The last segment must be long enough, and so must the one before it:
+    const auto newest = t - min_segment_size;
+    if (newest == 0 || newest >= min_segment_size)
+    {
+      candidates.push_back(newest);
+    }
+
+    for (const auto s : candidates)
+    {
+      const auto total = best[s] + cost(s, t) + beta;
+      if (total < best[t])
+      {
+        best[t] = total;
+        last[t] = s;
+      }
+    }
+
+    // Candidates that cannot start the last segment of any later optimum:
+    candidates.erase(std::remove_if(candidates.begin(),
+                                    candidates.end(),
+                                    [&](std::size_t s) {
+                                      return best[s] + cost(s, t) > best[t];
+                                    }),
+                     candidates.end());
+  }
+
+  std::vector<std::size_t> change_points;
+  for (auto t = last[n]; t != 0; t = last[t])
+  {
+    change_points.push_back(t);
+  }
+  std::reverse(change_points.begin(), change_points.end());
+  return change_points;
+}
+
+} // namespace nvbench::results
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/types.cuh>
+
+#include <string>
+#include <vector>
+
+namespace nvbench::results
+{
+
+/// How to resolve a state that appears in more than one input file.
+enum class merge_policy
+{
+  /// Keep the state from the last input file that has it.
+  latest,
+  /// Keep the state with the lowest relative standard deviation.
+  best_converged,
+  /// Combine the samples of all copies.
+  pool
+};
+
+/// Accepts "latest", "best-converged" and "pool".
+[[nodiscard]] merge_policy parse_merge_policy(const std::string &name);
+[[nodiscard]] std::string merge_policy_to_string(merge_policy policy);
+
+struct merge_stats
+{
+  nvbench::int64_t num_benchmarks{};
+  nvbench::int64_t num_states{};
+  /// States that appeared in more than one input and were resolved by policy.
+  nvbench::int64_t num_duplicate_states{};
+  nvbench::int64_t num_bin_files{};
+  /// Sample-times files referenced by an input that could not be found.
+  nvbench::int64_t num_missing_bin_files{};
+};
+
+/**
+ * Merges JSON result files, e.g. from sharded runs or reruns of flaky states,
+ * into a single file at `output`.
+ *
+ * Benchmarks are matched by name and states by (benchmark, device, axis
+ * values); everything else is taken from the first input that has it. Inputs
+ * are processed in order, one at a time, and sample-times files written by
+ * `--jsonbin` are copied (or concatenated, for `merge_policy::pool`) into
+ * `<output>-bin`. The output may not be one of the inputs.
+ *
+ * When pooling, the sample counts, walltimes, min / max / mean / standard
+ * deviations of each measurement and the throughputs derived from the mean
+ * are recomputed from the per-file summaries. Other summaries, such as
+ * benchmark-level summary groups, are taken from the latest copy and are not
+ * recomputed. Skipped copies are only kept if every copy was skipped.
+ *
+ * The output has the highest file version of the inputs, which must all
+ * share the same major version.
+ */
+merge_stats merge_result_files(const std::vector<std::string> &inputs,
+                               const std::string &output,
+                               merge_policy policy);
+
+} // namespace nvbench::results
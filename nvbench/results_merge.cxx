@@ -0,0 +1,966 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/results.cuh>
+#include <nvbench/results_merge.cuh>
+
+#include <nlohmann/json.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+namespace
+{
+
+using json = nlohmann::ordered_json;
+
+constexpr const char *metadata_keys[] = {"name", "description", "hint", "hide"};
+
+// A copy of a state as read from one of the inputs:
+struct state_copy
+{
+  json node;
+  // Used to locate the state's sample-times files:
+  std::string json_filename;
+};
+
+struct merged_benchmark
+{
+  // Everything but the states and summary groups:
+  json node;
+
+  // All copies of each state, in input order:
+  std::vector<std::vector<state_copy>> states;
+  std::unordered_map<std::string, std::size_t> state_index;
+
+  std::vector<json> summary_groups;
+  std::unordered_map<std::string, std::size_t> group_index;
+};
+
+json read_json(const std::string &filename)
+{
+  std::ifstream in{filename, std::ios::binary};
+  NVBENCH_THROW_IF(!in, std::runtime_error, "Failed to open result file '{}'.", filename);
+  try
+  {
+    return json::parse(in);
+  }
+  catch (json::exception &e)
+  {
+    NVBENCH_THROW(std::runtime_error, "Failed to parse result file '{}': {}", filename, e.what());
+  }
+}
+
+// Identifies a state or summary group within a benchmark:
+std::string get_key(const json &node)
+{
+  const auto device = node.find("device");
+  const auto values = node.find("axis_values");
+  return fmt::format("{}\n{}",
+                     device == node.end() ? "null" : device->dump(),
+                     values == node.end() ? "[]" : values->dump());
+}
+
+/**
+ * Summary descriptors are expanded into the summaries created from them while
+ * reading. A tag is only described in the output if every input that used it
+ * shared the same descriptor; otherwise its summaries keep their expanded
+ * metadata. Inputs before JSON file version 1.5.0 don't mark the summaries
+ * created from a descriptor, so theirs are matched by tag alone.
+ */
+struct descriptor_table
+{
+  // Expands the summaries of all states and summary groups in `root`.
+  void expand_file(json &root)
+  {
+    std::unordered_map<std::string, const json *> file_descriptors;
+    if (const auto descs = root.find("summary_descriptors"); descs != root.end())
+    {
+      m_has_descriptors = true;
+      for (const auto &desc : *descs)
+      {
+        file_descriptors.emplace(desc.at("tag").get<std::string>(), &desc);
+      }
+    }
+
+    bool has_markers = false;
+    if (const auto meta = root.find("meta");
+        meta != root.end() && meta->contains("version") && meta->at("version").contains("json"))
+    {
+      has_markers = meta->at("version").at("json").at("minor").get<nvbench::int64_t>() >= 5;
+    }
+
+    for (auto &bench : root.at("benchmarks"))
+    {
+      for (const char *section : {"states", "summary_groups"})
+      {
+        if (const auto nodes = bench.find(section); nodes != bench.end() && nodes->is_array())
+        {
+          for (auto &node : *nodes)
+          {
+            this->expand(node, file_descriptors, has_markers);
+          }
+        }
+      }
+    }
+  }
+
+  void collapse(json &node) const
+  {
+    const auto summaries = node.find("summaries");
+    if (summaries == node.end() || !summaries->is_array())
+    {
+      return;
+    }
+
+    for (auto &summ : *summaries)
+    {
+      if (!summ.value("descriptor", false))
+      {
+        continue;
+      }
+      const auto tag  = summ.at("tag").get<std::string>();
+      const auto desc = m_descriptors.find(tag);
+      if (desc == m_descriptors.cend() || m_conflicts.count(tag) != 0)
+      {
+        // Written in full, like an ad-hoc summary:
+        summ.erase("descriptor");
+        continue;
+      }
+      for (const char *key : metadata_keys)
+      {
+        if (summ.contains(key) && desc->second.contains(key) && summ[key] == desc->second[key])
+        {
+          summ.erase(key);
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] bool has_descriptors() const { return m_has_descriptors; }
+
+  [[nodiscard]] json get_descriptors() const
+  {
+    json descs = json::array();
+    for (const auto &tag : m_tags)
+    {
+      if (m_conflicts.count(tag) == 0)
+      {
+        descs.push_back(m_descriptors.at(tag));
+      }
+    }
+    return descs;
+  }
+
+private:
+  void expand(json &node,
+              const std::unordered_map<std::string, const json *> &file_descriptors,
+              bool has_markers)
+  {
+    const auto summaries = node.find("summaries");
+    if (summaries == node.end() || !summaries->is_array())
+    {
+      return;
+    }
+
+    for (auto &summ : *summaries)
+    {
+      // Ad-hoc summaries keep their metadata, even if they reuse a described tag:
+      if (has_markers && !summ.value("descriptor", false))
+      {
+        continue;
+      }
+
+      const auto tag  = summ.at("tag").get<std::string>();
+      const auto desc = file_descriptors.find(tag);
+      if (desc == file_descriptors.cend())
+      {
+        m_conflicts.insert(tag);
+        summ.erase("descriptor");
+        continue;
+      }
+
+      if (const auto [known, inserted] = m_descriptors.emplace(tag, *desc->second); inserted)
+      {
+        m_tags.push_back(tag);
+      }
+      else if (known->second != *desc->second)
+      {
+        m_conflicts.insert(tag);
+      }
+
+      // Keys written in the summary take precedence. Rebuild the summary so
+      // that its metadata precedes the data, as json_printer writes it:
+      json expanded;
+      expanded["tag"]        = tag;
+      expanded["descriptor"] = true;
+      for (const char *key : metadata_keys)
+      {
+        if (summ.contains(key))
+        {
+          expanded[key] = summ[key];
+        }
+        else if (desc->second->contains(key))
+        {
+          expanded[key] = desc->second->at(key);
+        }
+      }
+      for (auto &item : summ.items())
+      {
+        if (!expanded.contains(item.key()))
+        {
+          expanded[item.key()] = std::move(item.value());
+        }
+      }
+      summ = std::move(expanded);
+    }
+  }
+
+  bool m_has_descriptors{};
+  std::vector<std::string> m_tags;
+  std::unordered_map<std::string, json> m_descriptors;
+  std::unordered_set<std::string> m_conflicts;
+};
+
+json *find_summary(json &node, const std::string &tag)
+{
+  const auto summaries = node.find("summaries");
+  if (summaries == node.end() || !summaries->is_array())
+  {
+    return nullptr;
+  }
+  for (auto &summ : *summaries)
+  {
+    if (summ.at("tag").get<std::string>() == tag)
+    {
+      return &summ;
+    }
+  }
+  return nullptr;
+}
+
+json *find_data(json &summ, const std::string &name)
+{
+  const auto data = summ.find("data");
+  if (data == summ.end() || !data->is_array())
+  {
+    return nullptr;
+  }
+  for (auto &value : *data)
+  {
+    if (value.at("name").get<std::string>() == name)
+    {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+// Numbers are written as strings to avoid truncating int64s:
+std::optional<nvbench::float64_t> get_number(json &node, const std::string &tag)
+{
+  json *summ  = ::find_summary(node, tag);
+  json *value = summ != nullptr ? ::find_data(*summ, "value") : nullptr;
+  if (value == nullptr)
+  {
+    return std::nullopt;
+  }
+
+  const auto &val = value->at("value");
+  if (val.is_number())
+  {
+    return val.get<nvbench::float64_t>();
+  }
+  try
+  {
+    return std::stod(val.get<std::string>());
+  }
+  catch (std::exception &)
+  {
+    return std::nullopt;
+  }
+}
+
+void set_number(json &node, const std::string &tag, nvbench::float64_t number)
+{
+  json *summ  = ::find_summary(node, tag);
+  json *value = summ != nullptr ? ::find_data(*summ, "value") : nullptr;
+  if (value == nullptr)
+  {
+    return;
+  }
+
+  if (value->value("type", std::string{}) == "int64")
+  {
+    (*value)["value"] = fmt::to_string(static_cast<nvbench::int64_t>(std::llround(number)));
+  }
+  else
+  {
+    (*value)["value"] = fmt::to_string(number);
+  }
+}
+
+// The value of `tag` in every copy, or nothing if any copy lacks it.
+std::optional<std::vector<nvbench::float64_t>> get_numbers(const std::vector<state_copy *> &copies,
+                                                           const std::string &tag)
+{
+  std::vector<nvbench::float64_t> numbers;
+  for (auto *copy : copies)
+  {
+    const auto number = ::get_number(copy->node, tag);
+    if (!number)
+    {
+      return std::nullopt;
+    }
+    numbers.push_back(*number);
+  }
+  return numbers;
+}
+
+// Prefixes of the timed measurements in a state, e.g. "nv/cold":
+std::vector<std::string> get_measurements(json &node)
+{
+  std::vector<std::string> measurements;
+  if (const auto summaries = node.find("summaries");
+      summaries != node.end() && summaries->is_array())
+  {
+    constexpr std::string_view suffix = "/sample_size";
+    for (const auto &summ : *summaries)
+    {
+      const auto tag = summ.at("tag").get<std::string>();
+      if (tag.size() <= suffix.size() ||
+          tag.compare(tag.size() - suffix.size(), suffix.size(), suffix) != 0)
+      {
+        continue;
+      }
+      auto prefix = tag.substr(0, tag.size() - suffix.size());
+      if (::find_summary(node, prefix + "/time/gpu/mean") != nullptr ||
+          ::find_summary(node, prefix + "/time/cpu/mean") != nullptr)
+      {
+        measurements.push_back(std::move(prefix));
+      }
+    }
+  }
+  return measurements;
+}
+
+// Relative standard deviation of the first measurement; lower is better.
+nvbench::float64_t get_noise(json &node)
+{
+  const auto measurements = ::get_measurements(node);
+  if (!measurements.empty())
+  {
+    for (const char *clock : {"gpu", "cpu"})
+    {
+      if (const auto noise =
+            ::get_number(node, fmt::format("{}/time/{}/stdev/relative", measurements[0], clock));
+          noise && !std::isnan(*noise))
+      {
+        return *noise;
+      }
+    }
+  }
+  return std::numeric_limits<nvbench::float64_t>::infinity();
+}
+
+nvbench::float64_t get_sample_size(json &node)
+{
+  const auto measurements = ::get_measurements(node);
+  return measurements.empty()
+           ? 0.
+           : ::get_number(node, measurements[0] + "/sample_size").value_or(0.);
+}
+
+bool is_sample_times_file(const json &summ)
+{
+  return summ.value("hint", std::string{}) == "file/sample_times";
+}
+
+// Writes `<output>-bin/<N>.bin`, matching json_printer's layout:
+struct bin_writer
+{
+  bin_writer(std::string output, nvbench::results::merge_stats &stats)
+      : m_output{std::move(output)}
+      , m_stats{stats}
+  {}
+
+  // Copies the sample-times files listed by each summary in `node` into the
+  // output directory, concatenating the corresponding files of `others`.
+  // Summaries whose files are missing are dropped.
+  void write(json &node,
+             const std::string &json_filename,
+             const std::vector<state_copy *> &others = {})
+  {
+    const auto summaries = node.find("summaries");
+    if (summaries == node.end() || !summaries->is_array())
+    {
+      return;
+    }
+
+    json kept = json::array();
+    for (auto &summ : *summaries)
+    {
+      if (!::is_sample_times_file(summ) || this->write_summary(summ, json_filename, others))
+      {
+        kept.push_back(std::move(summ));
+      }
+    }
+    *summaries = std::move(kept);
+  }
+
+private:
+  bool write_summary(json &summ,
+                     const std::string &json_filename,
+                     const std::vector<state_copy *> &others)
+  {
+    std::vector<std::string> sources;
+    const auto add_source = [this, &sources](json &file_summ, const std::string &filename) {
+      json *file = ::find_data(file_summ, "filename");
+      if (file == nullptr)
+      {
+        return false;
+      }
+      auto source = nvbench::results::result_file::resolve_bin_filename(
+        filename,
+        file->at("value").get<std::string>());
+      if (!fs::exists(source))
+      {
+        ++m_stats.num_missing_bin_files;
+        return false;
+      }
+      sources.push_back(std::move(source));
+      return true;
+    };
+
+    const auto tag = summ.at("tag").get<std::string>();
+    for (auto *other : others)
+    {
+      json *other_summ = ::find_summary(other->node, tag);
+      if (other_summ == nullptr || !add_source(*other_summ, other->json_filename))
+      {
+        return false;
+      }
+    }
+    if (!add_source(summ, json_filename))
+    {
+      return false;
+    }
+
+    const fs::path directory{m_output + "-bin/"};
+    if (!fs::exists(directory))
+    {
+      NVBENCH_THROW_IF(!fs::create_directory(directory),
+                       std::runtime_error,
+                       "Failed to create result directory '{}'.",
+                       directory.string());
+    }
+    const auto path = directory / fmt::format("{:d}.bin", m_stats.num_bin_files++);
+
+    std::ofstream out;
+    out.exceptions(out.exceptions() | std::ios::failbit | std::ios::badbit);
+    out.open(path, std::ios::binary | std::ios::out | std::ios::trunc);
+    std::uintmax_t nbytes = 0;
+    for (const auto &source : sources)
+    {
+      std::ifstream in{source, std::ios::binary};
+      out << in.rdbuf();
+      nbytes += fs::file_size(source);
+    }
+
+    ::find_data(summ, "filename")->at("value") = path.string();
+    if (json *size = ::find_data(summ, "size"); size != nullptr)
+    {
+      size->at("value") = fmt::to_string(nbytes / sizeof(nvbench::float32_t));
+    }
+    return true;
+  }
+
+  std::string m_output;
+  nvbench::results::merge_stats &m_stats;
+};
+
+// Combines the statistics of the copies into those of the latest copy.
+json pool_states(const std::vector<state_copy *> &copies, bin_writer &bins)
+{
+  auto &latest = *copies.back();
+  json pooled  = latest.node;
+
+  for (const auto &measurement : ::get_measurements(pooled))
+  {
+    const auto sample_sizes = ::get_numbers(copies, measurement + "/sample_size");
+    if (!sample_sizes)
+    {
+      continue;
+    }
+
+    nvbench::float64_t total_samples = 0.;
+    for (const auto n : *sample_sizes)
+    {
+      total_samples += n;
+    }
+    ::set_number(pooled, measurement + "/sample_size", total_samples);
+
+    if (const auto walltimes = ::get_numbers(copies, measurement + "/walltime"))
+    {
+      nvbench::float64_t total_walltime = 0.;
+      for (const auto t : *walltimes)
+      {
+        total_walltime += t;
+      }
+      ::set_number(pooled, measurement + "/walltime", total_walltime);
+    }
+
+    // The throughputs are derived from the first clock's mean:
+    std::optional<nvbench::float64_t> throughput_scale;
+    for (const char *clock : {"gpu", "cpu"})
+    {
+      const auto prefix = fmt::format("{}/time/{}/", measurement, clock);
+      const auto means  = ::get_numbers(copies, prefix + "mean");
+      if (!means || total_samples == 0.)
+      {
+        continue;
+      }
+
+      nvbench::float64_t mean = 0.;
+      for (std::size_t i = 0; i < means->size(); ++i)
+      {
+        mean += (*sample_sizes)[i] * (*means)[i];
+      }
+      mean /= total_samples;
+
+      if (const auto mins = ::get_numbers(copies, prefix + "min"))
+      {
+        ::set_number(pooled, prefix + "min", *std::min_element(mins->cbegin(), mins->cend()));
+      }
+      if (const auto maxs = ::get_numbers(copies, prefix + "max"))
+      {
+        ::set_number(pooled, prefix + "max", *std::max_element(maxs->cbegin(), maxs->cend()));
+      }
+      if (const auto stdevs = ::get_numbers(copies, prefix + "stdev/absolute"))
+      {
+        // Within- and between-copy sums of squares, with Bessel's correction:
+        nvbench::float64_t sum_of_squares = 0.;
+        for (std::size_t i = 0; i < stdevs->size(); ++i)
+        {
+          const auto n          = (*sample_sizes)[i];
+          const auto mean_delta = (*means)[i] - mean;
+          sum_of_squares += (n - 1.) * (*stdevs)[i] * (*stdevs)[i] + n * mean_delta * mean_delta;
+        }
+        const auto stdev = total_samples > 1.
+                             ? std::sqrt(sum_of_squares / (total_samples - 1.))
+                             : std::numeric_limits<nvbench::float64_t>::infinity();
+        ::set_number(pooled, prefix + "stdev/absolute", stdev);
+        ::set_number(pooled, prefix + "stdev/relative", stdev / mean);
+      }
+
+      if (!throughput_scale && mean != 0.)
+      {
+        throughput_scale = ::get_number(latest.node, prefix + "mean").value_or(mean) / mean;
+      }
+      ::set_number(pooled, prefix + "mean", mean);
+    }
+
+    if (throughput_scale)
+    {
+      const auto bw_prefix = measurement + "/bw/";
+      for (const auto &summ : latest.node.at("summaries"))
+      {
+        const auto tag = summ.at("tag").get<std::string>();
+        if (tag.compare(0, bw_prefix.size(), bw_prefix) == 0)
+        {
+          if (const auto value = ::get_number(latest.node, tag))
+          {
+            ::set_number(pooled, tag, *value * *throughput_scale);
+          }
+        }
+      }
+    }
+  }
+
+  const std::vector<state_copy *> others(copies.cbegin(), copies.cend() - 1);
+  bins.write(pooled, latest.json_filename, others);
+  return pooled;
+}
+
+json resolve_state(std::vector<state_copy> &copies,
+                   nvbench::results::merge_policy policy,
+                   bin_writer &bins)
+{
+  // Skipped copies are only used if nothing ran:
+  std::vector<state_copy *> candidates;
+  for (auto &copy : copies)
+  {
+    if (!copy.node.value("is_skipped", false))
+    {
+      candidates.push_back(&copy);
+    }
+  }
+  if (candidates.empty())
+  {
+    candidates.push_back(&copies.back());
+  }
+
+  state_copy *chosen = candidates.back();
+  switch (policy)
+  {
+    case nvbench::results::merge_policy::latest:
+      break;
+
+    case nvbench::results::merge_policy::best_converged: {
+      // Ties go to the copy with more samples, then to the later copy:
+      auto best = std::make_tuple(std::numeric_limits<nvbench::float64_t>::infinity(), 0.);
+      for (auto *copy : candidates)
+      {
+        const auto score = std::make_tuple(::get_noise(copy->node), -::get_sample_size(copy->node));
+        if (copy == candidates.front() || score <= best)
+        {
+          best   = score;
+          chosen = copy;
+        }
+      }
+      break;
+    }
+
+    case nvbench::results::merge_policy::pool:
+      if (candidates.size() > 1)
+      {
+        return ::pool_states(candidates, bins);
+      }
+      break;
+  }
+
+  json node = std::move(chosen->node);
+  bins.write(node, chosen->json_filename);
+  return node;
+}
+
+// Adds devices and axis values that are missing from `merged`.
+void merge_benchmark_node(json &merged, const json &bench)
+{
+  if (const auto devices = bench.find("devices"); devices != bench.end() && devices->is_array())
+  {
+    auto &merged_devices = merged["devices"];
+    if (!merged_devices.is_array())
+    {
+      merged_devices = json::array();
+    }
+    for (const auto &device : *devices)
+    {
+      if (std::find(merged_devices.cbegin(), merged_devices.cend(), device) ==
+          merged_devices.cend())
+      {
+        merged_devices.push_back(device);
+      }
+    }
+  }
+
+  const auto axes = bench.find("axes");
+  if (axes == bench.end() || !axes->is_array())
+  {
+    return;
+  }
+  auto &merged_axes = merged["axes"];
+  for (const auto &axis : *axes)
+  {
+    const auto merged_axis =
+      std::find_if(merged_axes.begin(), merged_axes.end(), [&axis](const json &other) {
+        return other.at("name") == axis.at("name");
+      });
+    if (merged_axis == merged_axes.end())
+    {
+      merged_axes.push_back(axis);
+      continue;
+    }
+
+    auto &values = (*merged_axis)["values"];
+    for (const auto &value : axis.at("values"))
+    {
+      const auto known = std::find_if(values.cbegin(), values.cend(), [&value](const json &other) {
+        return other.at("input_string") == value.at("input_string");
+      });
+      if (known == values.cend())
+      {
+        values.push_back(value);
+      }
+    }
+  }
+}
+
+} // namespace
+
+namespace nvbench::results
+{
+
+merge_policy parse_merge_policy(const std::string &name)
+{
+  if (name == "latest")
+  {
+    return merge_policy::latest;
+  }
+  else if (name == "best-converged")
+  {
+    return merge_policy::best_converged;
+  }
+  else if (name == "pool")
+  {
+    return merge_policy::pool;
+  }
+  NVBENCH_THROW(std::runtime_error,
+                "Unknown merge policy '{}'. Expected 'latest', 'best-converged' or 'pool'.",
+                name);
+}
+
+std::string merge_policy_to_string(merge_policy policy)
+{
+  switch (policy)
+  {
+    case merge_policy::latest:
+      return "latest";
+    case merge_policy::best_converged:
+      return "best-converged";
+    case merge_policy::pool:
+      return "pool";
+  }
+  return "unknown";
+}
+
+merge_stats merge_result_files(const std::vector<std::string> &inputs,
+                               const std::string &output,
+                               merge_policy policy)
+{
+  NVBENCH_THROW_IF(inputs.empty(), std::runtime_error, "{}", "No result files to merge.");
+  for (const auto &filename : inputs)
+  {
+    // Writing the output would clobber the input's sample-times files before
+    // they are read:
+    NVBENCH_THROW_IF(fs::exists(output) && fs::exists(filename) &&
+                       fs::equivalent(output, filename),
+                     std::runtime_error,
+                     "The merge output '{}' is also an input.",
+                     output);
+  }
+
+  json meta;
+  std::optional<std::tuple<nvbench::int64_t, nvbench::int64_t, nvbench::int64_t>> version;
+  json version_node;
+
+  json devices = json::array();
+  std::unordered_set<std::string> device_ids;
+
+  descriptor_table descriptors;
+  std::vector<merged_benchmark> benchmarks;
+  std::unordered_map<std::string, std::size_t> benchmark_index;
+
+  for (const auto &filename : inputs)
+  {
+    json root = ::read_json(filename);
+
+    try
+    {
+      if (const auto file_meta = root.find("meta"); file_meta != root.end())
+      {
+        if (meta.is_null())
+        {
+          meta = *file_meta;
+        }
+
+        if (file_meta->contains("version") && file_meta->at("version").contains("json"))
+        {
+          const auto &file_version = file_meta->at("version").at("json");
+          const auto file_version_tuple =
+            std::make_tuple(file_version.at("major").get<nvbench::int64_t>(),
+                            file_version.at("minor").get<nvbench::int64_t>(),
+                            file_version.at("patch").get<nvbench::int64_t>());
+          NVBENCH_THROW_IF(version && std::get<0>(*version) != std::get<0>(file_version_tuple),
+                           std::runtime_error,
+                           "Cannot merge '{}' with JSON file version {}; other inputs use "
+                           "major version {}.",
+                           filename,
+                           file_version.value("string", std::string{}),
+                           std::get<0>(*version));
+          if (!version || file_version_tuple > *version)
+          {
+            version      = file_version_tuple;
+            version_node = file_version;
+          }
+        }
+      }
+
+      if (const auto file_devices = root.find("devices");
+          file_devices != root.end() && file_devices->is_array())
+      {
+        for (auto &device : *file_devices)
+        {
+          if (device_ids.insert(device.at("id").dump()).second)
+          {
+            devices.push_back(std::move(device));
+          }
+        }
+      }
+
+      descriptors.expand_file(root);
+
+      for (auto &bench : root.at("benchmarks"))
+      {
+        const auto name         = bench.at("name").get<std::string>();
+        const auto [it, is_new] = benchmark_index.try_emplace(name, benchmarks.size());
+        if (is_new)
+        {
+          auto &merged = benchmarks.emplace_back();
+          merged.node  = json::object();
+          for (const auto &item : bench.items())
+          {
+            if (item.key() != "states" && item.key() != "summary_groups")
+            {
+              merged.node[item.key()] = item.value();
+            }
+          }
+        }
+        else
+        {
+          ::merge_benchmark_node(benchmarks[it->second].node, bench);
+        }
+        auto &merged = benchmarks[it->second];
+
+        if (const auto states = bench.find("states"); states != bench.end() && states->is_array())
+        {
+          for (auto &state : *states)
+          {
+            const auto [state_it, is_new_state] =
+              merged.state_index.try_emplace(::get_key(state), merged.states.size());
+            if (is_new_state)
+            {
+              merged.states.emplace_back();
+            }
+            merged.states[state_it->second].push_back(state_copy{std::move(state), filename});
+          }
+        }
+
+        // Summary groups are not recomputed; later inputs replace earlier ones:
+        if (const auto groups = bench.find("summary_groups");
+            groups != bench.end() && groups->is_array())
+        {
+          for (auto &group : *groups)
+          {
+            const auto [group_it, is_new_group] =
+              merged.group_index.try_emplace(::get_key(group), merged.summary_groups.size());
+            if (is_new_group)
+            {
+              merged.summary_groups.push_back(std::move(group));
+            }
+            else
+            {
+              merged.summary_groups[group_it->second] = std::move(group);
+            }
+          }
+        }
+      }
+    }
+    catch (json::exception &e)
+    {
+      NVBENCH_THROW(std::runtime_error, "Failed to read result file '{}': {}", filename, e.what());
+    }
+  }
+
+  merge_stats stats;
+  bin_writer bins{output, stats};
+
+  json root;
+  if (!meta.is_null())
+  {
+    if (version)
+    {
+      meta["version"]["json"] = version_node;
+    }
+    meta["merged_from"] = inputs;
+    root["meta"]        = std::move(meta);
+  }
+  root["devices"] = std::move(devices);
+  if (descriptors.has_descriptors())
+  {
+    root["summary_descriptors"] = descriptors.get_descriptors();
+  }
+
+  auto &benchmarks_node = root["benchmarks"] = json::array();
+  for (auto &merged : benchmarks)
+  {
+    ++stats.num_benchmarks;
+
+    json bench     = std::move(merged.node);
+    bench["index"] = benchmarks_node.size();
+
+    auto &states = bench["states"] = json::array();
+    for (auto &copies : merged.states)
+    {
+      ++stats.num_states;
+      if (copies.size() > 1)
+      {
+        ++stats.num_duplicate_states;
+      }
+
+      auto state = ::resolve_state(copies, policy, bins);
+      descriptors.collapse(state);
+      states.push_back(std::move(state));
+    }
+
+    if (!merged.summary_groups.empty())
+    {
+      auto &groups = bench["summary_groups"] = json::array();
+      for (auto &group : merged.summary_groups)
+      {
+        descriptors.collapse(group);
+        groups.push_back(std::move(group));
+      }
+    }
+
+    benchmarks_node.push_back(std::move(bench));
+  }
+
+  std::ofstream out{output};
+  NVBENCH_THROW_IF(!out, std::runtime_error, "Failed to open '{}' for writing.", output);
+  out << root.dump(2) << "\n";
+  NVBENCH_THROW_IF(!out, std::runtime_error, "Failed to write '{}'.", output);
+
+  return stats;
+}
+
+} // namespace nvbench::results
@@ -19,8 +19,12 @@
 #pragma once
 
 #include <nvbench/benchmark_base.cuh>
+#include <nvbench/detail/core_reservation.cuh>
+#include <nvbench/detail/isolation.cuh>
+#include <nvbench/detail/retry.cuh>
 #include <nvbench/detail/state_generator.cuh>
 
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -43,7 +47,26 @@ struct runner_base
 
   void print_skip_notification(nvbench::state &exec_state) const;
 
+  // The states of `device`, in the order they should be run:
+  std::vector<nvbench::state *>
+  get_ordered_states(const std::optional<nvbench::device_info> &device, std::size_t device_index);
+
+  // Compute benchmark-level summaries after all states have been run.
+  void run_epilogue();
+
+  // Reserves cores on the host if requested by the benchmark.
+  void start_reservation();
+  void stop_reservation();
+
+  // Starts the fork server if the benchmark's states are isolated in child
+  // processes, which run them with `run_state`.
+  void start_isolation(nvbench::detail::fork_server::state_runner run_state);
+  void stop_isolation();
+
   nvbench::benchmark_base &m_benchmark;
+  // Forked processes hold the reserved cores too, so stop them first:
+  std::unique_ptr<nvbench::detail::core_reservation> m_core_reservation;
+  std::unique_ptr<nvbench::detail::fork_server> m_fork_server;
 };
 
 template <typename BenchmarkType>
@@ -61,60 +84,98 @@ struct runner : public runner_base
 
   void run()
   {
+    this->start_reservation();
+    this->start_isolation([this](nvbench::state &cur_state) { this->run_state(cur_state); });
     if (m_benchmark.m_devices.empty())
     {
-      this->run_device(std::nullopt);
+      this->run_device(std::nullopt, 0);
     }
     else
     {
+      std::size_t device_index = 0;
       for (const auto &device : m_benchmark.m_devices)
       {
-        this->run_device(device);
+        this->run_device(device, device_index++);
       }
     }
+    this->run_retries();
+    this->stop_isolation();
+    this->stop_reservation();
+    this->run_epilogue();
   }
 
 private:
-  void run_device(const std::optional<nvbench::device_info> &device)
+  void run_device(const std::optional<nvbench::device_info> &device, std::size_t device_index)
   {
     if (device)
     {
       device->set_active();
     }
 
-    // Iterate through type_configs:
+    // States are stored in canonical order, which printers rely on, and are
+    // dispatched in the benchmark's run order:
+    const auto states = this->get_ordered_states(device, device_index);
+    if (m_fork_server)
+    {
+      m_fork_server->run(states);
+      return;
+    }
+    for (nvbench::state *cur_state : states)
+    {
+      this->run_state(*cur_state);
+    }
+  }
+
+  // Measures states that timed out again, after the others:
+  void run_retries()
+  {
+    nvbench::detail::retry_pass retries{m_benchmark};
+    const auto &states = retries.get_states();
+    if (m_fork_server && !states.empty())
+    {
+      m_fork_server->run(states);
+    }
+    else
+    {
+      for (nvbench::state *cur_state : states)
+      {
+        if (const auto &device = cur_state->get_device(); device)
+        {
+          device->set_active();
+        }
+        this->run_state(*cur_state);
+      }
+    }
+    retries.finish();
+  }
+
+  void run_state(nvbench::state &cur_state)
+  {
+    // Find the type_config of the current state:
     std::size_t type_config_index = 0;
     nvbench::tl::foreach<type_configs>(
-      [&self = *this, &states = m_benchmark.m_states, &type_config_index, &device](
-        auto type_config_wrapper) {
-        // Get current type_config:
+      [&self = *this, &cur_state, &type_config_index](auto type_config_wrapper) {
+        if (type_config_index++ != cur_state.get_type_config_index())
+        {
+          return;
+        }
         using type_config = typename decltype(type_config_wrapper)::type;
 
-        // Find states with the current device / type_config
-        for (nvbench::state &cur_state : states)
+        self.run_state_prologue(cur_state);
+        try
         {
-          if (cur_state.get_device() == device &&
-              cur_state.get_type_config_index() == type_config_index)
+          auto kernel_generator_copy = self.m_kernel_generator;
+          kernel_generator_copy(cur_state, type_config{});
+          if (cur_state.is_skipped())
           {
-            self.run_state_prologue(cur_state);
-            try
-            {
-              auto kernel_generator_copy = self.m_kernel_generator;
-              kernel_generator_copy(cur_state, type_config{});
-              if (cur_state.is_skipped())
-              {
-                self.print_skip_notification(cur_state);
-              }
-            }
-            catch (std::exception &e)
-            {
-              self.handle_sampling_exception(e, cur_state);
-            }
-            self.run_state_epilogue(cur_state);
+            self.print_skip_notification(cur_state);
           }
         }
-
-        ++type_config_index;
+        catch (std::exception &e)
+        {
+          self.handle_sampling_exception(e, cur_state);
+        }
+        self.run_state_epilogue(cur_state);
       });
   }
 
@@ -17,14 +17,29 @@
  */
 
 #include <nvbench/benchmark_base.cuh>
+#include <nvbench/complexity.cuh>
+#include <nvbench/detail/aggregate.cuh>
+#include <nvbench/detail/baseline.cuh>
+#include <nvbench/detail/co_runner.cuh>
+#include <nvbench/detail/core_reservation.cuh>
+#include <nvbench/detail/isolation.cuh>
+#include <nvbench/detail/run_order.cuh>
+#include <nvbench/detail/sanity_check.cuh>
+#include <nvbench/fixture_cache.cuh>
+#include <nvbench/host_buffer_pool.cuh>
 #include <nvbench/printer_base.cuh>
 #include <nvbench/runner.cuh>
 #include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <memory>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace nvbench
 {
@@ -32,6 +47,7 @@ namespace nvbench
 void runner_base::generate_states()
 {
   m_benchmark.m_states = nvbench::detail::state_generator::create(m_benchmark);
+  m_benchmark.m_summary_groups.clear();
 }
 
 void runner_base::handle_sampling_exception(const std::exception &e, state &exec_state) const
@@ -69,6 +85,50 @@ void runner_base::run_state_prologue(nvbench::state &exec_state) const
 
 void runner_base::run_state_epilogue(state &exec_state) const
 {
+  // Input pools may reference the generator's locals and hold large buffers:
+  exec_state.m_input_pools.clear();
+  exec_state.m_fixtures.clear();
+
+  if (!exec_state.m_host_buffers.empty())
+  {
+    // Report the smallest page size the kernel actually provided:
+    auto &pool                 = nvbench::host_buffer_pool::get();
+    nvbench::int64_t page_size = 0;
+    for (auto &buf : exec_state.m_host_buffers)
+    {
+      const auto buf_page_size = static_cast<nvbench::int64_t>(buf.page_size);
+      page_size = page_size == 0 ? buf_page_size : std::min(page_size, buf_page_size);
+      pool.release(buf);
+    }
+    exec_state.m_host_buffers.clear();
+
+    if (page_size > 0)
+    {
+      static const auto &desc = nvbench::summary_registry::get().add(
+        {"nv/host_buffers/page_size",
+         "Page Size",
+         "bytes",
+         "Smallest page size backing the state's host buffers"});
+      auto &summ = exec_state.add_summary(desc);
+      summ.set_string("huge_pages", exec_state.get_benchmark().get_huge_pages());
+      summ.set_int64("value", page_size);
+    }
+  }
+
+  if (m_core_reservation)
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"nv/reservation/cpus",
+       "Reserved CPUs",
+       "",
+       "CPUs reserved on the host while the state ran",
+       "Hidden by default."});
+    exec_state.add_summary(desc).set_string("value", m_core_reservation->get_cpus_as_string());
+  }
+
+  // Compare with the baseline while the state's results are fresh:
+  nvbench::detail::add_baseline_summaries(exec_state);
+
   // Notify the printer that the state has completed::
   if (auto printer_opt_ref = exec_state.get_benchmark().get_printer(); printer_opt_ref.has_value())
   {
@@ -77,6 +137,177 @@ void runner_base::run_state_epilogue(state &exec_state) const
   }
 }
 
+void runner_base::run_epilogue()
+{
+  nvbench::detail::add_co_runner_summaries(m_benchmark);
+  nvbench::detail::add_complexity_summaries(m_benchmark);
+  nvbench::detail::add_aggregate_summaries(m_benchmark);
+  nvbench::detail::sanity_check::add_size_scaling_summaries(m_benchmark);
+
+  // Fixtures are specific to this benchmark:
+  auto &cache = nvbench::fixture_cache::get();
+  if (cache.get_hits() + cache.get_misses() > 0)
+  {
+    if (auto printer_opt_ref = m_benchmark.get_printer(); printer_opt_ref.has_value())
+    {
+      auto &printer = printer_opt_ref.value().get();
+      printer.log(nvbench::log_level::info,
+                  fmt::format("Fixture cache: {} hits, {} misses, {} evictions",
+                              cache.get_hits(),
+                              cache.get_misses(),
+                              cache.get_evictions()));
+    }
+  }
+  cache.clear();
+
+  // Recycled host buffers are only reused within a benchmark:
+  auto &pool = nvbench::host_buffer_pool::get();
+  if (pool.get_allocated() > 0)
+  {
+    if (auto printer_opt_ref = m_benchmark.get_printer(); printer_opt_ref.has_value())
+    {
+      auto &printer = printer_opt_ref.value().get();
+      printer.log(nvbench::log_level::info,
+                  fmt::format("Host buffers: {} allocated, {} reused",
+                              pool.get_allocated(),
+                              pool.get_reused()));
+    }
+  }
+  pool.clear();
+}
+
+void runner_base::start_reservation()
+{
+  const auto spec = nvbench::detail::core_reservation::spec::parse(m_benchmark.get_reserve_cores());
+  if (spec.m_kind == nvbench::detail::core_reservation::kind::none)
+  {
+    return;
+  }
+
+  auto printer_opt_ref = m_benchmark.get_printer();
+  if (!nvbench::detail::core_reservation::is_supported())
+  {
+    if (printer_opt_ref.has_value())
+    {
+      printer_opt_ref.value().get().log(nvbench::log_level::warn,
+                                        "Core reservation is only supported on Linux.");
+    }
+    return;
+  }
+
+  m_core_reservation =
+    std::make_unique<nvbench::detail::core_reservation>(m_benchmark.get_reserve_cores(),
+                                                        m_benchmark.get_reserve_timeout());
+  if (printer_opt_ref.has_value())
+  {
+    printer_opt_ref.value().get().log(
+      nvbench::log_level::info,
+      fmt::format("Reserved CPUs {} after waiting {:.1f}s",
+                  m_core_reservation->get_cpus_as_string(),
+                  m_core_reservation->get_wait_time()));
+  }
+}
+
+void runner_base::stop_reservation() { m_core_reservation.reset(); }
+
+void runner_base::start_isolation(nvbench::detail::fork_server::state_runner run_state)
+{
+  const auto isolation = nvbench::detail::isolation::parse(m_benchmark.get_isolation());
+  if (isolation.m_kind == nvbench::detail::isolation::kind::none)
+  {
+    return;
+  }
+
+  // CUDA is unusable in a forked child once this process has initialized it:
+  const char *reason = nullptr;
+  if (!m_benchmark.m_devices.empty())
+  {
+    reason = "the benchmark uses CUDA devices";
+  }
+  else if (!nvbench::detail::fork_server::is_supported())
+  {
+    reason = "fork isolation is only supported on Linux";
+  }
+  if (reason != nullptr)
+  {
+    if (auto printer_opt_ref = m_benchmark.get_printer(); printer_opt_ref.has_value())
+    {
+      auto &printer = printer_opt_ref.value().get();
+      printer.log(nvbench::log_level::warn,
+                  fmt::format("Running states in-process: {}.", reason));
+    }
+    return;
+  }
+
+  m_fork_server = std::make_unique<nvbench::detail::fork_server>(m_benchmark,
+                                                                 std::move(run_state));
+}
+
+void runner_base::stop_isolation() { m_fork_server.reset(); }
+
+std::vector<nvbench::state *>
+runner_base::get_ordered_states(const std::optional<nvbench::device_info> &device,
+                                std::size_t device_index)
+{
+  // Canonical order runs all states of a type_config before the next one:
+  std::vector<nvbench::state *> states;
+  for (auto &cur_state : m_benchmark.m_states)
+  {
+    if (cur_state.get_device() == device)
+    {
+      states.push_back(&cur_state);
+    }
+  }
+  std::stable_sort(states.begin(), states.end(), [](const auto *lhs, const auto *rhs) {
+    return lhs->get_type_config_index() < rhs->get_type_config_index();
+  });
+
+  const auto order = nvbench::detail::run_order::parse(m_benchmark.get_run_order());
+  if (order.m_kind == nvbench::detail::run_order::kind::canonical)
+  {
+    return states;
+  }
+
+  if (order.m_kind == nvbench::detail::run_order::kind::grouped)
+  {
+    // Run states that share fixtures back to back:
+    const auto &fixture_axes = m_benchmark.get_fixture_axes();
+    if (fixture_axes)
+    {
+      auto get_key = [&fixture_axes](const nvbench::state *cur_state) {
+        std::vector<nvbench::named_values::value_type> key;
+        for (const auto &axis_name : *fixture_axes)
+        {
+          const auto &values = cur_state->get_axis_values();
+          if (values.has_value(axis_name))
+          {
+            key.push_back(values.get_value(axis_name));
+          }
+        }
+        return key;
+      };
+      std::stable_sort(states.begin(),
+                       states.end(),
+                       [&get_key](const auto *lhs, const auto *rhs) {
+                         if (lhs->get_type_config_index() != rhs->get_type_config_index())
+                         {
+                           return lhs->get_type_config_index() < rhs->get_type_config_index();
+                         }
+                         return get_key(lhs) < get_key(rhs);
+                       });
+    }
+    return states;
+  }
+
+  std::vector<nvbench::state *> ordered;
+  ordered.reserve(states.size());
+  for (const auto index : order.get_permutation(states.size(), device_index))
+  {
+    ordered.push_back(states[index]);
+  }
+  return ordered;
+}
+
 void runner_base::print_skip_notification(state &exec_state) const
 {
   if (auto printer_opt_ref = exec_state.get_benchmark().get_printer(); printer_opt_ref.has_value())
@@ -19,22 +19,30 @@
 #pragma once
 
 #include <nvbench/cuda_stream.cuh>
+#include <nvbench/data_generator.cuh>
 #include <nvbench/device_info.cuh>
 #include <nvbench/exec_tag.cuh>
+#include <nvbench/fixture_cache.cuh>
+#include <nvbench/host_buffer_pool.cuh>
+#include <nvbench/input_pool.cuh>
 #include <nvbench/named_values.cuh>
 #include <nvbench/stopping_criterion.cuh>
 #include <nvbench/summary.cuh>
 #include <nvbench/types.cuh>
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
 #include <vector>
 
 namespace nvbench
 {
 
 struct benchmark_base;
+struct runner_base;
 
 namespace detail
 {
@@ -263,9 +271,86 @@ struct state
   }
 
   summary &add_summary(std::string summary_tag);
+  summary &add_summary(const summary_descriptor &descriptor);
   summary &add_summary(summary s);
   [[nodiscard]] const summary &get_summary(std::string_view tag) const;
   [[nodiscard]] summary &get_summary(std::string_view tag);
+  /// Creates a pool of `copies` inputs for benchmarks that modify their
+  /// input. `generator(T &copy, std::size_t index)` fills each copy, now and
+  /// whenever a consumed copy is refreshed. The pool lives until the state
+  /// has finished running. See nvbench::input_pool.
+  template <typename T, typename Generator>
+  nvbench::input_pool<T> &add_input_pool(std::size_t copies, Generator &&generator)
+  {
+    auto pool = std::make_unique<nvbench::input_pool<T>>(copies,
+                                                         std::forward<Generator>(generator));
+    auto &result = *pool;
+    m_input_pools.push_back(std::move(pool));
+    return result;
+  }
+
+  /// Seed derived from the benchmark's data seed, the benchmark name and the
+  /// state's axis values (not the device), so that a state's inputs are the
+  /// same on every device and in every run.
+  [[nodiscard]] nvbench::uint64_t get_data_seed() const;
+
+  /// Returns a generator for reproducible random inputs seeded with
+  /// `get_data_seed()`. Use different streams for independent arrays.
+  /// See nvbench::data_generator.
+  [[nodiscard]] nvbench::data_generator get_data_generator(nvbench::uint32_t stream = 0) const
+  {
+    return nvbench::data_generator{this->get_data_seed(), stream};
+  }
+
+  /// Returns the fixture `name` of type `T`, calling `generator()` to create
+  /// it if it isn't in the nvbench::fixture_cache. Fixtures are shared by the
+  /// states that have the same device, type configuration and values for the
+  /// benchmark's fixture axes (see `benchmark_base::set_fixture_axes`). The
+  /// returned reference is valid until the state has finished running.
+  template <typename T, typename Generator>
+  T &get_fixture(const std::string &name, Generator &&generator)
+  {
+    const auto key = this->get_fixture_key(name, typeid(T));
+    auto value     = nvbench::fixture_cache::get().find(key);
+    if (!value)
+    {
+      auto fixture     = std::make_shared<T>(std::forward<Generator>(generator)());
+      const auto bytes = nvbench::fixture_traits<T>::get_bytes(*fixture);
+      value            = std::move(fixture);
+      this->cache_fixture(key, value, bytes);
+    }
+    m_fixtures.push_back(value);
+    return *static_cast<T *>(value.get());
+  }
+
+  /// Returns a pre-faulted host buffer of at least `bytes` bytes aligned to
+  /// `alignment`, backed by pages of the benchmark's huge page mode (see
+  /// `benchmark_base::set_huge_pages`). The buffer is valid until the state
+  /// has finished running and is then recycled for later states of the
+  /// benchmark, so its initial contents are unspecified.
+  /// See nvbench::host_buffer_pool.
+  void *allocate_host_buffer(std::size_t bytes, std::size_t alignment = 64);
+
+  /// Allocates a host buffer for `count` elements of `T`. @see allocate_host_buffer
+  template <typename T>
+  T *allocate_host_buffer(std::size_t count)
+  {
+    static_assert(std::is_trivially_default_constructible_v<T> &&
+                    std::is_trivially_destructible_v<T>,
+                  "Host buffers hold trivial types only.");
+    constexpr std::size_t alignment = alignof(T) > 64 ? alignof(T) : 64;
+    return static_cast<T *>(this->allocate_host_buffer(count * sizeof(T), alignment));
+  }
+
+  /// Called by the measurements outside of the timed region. Refreshes every
+  /// input pool with fewer than `launches` unused copies and returns the
+  /// number of launches that may run before the next refresh, or the maximum
+  /// int64 value if the state has no input pools.
+  nvbench::int64_t prepare_input_pools(nvbench::int64_t launches);
+
+  /// Whether `prepare_input_pools(launches)` would refresh any input pool.
+  [[nodiscard]] bool needs_input_pool_refresh(nvbench::int64_t launches) const;
+
   [[nodiscard]] const std::vector<summary> &get_summaries() const;
   [[nodiscard]] std::vector<summary> &get_summaries();
 
@@ -288,6 +373,7 @@ struct state
   }
 
 private:
+  friend struct nvbench::runner_base;
   friend struct nvbench::detail::state_generator;
   friend struct nvbench::detail::state_tester;
 
@@ -298,6 +384,10 @@ private:
         std::optional<nvbench::device_info> device,
         std::size_t type_config_index);
 
+  [[nodiscard]] std::string get_fixture_key(const std::string &name,
+                                            const std::type_info &type) const;
+  void cache_fixture(const std::string &key, std::shared_ptr<void> value, std::size_t bytes);
+
   std::reference_wrapper<const nvbench::benchmark_base> m_benchmark;
   nvbench::named_values m_axis_values;
   std::optional<nvbench::device_info> m_device;
@@ -333,6 +423,12 @@ private:
   bool m_collect_stores_efficiency{};
   bool m_collect_loads_efficiency{};
   bool m_collect_dram_throughput{};
+
+  std::vector<std::unique_ptr<nvbench::input_pool_base>> m_input_pools;
+  // Keeps the fixtures used by this state alive while it runs:
+  std::vector<std::shared_ptr<void>> m_fixtures;
+  // Returned to the nvbench::host_buffer_pool when the state finishes:
+  std::vector<nvbench::host_buffer_pool::buffer> m_host_buffers;
 };
 
 } // namespace nvbench
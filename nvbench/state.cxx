@@ -25,8 +25,10 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <string>
+#include <variant>
 
 namespace nvbench
 {
@@ -120,6 +122,11 @@ summary &state::add_summary(std::string summary_tag)
   return m_summaries.emplace_back(std::move(summary_tag));
 }
 
+summary &state::add_summary(const summary_descriptor &descriptor)
+{
+  return m_summaries.emplace_back(descriptor);
+}
+
 summary &state::add_summary(summary s)
 {
   m_summaries.push_back(std::move(s));
@@ -128,10 +135,17 @@ summary &state::add_summary(summary s)
 
 const summary &state::get_summary(std::string_view tag) const
 {
-  // Check tags first
-  auto iter = std::find_if(m_summaries.cbegin(), m_summaries.cend(), [&tag](const auto &s) {
-    return s.get_tag() == tag;
+  // Check tags first. Registered tags only need to compare descriptors:
+  const summary_descriptor *descriptor = summary_registry::get().find(tag);
+  auto iter = std::find_if(m_summaries.cbegin(), m_summaries.cend(), [&](const auto &s) {
+    return descriptor != nullptr && s.get_descriptor() == descriptor;
   });
+  if (iter == m_summaries.cend())
+  {
+    iter = std::find_if(m_summaries.cbegin(), m_summaries.cend(), [&tag](const auto &s) {
+      return s.get_descriptor() == nullptr && s.get_tag() == tag;
+    });
+  }
   if (iter != m_summaries.cend())
   {
     return *iter;
@@ -139,7 +153,7 @@ const summary &state::get_summary(std::string_view tag) const
 
   // Then names:
   iter = std::find_if(m_summaries.cbegin(), m_summaries.cend(), [&tag](const auto &s) {
-    return s.get_string("name") == tag;
+    return s.get_name() == tag;
   });
   if (iter != m_summaries.cend())
   {
@@ -151,25 +165,101 @@ const summary &state::get_summary(std::string_view tag) const
 
 summary &state::get_summary(std::string_view tag)
 {
-  // Check tags first
-  auto iter = std::find_if(m_summaries.begin(), m_summaries.end(), [&tag](const auto &s) {
-    return s.get_tag() == tag;
-  });
-  if (iter != m_summaries.end())
+  const auto &self = *this;
+  return const_cast<summary &>(self.get_summary(tag));
+}
+
+nvbench::int64_t state::prepare_input_pools(nvbench::int64_t launches)
+{
+  auto available = std::numeric_limits<nvbench::int64_t>::max();
+  for (auto &pool : m_input_pools)
   {
-    return *iter;
+    if (static_cast<nvbench::int64_t>(pool->get_remaining()) < launches)
+    {
+      pool->refresh();
+    }
+    available = std::min(available, static_cast<nvbench::int64_t>(pool->get_remaining()));
   }
+  return available;
+}
 
-  // Then names:
-  iter = std::find_if(m_summaries.begin(), m_summaries.end(), [&tag](const auto &s) {
-    return s.get_string("name") == tag;
+bool state::needs_input_pool_refresh(nvbench::int64_t launches) const
+{
+  return std::any_of(m_input_pools.cbegin(), m_input_pools.cend(), [launches](const auto &pool) {
+    return static_cast<nvbench::int64_t>(pool->get_remaining()) < launches;
   });
-  if (iter != m_summaries.end())
+}
+
+nvbench::uint64_t state::get_data_seed() const
+{
+  // FNV-1a is stable across platforms and standard library implementations:
+  nvbench::uint64_t hash = 0xcbf29ce484222325;
+  auto append            = [&hash](const std::string &str) {
+    for (const char c : str)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 0x100000001b3;
+    }
+    hash ^= 0xff;
+    hash *= 0x100000001b3;
+  };
+
+  const auto &bench = m_benchmark.get();
+  append(fmt::format("{}", bench.get_data_seed()));
+  append(bench.get_name());
+  for (const auto &name : m_axis_values.get_names())
   {
-    return *iter;
+    std::visit([&append, &name](const auto &value) { append(fmt::format("{}={}", name, value)); },
+               m_axis_values.get_value(name));
   }
+  return hash;
+}
 
-  NVBENCH_THROW(std::invalid_argument, "No summary tagged '{}'.", tag);
+std::string state::get_fixture_key(const std::string &name, const std::type_info &type) const
+{
+  const auto &bench = m_benchmark.get();
+
+  fmt::memory_buffer buffer;
+  fmt::format_to(std::back_inserter(buffer),
+                 "{}|{}|{}|{}|{}",
+                 bench.get_name(),
+                 m_device ? m_device->get_id() : -1,
+                 m_type_config_index,
+                 name,
+                 type.name());
+
+  const auto &fixture_axes = bench.get_fixture_axes();
+  for (const auto &axis_name : fixture_axes ? *fixture_axes : m_axis_values.get_names())
+  {
+    NVBENCH_THROW_IF(!m_axis_values.has_value(axis_name),
+                     std::runtime_error,
+                     "Fixture axis '{}' not found in benchmark '{}'.",
+                     axis_name,
+                     bench.get_name());
+    std::visit(
+      [&buffer, &axis_name](const auto &value) {
+        fmt::format_to(std::back_inserter(buffer), "|{}={}", axis_name, value);
+      },
+      m_axis_values.get_value(axis_name));
+  }
+
+  return fmt::to_string(buffer);
+}
+
+void state::cache_fixture(const std::string &key, std::shared_ptr<void> value, std::size_t bytes)
+{
+  nvbench::fixture_cache::get().insert(key,
+                                       std::move(value),
+                                       bytes,
+                                       m_benchmark.get().get_fixture_cache_size());
+}
+
+void *state::allocate_host_buffer(std::size_t bytes, std::size_t alignment)
+{
+  auto &pool      = nvbench::host_buffer_pool::get();
+  const auto mode = nvbench::host_buffer_pool::parse_page_mode(m_benchmark.get().get_huge_pages());
+  m_host_buffers.push_back(pool.acquire(bytes, alignment, mode));
+  return m_host_buffers.back().data;
 }
 
 const std::vector<summary> &state::get_summaries() const { return m_summaries; }
@@ -80,7 +80,8 @@ public:
    */
   explicit stopping_criterion_base(std::string name, criterion_params params)
       : m_name{std::move(name)}
-      , m_params{std::move(params)}
+      , m_params{params}
+      , m_default_params{std::move(params)}
   {}
 
   virtual ~stopping_criterion_base() = default;
@@ -95,6 +96,8 @@ public:
    */
   void initialize(const criterion_params &params)
   {
+    // Criteria are shared between states; don't keep values from a previous run:
+    m_params = m_default_params;
     m_params.set_from(params);
     this->do_initialize();
   }
@@ -109,6 +112,9 @@ public:
    */
   bool is_finished() { return this->do_is_finished(); }
 
+private:
+  criterion_params m_default_params;
+
 protected:
   /**
    * Initialize the criterion after updating the parameters
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <nvbench/named_values.cuh>
+#include <nvbench/summary_registry.cuh>
 
 #include <string>
 #include <utility>
@@ -65,6 +66,8 @@ namespace nvbench
  * - "byte_rate": "value" is a float64_t byte rate in bytes / second.
  * - "sample_size": "value" is an int64_t samples count.
  * - "percentage": "value" is a float64_t percentage (100% stored as 1.0).
+ * - "normalized_count": "value" is a float64_t event count per element or
+ *   byte, e.g. CPU cycles per element.
  * - "file/sample_times":
  *   - "filename" is the path to a binary file that encodes all sample
  *     times (in seconds) as float32_t values.
@@ -83,6 +86,14 @@ namespace nvbench
  *                  timers.");
  * summ.set_float64("value", avg_batch_gpu_time);
  * ```
+ *
+ * Summaries that are added to many states should instead be created from a
+ * nvbench::summary_descriptor registered with nvbench::summary_registry. The
+ * tag and reserved metadata keys are then shared through the descriptor and
+ * only the values are stored in the summary. Metadata keys set on such a
+ * summary override the descriptor. Use the `get_name`, `get_hint`,
+ * `get_description` and `is_hidden` accessors to read metadata from either
+ * kind of summary.
  */
 struct summary : public nvbench::named_values
 {
@@ -90,6 +101,9 @@ struct summary : public nvbench::named_values
   explicit summary(std::string tag)
       : m_tag(std::move(tag))
   {}
+  explicit summary(const summary_descriptor &descriptor)
+      : m_descriptor(&descriptor)
+  {}
 
   // move-only
   summary(const summary &)            = delete;
@@ -97,11 +111,31 @@ struct summary : public nvbench::named_values
   summary &operator=(const summary &) = delete;
   summary &operator=(summary &&)      = default;
 
-  void set_tag(std::string tag) { m_tag = std::move(tag); }
-  [[nodiscard]] const std::string &get_tag() const { return m_tag; }
+  /// Copies the descriptor's metadata into the summary before detaching it.
+  void set_tag(std::string tag);
+  [[nodiscard]] const std::string &get_tag() const
+  {
+    return m_descriptor != nullptr ? m_descriptor->tag : m_tag;
+  }
+
+  /// nullptr unless created from a registered descriptor.
+  [[nodiscard]] const summary_descriptor *get_descriptor() const { return m_descriptor; }
+
+  /// Metadata from the reserved keys, falling back to the descriptor. Absent
+  /// values are empty, except for the name, which defaults to the tag. @{
+  [[nodiscard]] const std::string &get_name() const;
+  [[nodiscard]] const std::string &get_hint() const;
+  [[nodiscard]] const std::string &get_description() const;
+  [[nodiscard]] const std::string &get_hide() const;
+  [[nodiscard]] bool is_hidden() const;
+  /// @}
 
 private:
+  [[nodiscard]] const std::string &get_metadata(const std::string &key,
+                                                std::string summary_descriptor::*field) const;
+
   std::string m_tag;
+  const summary_descriptor *m_descriptor{};
 };
 
 } // namespace nvbench
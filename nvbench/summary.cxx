@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/summary.cuh>
+
+namespace nvbench
+{
+
+void summary::set_tag(std::string tag)
+{
+  if (m_descriptor != nullptr)
+  {
+    const auto copy_field = [this](const char *key, const std::string &value) {
+      if (!value.empty() && !this->has_value(key))
+      {
+        this->set_string(key, value);
+      }
+    };
+    copy_field("name", m_descriptor->name);
+    copy_field("hint", m_descriptor->hint);
+    copy_field("description", m_descriptor->description);
+    copy_field("hide", m_descriptor->hide);
+    m_descriptor = nullptr;
+  }
+  m_tag = std::move(tag);
+}
+
+const std::string &summary::get_metadata(const std::string &key,
+                                         std::string summary_descriptor::*field) const
+{
+  static const std::string empty;
+  if (this->has_value(key))
+  {
+    return this->get_string(key);
+  }
+  return m_descriptor != nullptr ? m_descriptor->*field : empty;
+}
+
+const std::string &summary::get_name() const
+{
+  const auto &name = this->get_metadata("name", &summary_descriptor::name);
+  return name.empty() ? this->get_tag() : name;
+}
+
+const std::string &summary::get_hint() const
+{
+  return this->get_metadata("hint", &summary_descriptor::hint);
+}
+
+const std::string &summary::get_description() const
+{
+  return this->get_metadata("description", &summary_descriptor::description);
+}
+
+const std::string &summary::get_hide() const
+{
+  return this->get_metadata("hide", &summary_descriptor::hide);
+}
+
+bool summary::is_hidden() const
+{
+  return this->has_value("hide") || (m_descriptor != nullptr && !m_descriptor->hide.empty());
+}
+
+} // namespace nvbench
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvbench/device_info.cuh>
+#include <nvbench/named_values.cuh>
+#include <nvbench/summary.cuh>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nvbench
+{
+
+/**
+ * @brief Summaries computed from a group of benchmark states.
+ *
+ * Some results, such as complexity fits, describe several states at once
+ * rather than any single configuration. A summary group identifies the states
+ * it was computed from by device and by the subset of axis values shared by
+ * all of them. Axes that vary within the group are omitted from
+ * `get_axis_values()`.
+ *
+ * Summary groups are stored on the benchmark and are written by printers
+ * after the per-state results. See nvbench::summary for the key/value
+ * conventions used by the summaries.
+ */
+struct summary_group
+{
+  summary_group(std::optional<nvbench::device_info> device, nvbench::named_values axis_values)
+      : m_device{std::move(device)}
+      , m_axis_values{std::move(axis_values)}
+  {}
+
+  // move-only
+  summary_group(const summary_group &)            = delete;
+  summary_group(summary_group &&)                 = default;
+  summary_group &operator=(const summary_group &) = delete;
+  summary_group &operator=(summary_group &&)      = default;
+
+  [[nodiscard]] const std::optional<nvbench::device_info> &get_device() const { return m_device; }
+
+  [[nodiscard]] const nvbench::named_values &get_axis_values() const { return m_axis_values; }
+
+  nvbench::summary &add_summary(std::string summary_tag)
+  {
+    return m_summaries.emplace_back(std::move(summary_tag));
+  }
+
+  nvbench::summary &add_summary(const nvbench::summary_descriptor &descriptor)
+  {
+    return m_summaries.emplace_back(descriptor);
+  }
+
+  [[nodiscard]] const std::vector<nvbench::summary> &get_summaries() const { return m_summaries; }
+  [[nodiscard]] std::vector<nvbench::summary> &get_summaries() { return m_summaries; }
+
+private:
+  std::optional<nvbench::device_info> m_device;
+  nvbench::named_values m_axis_values;
+  std::vector<nvbench::summary> m_summaries;
+};
+
+} // namespace nvbench
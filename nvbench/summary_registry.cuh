@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nvbench
+{
+
+/**
+ * Metadata shared by every summary with the same tag.
+ *
+ * The fields correspond to the reserved summary keys described in
+ * nvbench::summary. Empty fields are treated as absent; in particular, the
+ * summary is only hidden if `hide` is non-empty.
+ */
+struct summary_descriptor
+{
+  summary_descriptor(std::string tag,
+                     std::string name,
+                     std::string hint        = {},
+                     std::string description = {},
+                     std::string hide        = {})
+      : tag{std::move(tag)}
+      , name{std::move(name)}
+      , hint{std::move(hint)}
+      , description{std::move(description)}
+      , hide{std::move(hide)}
+  {}
+
+  std::string tag;
+  std::string name;
+  std::string hint;
+  std::string description;
+  std::string hide;
+
+  [[nodiscard]] bool operator==(const summary_descriptor &other) const
+  {
+    return tag == other.tag && name == other.name && hint == other.hint &&
+           description == other.description && hide == other.hide;
+  }
+  [[nodiscard]] bool operator!=(const summary_descriptor &other) const
+  {
+    return !(*this == other);
+  }
+};
+
+/**
+ * Singleton that owns all registered summary descriptors.
+ *
+ * Summaries created from a registered descriptor only store their values and
+ * a pointer to the descriptor, instead of copying the metadata into every
+ * state. Descriptors are never removed, so references remain valid for the
+ * lifetime of the program.
+ *
+ * Register descriptors once, e.g. in a function-local static:
+ *
+ * ```
+ * static const auto &desc = nvbench::summary_registry::get().add(
+ *   {"my/time/mean", "Time", "duration", "Mean time of my measurement"});
+ * auto &summ = state.add_summary(desc);
+ * summ.set_float64("value", mean_time);
+ * ```
+ */
+struct summary_registry
+{
+  /**
+   * @return The singleton summary_registry instance.
+   */
+  [[nodiscard]] static summary_registry &get();
+
+  /**
+   * Register a new descriptor. If an identical descriptor is already
+   * registered, it is returned instead. Throws if the tag is registered with
+   * different metadata.
+   */
+  const summary_descriptor &add(summary_descriptor descriptor);
+
+  /**
+   * @return The descriptor registered for `tag`, or nullptr.
+   */
+  [[nodiscard]] const summary_descriptor *find(std::string_view tag) const;
+
+  /**
+   * @return All descriptors in registration order.
+   */
+  [[nodiscard]] std::vector<const summary_descriptor *> get_descriptors() const;
+
+private:
+  summary_registry()                                    = default;
+  summary_registry(const summary_registry &)            = delete;
+  summary_registry(summary_registry &&)                 = delete;
+  summary_registry &operator=(const summary_registry &) = delete;
+  summary_registry &operator=(summary_registry &&)      = delete;
+
+  mutable std::mutex m_mutex;
+  // Deque elements don't move, so the map may reference their tags:
+  std::deque<summary_descriptor> m_descriptors;
+  std::unordered_map<std::string_view, const summary_descriptor *> m_tags;
+};
+
+} // namespace nvbench
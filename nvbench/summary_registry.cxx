@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/throw.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <stdexcept>
+
+namespace nvbench
+{
+
+summary_registry &summary_registry::get()
+{
+  static summary_registry the_registry;
+  return the_registry;
+}
+
+const summary_descriptor &summary_registry::add(summary_descriptor descriptor)
+{
+  NVBENCH_THROW_IF(descriptor.tag.empty(),
+                   std::invalid_argument,
+                   "{}",
+                   "Summary descriptors require a tag.");
+
+  std::lock_guard<std::mutex> lock{m_mutex};
+  if (auto iter = m_tags.find(descriptor.tag); iter != m_tags.cend())
+  {
+    NVBENCH_THROW_IF(*iter->second != descriptor,
+                     std::invalid_argument,
+                     "Summary tag '{}' is already registered with different metadata.",
+                     descriptor.tag);
+    return *iter->second;
+  }
+
+  const auto &result = m_descriptors.emplace_back(std::move(descriptor));
+  m_tags.emplace(std::string_view{result.tag}, &result);
+  return result;
+}
+
+const summary_descriptor *summary_registry::find(std::string_view tag) const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  const auto iter = m_tags.find(tag);
+  return iter == m_tags.cend() ? nullptr : iter->second;
+}
+
+std::vector<const summary_descriptor *> summary_registry::get_descriptors() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  std::vector<const summary_descriptor *> result;
+  result.reserve(m_descriptors.size());
+  for (const auto &descriptor : m_descriptors)
+  {
+    result.push_back(&descriptor);
+  }
+  return result;
+}
+
+} // namespace nvbench
@@ -23,6 +23,8 @@ config_count = 0
 unknown_count = 0
 failure_count = 0
 pass_count = 0
+log_ratio_sum = 0.0
+log_ratio_count = 0
 
 
 def find_matching_bench(needle, haystack):
@@ -140,6 +142,8 @@ def compare_benches(ref_benches, cmp_benches, threshold, plot):
 
         for device_id in device_ids:
             rows = []
+            log_ratios = []
+            worst = None
             plot_data = {"cmp": {}, "ref": {}, "cmp_noise": {}, "ref_noise": {}}
 
             for cmp_state in cmp_states:
@@ -255,8 +259,17 @@ def compare_benches(ref_benches, cmp_benches, threshold, plot):
                 global unknown_count
                 global pass_count
                 global failure_count
+                global log_ratio_sum
+                global log_ratio_count
 
                 config_count += 1
+                if ref_time > 0 and cmp_time > 0:
+                    log_ratio = math.log(cmp_time / ref_time)
+                    log_ratios.append(log_ratio)
+                    log_ratio_sum += log_ratio
+                    log_ratio_count += 1
+                    if worst is None or frac_diff > worst[1]:
+                        worst = (cmp_state_name, frac_diff)
                 if not min_noise:
                     unknown_count += 1
                     status = Fore.YELLOW + "????" + Fore.RESET
@@ -298,6 +311,14 @@ def compare_benches(ref_benches, cmp_benches, threshold, plot):
 
             print("")
 
+            if log_ratios:
+                geomean = math.exp(sum(log_ratios) / len(log_ratios)) - 1
+                print(
+                    "- Geomean %%Diff: %s over %d states"
+                    % (format_percentage(geomean), len(log_ratios))
+                )
+                print("- Worst: %s (%s)\n" % (worst[0], format_percentage(worst[1])))
+
             if plot:
                 plt.xscale("log")
                 plt.yscale("log")
@@ -390,6 +411,9 @@ def main():
     print("  - Pass    (diff <= min_noise): %d" % pass_count)
     print("  - Unknown (infinite noise):    %d" % unknown_count)
     print("  - Failure (diff > min_noise):  %d" % failure_count)
+    if log_ratio_count:
+        geomean = math.exp(log_ratio_sum / log_ratio_count) - 1
+        print("- Geomean %%Diff: %s" % format_percentage(geomean))
     return failure_count
 
 
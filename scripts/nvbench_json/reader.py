@@ -2,9 +2,61 @@ import json
 
 from . import version
 
+# First file version that marks the summaries created from a descriptor:
+descriptor_marker_version = (1, 5, 0)
+
+
+def get_file_version(file_root):
+    """
+    The file's JSON version as a (major, minor, patch) tuple, or None for
+    unversioned files.
+    """
+    try:
+        node = file_root["meta"]["version"]["json"]
+    except KeyError:
+        return None
+    return (node["major"], node["minor"], node["patch"])
+
+
+def expand_summary_descriptors(file_root):
+    """
+    Copy the metadata of each entry in the file's "summary_descriptors" section
+    into the summaries created from it. Metadata written in a summary takes
+    precedence. Files without the section are left unchanged.
+
+    Since version 1.5.0 such summaries are marked with `"descriptor": true`, so
+    ad-hoc summaries that reuse a registered tag keep their own metadata. Older
+    files are matched by tag alone. The marker is removed after expanding.
+    """
+    descriptors = {d["tag"]: d for d in file_root.get("summary_descriptors", [])}
+    if not descriptors:
+        return file_root
+
+    file_version = get_file_version(file_root)
+    has_markers = file_version is not None and file_version >= descriptor_marker_version
+
+    def expand(summaries):
+        for summary in summaries:
+            is_described = summary.pop("descriptor", False)
+            if has_markers and not is_described:
+                continue
+            descriptor = descriptors.get(summary["tag"])
+            if descriptor is None:
+                continue
+            for key, value in descriptor.items():
+                summary.setdefault(key, value)
+
+    for bench in file_root.get("benchmarks", []):
+        for state in bench.get("states", []):
+            expand(state.get("summaries") or [])
+        for group in bench.get("summary_groups", []):
+            expand(group.get("summaries") or [])
+
+    return file_root
+
 
 def read_file(filename):
     with open(filename, "r") as f:
         file_root = json.load(f)
     version.check_file_version(filename, file_root)
-    return file_root
+    return expand_summary_descriptors(file_root)
@@ -1,4 +1,4 @@
-file_version = (1, 0, 0)
+file_version = (1, 5, 0)
 
 file_version_string = "{}.{}.{}".format(
     file_version[0], file_version[1], file_version[2]
@@ -0,0 +1,100 @@
+import copy
+import json
+
+from nvbench_json import reader
+
+DESCRIPTORS = [
+    {
+        "tag": "nv/cold/time/gpu/mean",
+        "name": "GPU Time",
+        "hint": "duration",
+        "description": "Mean GPU time",
+        "hide": "Hidden by default.",
+    }
+]
+
+
+def make_file(version, summaries, descriptors=None):
+    root = {
+        "meta": {
+            "version": {
+                "json": {
+                    "major": version[0],
+                    "minor": version[1],
+                    "patch": version[2],
+                    "string": "{}.{}.{}".format(*version),
+                }
+            }
+        },
+        "benchmarks": [
+            {
+                "name": "bench",
+                "states": [{"name": "state", "summaries": copy.deepcopy(summaries)}],
+                "summary_groups": [{"summaries": copy.deepcopy(summaries)}],
+            }
+        ],
+    }
+    if descriptors is not None:
+        root["summary_descriptors"] = copy.deepcopy(descriptors)
+    return root
+
+
+def get_summaries(root):
+    bench = root["benchmarks"][0]
+    return bench["states"][0]["summaries"], bench["summary_groups"][0]["summaries"]
+
+
+def test_without_descriptors():
+    # Before 1.2.0, every summary carries its own metadata:
+    summaries = [
+        {
+            "tag": "nv/cold/time/gpu/mean",
+            "name": "GPU Time",
+            "hint": "duration",
+            "data": [{"name": "value", "type": "float64", "value": "1.0"}],
+        }
+    ]
+    root = make_file((1, 1, 0), summaries)
+    expected = copy.deepcopy(root)
+    assert reader.expand_summary_descriptors(root) == expected
+
+
+def test_unmarked_descriptors():
+    # 1.2.0 to 1.4.0 match summaries to descriptors by tag:
+    summaries = [
+        {"tag": "nv/cold/time/gpu/mean"},
+        {"tag": "nv/cold/time/gpu/mean", "name": "Override"},
+        {"tag": "custom/tag", "name": "Custom"},
+    ]
+    root = make_file((1, 4, 0), summaries, DESCRIPTORS)
+    for node in get_summaries(reader.expand_summary_descriptors(root)):
+        assert node[0]["name"] == "GPU Time"
+        assert node[0]["hint"] == "duration"
+        assert node[0]["hide"] == "Hidden by default."
+        assert node[1]["name"] == "Override"
+        assert node[1]["hint"] == "duration"
+        assert node[2] == {"tag": "custom/tag", "name": "Custom"}
+
+
+def test_marked_descriptors():
+    # Since 1.5.0, only marked summaries are expanded, even if an ad-hoc
+    # summary reuses a described tag:
+    summaries = [
+        {"tag": "nv/cold/time/gpu/mean", "descriptor": True},
+        {"tag": "nv/cold/time/gpu/mean", "descriptor": True, "name": "Override"},
+        {"tag": "nv/cold/time/gpu/mean", "name": "Ad-hoc"},
+    ]
+    root = make_file((1, 5, 0), summaries, DESCRIPTORS)
+    for node in get_summaries(reader.expand_summary_descriptors(root)):
+        assert node[0] == dict(DESCRIPTORS[0])
+        assert node[1]["name"] == "Override"
+        assert node[1]["description"] == "Mean GPU time"
+        assert node[2] == {"tag": "nv/cold/time/gpu/mean", "name": "Ad-hoc"}
+
+
+def test_read_file(tmp_path):
+    summaries = [{"tag": "nv/cold/time/gpu/mean", "descriptor": True}]
+    path = tmp_path / "result.json"
+    path.write_text(json.dumps(make_file((1, 5, 0), summaries, DESCRIPTORS)))
+    state_summaries, _ = get_summaries(reader.read_file(str(path)))
+    assert state_summaries[0]["name"] == "GPU Time"
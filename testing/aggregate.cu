@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_group.cuh>
+#include <nvbench/types.cuh>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+const nvbench::summary &get_summary(const nvbench::summary_group &group, const std::string &tag)
+{
+  const auto &summaries = group.get_summaries();
+  const auto iter = std::find_if(summaries.cbegin(), summaries.cend(), [&tag](const auto &summ) {
+    return summ.get_tag() == tag;
+  });
+  ASSERT_MSG(iter != summaries.cend(), "Missing summary '{}'", tag);
+  return *iter;
+}
+
+bool has_summary(const nvbench::summary_group &group, const std::string &tag)
+{
+  const auto &summaries = group.get_summaries();
+  return std::any_of(summaries.cbegin(), summaries.cend(), [&tag](const auto &summ) {
+    return summ.get_tag() == tag;
+  });
+}
+
+// Times of 1, 4 and 16 us for Elements = 1, 2, 3; "B" is twice as slow.
+// "A" processes one item per state, "B" reports no items.
+void aggregate_generator(nvbench::state &state)
+{
+  const auto elements = state.get_int64("Elements");
+  const auto is_a     = state.get_string("Variant") == "A";
+  const auto time     = (is_a ? 1e-6 : 2e-6) * std::pow(4., static_cast<double>(elements - 1));
+
+  {
+    auto &summ = state.add_summary("nv/cpu_only/time/cpu/mean");
+    summ.set_float64("value", time);
+  }
+  if (is_a)
+  {
+    auto &summ = state.add_summary("nv/cpu_only/bw/item_rate");
+    summ.set_float64("value", static_cast<double>(elements) / time);
+  }
+  if (elements == 2)
+  {
+    // As added by --baseline:
+    auto &summ = state.add_summary("nv/baseline/diff");
+    summ.set_float64("value", is_a ? 0.21 : -0.5);
+  }
+}
+NVBENCH_DEFINE_CALLABLE(aggregate_generator, aggregate_callable);
+
+using benchmark_type = nvbench::benchmark<aggregate_callable>;
+using runner_type    = nvbench::runner<benchmark_type>;
+
+void setup(benchmark_type &bench)
+{
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Elements", {1, 2, 3});
+  bench.add_string_axis("Variant", {"A", "B"});
+}
+
+} // namespace
+
+void test_per_axis()
+{
+  benchmark_type bench;
+  setup(bench);
+  bench.add_aggregate({"Elements"});
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  const auto &groups = bench.get_summary_groups();
+  ASSERT(groups.size() == 2);
+  for (const auto &group : groups)
+  {
+    ASSERT(!group.get_device().has_value());
+    ASSERT(group.get_axis_values().get_size() == 1);
+    const auto is_a = group.get_axis_values().get_string("Variant") == "A";
+
+    ASSERT(get_summary(group, "nv/aggregate/num_states").get_int64("value") == 3);
+
+    const auto &geomean = get_summary(group, "nv/aggregate/time/geomean");
+    ASSERT(geomean.get_string("time_tag") == "nv/cpu_only/time/cpu/mean");
+    ASSERT(std::abs(geomean.get_float64("value") - (is_a ? 4e-6 : 8e-6)) < 1e-15);
+
+    // Only "B" has no item rates:
+    ASSERT(has_summary(group, "nv/aggregate/bw/item_rate/hmean") == is_a);
+    if (is_a)
+    {
+      const auto hmean = 3. / (1e-6 / 1. + 4e-6 / 2. + 16e-6 / 3.);
+      ASSERT(std::abs(get_summary(group, "nv/aggregate/bw/item_rate/hmean").get_float64("value") -
+                      hmean) < 1e-6);
+    }
+    ASSERT(!has_summary(group, "nv/aggregate/bw/global/bytes_per_second/hmean"));
+
+    // Only Elements=2 was compared with the baseline:
+    const auto base_diff = get_summary(group, "nv/aggregate/baseline/diff").get_float64("value");
+    ASSERT(std::abs(base_diff - (is_a ? 0.21 : -0.5)) < 1e-12);
+
+    // The regression beats the other criteria for "A", the improvement doesn't for "B":
+    const auto &worst = get_summary(group, "nv/aggregate/worst_state");
+    ASSERT_MSG(worst.get_string("value") == "Elements=2", "{}", worst.get_string("value"));
+  }
+}
+
+void test_all_states()
+{
+  benchmark_type bench;
+  setup(bench);
+  bench.add_aggregate();
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  const auto &groups = bench.get_summary_groups();
+  ASSERT(groups.size() == 1);
+  const auto &group = groups[0];
+  ASSERT(group.get_axis_values().get_size() == 0);
+  ASSERT(get_summary(group, "nv/aggregate/num_states").get_int64("value") == 6);
+  ASSERT(std::abs(get_summary(group, "nv/aggregate/time/geomean").get_float64("value") -
+                  std::sqrt(4e-6 * 8e-6)) < 1e-15);
+  ASSERT(!has_summary(group, "nv/aggregate/bw/item_rate/hmean"));
+
+  const auto base_diff = get_summary(group, "nv/aggregate/baseline/diff").get_float64("value");
+  ASSERT(std::abs(base_diff - (std::sqrt(1.21 * 0.5) - 1.)) < 1e-12);
+  ASSERT(get_summary(group, "nv/aggregate/worst_state").get_string("value") ==
+         "Elements=2 Variant=A");
+}
+
+void test_missing_axis()
+{
+  benchmark_type bench;
+  setup(bench);
+  bench.add_aggregate({"Size"});
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+  ASSERT(bench.get_summary_groups().empty());
+}
+
+int main()
+{
+  test_per_axis();
+  test_all_states();
+  test_missing_axis();
+}
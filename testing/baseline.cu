@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/results.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+namespace
+{
+
+// The baseline has a mean of 1ms with 1% noise for every size:
+const char *baseline_json = R"json({
+  "benchmarks": [{
+    "name": "baseline_bench", "index": 0,
+    "states": [
+      {"name": "Size=1", "summaries": [
+        {"tag": "nv/cpu_only/time/cpu/mean",
+         "data": [{"name": "value", "type": "float64", "value": "1e-3"}]},
+        {"tag": "nv/cpu_only/time/cpu/stdev/relative",
+         "data": [{"name": "value", "type": "float64", "value": "0.01"}]}]},
+      {"name": "Size=2", "summaries": [
+        {"tag": "nv/cpu_only/time/cpu/mean",
+         "data": [{"name": "value", "type": "float64", "value": "1e-3"}]},
+        {"tag": "nv/cpu_only/time/cpu/stdev/relative",
+         "data": [{"name": "value", "type": "float64", "value": "0.01"}]}]},
+      {"name": "Size=3", "summaries": [
+        {"tag": "nv/cpu_only/time/cpu/mean",
+         "data": [{"name": "value", "type": "float64", "value": "1e-3"}]},
+        {"tag": "nv/cpu_only/time/cpu/stdev/relative",
+         "data": [{"name": "value", "type": "float64", "value": "0.01"}]}]}
+    ]
+  }]
+})json";
+
+} // namespace
+
+// Size=1 is unchanged, Size=2 is 20% slower, Size=3 is 20% faster and
+// Size=4 has no baseline:
+void baseline_generator(nvbench::state &state)
+{
+  const auto size = state.get_int64("Size");
+  const auto time = size == 2 ? 1.2e-3 : size == 3 ? 0.8e-3 : 1.001e-3;
+  state.add_summary("nv/cpu_only/time/cpu/mean").set_float64("value", time);
+  state.add_summary("nv/cpu_only/time/cpu/stdev/relative").set_float64("value", 0.02);
+}
+NVBENCH_DEFINE_CALLABLE(baseline_generator, baseline_callable);
+
+void test_baseline_summaries()
+{
+  const auto path = (fs::temp_directory_path() / "nvbench_test_baseline.json").string();
+  {
+    std::ofstream out{path};
+    out << baseline_json;
+  }
+  auto baseline = std::make_shared<const nvbench::results::result_file>(
+    nvbench::results::result_file::read(path));
+  std::remove(path.c_str());
+
+  using benchmark_type = nvbench::benchmark<baseline_callable>;
+  using runner_type    = nvbench::runner<benchmark_type>;
+
+  benchmark_type bench;
+  bench.set_name("baseline_bench");
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Size", {1, 2, 3, 4});
+  bench.set_baseline(baseline);
+  ASSERT(bench.get_baseline() == baseline.get());
+  ASSERT(bench.clone()->get_baseline() == baseline.get());
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  const auto &states = bench.get_states();
+  ASSERT(states.size() == 4);
+
+  const auto check = [&states](std::size_t i, double diff, const std::string &verdict) {
+    const auto &state = states[i];
+    ASSERT(state.get_summary("nv/baseline/time").get_float64("value") == 1e-3);
+    ASSERT(state.get_summary("nv/baseline/time").get_hint() == "duration");
+    ASSERT(std::abs(state.get_summary("nv/baseline/diff").get_float64("value") - diff) < 1e-9);
+    ASSERT(state.get_summary("nv/baseline/diff").get_hint() == "percentage");
+    ASSERT_MSG(state.get_summary("nv/baseline/verdict").get_string("value") == verdict,
+               "{}: {}",
+               state.get_axis_values_as_string(),
+               state.get_summary("nv/baseline/verdict").get_string("value"));
+  };
+  check(0, 0.001, "SAME");
+  check(1, 0.2, "SLOW");
+  check(2, -0.2, "FAST");
+
+  // No matching baseline state:
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto &s = states[3].get_summary("nv/baseline/diff"));
+}
+
+int main() { test_baseline_summaries(); }
@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/co_runner.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+void test_specs()
+{
+  using co_runner = nvbench::detail::co_runner;
+
+  ASSERT(co_runner{"none"}.get_kind() == co_runner::kind::none);
+  ASSERT(co_runner{"membw"}.get_kind() == co_runner::kind::memory_bandwidth);
+  ASSERT(co_runner{"llc"}.get_kind() == co_runner::kind::cache_thrash);
+  ASSERT(co_runner{"smt"}.get_kind() == co_runner::kind::smt_spin);
+  ASSERT(co_runner{"membw"}.get_cpu() == -1);
+  ASSERT(co_runner{"llc@3"}.get_cpu() == 3);
+
+  for (const auto k : {co_runner::kind::none,
+                       co_runner::kind::memory_bandwidth,
+                       co_runner::kind::cache_thrash,
+                       co_runner::kind::smt_spin})
+  {
+    ASSERT(co_runner::kind_from_string(co_runner::kind_to_string(k)) == k);
+  }
+
+  for (const std::string spec : {"", "spin", "membw@", "membw@x", "llc@-1", "llc@1x", "smt@2"})
+  {
+    ASSERT_THROWS_ANY(co_runner{spec});
+  }
+}
+
+void test_start_stop()
+{
+  using co_runner = nvbench::detail::co_runner;
+
+  for (const std::string spec : {"none", "membw", "llc"})
+  {
+    co_runner runner{spec};
+    runner.start();
+    runner.stop();
+    // Stopping twice is harmless:
+    runner.stop();
+
+    if (runner.get_kind() == co_runner::kind::none)
+    {
+      ASSERT(runner.get_buffer_size() == 0);
+    }
+    else
+    {
+      ASSERT(runner.get_buffer_size() > 0);
+    }
+  }
+
+  // Requires an SMT sibling, which not every machine has:
+  try
+  {
+    co_runner runner{"smt"};
+    runner.start();
+    ASSERT(runner.get_cpu() >= 0);
+  }
+  catch (std::runtime_error &)
+  {}
+}
+
+void slowdown_generator(nvbench::state &state)
+{
+  const auto &co_runner = state.get_string("CoRunner");
+  const auto time       = co_runner == "none" ? 1e-3 : co_runner == "membw" ? 1.5e-3 : 1.1e-3;
+
+  auto &summ = state.add_summary("nv/cpu_only/time/cpu/mean");
+  summ.set_string("hint", "duration");
+  summ.set_float64("value", time * static_cast<nvbench::float64_t>(state.get_int64("Size")));
+}
+NVBENCH_DEFINE_CALLABLE(slowdown_generator, slowdown_callable);
+
+void test_slowdown_summaries()
+{
+  using benchmark_type = nvbench::benchmark<slowdown_callable>;
+  using runner_type    = nvbench::runner<benchmark_type>;
+
+  benchmark_type bench;
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Size", {1, 2});
+  bench.add_co_runner_axis({"membw", "llc@0"});
+
+  // "none" is added first:
+  const auto &axis = bench.get_axes().get_string_axis("CoRunner");
+  ASSERT(axis.get_size() == 3);
+  ASSERT(axis.get_value(0) == "none");
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  const auto &states = bench.get_states();
+  ASSERT(states.size() == 6);
+  for (const auto &state : states)
+  {
+    const auto &co_runner = state.get_string("CoRunner");
+    const auto &summaries = state.get_summaries();
+    const auto iter = std::find_if(summaries.cbegin(), summaries.cend(), [](const auto &summ) {
+      return summ.get_tag() == "nv/co_runner/slowdown";
+    });
+
+    if (co_runner == "none")
+    {
+      ASSERT(iter == summaries.cend());
+      continue;
+    }
+
+    ASSERT(iter != summaries.cend());
+    const auto expected = co_runner == "membw" ? 0.5 : 0.1;
+    ASSERT_MSG(std::abs(iter->get_float64("value") - expected) < 1e-9,
+               "{}: {}",
+               co_runner,
+               iter->get_float64("value"));
+    ASSERT(iter->get_hint() == "percentage");
+  }
+}
+
+int main()
+{
+  test_specs();
+  test_start_stop();
+  test_slowdown_summaries();
+}
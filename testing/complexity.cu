@@ -0,0 +1,203 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/complexity.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/types.cuh>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+std::vector<nvbench::int64_t> get_sizes() { return {16, 64, 256, 1024, 4096, 16384}; }
+
+std::vector<nvbench::float64_t> get_times(const std::vector<nvbench::int64_t> &ns,
+                                          nvbench::float64_t (*f)(nvbench::float64_t))
+{
+  std::vector<nvbench::float64_t> times;
+  for (auto n : ns)
+  {
+    times.push_back(2e-9 * f(static_cast<nvbench::float64_t>(n)));
+  }
+  return times;
+}
+
+nvbench::complexity_fit make_fit(nvbench::complexity model = nvbench::complexity::automatic)
+{
+  return {"Elements", model, {}, {}};
+}
+
+} // namespace
+
+void test_automatic()
+{
+  const auto ns = get_sizes();
+
+  const auto check = [&ns](nvbench::float64_t (*f)(nvbench::float64_t),
+                           nvbench::complexity expected) {
+    const auto result = nvbench::detail::fit_complexity(ns, get_times(ns, f), make_fit());
+    ASSERT_MSG(result.model == expected,
+               "Expected {}, got {}",
+               nvbench::complexity_to_string(expected),
+               result.big_o);
+    ASSERT(result.big_o == nvbench::complexity_to_string(expected));
+    ASSERT(std::abs(result.coefficient - 2e-9) < 1e-12);
+    ASSERT(result.rms < 1e-6);
+  };
+
+  check([](nvbench::float64_t) { return 1.; }, nvbench::complexity::o1);
+  check([](nvbench::float64_t n) { return std::log2(n); }, nvbench::complexity::log_n);
+  check([](nvbench::float64_t n) { return n; }, nvbench::complexity::n);
+  check([](nvbench::float64_t n) { return n * std::log2(n); }, nvbench::complexity::n_log_n);
+  check([](nvbench::float64_t n) { return n * n; }, nvbench::complexity::n_squared);
+}
+
+void test_explicit_model()
+{
+  const auto ns    = get_sizes();
+  const auto times = get_times(ns, [](nvbench::float64_t n) { return n * n; });
+
+  // A poor fit is still reported when the model is requested explicitly:
+  const auto result = nvbench::detail::fit_complexity(ns, times, make_fit(nvbench::complexity::n));
+  ASSERT(result.model == nvbench::complexity::n);
+  ASSERT(result.big_o == "O(n)");
+  ASSERT(result.rms > 0.1);
+}
+
+void test_user_function()
+{
+  const auto ns    = get_sizes();
+  const auto times = get_times(ns, [](nvbench::float64_t n) { return std::sqrt(n); });
+
+  nvbench::complexity_fit fit{"Elements",
+                              nvbench::complexity::user,
+                              [](nvbench::int64_t n) {
+                                return std::sqrt(static_cast<nvbench::float64_t>(n));
+                              },
+                              "sqrt(n)"};
+  const auto result = nvbench::detail::fit_complexity(ns, times, fit);
+  ASSERT(result.model == nvbench::complexity::user);
+  ASSERT(result.big_o == "O(sqrt(n))");
+  ASSERT(std::abs(result.coefficient - 2e-9) < 1e-12);
+  ASSERT(result.rms < 1e-6);
+}
+
+void test_too_few_sizes()
+{
+  bool threw = false;
+  try
+  {
+    [[maybe_unused]] auto result =
+      nvbench::detail::fit_complexity({64, 64}, {1e-6, 1e-6}, make_fit());
+  }
+  catch (std::runtime_error &)
+  {
+    threw = true;
+  }
+  ASSERT(threw);
+}
+
+void test_strings()
+{
+  ASSERT(nvbench::complexity_from_string("auto") == nvbench::complexity::automatic);
+  ASSERT(nvbench::complexity_from_string("1") == nvbench::complexity::o1);
+  ASSERT(nvbench::complexity_from_string("logn") == nvbench::complexity::log_n);
+  ASSERT(nvbench::complexity_from_string("n") == nvbench::complexity::n);
+  ASSERT(nvbench::complexity_from_string("nlogn") == nvbench::complexity::n_log_n);
+  ASSERT(nvbench::complexity_from_string("n2") == nvbench::complexity::n_squared);
+
+  bool threw = false;
+  try
+  {
+    [[maybe_unused]] auto model = nvbench::complexity_from_string("n^3");
+  }
+  catch (std::runtime_error &)
+  {
+    threw = true;
+  }
+  ASSERT(threw);
+}
+
+void quadratic_generator(nvbench::state &state)
+{
+  const auto n     = static_cast<nvbench::float64_t>(state.get_int64("Elements"));
+  const auto scale = state.get_string("Variant") == "A" ? 1e-9 : 3e-9;
+
+  auto &summ = state.add_summary("nv/cpu_only/time/cpu/mean");
+  summ.set_string("hint", "duration");
+  summ.set_float64("value", scale * n * n);
+}
+NVBENCH_DEFINE_CALLABLE(quadratic_generator, quadratic_callable);
+
+void test_summary_groups()
+{
+  using benchmark_type = nvbench::benchmark<quadratic_callable>;
+  using runner_type    = nvbench::runner<benchmark_type>;
+
+  benchmark_type bench;
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Elements", get_sizes());
+  bench.add_string_axis("Variant", {"A", "B"});
+  bench.add_complexity_fit("Elements");
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  const auto &groups = bench.get_summary_groups();
+  ASSERT(groups.size() == 2);
+  for (const auto &group : groups)
+  {
+    ASSERT(!group.get_device().has_value());
+
+    const auto &axis_values = group.get_axis_values();
+    ASSERT(axis_values.get_size() == 1);
+    const auto scale = axis_values.get_string("Variant") == "A" ? 1e-9 : 3e-9;
+
+    const auto &summaries = group.get_summaries();
+    ASSERT(summaries.size() == 3);
+    ASSERT(summaries[0].get_tag() == "nv/complexity/Elements/big_o");
+    ASSERT(summaries[0].get_string("value") == "O(n^2)");
+    ASSERT(summaries[1].get_tag() == "nv/complexity/Elements/coefficient");
+    ASSERT(std::abs(summaries[1].get_float64("value") - scale) < 1e-12);
+    ASSERT(summaries[2].get_tag() == "nv/complexity/Elements/rms");
+    ASSERT(summaries[2].get_float64("value") < 1e-6);
+  }
+
+  // Regenerating states clears the previous results:
+  runner.generate_states();
+  ASSERT(bench.get_summary_groups().empty());
+}
+
+int main()
+{
+  test_automatic();
+  test_explicit_model();
+  test_user_function();
+  test_too_few_sizes();
+  test_strings();
+  test_summary_groups();
+}
@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/core_reservation.cuh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "test_asserts.cuh"
+
+using nvbench::detail::core_reservation;
+
+namespace
+{
+
+std::string make_directory()
+{
+  char path[] = "/tmp/nvbench_core_reservation_XXXXXX";
+  ASSERT(mkdtemp(path) != nullptr);
+  return path;
+}
+
+std::vector<int> get_affinity()
+{
+  cpu_set_t cpus;
+  sched_getaffinity(0, sizeof(cpus), &cpus);
+  std::vector<int> result;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &cpus))
+    {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+// Reserves one core at a time until none are free:
+std::vector<std::unique_ptr<core_reservation>> reserve_all(const std::string &dir)
+{
+  std::vector<std::unique_ptr<core_reservation>> reservations;
+  for (;;)
+  {
+    try
+    {
+      reservations.push_back(std::make_unique<core_reservation>("1", 0., dir));
+    }
+    catch (std::exception &)
+    {
+      return reservations;
+    }
+  }
+}
+
+} // namespace
+
+void test_spec()
+{
+  ASSERT(core_reservation::spec::parse("").m_kind == core_reservation::kind::none);
+  ASSERT(core_reservation::spec::parse("none").to_string() == "none");
+  ASSERT(core_reservation::spec::parse("numa").m_kind == core_reservation::kind::numa);
+
+  const auto cores = core_reservation::spec::parse("4");
+  ASSERT(cores.m_kind == core_reservation::kind::cores);
+  ASSERT(cores.m_count == 4);
+  ASSERT(cores.to_string() == "4");
+
+  ASSERT_THROWS_ANY([[maybe_unused]] auto s = core_reservation::spec::parse("0"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto s = core_reservation::spec::parse("-1"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto s = core_reservation::spec::parse("2x"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto s = core_reservation::spec::parse("node"));
+}
+
+void test_reserve()
+{
+  const auto dir      = make_directory();
+  const auto affinity = get_affinity();
+  {
+    core_reservation reservation{"1", 0., dir};
+    const auto &cpus = reservation.get_cpus();
+    ASSERT(!cpus.empty());
+    ASSERT(std::is_sorted(cpus.cbegin(), cpus.cend()));
+    ASSERT(!reservation.get_cpus_as_string().empty());
+
+    // Pinned to the reserved CPUs:
+    for (const int cpu : get_affinity())
+    {
+      ASSERT(std::find(cpus.cbegin(), cpus.cend(), cpu) != cpus.cend());
+    }
+
+    // The lock file names the holder:
+    std::ifstream file{fmt::format("{}/cpu{}.lock", dir, cpus.front())};
+    int pid = 0;
+    file >> pid;
+    ASSERT(pid == getpid());
+  }
+  ASSERT(get_affinity() == affinity);
+
+  // Reservations are exclusive, even within a process:
+  auto reservations = reserve_all(dir);
+  ASSERT(!reservations.empty());
+  std::vector<int> reserved;
+  for (const auto &reservation : reservations)
+  {
+    for (const int cpu : reservation->get_cpus())
+    {
+      ASSERT(std::find(reserved.cbegin(), reserved.cend(), cpu) == reserved.cend());
+      reserved.push_back(cpu);
+    }
+  }
+  ASSERT_THROWS_ANY(core_reservation("numa", 0., dir));
+
+  // Waits for a core to be released:
+  std::thread releaser{[&reservations]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    reservations.pop_back();
+  }};
+  {
+    core_reservation reservation{"1", 10., dir};
+    ASSERT(reservation.get_wait_time() >= 0.2);
+  }
+  releaser.join();
+  reservations.clear();
+
+  // At most all cores can be requested:
+  ASSERT_THROWS_ANY(core_reservation("100000", 0., dir));
+}
+
+void test_crash()
+{
+  const auto dir = make_directory();
+
+  int to_parent[2];
+  int to_child[2];
+  ASSERT(pipe(to_parent) == 0);
+  ASSERT(pipe(to_child) == 0);
+
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    // Hold every core, then die without releasing them:
+    auto reservations = reserve_all(dir);
+    char msg = reservations.empty() ? 'n' : 'y';
+    [[maybe_unused]] auto num_written = write(to_parent[1], &msg, 1);
+    [[maybe_unused]] auto num_read    = read(to_child[0], &msg, 1);
+    std::raise(SIGKILL);
+  }
+
+  char msg = 0;
+  ASSERT(read(to_parent[0], &msg, 1) == 1);
+  ASSERT(msg == 'y');
+  ASSERT_THROWS_ANY(core_reservation("1", 0., dir));
+
+  ASSERT(write(to_child[1], &msg, 1) == 1);
+  int status = 0;
+  ASSERT(waitpid(pid, &status, 0) == pid);
+  ASSERT(WIFSIGNALED(status));
+
+  // The kernel released the locks of the dead process:
+  core_reservation reservation{"1", 0., dir};
+  ASSERT(!reservation.get_cpus().empty());
+}
+
+int main()
+{
+  test_spec();
+  test_reserve();
+  test_crash();
+}
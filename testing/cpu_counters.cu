@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/cpu_timer.cuh>
+#include <nvbench/detail/cpu_counters.cuh>
+
+#include <chrono>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+// Busy-wait so that cycles are spent on this thread:
+void spin_for(std::chrono::milliseconds duration)
+{
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end)
+  {
+  }
+}
+
+} // namespace
+
+void test_basic()
+{
+  using namespace std::literals::chrono_literals;
+
+  nvbench::detail::cpu_counters counters;
+  if (!counters.has_cycles())
+  {
+    ASSERT(counters.get_source_as_string() == "none");
+    return;
+  }
+
+  counters.start();
+  spin_for(50ms);
+  counters.stop();
+  ASSERT(counters.is_valid());
+
+  // Any modern CPU runs well above 10MHz:
+  ASSERT_MSG(counters.get_cycles() > 500'000,
+             "{} cycles from {}",
+             counters.get_cycles(),
+             counters.get_source_as_string());
+
+  if (counters.has_instructions())
+  {
+    ASSERT(counters.get_instructions() > 0);
+  }
+}
+
+void test_counting_timer()
+{
+  using namespace std::literals::chrono_literals;
+
+  nvbench::cpu_timer timer;
+  nvbench::detail::cpu_counters counters;
+  nvbench::detail::counting_cpu_timer counting_timer{timer, counters};
+
+  counting_timer.start();
+  spin_for(50ms);
+  counting_timer.stop();
+
+  ASSERT(timer.get_duration() > 0.05);
+  ASSERT(counting_timer.get_duration() == timer.get_duration());
+  if (counters.has_cycles())
+  {
+    ASSERT(counters.get_cycles() > 0);
+  }
+}
+
+void test_invalid()
+{
+  nvbench::detail::cpu_counters counters;
+
+  // Without a reading at the start, the interval can't be counted:
+  counters.stop();
+  ASSERT(!counters.is_valid());
+  ASSERT(counters.get_cycles() == 0);
+  ASSERT(counters.get_instructions() == 0);
+
+  counters.start();
+  counters.stop();
+  ASSERT(counters.is_valid() == counters.has_cycles());
+  ASSERT(counters.get_cycles() >= 0);
+}
+
+int main()
+{
+  test_basic();
+  test_counting_timer();
+  test_invalid();
+}
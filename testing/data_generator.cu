@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/data_generator.cuh>
+#include <nvbench/detail/philox.cuh>
+#include <nvbench/state.cuh>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+// Mock up a benchmark for testing:
+void dummy_generator(nvbench::state &) {}
+NVBENCH_DEFINE_CALLABLE(dummy_generator, dummy_callable);
+using dummy_bench = nvbench::benchmark<dummy_callable>;
+
+namespace nvbench::detail
+{
+struct state_tester : public nvbench::state
+{
+  state_tester(const nvbench::benchmark_base &bench)
+      : nvbench::state{bench}
+  {}
+
+  template <typename T>
+  void set_param(std::string name, T &&value)
+  {
+    this->state::m_axis_values.set_value(std::move(name),
+                                         nvbench::named_values::value_type{std::forward<T>(value)});
+  }
+};
+} // namespace nvbench::detail
+
+using nvbench::detail::state_tester;
+
+void test_philox()
+{
+  // Known answers from Random123:
+  using philox = nvbench::detail::philox4x32;
+  ASSERT((philox::generate({0, 0, 0, 0}, {0, 0}) ==
+          philox::counter_type{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  ASSERT((philox::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                           {0xffffffff, 0xffffffff}) ==
+          philox::counter_type{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  ASSERT((philox::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                           {0xa4093822, 0x299f31d0}) ==
+          philox::counter_type{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+void test_deterministic()
+{
+  constexpr std::size_t n = 300000;
+  std::vector<nvbench::uint64_t> serial(n);
+  std::vector<nvbench::uint64_t> threaded(n);
+  nvbench::data_generator{42, 0, 1}.uniform<nvbench::uint64_t>(serial.data(), n, 0, 1000);
+  nvbench::data_generator{42, 0, 7}.uniform<nvbench::uint64_t>(threaded.data(), n, 0, 1000);
+  ASSERT(serial == threaded);
+
+  // Other seeds and streams produce other values:
+  ASSERT(nvbench::data_generator{43}.uniform<nvbench::uint64_t>(n, 0, 1000) != serial);
+  ASSERT(nvbench::data_generator(42, 1).uniform<nvbench::uint64_t>(n, 0, 1000) != serial);
+}
+
+void test_uniform()
+{
+  constexpr std::size_t n = 100000;
+  const nvbench::data_generator gen{1};
+
+  const auto ints = gen.uniform<nvbench::int32_t>(n, -3, 3);
+  ASSERT(*std::min_element(ints.cbegin(), ints.cend()) == -3);
+  ASSERT(*std::max_element(ints.cbegin(), ints.cend()) == 3);
+  for (int value = -3; value <= 3; ++value)
+  {
+    const auto freq = static_cast<double>(std::count(ints.cbegin(), ints.cend(), value)) / n;
+    ASSERT_MSG(std::abs(freq - 1. / 7.) < 0.01, "{}: {}", value, freq);
+  }
+
+  // The full range of the type:
+  const auto bytes = gen.uniform<nvbench::uint8_t>(n, 0, 255);
+  ASSERT(*std::max_element(bytes.cbegin(), bytes.cend()) == 255);
+
+  // Full-range signed bounds; `max - min` doesn't fit the type:
+  const auto i32 = gen.uniform<nvbench::int32_t>(n,
+                                                 std::numeric_limits<nvbench::int32_t>::min(),
+                                                 std::numeric_limits<nvbench::int32_t>::max());
+  ASSERT(*std::min_element(i32.cbegin(), i32.cend()) < -(1 << 30));
+  ASSERT(*std::max_element(i32.cbegin(), i32.cend()) > (1 << 30));
+
+  const auto i64 = gen.uniform<nvbench::int64_t>(n,
+                                                 std::numeric_limits<nvbench::int64_t>::min(),
+                                                 std::numeric_limits<nvbench::int64_t>::max());
+  ASSERT(*std::min_element(i64.cbegin(), i64.cend()) < -(nvbench::int64_t{1} << 62));
+  ASSERT(*std::max_element(i64.cbegin(), i64.cend()) > (nvbench::int64_t{1} << 62));
+
+  // A signed range that doesn't start at 0:
+  const auto shifted = gen.uniform<nvbench::int8_t>(n, -128, -120);
+  ASSERT(*std::min_element(shifted.cbegin(), shifted.cend()) == -128);
+  ASSERT(*std::max_element(shifted.cbegin(), shifted.cend()) == -120);
+
+  const auto floats = gen.uniform<float>(n, 1.f, 2.f);
+  ASSERT(*std::min_element(floats.cbegin(), floats.cend()) >= 1.f);
+  ASSERT(*std::max_element(floats.cbegin(), floats.cend()) < 2.f);
+
+  // Units close to 1 round up to 1 in `float`; the result must stay below max:
+  const auto last_unit = std::nextafter(1., 0.);
+  using gen_t          = nvbench::data_generator;
+  ASSERT(gen_t::uniform_real(1.f, 2.f, last_unit) == std::nextafter(2.f, 1.f));
+  ASSERT(gen_t::uniform_real(1.f, 2.f, 1. - 0x1.0p-26) < 2.f);
+  ASSERT(gen_t::uniform_real(-2.f, -1.f, last_unit) < -1.f);
+  ASSERT(gen_t::uniform_real(1., 2., last_unit) < 2.);
+  ASSERT(gen_t::uniform_real(1.f, 2.f, 0.) == 1.f);
+  ASSERT(gen_t::uniform_real(1.f, 2.f, 0.5) == 1.5f);
+}
+
+void test_normal()
+{
+  constexpr std::size_t n = 200000;
+  const auto values       = nvbench::data_generator{2}.normal<double>(n, 10., 2.);
+
+  double mean = 0.;
+  for (auto v : values)
+  {
+    mean += v;
+  }
+  mean /= n;
+
+  double variance = 0.;
+  for (auto v : values)
+  {
+    variance += (v - mean) * (v - mean);
+  }
+  variance /= n - 1;
+
+  ASSERT_MSG(std::abs(mean - 10.) < 0.02, "{}", mean);
+  ASSERT_MSG(std::abs(std::sqrt(variance) - 2.) < 0.02, "{}", std::sqrt(variance));
+}
+
+void test_zipf()
+{
+  constexpr std::size_t n = 200000;
+  std::vector<nvbench::uint32_t> values(n);
+  nvbench::data_generator{3}.zipf(values.data(), n, 1000, 1.);
+
+  ASSERT(*std::max_element(values.cbegin(), values.cend()) < 1000);
+
+  // P(k) ~ 1 / (k + 1), normalized by the harmonic number H(1000):
+  double harmonic = 0.;
+  for (int k = 1; k <= 1000; ++k)
+  {
+    harmonic += 1. / k;
+  }
+  for (nvbench::uint32_t k = 0; k < 4; ++k)
+  {
+    const auto freq = static_cast<double>(std::count(values.cbegin(), values.cend(), k)) / n;
+    const auto expected = 1. / (k + 1) / harmonic;
+    ASSERT_MSG(std::abs(freq - expected) < 0.01, "{}: {} != {}", k, freq, expected);
+  }
+
+  ASSERT_THROWS_ANY(nvbench::data_generator{3}.zipf(values.data(), n, 1000, 0.));
+}
+
+void test_sorted()
+{
+  constexpr std::size_t n = 100000;
+  const nvbench::data_generator gen{4};
+
+  std::vector<nvbench::int64_t> values(n);
+  gen.sorted<nvbench::int64_t>(values.data(), n, 100, 199);
+  ASSERT(std::is_sorted(values.cbegin(), values.cend()));
+  ASSERT(values.front() == 100);
+  ASSERT(values.back() == 199);
+
+  std::vector<double> nearly(n);
+  gen.sorted(nearly.data(), n, 0., 1., 0.1);
+  std::size_t descents = 0;
+  for (std::size_t i = 1; i < n; ++i)
+  {
+    descents += nearly[i] < nearly[i - 1] ? 1 : 0;
+  }
+  // About half of the replaced values are below their predecessor:
+  ASSERT_MSG(descents > n / 50 && descents < n / 5, "{}", descents);
+}
+
+void test_entropy_bits()
+{
+  using gen_t = nvbench::data_generator;
+  ASSERT(gen_t::get_entropy_and_count(1.) == 1);
+  ASSERT(gen_t::get_entropy_and_count(0.811) == 2);
+  ASSERT(gen_t::get_entropy_and_count(0.544) == 3);
+  ASSERT(gen_t::get_entropy_and_count(0.337) == 4);
+  ASSERT(gen_t::get_entropy_and_count(0.201) == 5);
+  ASSERT(gen_t::get_entropy_and_count(0.) == 0);
+  ASSERT_THROWS_ANY([[maybe_unused]] auto k = gen_t::get_entropy_and_count(1.5));
+
+  constexpr std::size_t n = 100000;
+  std::vector<nvbench::uint32_t> values(n);
+  for (nvbench::uint32_t k = 1; k <= 3; ++k)
+  {
+    const double entropies[] = {0., 1., 0.811, 0.544};
+    gen_t{5}.entropy_bits(values.data(), n, entropies[k]);
+
+    std::size_t set_bits = 0;
+    for (auto v : values)
+    {
+      set_bits += std::bitset<32>(v).count();
+    }
+    const auto p = static_cast<double>(set_bits) / (32. * n);
+    ASSERT_MSG(std::abs(p - std::ldexp(1., -static_cast<int>(k))) < 0.01, "{}: {}", k, p);
+  }
+
+  gen_t{5}.entropy_bits(values.data(), n, 0.);
+  ASSERT(std::all_of(values.cbegin(), values.cend(), [](auto v) { return v == 0; }));
+}
+
+void test_state_seed()
+{
+  dummy_bench bench;
+  bench.set_name("bench");
+
+  state_tester state_a{bench};
+  state_a.set_param("Elements", nvbench::int64_t{1024});
+  state_tester state_b{bench};
+  state_b.set_param("Elements", nvbench::int64_t{1024});
+  state_tester state_c{bench};
+  state_c.set_param("Elements", nvbench::int64_t{2048});
+
+  ASSERT(state_a.get_data_seed() == state_b.get_data_seed());
+  ASSERT(state_a.get_data_seed() != state_c.get_data_seed());
+  ASSERT(state_a.get_data_generator(1).get_stream() == 1);
+
+  const auto seed = state_a.get_data_seed();
+  bench.set_data_seed(1);
+  ASSERT(state_a.get_data_seed() != seed);
+}
+
+int main()
+{
+  test_philox();
+  test_deterministic();
+  test_uniform();
+  test_normal();
+  test_zipf();
+  test_sorted();
+  test_entropy_bits();
+  test_state_seed();
+}
@@ -39,6 +39,37 @@ void test_const()
   ASSERT(criterion.is_finished());
 }
 
+void test_timer_resolution()
+{
+  nvbench::criterion_params params;
+  nvbench::detail::entropy_criterion criterion;
+
+  // Every sample is distinct, so the entropy keeps growing:
+  criterion.initialize(params);
+  for (int i = 0; i < 50; i++)
+  {
+    criterion.add_measurement(42.0 + 0.01 * i);
+  }
+  ASSERT(!criterion.is_finished());
+
+  // ...unless they are within a tick of the timer:
+  params.set_float64("timer-resolution", 1.0);
+  criterion.initialize(params);
+  for (int i = 0; i < 50; i++)
+  {
+    criterion.add_measurement(42.0 + 0.01 * i);
+  }
+  ASSERT(criterion.is_finished());
+
+  // The resolution doesn't carry over to runs that don't set it:
+  criterion.initialize(nvbench::criterion_params{});
+  for (int i = 0; i < 50; i++)
+  {
+    criterion.add_measurement(42.0 + 0.01 * i);
+  }
+  ASSERT(!criterion.is_finished());
+}
+
 void produce_entropy_arch(nvbench::detail::entropy_criterion &criterion)
 {
   /*
@@ -87,5 +118,6 @@ void test_entropy_arch()
 int main()
 {
   test_const();
+  test_timer_resolution();
   test_entropy_arch();
 }
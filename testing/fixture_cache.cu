@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/fixture_cache.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+std::shared_ptr<void> make_value(int value) { return std::make_shared<int>(value); }
+
+int get_value(const std::shared_ptr<void> &ptr) { return *static_cast<int *>(ptr.get()); }
+
+} // namespace
+
+void test_traits()
+{
+  ASSERT(nvbench::fixture_traits<std::vector<double>>::get_bytes(std::vector<double>(10)) == 80);
+  ASSERT(nvbench::fixture_traits<std::string>::get_bytes(std::string(5, 'x')) == 5);
+  ASSERT(nvbench::fixture_traits<int>::get_bytes(3) == sizeof(int));
+}
+
+void test_lru()
+{
+  auto &cache = nvbench::fixture_cache::get();
+  cache.clear();
+
+  ASSERT(!cache.find("a"));
+  cache.insert("a", make_value(1), 40, 100);
+  cache.insert("b", make_value(2), 40, 100);
+  ASSERT(cache.get_size() == 2);
+  ASSERT(cache.get_bytes() == 80);
+
+  // Touch "a" so that "b" is the least recently used:
+  ASSERT(get_value(cache.find("a")) == 1);
+  cache.insert("c", make_value(3), 40, 100);
+  ASSERT(cache.get_size() == 2);
+  ASSERT(cache.get_bytes() == 80);
+  ASSERT(!cache.find("b"));
+  ASSERT(get_value(cache.find("a")) == 1);
+  ASSERT(get_value(cache.find("c")) == 3);
+
+  // Too large to cache; nothing is evicted:
+  cache.insert("d", make_value(4), 101, 100);
+  ASSERT(!cache.find("d"));
+  ASSERT(cache.get_size() == 2);
+
+  // Replacing an entry updates its size:
+  cache.insert("a", make_value(5), 10, 100);
+  ASSERT(cache.get_bytes() == 50);
+  ASSERT(get_value(cache.find("a")) == 5);
+
+  ASSERT(cache.get_hits() == 4);
+  ASSERT(cache.get_misses() == 3);
+  ASSERT(cache.get_evictions() == 1);
+
+  cache.clear();
+  ASSERT(cache.get_size() == 0);
+  ASSERT(cache.get_bytes() == 0);
+  ASSERT(cache.get_hits() == 0);
+}
+
+namespace
+{
+
+// Number of times each fixture was generated, and the states in run order:
+int generated = 0;
+std::vector<std::string> run_log;
+
+void fixture_generator(nvbench::state &state)
+{
+  const auto elements = state.get_int64("Elements");
+  const auto &input   = state.get_fixture<std::vector<int>>("input", [elements] {
+    ++generated;
+    return std::vector<int>(static_cast<std::size_t>(elements), 7);
+  });
+  ASSERT(input.size() == static_cast<std::size_t>(elements));
+
+  run_log.push_back(fmt::format("{}/{}", elements, state.get_int64("BlockSize")));
+}
+NVBENCH_DEFINE_CALLABLE(fixture_generator, fixture_callable);
+
+using benchmark_type = nvbench::benchmark<fixture_callable>;
+using runner_type    = nvbench::runner<benchmark_type>;
+
+void run(benchmark_type &bench)
+{
+  generated = 0;
+  run_log.clear();
+
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Elements", {10, 20});
+  bench.add_int64_axis("BlockSize", {128, 256});
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  // The cache is cleared after each benchmark:
+  ASSERT(nvbench::fixture_cache::get().get_size() == 0);
+}
+
+} // namespace
+
+void test_no_fixture_axes()
+{
+  // Every state generates its own fixture:
+  benchmark_type bench;
+  run(bench);
+  ASSERT(generated == 4);
+}
+
+void test_fixture_axes()
+{
+  benchmark_type bench;
+  bench.set_fixture_axes({"Elements"});
+  run(bench);
+  ASSERT(generated == 2);
+  ASSERT((run_log == std::vector<std::string>{"10/128", "20/128", "10/256", "20/256"}));
+}
+
+void test_eviction()
+{
+  // Only one fixture fits, and the canonical order alternates between them:
+  benchmark_type bench;
+  bench.set_fixture_axes({"Elements"});
+  bench.set_fixture_cache_size(20 * sizeof(int));
+  run(bench);
+  ASSERT(generated == 4);
+}
+
+void test_grouped_order()
+{
+  benchmark_type bench;
+  bench.set_fixture_axes({"Elements"});
+  bench.set_fixture_cache_size(20 * sizeof(int));
+  bench.set_run_order("grouped");
+  run(bench);
+  ASSERT(generated == 2);
+  ASSERT((run_log == std::vector<std::string>{"10/128", "10/256", "20/128", "20/256"}));
+}
+
+void test_missing_axis()
+{
+  benchmark_type bench;
+  bench.set_fixture_axes({"Missing"});
+  run(bench);
+  // The generator throws, so the states are skipped:
+  ASSERT(generated == 0);
+  for (const auto &state : bench.get_states())
+  {
+    ASSERT(state.is_skipped());
+  }
+}
+
+int main()
+{
+  test_traits();
+  test_lru();
+  test_no_fixture_axes();
+  test_fixture_axes();
+  test_eviction();
+  test_grouped_order();
+  test_missing_axis();
+}
@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/host_buffer_pool.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+using page_mode = nvbench::host_buffer_pool::page_mode;
+
+bool is_aligned(const void *ptr, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+} // namespace
+
+void test_page_modes()
+{
+  using pool_type = nvbench::host_buffer_pool;
+  ASSERT(pool_type::parse_page_mode("none") == page_mode::none);
+  ASSERT(pool_type::parse_page_mode("transparent") == page_mode::transparent);
+  ASSERT(pool_type::parse_page_mode("hugetlb") == page_mode::hugetlb);
+  ASSERT(pool_type::to_string(page_mode::hugetlb) == "hugetlb");
+  ASSERT_THROWS_ANY([[maybe_unused]] auto mode = pool_type::parse_page_mode("huge"));
+}
+
+void test_recycling()
+{
+  auto &pool = nvbench::host_buffer_pool::get();
+  pool.clear();
+
+  ASSERT_THROWS_ANY([[maybe_unused]] auto bad = pool.acquire(100, 48, page_mode::none));
+
+  auto buf = pool.acquire(100000, 1 << 20, page_mode::none);
+  ASSERT(buf.data != nullptr);
+  ASSERT(buf.capacity >= 100000);
+  ASSERT(is_aligned(buf.data, 1 << 20));
+#ifdef __linux__
+  ASSERT(buf.page_size >= 4096);
+#endif
+  std::memset(buf.data, 1, buf.capacity);
+  pool.release(buf);
+  ASSERT(pool.get_size() == 1);
+
+  // Smaller requests with the same mode reuse the buffer:
+  auto reused = pool.acquire(1000, 64, page_mode::none);
+  ASSERT(reused.data == buf.data);
+  ASSERT(static_cast<unsigned char *>(reused.data)[0] == 1);
+
+  // Larger requests, stricter alignments and other modes don't:
+  pool.release(reused);
+  auto larger = pool.acquire(buf.capacity + 1, 64, page_mode::none);
+  ASSERT(larger.data != buf.data);
+  auto aligned = pool.acquire(1000, std::size_t{1} << 30, page_mode::none);
+  ASSERT(aligned.data != buf.data);
+  ASSERT(is_aligned(aligned.data, std::size_t{1} << 30));
+  auto transparent = pool.acquire(1000, 64, page_mode::transparent);
+  ASSERT(transparent.data != buf.data);
+  pool.release(larger);
+  pool.release(aligned);
+  pool.release(transparent);
+
+  ASSERT(pool.get_reused() == 1);
+  ASSERT(pool.get_allocated() == 4);
+  ASSERT(pool.get_size() == 4);
+
+  pool.clear();
+  ASSERT(pool.get_size() == 0);
+  ASSERT(pool.get_bytes() == 0);
+  ASSERT(pool.get_allocated() == 0);
+}
+
+void test_huge_pages()
+{
+  auto &pool = nvbench::host_buffer_pool::get();
+  pool.clear();
+
+  // Huge page buffers are aligned to the huge page size so that all of their
+  // pages may be huge, but the kernel decides which page size is used:
+  for (auto mode : {page_mode::transparent, page_mode::hugetlb})
+  {
+    auto buf = pool.acquire(3 << 20, 64, mode);
+    ASSERT(buf.mode == mode);
+    ASSERT(buf.capacity % (2 << 20) == 0);
+    ASSERT(is_aligned(buf.data, 2 << 20));
+    std::memset(buf.data, 0, buf.capacity);
+#ifdef __linux__
+    ASSERT(buf.page_size >= 4096);
+#endif
+    pool.release(buf);
+  }
+  pool.clear();
+}
+
+namespace
+{
+
+std::vector<void *> buffers;
+
+void buffer_generator(nvbench::state &state)
+{
+  const auto elements = static_cast<std::size_t>(state.get_int64("Elements"));
+  auto *data          = state.allocate_host_buffer<double>(elements);
+  ASSERT(is_aligned(data, 64));
+  std::fill_n(data, elements, 1.);
+  buffers.push_back(data);
+}
+NVBENCH_DEFINE_CALLABLE(buffer_generator, buffer_callable);
+
+using benchmark_type = nvbench::benchmark<buffer_callable>;
+using runner_type    = nvbench::runner<benchmark_type>;
+
+} // namespace
+
+void test_state_buffers()
+{
+  buffers.clear();
+
+  benchmark_type bench;
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Elements", {1000, 100, 1000});
+  bench.set_huge_pages("none");
+  ASSERT_THROWS_ANY(bench.set_huge_pages("huge"));
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  // Buffers are recycled across the states and freed after the benchmark:
+  ASSERT(buffers.size() == 3);
+  ASSERT(buffers[0] == buffers[1]);
+  ASSERT(buffers[0] == buffers[2]);
+  ASSERT(nvbench::host_buffer_pool::get().get_size() == 0);
+
+#ifdef __linux__
+  for (const auto &state : bench.get_states())
+  {
+    const auto &summ = state.get_summary("nv/host_buffers/page_size");
+    ASSERT(summ.get_int64("value") >= 4096);
+    ASSERT(summ.get_string("huge_pages") == "none");
+  }
+#endif
+}
+
+int main()
+{
+  test_page_modes();
+  test_recycling();
+  test_huge_pages();
+  test_state_buffers();
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/host_caches.cuh>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+// L1=48KiB, L2=2MiB, L3=32MiB:
+const nvbench::host_caches caches{{48 << 10, 2 << 20, 32 << 20}};
+
+} // namespace
+
+void test_levels()
+{
+  ASSERT(caches.get_size(1) == 48 << 10);
+  ASSERT(caches.get_size(3) == 32 << 20);
+  ASSERT(caches.get_size(0) == 0);
+  ASSERT(caches.get_size(4) == 0);
+  ASSERT(caches.get_llc_level() == 3);
+  ASSERT(caches.get_llc_size() == 32 << 20);
+  ASSERT(caches.to_string() == "L1=48KiB L2=2MiB L3=32MiB");
+
+  // Unknown levels are skipped:
+  const nvbench::host_caches l2_only{{0, 1 << 20}};
+  ASSERT(l2_only.get_llc_level() == 2);
+  ASSERT(l2_only.to_string() == "L2=1MiB");
+
+  const nvbench::host_caches none{{}};
+  ASSERT(none.get_llc_level() == 0);
+  ASSERT(none.get_llc_size() == 0);
+  ASSERT(none.to_string() == "none");
+}
+
+void test_resolve()
+{
+  ASSERT(caches.resolve("L1") == 48 << 10);
+  ASSERT(caches.resolve("0.5xL1") == 24 << 10);
+  ASSERT(caches.resolve("0.5 x L1") == 24 << 10);
+  ASSERT(caches.resolve("2*L2") == 4 << 20);
+  ASSERT(caches.resolve("4xLLC") == 128 << 20);
+  ASSERT(caches.resolve("llc") == 32 << 20);
+  ASSERT(caches.resolve("4096") == 4096);
+  ASSERT(caches.resolve("1e6") == 1000000);
+
+  ASSERT_THROWS_ANY([[maybe_unused]] auto size = caches.resolve(""));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto size = caches.resolve("L5"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto size = caches.resolve("2x"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto size = caches.resolve("-1xL1"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto size = caches.resolve("halfxL1"));
+  // Not detected:
+  ASSERT_THROWS_ANY([[maybe_unused]] auto size = caches.resolve("L4"));
+}
+
+void test_detected()
+{
+  // Whatever was detected must be consistent:
+  const auto &host = nvbench::host_caches::get();
+  if (host.get_llc_level() == 0)
+  {
+    return;
+  }
+  ASSERT(host.get_llc_size() > 0);
+  ASSERT(host.resolve("LLC") == host.get_llc_size());
+
+  const auto sizes = nvbench::cache_range("L1", "LLC", 4);
+  ASSERT(sizes.front() == host.get_size(1));
+  ASSERT(sizes.back() == host.get_llc_size());
+}
+
+int main()
+{
+  test_levels();
+  test_resolve();
+  test_detected();
+}
@@ -0,0 +1,252 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/sampling_profiler.cuh>
+#include <nvbench/input_pool.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <chrono>
+#include <limits>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+// Mock up a benchmark for testing:
+void dummy_generator(nvbench::state &) {}
+NVBENCH_DEFINE_CALLABLE(dummy_generator, dummy_callable);
+using dummy_bench = nvbench::benchmark<dummy_callable>;
+
+namespace nvbench::detail
+{
+struct state_tester : public nvbench::state
+{
+  state_tester(const nvbench::benchmark_base &bench)
+      : nvbench::state{bench}
+  {}
+};
+} // namespace nvbench::detail
+
+using nvbench::detail::state_tester;
+
+namespace
+{
+
+// Fills each copy with its index and counts the calls:
+struct counting_generator
+{
+  int *calls;
+
+  void operator()(std::vector<int> &copy, std::size_t index) const
+  {
+    ++*calls;
+    copy.assign(4, static_cast<int>(index));
+  }
+};
+
+} // namespace
+
+void test_pool()
+{
+  int calls = 0;
+  nvbench::input_pool<std::vector<int>> pool{3, counting_generator{&calls}};
+  ASSERT(calls == 3);
+  ASSERT(pool.get_size() == 3);
+  ASSERT(pool.get_remaining() == 3);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    auto &copy = pool.next();
+    ASSERT(copy.size() == 4 && copy[0] == i);
+    // Mutate the input:
+    copy.clear();
+  }
+  ASSERT(pool.get_remaining() == 0);
+  ASSERT_THROWS_ANY([[maybe_unused]] auto &copy = pool.next());
+
+  pool.refresh();
+  ASSERT(calls == 6);
+  ASSERT(pool.get_refresh_count() == 1);
+  ASSERT(pool.get_remaining() == 3);
+  ASSERT(pool.next().size() == 4);
+
+  // Only consumed copies are regenerated:
+  pool.refresh();
+  ASSERT(calls == 7);
+  pool.refresh();
+  ASSERT(calls == 7);
+  ASSERT(pool.get_refresh_count() == 2);
+
+  ASSERT_THROWS_ANY((nvbench::input_pool<int>{0, [](int &, std::size_t) {}}));
+}
+
+void test_state_pools()
+{
+  dummy_bench bench;
+  state_tester state{bench};
+
+  // No pools:
+  ASSERT(state.prepare_input_pools(100) == std::numeric_limits<nvbench::int64_t>::max());
+
+  int small_calls = 0;
+  int large_calls = 0;
+  auto &small = state.add_input_pool<std::vector<int>>(2, counting_generator{&small_calls});
+  auto &large = state.add_input_pool<std::vector<int>>(8, counting_generator{&large_calls});
+  ASSERT(small_calls == 2);
+  ASSERT(large_calls == 8);
+
+  // Batches are limited by the smallest pool:
+  ASSERT(state.prepare_input_pools(100) == 2);
+  ASSERT(small_calls == 2);
+
+  [[maybe_unused]] auto &s0 = small.next();
+  [[maybe_unused]] auto &l0 = large.next();
+  ASSERT(state.prepare_input_pools(1) == 1);
+  ASSERT(small_calls == 2);
+
+  [[maybe_unused]] auto &s1 = small.next();
+  [[maybe_unused]] auto &l1 = large.next();
+
+  // The small pool is exhausted; the large one still has enough copies:
+  ASSERT(state.prepare_input_pools(1) == 2);
+  ASSERT(small_calls == 4);
+  ASSERT(large_calls == 8);
+  ASSERT(large.get_remaining() == 6);
+
+  // Not enough copies left in the large pool for a batch of 8:
+  ASSERT(state.prepare_input_pools(8) == 2);
+  ASSERT(large_calls == 10);
+  ASSERT(large.get_remaining() == 8);
+}
+
+namespace
+{
+
+struct tracked_input
+{
+  static inline int live = 0;
+  tracked_input() { ++live; }
+  ~tracked_input() { --live; }
+};
+
+int live_during_run = 0;
+
+void pool_generator(nvbench::state &state)
+{
+  state.add_input_pool<tracked_input>(4, [](tracked_input &, std::size_t) {});
+  live_during_run = tracked_input::live;
+}
+NVBENCH_DEFINE_CALLABLE(pool_generator, pool_callable);
+
+} // namespace
+
+void test_runner_releases_pools()
+{
+  using benchmark_type = nvbench::benchmark<pool_callable>;
+  using runner_type    = nvbench::runner<benchmark_type>;
+
+  benchmark_type bench;
+  bench.set_devices(std::vector<int>{});
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  ASSERT(live_during_run == 4);
+  ASSERT(tracked_input::live == 0);
+}
+
+namespace
+{
+
+nvbench::int64_t profiled_refreshes = 0;
+
+// Every trial consumes the only copy, and regenerating it takes far longer
+// than the trial itself:
+void profiled_generator(nvbench::state &state)
+{
+  auto &pool = state.add_input_pool<int>(1, [](int &value, std::size_t index) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds{2};
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+    value = static_cast<int>(index);
+  });
+  state.exec(nvbench::exec_tag::no_gpu, [&pool](nvbench::launch &) { ++pool.next(); });
+  profiled_refreshes = pool.get_refresh_count();
+}
+NVBENCH_DEFINE_CALLABLE(profiled_generator, profiled_callable);
+
+} // namespace
+
+void test_refresh_not_profiled()
+{
+  if (!nvbench::detail::sampling_profiler::is_supported())
+  {
+    return;
+  }
+
+  using benchmark_type = nvbench::benchmark<profiled_callable>;
+  using runner_type    = nvbench::runner<benchmark_type>;
+
+  const auto directory = fs::temp_directory_path() / "nvbench_input_pool_profile";
+  fs::remove_all(directory);
+
+  benchmark_type bench;
+  bench.set_is_cpu_only(true);
+  bench.set_min_samples(50);
+  bench.set_timeout(0.5);
+  bench.set_cpu_profile_directory(directory.string());
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+  fs::remove_all(directory);
+
+  const auto &state = bench.get_states().front();
+  const auto samples = state.get_summary("nv/cpu_only/profile/sample_size").get_int64("value");
+
+  // Each refresh spins for twice the default 1ms sampling period. The profiling
+  // timer may be coarser than that, so only require far fewer samples than
+  // refreshes:
+  ASSERT(profiled_refreshes >= 50);
+  ASSERT_MSG(samples * 4 < profiled_refreshes,
+             "{} samples, {} refreshes",
+             samples,
+             profiled_refreshes);
+}
+
+int main()
+{
+  test_pool();
+  test_state_pools();
+  test_runner_releases_pools();
+  test_refresh_not_profiled();
+}
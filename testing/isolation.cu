@@ -0,0 +1,261 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/isolation.cuh>
+#include <nvbench/json_printer.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "test_asserts.cuh"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+namespace
+{
+
+// Only changes in the process that runs the generator:
+nvbench::int64_t num_calls = 0;
+
+void counting_generator(nvbench::state &state)
+{
+  const auto &mode = state.get_string("Mode");
+  if (mode == "exit")
+  {
+    _exit(3);
+  }
+  if (mode == "signal")
+  {
+    std::raise(SIGTERM);
+  }
+  if (mode == "hang")
+  {
+    for (;;)
+    {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+  }
+  if (mode == "skip")
+  {
+    state.skip("Skipped by the generator.");
+    return;
+  }
+
+  static const auto &desc = nvbench::summary_registry::get().add(
+    {"test/isolation/calls", "Calls", "", "Calls in the running process"});
+  state.add_summary(desc).set_int64("value", ++num_calls);
+
+  auto &summ = state.add_summary("test/isolation/values");
+  summ.set_float64("float", 0.25);
+  summ.set_string("string", mode);
+  state.set_element_count(42);
+
+  // A different number of samples per state:
+  if (auto printer_opt_ref = state.get_benchmark().get_printer(); printer_opt_ref.has_value())
+  {
+    const std::vector<nvbench::float64_t> samples(100 + 10 * mode.size(), 1e-6);
+    printer_opt_ref.value().get().process_bulk_data(state,
+                                                    "test/isolation/sample_times",
+                                                    "sample_times",
+                                                    samples);
+  }
+}
+NVBENCH_DEFINE_CALLABLE(counting_generator, counting_callable);
+
+using benchmark_type = nvbench::benchmark<counting_callable>;
+
+void run(benchmark_type &bench, const std::string &isolation, std::vector<std::string> modes)
+{
+  bench.set_devices(std::vector<int>{});
+  bench.set_is_cpu_only(true);
+  bench.set_isolation(isolation);
+  bench.set_hard_timeout(0.5);
+  bench.add_string_axis("Mode", std::move(modes));
+
+  nvbench::runner<benchmark_type> runner{bench};
+  runner.generate_states();
+  runner.run();
+}
+
+nvbench::int64_t get_calls(const nvbench::state &state)
+{
+  return state.get_summary("test/isolation/calls").get_int64("value");
+}
+
+} // namespace
+
+void test_parse()
+{
+  using nvbench::detail::isolation;
+  ASSERT(isolation::parse("none").m_kind == isolation::kind::none);
+  ASSERT(isolation::parse("fork").m_kind == isolation::kind::state);
+  ASSERT(isolation::parse("fork:state").to_string() == "fork:state");
+  ASSERT(isolation::parse("fork:benchmark").to_string() == "fork:benchmark");
+  ASSERT_THROWS_ANY([[maybe_unused]] auto iso = isolation::parse("fork:device"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto iso = isolation::parse(""));
+}
+
+void test_fork_state()
+{
+  benchmark_type bench;
+  run(bench, "fork", {"a", "b", "skip", "c"});
+
+  const auto &states = bench.get_states();
+  ASSERT(states.size() == 4);
+  ASSERT(num_calls == 0);
+
+  // Each state starts from the same snapshot:
+  for (const auto index : {0, 1, 3})
+  {
+    const auto &state = states[static_cast<std::size_t>(index)];
+    ASSERT(!state.is_skipped());
+    ASSERT(get_calls(state) == 1);
+    ASSERT(state.get_element_count() == 42);
+
+    const auto &summ = state.get_summary("test/isolation/calls");
+    ASSERT(summ.get_name() == "Calls");
+    ASSERT(summ.get_description() == "Calls in the running process");
+
+    const auto &values = state.get_summary("test/isolation/values");
+    ASSERT(values.get_float64("float") == 0.25);
+    ASSERT(values.get_string("string") == state.get_string("Mode"));
+  }
+  ASSERT(states[2].get_skip_reason() == "Skipped by the generator.");
+}
+
+void test_fork_benchmark()
+{
+  benchmark_type bench;
+  run(bench, "fork:benchmark", {"a", "b", "c"});
+
+  // One worker runs all states:
+  const auto &states = bench.get_states();
+  ASSERT(num_calls == 0);
+  ASSERT(get_calls(states[0]) == 1);
+  ASSERT(get_calls(states[1]) == 2);
+  ASSERT(get_calls(states[2]) == 3);
+}
+
+void test_failures()
+{
+  for (const auto &isolation : {"fork:state", "fork:benchmark"})
+  {
+    benchmark_type bench;
+    run(bench, isolation, {"a", "exit", "b", "signal", "hang", "c"});
+
+    const auto &states = bench.get_states();
+    ASSERT(num_calls == 0);
+    ASSERT(get_calls(states[0]) == 1);
+    ASSERT(states[1].is_skipped());
+    ASSERT_MSG(states[1].get_skip_reason().find("status 3") != std::string::npos,
+               "{}",
+               states[1].get_skip_reason());
+    ASSERT(states[3].is_skipped());
+    ASSERT_MSG(states[3].get_skip_reason().find("signal") != std::string::npos,
+               "{}",
+               states[3].get_skip_reason());
+    ASSERT(states[4].is_skipped());
+    ASSERT_MSG(states[4].get_skip_reason().find("hard timeout") != std::string::npos,
+               "{}",
+               states[4].get_skip_reason());
+
+    // Failed workers are replaced:
+    ASSERT(get_calls(states[2]) == 1);
+    ASSERT(get_calls(states[5]) == 1);
+  }
+}
+
+void test_jsonbin()
+{
+  const auto dir = fs::temp_directory_path() / "nvbench_test_isolation";
+  fs::create_directories(dir);
+  const auto json_path = (dir / "out.json").string();
+
+  for (const auto &isolation : {"fork:state", "fork:benchmark"})
+  {
+    std::ofstream json_stream{json_path};
+    nvbench::json_printer printer{json_stream, json_path, true};
+
+    benchmark_type bench;
+    bench.set_printer(printer);
+    run(bench, isolation, {"a", "bb", "ccc"});
+
+    // The benchmark process names the files, so workers don't overwrite each
+    // other's:
+    std::vector<std::string> filenames;
+    for (const auto &state : bench.get_states())
+    {
+      const auto &summ      = state.get_summary("nv/json/bin:test/isolation/sample_times");
+      const auto filename   = summ.get_string("filename");
+      const auto num_values = summ.get_int64("size");
+      const auto mode_size  = static_cast<nvbench::int64_t>(state.get_string("Mode").size());
+      ASSERT(num_values == 100 + 10 * mode_size);
+      ASSERT_MSG(fs::exists(filename), "{}", filename);
+      ASSERT_MSG(fs::file_size(filename) == static_cast<std::uintmax_t>(num_values) * 4,
+                 "{}: {} bytes",
+                 filename,
+                 fs::file_size(filename));
+      ASSERT(std::find(filenames.cbegin(), filenames.cend(), filename) == filenames.cend());
+      filenames.push_back(filename);
+    }
+    ASSERT(filenames.size() == 3);
+    fs::remove_all(json_path + "-bin");
+  }
+  ASSERT(num_calls == 0);
+  fs::remove_all(dir);
+}
+
+void test_in_process()
+{
+  benchmark_type bench;
+  run(bench, "none", {"a", "b"});
+  ASSERT(num_calls == 2);
+  ASSERT(get_calls(bench.get_states()[1]) == 2);
+  num_calls = 0;
+}
+
+int main()
+{
+  test_parse();
+  test_fork_state();
+  test_fork_benchmark();
+  test_failures();
+  test_jsonbin();
+  test_in_process();
+}
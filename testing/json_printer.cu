@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/json_printer.cuh>
+#include <nvbench/results.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+namespace
+{
+
+constexpr const char *test_tag = "test/json_printer/time";
+
+const nvbench::summary_descriptor &get_descriptor()
+{
+  static const auto &desc = nvbench::summary_registry::get().add(
+    {test_tag, "Time", "duration", "Registered test summary", "Hidden by default."});
+  return desc;
+}
+
+// The same tag as a registered summary, an override and an ad-hoc summary:
+void summary_generator(nvbench::state &state)
+{
+  state.add_summary(get_descriptor()).set_float64("value", 1.5);
+
+  auto &renamed = state.add_summary(get_descriptor());
+  renamed.set_string("name", "Renamed");
+  renamed.set_float64("value", 2.5);
+
+  auto &adhoc = state.add_summary(test_tag);
+  adhoc.set_string("name", "Ad-hoc");
+  adhoc.set_int64("value", 3);
+}
+NVBENCH_DEFINE_CALLABLE(summary_generator, summary_callable);
+
+std::size_t count_occurrences(const std::string &text, const std::string &pattern)
+{
+  std::size_t count = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+void test_summaries()
+{
+  using benchmark_type = nvbench::benchmark<summary_callable>;
+  using runner_type    = nvbench::runner<benchmark_type>;
+
+  auto bench_ptr = std::make_unique<benchmark_type>();
+  bench_ptr->set_devices(std::vector<int>{});
+  {
+    runner_type runner{*bench_ptr};
+    runner.generate_states();
+    runner.run();
+  }
+
+  const auto path = (fs::temp_directory_path() / "nvbench_test_json_printer.json").string();
+  {
+    nvbench::printer_base::benchmark_vector benches;
+    benches.push_back(std::move(bench_ptr));
+
+    std::ofstream stream{path};
+    nvbench::json_printer printer{stream, path, false};
+    printer.print_benchmark_results(benches);
+  }
+
+  std::string text;
+  {
+    std::ifstream stream{path};
+    text.assign(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+  }
+
+  // Only the summaries created from the descriptor are marked, and the
+  // descriptor's metadata is written once:
+  ASSERT(count_occurrences(text, "\"descriptor\": true") == 2);
+  ASSERT(count_occurrences(text, "\"Registered test summary\"") == 1);
+
+  const auto file = nvbench::results::result_file::read(path);
+  fs::remove(path);
+
+  const auto version = nvbench::json_printer::get_json_file_version();
+  ASSERT(file.get_version().has_value());
+  ASSERT(file.get_version()->major == version.major);
+  ASSERT(file.get_version()->minor == version.minor);
+
+  const auto &summaries = file.get_benchmarks().front().get_states().front().get_summaries();
+  ASSERT(summaries.size() == 3);
+
+  // The registered summary takes all metadata from the descriptor:
+  ASSERT(summaries[0].get_tag() == test_tag);
+  ASSERT(summaries[0].get_name() == "Time");
+  ASSERT(summaries[0].get_hint() == "duration");
+  ASSERT(summaries[0].get_description() == "Registered test summary");
+  ASSERT(summaries[0].is_hidden());
+  ASSERT(summaries[0].get_float64("value") == 1.5);
+
+  // Keys set on the summary override the descriptor:
+  ASSERT(summaries[1].get_name() == "Renamed");
+  ASSERT(summaries[1].get_hint() == "duration");
+  ASSERT(summaries[1].is_hidden());
+  ASSERT(summaries[1].get_float64("value") == 2.5);
+
+  // The ad-hoc summary doesn't pick up the descriptor's metadata:
+  ASSERT(summaries[2].get_tag() == test_tag);
+  ASSERT(summaries[2].get_name() == "Ad-hoc");
+  ASSERT(summaries[2].get_hint().empty());
+  ASSERT(summaries[2].get_description().empty());
+  ASSERT(!summaries[2].is_hidden());
+  ASSERT(summaries[2].get_int64("value") == 3);
+}
+
+int main() { test_summaries(); }
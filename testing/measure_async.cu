@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/async_completion.cuh>
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+bool has_summary(const nvbench::state &state, const std::string &tag)
+{
+  const auto &summaries = state.get_summaries();
+  return std::any_of(summaries.cbegin(), summaries.cend(), [&tag](const auto &summ) {
+    return summ.get_tag() == tag;
+  });
+}
+
+// Completes each operation on its own thread after a short delay, and tracks
+// the number of operations in flight:
+std::atomic<int> in_flight{0};
+std::atomic<int> max_in_flight{0};
+std::mutex threads_mutex;
+std::vector<std::thread> threads;
+
+void join_threads()
+{
+  std::lock_guard<std::mutex> lock{threads_mutex};
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  threads.clear();
+}
+
+void threaded_generator(nvbench::state &state)
+{
+  in_flight     = 0;
+  max_in_flight = 0;
+  state.exec(nvbench::exec_tag::async, [](nvbench::launch &, nvbench::async_completion done) {
+    const int cur = ++in_flight;
+    int prev      = max_in_flight;
+    while (prev < cur && !max_in_flight.compare_exchange_weak(prev, cur))
+    {
+    }
+
+    std::lock_guard<std::mutex> lock{threads_mutex};
+    threads.emplace_back([done] {
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+      --in_flight;
+      done();
+    });
+  });
+  join_threads();
+}
+NVBENCH_DEFINE_CALLABLE(threaded_generator, threaded_callable);
+
+void inline_generator(nvbench::state &state)
+{
+  // Completing inside the launcher is allowed:
+  state.exec(nvbench::exec_tag::async,
+             [](nvbench::launch &, nvbench::async_completion done) { done(); });
+}
+NVBENCH_DEFINE_CALLABLE(inline_generator, inline_callable);
+
+void future_generator(nvbench::state &state)
+{
+  state.exec(nvbench::exec_tag::async, [](nvbench::launch &) {
+    return std::async(std::launch::async,
+                      [] { std::this_thread::sleep_for(std::chrono::microseconds{100}); });
+  });
+}
+NVBENCH_DEFINE_CALLABLE(future_generator, future_callable);
+
+void twice_generator(nvbench::state &state)
+{
+  state.exec(nvbench::exec_tag::async, [](nvbench::launch &, nvbench::async_completion done) {
+    done();
+    done();
+  });
+}
+NVBENCH_DEFINE_CALLABLE(twice_generator, twice_callable);
+
+void never_generator(nvbench::state &state)
+{
+  state.exec(nvbench::exec_tag::async, [](nvbench::launch &, nvbench::async_completion) {});
+}
+NVBENCH_DEFINE_CALLABLE(never_generator, never_callable);
+
+template <typename Callable>
+nvbench::benchmark<Callable> &run(nvbench::benchmark<Callable> &bench)
+{
+  bench.set_devices(std::vector<int>{});
+  bench.set_is_cpu_only(true);
+  bench.set_min_samples(5);
+  bench.set_timeout(0.05);
+
+  nvbench::runner<nvbench::benchmark<Callable>> runner{bench};
+  runner.generate_states();
+  runner.run();
+  return bench;
+}
+
+} // namespace
+
+void test_completion_queue()
+{
+  auto queue = std::make_shared<nvbench::detail::async_completion_queue>();
+  std::vector<nvbench::detail::async_completion_queue::entry> entries;
+
+  // Times out without completions:
+  const auto now = nvbench::detail::async_completion_queue::clock::now();
+  ASSERT(!queue->pop_all(entries, now));
+
+  nvbench::async_completion done{queue, 3, 7};
+  std::thread{[done] { done(); }}.join();
+  ASSERT(queue->pop_all(entries, now));
+  ASSERT(entries.size() == 1);
+  ASSERT(entries[0].slot == 3);
+  ASSERT(entries[0].sequence == 7);
+  ASSERT(entries[0].time >= now);
+}
+
+void test_threaded()
+{
+  nvbench::benchmark<threaded_callable> bench;
+  bench.set_async_depth(4);
+  const auto &state = run(bench).get_states().front();
+
+  ASSERT(!state.is_skipped());
+  ASSERT(max_in_flight <= 4);
+  ASSERT(max_in_flight > 1);
+  ASSERT(state.get_summary("nv/async/depth").get_int64("value") == 4);
+  ASSERT(state.get_summary("nv/async/sample_size").get_int64("value") >= 5);
+  ASSERT(state.get_summary("nv/async/time/latency/mean").get_float64("value") >= 100e-6);
+  ASSERT(state.get_summary("nv/async/time/latency/p99").get_float64("value") >=
+         state.get_summary("nv/async/time/latency/p50").get_float64("value"));
+  ASSERT(has_summary(state, "nv/async/throughput"));
+}
+
+void test_inline()
+{
+  nvbench::benchmark<inline_callable> bench;
+  bench.set_async_depth(8);
+  const auto &state = run(bench).get_states().front();
+  ASSERT(!state.is_skipped());
+  ASSERT(state.get_summary("nv/async/sample_size").get_int64("value") >= 5);
+}
+
+void test_future()
+{
+  nvbench::benchmark<future_callable> bench;
+  bench.set_async_depth(2);
+  const auto &state = run(bench).get_states().front();
+  ASSERT(!state.is_skipped());
+  ASSERT(state.get_summary("nv/async/time/latency/min").get_float64("value") >= 100e-6);
+}
+
+void test_errors()
+{
+  {
+    nvbench::benchmark<twice_callable> bench;
+    ASSERT(run(bench).get_states().front().is_skipped());
+  }
+  {
+    nvbench::benchmark<never_callable> bench;
+    ASSERT(run(bench).get_states().front().is_skipped());
+  }
+  {
+    nvbench::benchmark<inline_callable> bench;
+    bench.set_async_depth(0);
+    ASSERT(run(bench).get_states().front().is_skipped());
+  }
+}
+
+int main()
+{
+  test_completion_queue();
+  test_threaded();
+  test_inline();
+  test_future();
+  test_errors();
+}
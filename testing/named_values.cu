@@ -143,9 +143,37 @@ void test_append()
   ASSERT(vals1.get_int64("IntVar2") == 55);
 }
 
+void test_equality()
+{
+  nvbench::named_values vals1;
+  vals1.set_int64("Int", 32);
+  vals1.set_string("String", "string!");
+
+  nvbench::named_values vals2;
+  vals2.set_int64("Int", 32);
+  vals2.set_string("String", "string!");
+
+  ASSERT(vals1 == vals2);
+  ASSERT(nvbench::named_values{} == nvbench::named_values{});
+
+  vals2.set_float64("Float", 3.14);
+  ASSERT(vals1 != vals2);
+
+  vals2.remove_value("Float");
+  vals2.remove_value("Int");
+  vals2.set_int64("Int", 32);
+  ASSERT(vals1 != vals2); // Order matters
+
+  nvbench::named_values vals3;
+  vals3.set_float64("Int", 32.);
+  vals3.set_string("String", "string!");
+  ASSERT(vals1 != vals3); // Type matters
+}
+
 int main()
 {
   test_empty();
   test_basic();
   test_append();
+  test_equality();
 }
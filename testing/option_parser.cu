@@ -17,11 +17,15 @@
  */
 
 #include <nvbench/create.cuh>
+#include <nvbench/host_caches.cuh>
 #include <nvbench/option_parser.cuh>
+#include <nvbench/range.cuh>
 #include <nvbench/type_list.cuh>
 
 #include <fmt/format.h>
 
+#include <cmath>
+
 #include "test_asserts.cuh"
 
 //==============================================================================
@@ -784,6 +788,68 @@ void test_float64_axis_multi()
   }
 }
 
+void test_log_axes()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "TestBench", "--axis", "Ints[log]=[1 : 1e3 : 2]"});
+    const auto &axis = parser.get_benchmarks().front()->get_axes().get_int64_axis("Ints");
+    ASSERT((axis.get_values() == std::vector<nvbench::int64_t>{1, 3, 10, 32, 100, 316, 1000}));
+    ASSERT(!axis.is_power_of_two());
+  }
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "TestBench", "--axis", "Floats [log] = [0.1:10:1]"});
+    const auto &axis = parser.get_benchmarks().front()->get_axes().get_float64_axis("Floats");
+    ASSERT(axis.get_size() == 3);
+    ASSERT(std::abs(axis.get_value(0) - 0.1) < 1e-12);
+    ASSERT(std::abs(axis.get_value(2) - 10.) < 1e-12);
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "TestBench", "--axis", "Ints[log]=[1:1e3]"}));
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "TestBench", "--axis", "Ints[log]=[0:10:4]"}));
+  }
+}
+
+void test_cache_axis()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "TestBench", "--axis", "Ints[cache]=[4096, 8192]"});
+    const auto &axis = parser.get_benchmarks().front()->get_axes().get_int64_axis("Ints");
+    ASSERT((axis.get_values() == std::vector<nvbench::int64_t>{4096, 8192}));
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "TestBench", "--axis", "Floats[cache]=L1"}));
+  }
+
+  // Relative to the caches of this host, if they are known:
+  if (nvbench::host_caches::get().get_size(1) == 0)
+  {
+    return;
+  }
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "TestBench", "--axis", "Ints[cache]=[0.5xL1 : 4xLLC : 16]"});
+    const auto &axis = parser.get_benchmarks().front()->get_axes().get_int64_axis("Ints");
+    ASSERT(axis.get_values() == nvbench::cache_range("0.5xL1", "4xLLC", 16));
+  }
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "TestBench", "--axis", "Ints[cache]=[L1, 2*LLC]"});
+    const auto &axis   = parser.get_benchmarks().front()->get_axes().get_int64_axis("Ints");
+    const auto &caches = nvbench::host_caches::get();
+    ASSERT(axis.get_size() == 2);
+    ASSERT(axis.get_value(0) == caches.get_size(1));
+    ASSERT(axis.get_value(1) == 2 * caches.get_llc_size());
+  }
+}
+
 void test_string_axis_single()
 {
   const std::string ref =
@@ -1175,6 +1241,166 @@ void test_timeout()
   ASSERT(std::abs(states[0].get_timeout() - 12345e2) < 1.);
 }
 
+void test_soak()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--soak",
+                  "30",
+                  "--soak-threshold",
+                  "2",
+                  "--benchmark",
+                  "DummyBench",
+                  "--soak-iterations",
+                  "1000",
+                  "--soak-windows",
+                  "20"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    const auto &bench = states[0].get_benchmark();
+    ASSERT(std::abs(bench.get_soak_duration() - 30.) < 1e-12);
+    ASSERT(std::abs(bench.get_soak_threshold() - 0.02) < 1e-12);
+    ASSERT(bench.get_soak_iterations() == 1000);
+    ASSERT(bench.get_soak_windows() == 20);
+  }
+
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--soak-windows", "2"}));
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--soak", "-1"}));
+  }
+}
+
+void test_fixture_cache()
+{
+  nvbench::option_parser parser;
+  parser.parse({"--benchmark", "DummyBench", "--fixture-cache", "1.5"});
+  const auto &states = parser_to_states(parser);
+
+  ASSERT(states.size() == 1);
+  ASSERT(states[0].get_benchmark().get_fixture_cache_size() == 1536 * 1024);
+}
+
+void test_async_depth()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "DummyBench", "--async-depth", "16"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_async_depth() == 16);
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--async-depth", "0"}));
+  }
+}
+
+void test_huge_pages()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--huge-pages", "hugetlb", "--benchmark", "DummyBench"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_huge_pages() == "hugetlb");
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--huge-pages", "huge"}));
+  }
+}
+
+void test_isolation()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--isolate", "fork", "--hard-timeout", "30", "--benchmark", "DummyBench"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_isolation() == "fork:state");
+    ASSERT(states[0].get_benchmark().get_hard_timeout() == 30.);
+  }
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "DummyBench", "--isolate", "fork:benchmark"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_isolation() == "fork:benchmark");
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--isolate", "thread"}));
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--hard-timeout", "-1"}));
+  }
+}
+
+void test_reserve_cores()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--reserve-cores", "1", "--reserve-timeout", "5", "--benchmark", "DummyBench"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_reserve_cores() == "1");
+    ASSERT(states[0].get_benchmark().get_reserve_timeout() == 5.);
+  }
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "DummyBench", "--reserve-cores", "numa"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_reserve_cores() == "numa");
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--reserve-cores", "0"}));
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--reserve-cores", "all"}));
+  }
+}
+
+void test_retry()
+{
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--retry", "4", "--retry-combine", "--benchmark", "DummyBench"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_retry_factor() == 4.);
+    ASSERT(states[0].get_benchmark().get_retry_combine());
+  }
+  {
+    nvbench::option_parser parser;
+    parser.parse({"--benchmark", "DummyBench", "--retry", "2.5"});
+    const auto &states = parser_to_states(parser);
+
+    ASSERT(states.size() == 1);
+    ASSERT(states[0].get_benchmark().get_retry_factor() == 2.5);
+    ASSERT(!states[0].get_benchmark().get_retry_combine());
+  }
+  {
+    nvbench::option_parser parser;
+    ASSERT_THROWS_ANY(parser.parse({"--benchmark", "DummyBench", "--retry", "-1"}));
+  }
+}
+
 void test_stopping_criterion()
 {
   { // Per benchmark criterion
@@ -1456,6 +1682,8 @@ try
   test_int64_axis_pow2_to_none_multi();
   test_float64_axis_single();
   test_float64_axis_multi();
+  test_log_axes();
+  test_cache_axis();
   test_string_axis_single();
   test_string_axis_multi();
   test_type_axis_single();
@@ -1468,6 +1696,13 @@ try
   test_min_samples();
   test_skip_time();
   test_timeout();
+  test_soak();
+  test_fixture_cache();
+  test_async_depth();
+  test_huge_pages();
+  test_isolation();
+  test_reserve_cores();
+  test_retry();
 
   test_stopping_criterion();
 
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/perf_ctl.cuh>
+
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "test_asserts.cuh"
+
+#ifdef __linux__
+
+// Emulates the `perf record --control` side of the fifos.
+void fake_perf(const std::string &ctl_path,
+               const std::string &ack_path,
+               std::size_t num_commands,
+               std::vector<std::string> &commands)
+{
+  const int ctl_fd = open(ctl_path.c_str(), O_RDONLY);
+  const int ack_fd = open(ack_path.c_str(), O_WRONLY);
+
+  std::string buffer;
+  while (commands.size() < num_commands)
+  {
+    char c{};
+    if (read(ctl_fd, &c, 1) != 1)
+    {
+      break;
+    }
+    if (c != '\n')
+    {
+      buffer.push_back(c);
+      continue;
+    }
+    commands.push_back(buffer);
+    buffer.clear();
+    [[maybe_unused]] auto written = write(ack_fd, "ack\n", 4);
+  }
+
+  close(ack_fd);
+  close(ctl_fd);
+}
+
+void test_fifo()
+{
+  const std::string ctl_path = fmt::format("/tmp/nvbench_perf_ctl_test.{}.ctl", getpid());
+  const std::string ack_path = fmt::format("/tmp/nvbench_perf_ctl_test.{}.ack", getpid());
+  ASSERT(mkfifo(ctl_path.c_str(), 0600) == 0);
+  ASSERT(mkfifo(ack_path.c_str(), 0600) == 0);
+
+  std::vector<std::string> commands;
+  std::thread perf{fake_perf, ctl_path, ack_path, 4, std::ref(commands)};
+
+  auto &ctl = nvbench::detail::perf_ctl::get(ctl_path + "," + ack_path);
+  ASSERT(&ctl == &nvbench::detail::perf_ctl::get(ctl_path + "," + ack_path));
+
+  ctl.enable();
+  ctl.disable();
+  ctl.enable();
+  ctl.disable();
+
+  perf.join();
+  std::remove(ctl_path.c_str());
+  std::remove(ack_path.c_str());
+
+  ASSERT(commands.size() == 4);
+  ASSERT(commands[0] == "enable");
+  ASSERT(commands[1] == "disable");
+  ASSERT(commands[2] == "enable");
+  ASSERT(commands[3] == "disable");
+}
+
+void test_missing_fifo()
+{
+  auto &ctl = nvbench::detail::perf_ctl::get("/tmp/nvbench_perf_ctl_test.does_not_exist");
+  ASSERT_THROWS_ANY(ctl.enable());
+}
+
+int main()
+{
+  test_fifo();
+  test_missing_fifo();
+}
+
+#else
+
+int main() {}
+
+#endif
@@ -18,6 +18,8 @@
 
 #include <nvbench/range.cuh>
 
+#include <cmath>
+
 #include "test_asserts.cuh"
 
 void test_basic()
@@ -63,9 +65,61 @@ void test_fp_tolerance()
   }
 }
 
+void test_log_range()
+{
+  ASSERT((nvbench::log_range(1, 1000, 2) ==
+          std::vector<nvbench::int64_t>{1, 3, 10, 32, 100, 316, 1000}));
+  ASSERT((nvbench::log_range(10, 100, 1) == std::vector<nvbench::int64_t>{10, 100}));
+  // End is not a point of the series:
+  ASSERT((nvbench::log_range(1, 50, 1) == std::vector<nvbench::int64_t>{1, 10}));
+  // Rounded values are not repeated:
+  ASSERT((nvbench::log_range(1, 10, 10) ==
+          std::vector<nvbench::int64_t>{1, 2, 3, 4, 5, 6, 8, 10}));
+
+  const auto floats = nvbench::log_range(0.01, 100., 3);
+  ASSERT((std::is_same_v<decltype(floats), const std::vector<nvbench::float64_t>>));
+  ASSERT(floats.size() == 13);
+  ASSERT(std::abs(floats.front() - 0.01) < 1e-15);
+  ASSERT(std::abs(floats[3] - 0.1) < 1e-15);
+  ASSERT(std::abs(floats.back() - 100.) < 1e-12);
+
+  ASSERT_THROWS_ANY([[maybe_unused]] auto r = nvbench::log_range(0, 10, 1));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto r = nvbench::log_range(10, 1, 1));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto r = nvbench::log_range(1, 10, 0));
+}
+
+void test_geometric_range()
+{
+  ASSERT((nvbench::geometric_range(2, 162, 5) ==
+          std::vector<nvbench::int64_t>{2, 6, 18, 54, 162}));
+  ASSERT((nvbench::geometric_range(1024, 1 << 20, 11) ==
+          std::vector<nvbench::int64_t>{1 << 10,
+                                        1 << 11,
+                                        1 << 12,
+                                        1 << 13,
+                                        1 << 14,
+                                        1 << 15,
+                                        1 << 16,
+                                        1 << 17,
+                                        1 << 18,
+                                        1 << 19,
+                                        1 << 20}));
+  ASSERT((nvbench::geometric_range(7, 7, 1) == std::vector<nvbench::int64_t>{7}));
+
+  // The end is exact:
+  const auto floats = nvbench::geometric_range(0.3, 0.7, 9);
+  ASSERT(floats.size() == 9);
+  ASSERT(floats.front() == 0.3);
+  ASSERT(floats.back() == 0.7);
+
+  ASSERT_THROWS_ANY([[maybe_unused]] auto r = nvbench::geometric_range(1, 10, 0));
+}
+
 int main()
 {
   test_basic();
   test_result_type();
   test_fp_tolerance();
+  test_log_range();
+  test_geometric_range();
 }
@@ -0,0 +1,213 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/results.cuh>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "test_asserts.cuh"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+namespace
+{
+
+// Abridged output of `--jsonbin`, written from a different working directory:
+const char *test_json = R"json({
+  "meta": {
+    "argv": ["./bench", "--jsonbin", "out/results.json"],
+    "version": {"json": {"major": 1, "minor": 2, "patch": 0, "string": "1.2.0"}}
+  },
+  "devices": [{"id": 0, "name": "Test GPU"}],
+  "summary_descriptors": [
+    {"tag": "nv/cold/time/gpu/mean", "name": "GPU Time", "hint": "duration",
+     "description": "Mean GPU time"},
+    {"tag": "nv/cold/sample_size", "name": "Samples", "hint": "sample_size"}
+  ],
+  "benchmarks": [
+    {
+      "name": "copy",
+      "index": 0,
+      "devices": [0],
+      "axes": [
+        {"name": "Elements", "type": "int64", "flags": "pow2",
+         "values": [{"input_string": "10", "description": "2^10 = 1024", "value": 1024}]},
+        {"name": "Kind", "type": "string", "flags": "",
+         "values": [{"input_string": "a", "description": "", "value": "a"}]}
+      ],
+      "states": [
+        {
+          "name": "Device=0 Elements=2^10 Kind=a",
+          "min_samples": 10,
+          "skip_time": -1.0,
+          "timeout": 15.0,
+          "device": 0,
+          "type_config_index": 0,
+          "axis_values": [
+            {"name": "Elements", "type": "int64", "value": "1024"},
+            {"name": "Kind", "type": "string", "value": "a"}
+          ],
+          "summaries": [
+            {"tag": "nv/cold/sample_size",
+             "data": [{"name": "value", "type": "int64", "value": "3"}]},
+            {"tag": "nv/cold/time/gpu/mean", "description": "Overridden",
+             "data": [{"name": "value", "type": "float64", "value": "2.5e-06"}]},
+            {"tag": "nv/json/bin:nv/cold/sample_times", "name": "Samples Times File",
+             "hint": "file/sample_times", "hide": "Not needed in table.",
+             "data": [{"name": "filename", "type": "string", "value": "out/results.json-bin/0.bin"},
+                      {"name": "size", "type": "int64", "value": "3"}]}
+          ],
+          "is_skipped": false
+        },
+        {
+          "name": "Device=0 Elements=2^10 Kind=b",
+          "device": 0,
+          "axis_values": [],
+          "summaries": [],
+          "is_skipped": true,
+          "skip_reason": "Unsupported."
+        }
+      ],
+      "summary_groups": [
+        {"device": null, "axis_values": [],
+         "summaries": [{"tag": "test/group", "data": [{"name": "value", "type": "string",
+                                                       "value": "O(n)"}]}]}
+      ]
+    }
+  ]
+})json";
+
+} // namespace
+
+void test_read()
+{
+  const auto dir = fs::temp_directory_path() / "nvbench_test_results";
+  fs::remove_all(dir);
+  fs::create_directories(dir / "results.json-bin");
+
+  const auto json_path = (dir / "results.json").string();
+  {
+    std::ofstream out{json_path};
+    out << test_json;
+  }
+  {
+    const float times[3] = {1.f, 2.f, 3.f};
+    std::ofstream out{dir / "results.json-bin" / "0.bin", std::ios::binary};
+    out.write(reinterpret_cast<const char *>(times), sizeof(times));
+  }
+
+  const auto file = nvbench::results::result_file::read(json_path);
+  ASSERT(file.get_version().has_value());
+  ASSERT(file.get_version()->minor == 2);
+  ASSERT(file.get_argv().size() == 3);
+  ASSERT(file.get_devices().size() == 1);
+  ASSERT(file.get_devices()[0].name == "Test GPU");
+
+  ASSERT(file.find_benchmark("missing") == nullptr);
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto &b = file.get_benchmark("missing"));
+
+  const auto &bench = file.get_benchmark("copy");
+  ASSERT(bench.get_devices().size() == 1);
+  ASSERT(bench.get_run_order() == "canonical");
+  ASSERT(bench.get_axes().size() == 2);
+  ASSERT(bench.get_axes()[0].get_flags() == "pow2");
+  ASSERT(bench.get_axes()[0].get_input_strings()[0] == "10");
+  ASSERT(bench.get_states().size() == 2);
+
+  const auto &state = bench.get_state("Device=0 Elements=2^10 Kind=a");
+  ASSERT(state.get_device() == 0);
+  ASSERT(state.get_min_samples() == 10);
+  ASSERT(state.get_axis_values().get_int64("Elements") == 1024);
+  ASSERT(state.get_axis_values().get_string("Kind") == "a");
+  ASSERT(!state.is_skipped());
+
+  // Metadata is expanded from the descriptors; summary keys take precedence:
+  const auto &mean = state.get_summary("nv/cold/time/gpu/mean");
+  ASSERT(mean.get_name() == "GPU Time");
+  ASSERT(mean.get_hint() == "duration");
+  ASSERT(mean.get_description() == "Overridden");
+  ASSERT(!mean.is_hidden());
+  ASSERT(mean.get_float64("value") == 2.5e-06);
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto v = mean.get_int64("value"));
+
+  const auto &samples = state.get_summary("nv/cold/sample_size");
+  ASSERT(samples.get_int64("value") == 3);
+  ASSERT(samples.get_float64("value") == 3.);
+  ASSERT(state.find_summary("nv/cold/missing") == nullptr);
+
+  ASSERT(state.get_summary("nv/json/bin:nv/cold/sample_times").is_hidden());
+
+  const auto &skipped = bench.get_state("Device=0 Elements=2^10 Kind=b");
+  ASSERT(skipped.is_skipped());
+  ASSERT(skipped.get_skip_reason() == "Unsupported.");
+  ASSERT(skipped.get_min_samples() == 0);
+
+  ASSERT(bench.get_summary_groups().size() == 1);
+  const auto &group = bench.get_summary_groups()[0];
+  ASSERT(!group.get_device().has_value());
+  ASSERT(group.get_summaries().get("test/group").get_string("value") == "O(n)");
+
+  // The bin file is found next to the JSON file, not at the path written:
+  const auto times = file.map_sample_times(state, "nv/cold/sample_times");
+  ASSERT(times.size() == 3);
+  ASSERT(times[0] == 1.f);
+  ASSERT(times[2] == 3.f);
+
+  const auto first = file.map_sample_times(state);
+  ASSERT(first.size() == 3);
+
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto t = file.map_sample_times(skipped));
+
+  fs::remove_all(dir);
+}
+
+void test_invalid()
+{
+  const auto path = (fs::temp_directory_path() / "nvbench_test_results_invalid.json").string();
+  {
+    std::ofstream out{path};
+    out << R"({"meta": {"version": {"json": {"major": 2, "minor": 0, "patch": 0}}},
+              "benchmarks": []})";
+  }
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto f = nvbench::results::result_file::read(path));
+
+  {
+    std::ofstream out{path};
+    out << "{ not json";
+  }
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto f = nvbench::results::result_file::read(path));
+
+  std::remove(path.c_str());
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto f = nvbench::results::result_file::read(path));
+}
+
+int main()
+{
+  test_read();
+  test_invalid();
+}
@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/results.cuh>
+#include <nvbench/results_history.cuh>
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+namespace
+{
+
+const auto test_dir = fs::temp_directory_path() / "nvbench_test_results_history";
+
+const char *test_json = R"json({
+  "meta": {"version": {"json": {"major": 1, "minor": 2, "patch": 0, "string": "1.2.0"}}},
+  "devices": [{"id": 0, "name": "Test GPU"}],
+  "benchmarks": [{
+    "name": "copy", "index": 0, "devices": [0],
+    "axes": [{"name": "Elements", "type": "int64", "flags": "", "values": []}],
+    "states": [
+      {"name": "Device=0 Elements=1", "device": 0, "is_skipped": false,
+       "axis_values": [{"name": "Elements", "type": "int64", "value": "1"}],
+       "summaries": [
+         {"tag": "nv/cold/sample_size",
+          "data": [{"name": "value", "type": "int64", "value": "100"}]},
+         {"tag": "nv/cold/time/gpu/mean",
+          "data": [{"name": "value", "type": "float64", "value": "0.5"}]},
+         {"tag": "nv/cold/time/gpu/stdev/relative",
+          "data": [{"name": "value", "type": "float64", "value": "0.01"}]},
+         {"tag": "nv/batch/time/gpu/mean",
+          "data": [{"name": "value", "type": "float64", "value": "0.25"}]}
+       ]},
+      {"name": "Device=0 Elements=2", "device": 0, "is_skipped": true,
+       "skip_reason": "Not interesting",
+       "axis_values": [{"name": "Elements", "type": "int64", "value": "2"}],
+       "summaries": []}
+    ]
+  }]
+})json";
+
+// Deterministic, roughly uniform noise in [-1, 1):
+double noise(std::size_t i) { return static_cast<double>((i * 7919) % 200) / 100. - 1.; }
+
+} // namespace
+
+void test_make_history_records()
+{
+  fs::create_directories(test_dir);
+  const auto json_path = (test_dir / "results.json").string();
+  std::ofstream{json_path} << test_json;
+
+  const auto file    = nvbench::results::result_file::read(json_path);
+  const auto records = nvbench::results::make_history_records(file, "abc123", "node0");
+  ASSERT(records.size() == 1);
+
+  const auto &record = records[0];
+  ASSERT(record.revision == "abc123");
+  ASSERT(record.host == "node0");
+  ASSERT(record.device == "Test GPU");
+  ASSERT(record.benchmark == "copy");
+  ASSERT(record.state == "Device=0 Elements=1");
+  ASSERT(record.tag == "nv/cold/time/gpu/mean");
+  ASSERT(record.value == 0.5);
+  ASSERT(record.noise == 0.01);
+  ASSERT(record.samples == 100);
+}
+
+void test_history_store()
+{
+  fs::create_directories(test_dir);
+  const nvbench::results::history_store store{(test_dir / "history.jsonl").string()};
+  fs::remove(store.get_filename());
+  ASSERT(store.read().empty());
+
+  nvbench::results::history_record record;
+  record.revision  = "r0";
+  record.host      = "node0";
+  record.device    = "cpu";
+  record.benchmark = "bench";
+  record.state     = "N=1";
+  record.tag       = "nv/cpu_only/time/cpu/mean";
+  record.value     = 1.;
+  record.noise     = std::numeric_limits<double>::infinity();
+  store.append({record});
+
+  // A truncated line from an interrupted writer is skipped:
+  std::ofstream{store.get_filename(), std::ios::app} << "{\"revision\": \"r\n";
+
+  record.revision = "r1";
+  record.value    = 2.;
+  record.noise    = 0.1;
+  store.append({record, record});
+
+  const auto records = store.read();
+  ASSERT(records.size() == 3);
+  ASSERT(records[0].revision == "r0");
+  ASSERT(std::isinf(records[0].noise));
+  ASSERT(records[2].revision == "r1");
+  ASSERT(records[2].value == 2.);
+  ASSERT(records[2].noise == 0.1);
+}
+
+void test_make_history_series()
+{
+  std::vector<nvbench::results::history_record> records;
+  const auto add = [&records](std::string rev, std::string state, double value) {
+    nvbench::results::history_record record;
+    record.revision = std::move(rev);
+    record.state    = std::move(state);
+    record.value    = value;
+    records.push_back(std::move(record));
+  };
+  add("r0", "A", 1.);
+  add("r0", "B", 10.);
+  add("r1", "A", 3.);
+  add("r1", "A", 2.);
+  add("r1", "A", 9.);
+  add("r0", "A", 3.);
+
+  const auto series = nvbench::results::make_history_series(records);
+  ASSERT(series.size() == 2);
+  ASSERT(series[0].state == "A");
+  ASSERT((series[0].revisions == std::vector<std::string>{"r0", "r1"}));
+  ASSERT((series[0].values == std::vector<double>{2., 3.}));
+  ASSERT(series[1].state == "B");
+  ASSERT((series[1].values == std::vector<double>{10.}));
+}
+
+void test_detect_change_points()
+{
+  using nvbench::results::detect_change_points;
+
+  // 2% noise around 1.0, then a 20% regression at 30 and a recovery at 45:
+  std::vector<double> values;
+  for (std::size_t i = 0; i < 60; ++i)
+  {
+    const double level = i >= 30 && i < 45 ? 1.2 : 1.;
+    values.push_back(level + 0.02 * noise(i));
+  }
+  ASSERT((detect_change_points(values) == std::vector<std::size_t>{30, 45}));
+
+  // Noise alone is not a change:
+  for (std::size_t i = 30; i < 45; ++i)
+  {
+    values[i] -= 0.2;
+  }
+  ASSERT(detect_change_points(values).empty());
+
+  // Exact steps, e.g. from deterministic counters:
+  ASSERT((detect_change_points({5., 5., 5., 7., 7., 7.}) == std::vector<std::size_t>{3}));
+
+  // Segments shorter than the minimum are not reported:
+  ASSERT(detect_change_points({5., 5., 7., 5., 5.}, 2., 2).empty());
+  ASSERT((detect_change_points({5., 5., 5., 5., 9., 5., 5., 5., 5.}, 2., 1) ==
+          std::vector<std::size_t>{4, 5}));
+
+  ASSERT(detect_change_points({}).empty());
+  ASSERT(detect_change_points({1.}).empty());
+}
+
+int main()
+{
+  test_make_history_records();
+  test_history_store();
+  test_make_history_series();
+  test_detect_change_points();
+  fs::remove_all(test_dir);
+}
@@ -0,0 +1,278 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/results.cuh>
+#include <nvbench/results_merge.cuh>
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+static_assert(false, "No <filesystem> or <experimental/filesystem> found.");
+#endif
+
+namespace
+{
+
+const auto test_dir = fs::temp_directory_path() / "nvbench_test_results_merge";
+
+struct test_state
+{
+  nvbench::int64_t elements;
+  nvbench::int64_t samples;
+  double mean;
+  double stdev;
+};
+
+// Writes a result file and a sample-times file per state, with `samples`
+// copies of `mean`:
+std::string write_result_file(const std::string &name, const std::vector<test_state> &states)
+{
+  const auto json_path = (test_dir / name).string();
+  fs::create_directories(json_path + "-bin");
+
+  std::string states_json;
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    const auto &st      = states[i];
+    const auto bin_path = fmt::format("{}-bin/{}.bin", json_path, i);
+    {
+      const std::vector<float> times(static_cast<std::size_t>(st.samples),
+                                     static_cast<float>(st.mean));
+      std::ofstream out{bin_path, std::ios::binary};
+      out.write(reinterpret_cast<const char *>(times.data()),
+                static_cast<std::streamsize>(times.size() * sizeof(float)));
+    }
+
+    states_json += fmt::format(
+      R"json({}{{
+        "name": "Elements={}", "device": null, "is_skipped": false,
+        "axis_values": [{{"name": "Elements", "type": "int64", "value": "{}"}}],
+        "summaries": [
+          {{"tag": "nv/cpu_only/sample_size",
+           "data": [{{"name": "value", "type": "int64", "value": "{}"}}]}},
+          {{"tag": "nv/cpu_only/time/cpu/min",
+           "data": [{{"name": "value", "type": "float64", "value": "{}"}}]}},
+          {{"tag": "nv/cpu_only/time/cpu/max",
+           "data": [{{"name": "value", "type": "float64", "value": "{}"}}]}},
+          {{"tag": "nv/cpu_only/time/cpu/mean",
+           "data": [{{"name": "value", "type": "float64", "value": "{}"}}]}},
+          {{"tag": "nv/cpu_only/time/cpu/stdev/absolute",
+           "data": [{{"name": "value", "type": "float64", "value": "{}"}}]}},
+          {{"tag": "nv/cpu_only/time/cpu/stdev/relative",
+           "data": [{{"name": "value", "type": "float64", "value": "{}"}}]}},
+          {{"tag": "nv/cpu_only/bw/item_rate",
+           "data": [{{"name": "value", "type": "float64", "value": "{}"}}]}},
+          {{"tag": "nv/json/bin:nv/cpu_only/sample_times", "hint": "file/sample_times",
+           "data": [{{"name": "filename", "type": "string", "value": "{}"}},
+                    {{"name": "size", "type": "int64", "value": "{}"}}]}}
+        ]}})json",
+      i == 0 ? "" : ",",
+      st.elements,
+      st.elements,
+      st.samples,
+      st.mean / 2,
+      st.mean * 2,
+      st.mean,
+      st.stdev,
+      st.stdev / st.mean,
+      100. / st.mean,
+      bin_path,
+      st.samples);
+  }
+
+  std::ofstream out{json_path};
+  out << fmt::format(
+    R"json({{
+      "meta": {{"version": {{"json": {{"major": 1, "minor": 2, "patch": 0, "string": "1.2.0"}}}}}},
+      "devices": [],
+      "summary_descriptors": [
+        {{"tag": "nv/cpu_only/time/cpu/mean", "name": "CPU Time", "hint": "duration"}}
+      ],
+      "benchmarks": [{{
+        "name": "bench", "index": 0, "devices": null,
+        "axes": [{{"name": "Elements", "type": "int64", "flags": "", "values": []}}],
+        "states": [{}]
+      }}]
+    }})json",
+    states_json);
+  return json_path;
+}
+
+std::vector<std::string> write_inputs()
+{
+  fs::remove_all(test_dir);
+  // Elements=1 is in both files; the first copy has less noise:
+  return {write_result_file("a.json", {{1, 10, 1., 0.1}, {2, 10, 1., 0.1}}),
+          write_result_file("b.json", {{1, 30, 2., 0.4}, {3, 10, 1., 0.1}})};
+}
+
+nvbench::results::result_file merge(nvbench::results::merge_policy policy,
+                                    nvbench::int64_t expected_bin_files)
+{
+  const auto output = (test_dir / "merged.json").string();
+  const auto stats  = nvbench::results::merge_result_files(write_inputs(), output, policy);
+  ASSERT(stats.num_benchmarks == 1);
+  ASSERT(stats.num_states == 3);
+  ASSERT(stats.num_duplicate_states == 1);
+  ASSERT(stats.num_bin_files == expected_bin_files);
+  ASSERT(stats.num_missing_bin_files == 0);
+  return nvbench::results::result_file::read(output);
+}
+
+double get_mean(const nvbench::results::state &state)
+{
+  return state.get_summary("nv/cpu_only/time/cpu/mean").get_float64("value");
+}
+
+} // namespace
+
+void test_latest()
+{
+  const auto file   = merge(nvbench::results::merge_policy::latest, 3);
+  const auto &bench = file.get_benchmark("bench");
+  ASSERT(bench.get_states().size() == 3);
+  ASSERT(get_mean(bench.get_state("Elements=1")) == 2.);
+  ASSERT(bench.find_state("Elements=2") != nullptr);
+  ASSERT(bench.find_state("Elements=3") != nullptr);
+
+  // Descriptors survive the merge:
+  ASSERT(bench.get_state("Elements=1").get_summary("nv/cpu_only/time/cpu/mean").get_name() ==
+         "CPU Time");
+
+  const auto times = file.map_sample_times(bench.get_state("Elements=1"));
+  ASSERT(times.size() == 30);
+  ASSERT(times.get_filename().find("merged.json-bin") != std::string::npos);
+}
+
+void test_best_converged()
+{
+  const auto file   = merge(nvbench::results::merge_policy::best_converged, 3);
+  const auto &state = file.get_benchmark("bench").get_state("Elements=1");
+  ASSERT(get_mean(state) == 1.);
+  ASSERT(file.map_sample_times(state).size() == 10);
+}
+
+void test_pool()
+{
+  const auto file   = merge(nvbench::results::merge_policy::pool, 3);
+  const auto &state = file.get_benchmark("bench").get_state("Elements=1");
+
+  const auto mean = (10. * 1. + 30. * 2.) / 40.;
+  ASSERT(state.get_summary("nv/cpu_only/sample_size").get_int64("value") == 40);
+  ASSERT(std::abs(get_mean(state) - mean) < 1e-12);
+  ASSERT(state.get_summary("nv/cpu_only/time/cpu/min").get_float64("value") == 0.5);
+  ASSERT(state.get_summary("nv/cpu_only/time/cpu/max").get_float64("value") == 4.);
+
+  const auto sum_of_squares = 9. * 0.1 * 0.1 + 10. * (1. - mean) * (1. - mean) + //
+                              29. * 0.4 * 0.4 + 30. * (2. - mean) * (2. - mean);
+  const auto stdev = std::sqrt(sum_of_squares / 39.);
+  ASSERT(std::abs(state.get_summary("nv/cpu_only/time/cpu/stdev/absolute").get_float64("value") -
+                  stdev) < 1e-12);
+
+  // Throughput follows the pooled mean:
+  ASSERT(std::abs(state.get_summary("nv/cpu_only/bw/item_rate").get_float64("value") -
+                  100. / mean) < 1e-9);
+
+  const auto times = file.map_sample_times(state);
+  ASSERT(times.size() == 40);
+  ASSERT(times[0] == 1.f);
+  ASSERT(times[39] == 2.f);
+}
+
+void test_errors()
+{
+  ASSERT(nvbench::results::parse_merge_policy("best-converged") ==
+         nvbench::results::merge_policy::best_converged);
+  ASSERT_THROWS_ANY([[maybe_unused]] auto p = nvbench::results::parse_merge_policy("oldest"));
+
+  const auto output = (test_dir / "merged.json").string();
+  ASSERT_THROWS_ANY(nvbench::results::merge_result_files({}, output, {}));
+  ASSERT_THROWS_ANY(nvbench::results::merge_result_files({(test_dir / "missing.json").string()},
+                                                         output,
+                                                         {}));
+
+  // The output would overwrite the input's sample-times files:
+  const auto input = ::write_result_file("self.json", {{1, 10, 1., 0.}});
+  const auto bin   = input + "-bin/0.bin";
+  const auto size  = fs::file_size(bin);
+  ASSERT_THROWS_ANY(nvbench::results::merge_result_files({input}, input, {}));
+  const auto same_file = (test_dir / "." / "self.json").string();
+  ASSERT_THROWS_ANY(nvbench::results::merge_result_files({input}, same_file, {}));
+  ASSERT(fs::file_size(bin) == size);
+}
+
+void test_descriptor_markers()
+{
+  // Since 1.5.0, only marked summaries use the descriptor of their tag:
+  fs::create_directories(test_dir);
+  const auto input = (test_dir / "markers.json").string();
+  {
+    std::ofstream out{input};
+    out << R"json({
+      "meta": {"version": {"json": {"major": 1, "minor": 5, "patch": 0, "string": "1.5.0"}}},
+      "devices": [],
+      "summary_descriptors": [{"tag": "test/time", "name": "Time", "hint": "duration"}],
+      "benchmarks": [{
+        "name": "bench", "index": 0, "devices": null, "axes": [],
+        "states": [{
+          "name": "", "device": null, "is_skipped": false, "axis_values": [],
+          "summaries": [
+            {"tag": "test/time", "descriptor": true,
+             "data": [{"name": "value", "type": "float64", "value": "1"}]},
+            {"tag": "test/time", "name": "Ad-hoc",
+             "data": [{"name": "value", "type": "float64", "value": "2"}]}
+          ]
+        }]
+      }]
+    })json";
+  }
+
+  const auto output = (test_dir / "merged.json").string();
+  nvbench::results::merge_result_files({input}, output, {});
+
+  const auto file       = nvbench::results::result_file::read(output);
+  const auto &summaries = file.get_benchmark("bench").get_states().front().get_summaries();
+  ASSERT(summaries.size() == 2);
+  ASSERT(summaries[0].get_name() == "Time");
+  ASSERT(summaries[0].get_hint() == "duration");
+  ASSERT(summaries[1].get_name() == "Ad-hoc");
+  ASSERT(summaries[1].get_hint().empty());
+}
+
+int main()
+{
+  test_latest();
+  test_best_converged();
+  test_pool();
+  test_errors();
+  test_descriptor_markers();
+  fs::remove_all(test_dir);
+}
@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/isolation.cuh>
+#include <nvbench/detail/retry.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+constexpr nvbench::float64_t timeout = 0.5;
+
+// Reports CPU-only results without measuring anything. States time out while
+// their timeout is the benchmark's, and the "stuck" ones always do.
+void fake_cpu_only_generator(nvbench::state &state)
+{
+  const auto &mode        = state.get_string("Mode");
+  const bool is_first     = state.get_timeout() == timeout;
+  const bool is_timed_out = mode == "stuck" || (mode != "ok" && is_first);
+  if (mode == "fail" && !is_first)
+  {
+    state.skip("Failed on retry.");
+    return;
+  }
+
+  const nvbench::int64_t samples = is_first ? 10 : 30;
+  const nvbench::float64_t mean  = mode == "shifted" && !is_first ? 2. : is_first ? 1. : 1.01;
+  const nvbench::float64_t stdev = 0.1;
+
+  state.add_element_count(100);
+  state.add_summary("nv/cpu_only/sample_size").set_int64("value", samples);
+  state.add_summary("nv/cpu_only/time/cpu/min").set_float64("value", is_first ? 0.5 : 0.8);
+  state.add_summary("nv/cpu_only/time/cpu/max").set_float64("value", is_first ? 1.5 : 1.2);
+  state.add_summary("nv/cpu_only/time/cpu/mean").set_float64("value", mean);
+  state.add_summary("nv/cpu_only/time/cpu/stdev/absolute").set_float64("value", stdev);
+  state.add_summary("nv/cpu_only/time/cpu/stdev/relative").set_float64("value", stdev / mean);
+  state.add_summary("nv/cpu_only/bw/item_rate").set_float64("value", 100. / mean);
+  if (is_timed_out)
+  {
+    state.add_summary("nv/cpu_only/timed_out").set_float64("value", state.get_timeout());
+  }
+}
+NVBENCH_DEFINE_CALLABLE(fake_cpu_only_generator, fake_cpu_only_callable);
+
+using benchmark_type = nvbench::benchmark<fake_cpu_only_callable>;
+
+void run(benchmark_type &bench,
+         nvbench::float64_t factor,
+         bool combine,
+         const std::string &isolation = "none")
+{
+  bench.set_devices(std::vector<int>{});
+  bench.set_is_cpu_only(true);
+  bench.set_timeout(timeout);
+  bench.set_retry_factor(factor);
+  bench.set_retry_combine(combine);
+  bench.set_isolation(isolation);
+  bench.add_string_axis("Mode", {"ok", "compatible", "shifted", "stuck", "fail"});
+
+  nvbench::runner<benchmark_type> runner{bench};
+  runner.generate_states();
+  runner.run();
+}
+
+nvbench::float64_t get_value(const nvbench::state &state, const std::string &tag)
+{
+  return state.get_summary(tag).get_float64("value");
+}
+
+std::string get_retry(const nvbench::state &state)
+{
+  return state.get_summary("nv/retry").get_string("value");
+}
+
+bool has_retry(const nvbench::state &state)
+{
+  for (const auto &summ : state.get_summaries())
+  {
+    if (summ.get_tag() == "nv/retry")
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void add_pass(std::vector<nvbench::summary> &summaries,
+              nvbench::int64_t samples,
+              nvbench::float64_t mean,
+              nvbench::float64_t stdev)
+{
+  summaries.emplace_back("nv/cpu_only/sample_size").set_int64("value", samples);
+  summaries.emplace_back("nv/cpu_only/time/cpu/mean").set_float64("value", mean);
+  summaries.emplace_back("nv/cpu_only/time/cpu/stdev/absolute").set_float64("value", stdev);
+  summaries.emplace_back("nv/cpu_only/time/cpu/stdev/relative").set_float64("value", stdev / mean);
+  summaries.emplace_back("nv/cpu_only/walltime").set_float64("value", 1.);
+}
+
+} // namespace
+
+void test_combine()
+{
+  using nvbench::detail::retry_pass;
+
+  // Samples 1..5 and 6..10:
+  std::vector<nvbench::summary> first;
+  std::vector<nvbench::summary> second;
+  add_pass(first, 5, 3., std::sqrt(2.5));
+  add_pass(second, 5, 8., std::sqrt(2.5));
+
+  // |3 - 8| / sqrt(2.5 / 5 + 2.5 / 5):
+  ASSERT(std::abs(retry_pass::get_t_stat(first, second) - 5.) < 1e-12);
+  ASSERT(std::isnan(retry_pass::get_t_stat(first, {})));
+
+  retry_pass::combine(first, second);
+  const auto find = [&second](const std::string &tag) -> const nvbench::summary & {
+    for (const auto &summ : second)
+    {
+      if (summ.get_tag() == tag)
+      {
+        return summ;
+      }
+    }
+    throw std::runtime_error(tag);
+  };
+  // Same as the moments of 1..10:
+  ASSERT(find("nv/cpu_only/sample_size").get_int64("value") == 10);
+  ASSERT(std::abs(find("nv/cpu_only/time/cpu/mean").get_float64("value") - 5.5) < 1e-12);
+  const auto stdev = std::sqrt(82.5 / 9.);
+  ASSERT(std::abs(find("nv/cpu_only/time/cpu/stdev/absolute").get_float64("value") - stdev) <
+         1e-12);
+  ASSERT(std::abs(find("nv/cpu_only/time/cpu/stdev/relative").get_float64("value") -
+                  stdev / 5.5) < 1e-12);
+  ASSERT(find("nv/cpu_only/walltime").get_float64("value") == 2.);
+}
+
+void test_disabled()
+{
+  benchmark_type bench;
+  run(bench, 0., true);
+  for (const auto &state : bench.get_states())
+  {
+    ASSERT(!has_retry(state));
+    ASSERT(state.get_timeout() == timeout);
+  }
+}
+
+void check_retried(const benchmark_type &bench, bool combine)
+{
+  const auto &states = bench.get_states();
+  ASSERT(states.size() == 5);
+
+  // Converged on the first pass:
+  ASSERT(!has_retry(states[0]));
+  ASSERT(states[0].get_timeout() == timeout);
+
+  for (std::size_t i = 1; i < states.size(); ++i)
+  {
+    ASSERT(states[i].get_timeout() == 4 * timeout);
+    ASSERT(!states[i].is_skipped());
+    ASSERT(states[i].get_element_count() == 100);
+  }
+
+  const auto &compatible = states[1];
+  if (combine)
+  {
+    ASSERT_MSG(get_retry(compatible) == "converged, combined", "{}", get_retry(compatible));
+    ASSERT(compatible.get_summary("nv/cpu_only/sample_size").get_int64("value") == 40);
+    ASSERT(std::abs(get_value(compatible, "nv/cpu_only/time/cpu/mean") - 1.0075) < 1e-12);
+    ASSERT(get_value(compatible, "nv/cpu_only/time/cpu/min") == 0.5);
+    ASSERT(get_value(compatible, "nv/cpu_only/time/cpu/max") == 1.5);
+    ASSERT(std::abs(get_value(compatible, "nv/cpu_only/bw/item_rate") - 100. / 1.0075) < 1e-9);
+  }
+  else
+  {
+    ASSERT_MSG(get_retry(compatible) == "converged", "{}", get_retry(compatible));
+    ASSERT(compatible.get_summary("nv/cpu_only/sample_size").get_int64("value") == 30);
+    ASSERT(get_value(compatible, "nv/cpu_only/time/cpu/mean") == 1.01);
+  }
+  ASSERT(compatible.get_summary("nv/retry").get_float64("timeout") == 4 * timeout);
+
+  // Means 10 standard errors apart are never combined:
+  const auto &shifted = states[2];
+  ASSERT_MSG(get_retry(shifted) == "converged", "{}", get_retry(shifted));
+  ASSERT(get_value(shifted, "nv/cpu_only/time/cpu/mean") == 2.);
+
+  const auto &stuck = states[3];
+  ASSERT_MSG(get_retry(stuck) == (combine ? "timed out, combined" : "timed out"),
+             "{}",
+             get_retry(stuck));
+
+  // The first pass is kept:
+  const auto &fail = states[4];
+  ASSERT_MSG(get_retry(fail) == "failed", "{}", get_retry(fail));
+  ASSERT(fail.get_summary("nv/cpu_only/sample_size").get_int64("value") == 10);
+  ASSERT(get_value(fail, "nv/cpu_only/time/cpu/mean") == 1.);
+}
+
+void test_retry()
+{
+  benchmark_type bench;
+  run(bench, 4., false);
+  check_retried(bench, false);
+}
+
+void test_retry_combine()
+{
+  benchmark_type bench;
+  run(bench, 4., true);
+  check_retried(bench, true);
+}
+
+void test_retry_forked()
+{
+  if (!nvbench::detail::fork_server::is_supported())
+  {
+    return;
+  }
+
+  // Workers must use the escalated timeout:
+  benchmark_type bench;
+  run(bench, 4., true, "fork");
+  check_retried(bench, true);
+}
+
+int main()
+{
+  test_combine();
+  test_disabled();
+  test_retry();
+  test_retry_combine();
+  test_retry_forked();
+}
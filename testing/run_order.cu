@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/run_order.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+using run_order = nvbench::detail::run_order;
+
+namespace
+{
+
+// Elements of each state, in the order the states were run:
+std::vector<nvbench::int64_t> run_log;
+
+void logging_generator(nvbench::state &state)
+{
+  run_log.push_back(state.get_int64("Elements"));
+  auto &summ = state.add_summary("nv/cpu_only/time/cpu/mean");
+  summ.set_float64("value", 1e-6);
+}
+NVBENCH_DEFINE_CALLABLE(logging_generator, logging_callable);
+
+std::vector<nvbench::int64_t> run_with_order(const std::string &order)
+{
+  using benchmark_type = nvbench::benchmark<logging_callable>;
+  using runner_type    = nvbench::runner<benchmark_type>;
+
+  benchmark_type bench;
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Elements", {0, 1, 2, 3, 4, 5, 6, 7});
+  bench.set_run_order(order);
+
+  run_log.clear();
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  // Results stay in canonical order:
+  const auto &states = bench.get_states();
+  ASSERT(states.size() == 8);
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    ASSERT(states[i].get_int64("Elements") == static_cast<nvbench::int64_t>(i));
+  }
+  return run_log;
+}
+
+bool is_permutation(const std::vector<std::size_t> &order, std::size_t count)
+{
+  std::vector<std::size_t> expected(count);
+  std::iota(expected.begin(), expected.end(), std::size_t{});
+  return order.size() == count &&
+         std::is_permutation(order.cbegin(), order.cend(), expected.cbegin());
+}
+
+} // namespace
+
+void test_parse()
+{
+  ASSERT(run_order::parse("canonical").m_kind == run_order::kind::canonical);
+  ASSERT(run_order::parse("reverse").to_string() == "reverse");
+  ASSERT(run_order::parse("interleave").to_string() == "interleave");
+  ASSERT(run_order::parse("grouped").to_string() == "grouped");
+
+  const auto random = run_order::parse("random:42");
+  ASSERT(random.m_kind == run_order::kind::random);
+  ASSERT(random.m_seed == 42);
+  ASSERT(random.to_string() == "random:42");
+
+  // A seed is drawn and reported:
+  const auto drawn = run_order::parse("random").to_string();
+  ASSERT(drawn.rfind("random:", 0) == 0);
+  ASSERT(run_order::parse(drawn).to_string() == drawn);
+
+  ASSERT_THROWS_ANY([[maybe_unused]] auto o = run_order::parse("sorted"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto o = run_order::parse("random:"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto o = run_order::parse("random:-1"));
+  ASSERT_THROWS_ANY([[maybe_unused]] auto o = run_order::parse("random:12x"));
+}
+
+void test_permutations()
+{
+  using indices = std::vector<std::size_t>;
+
+  ASSERT((run_order::parse("canonical").get_permutation(4) == indices{0, 1, 2, 3}));
+  ASSERT((run_order::parse("reverse").get_permutation(4) == indices{3, 2, 1, 0}));
+  ASSERT((run_order::parse("interleave").get_permutation(8) == indices{0, 4, 2, 6, 1, 5, 3, 7}));
+  ASSERT((run_order::parse("interleave").get_permutation(5) == indices{0, 4, 2, 1, 3}));
+  ASSERT(run_order::parse("interleave").get_permutation(0).empty());
+  ASSERT((run_order::parse("interleave").get_permutation(1) == indices{0}));
+
+  const auto random = run_order::parse("random:1234");
+  const auto order  = random.get_permutation(100);
+  ASSERT(is_permutation(order, 100));
+  ASSERT(order != run_order::parse("canonical").get_permutation(100));
+  // Reproducible for a seed, independent for each stream:
+  ASSERT(order == random.get_permutation(100));
+  ASSERT(order != random.get_permutation(100, 1));
+  ASSERT(order != run_order::parse("random:1235").get_permutation(100));
+}
+
+void test_runner()
+{
+  using log = std::vector<nvbench::int64_t>;
+  ASSERT((run_with_order("canonical") == log{0, 1, 2, 3, 4, 5, 6, 7}));
+  ASSERT((run_with_order("reverse") == log{7, 6, 5, 4, 3, 2, 1, 0}));
+  ASSERT((run_with_order("interleave") == log{0, 4, 2, 6, 1, 5, 3, 7}));
+
+  const auto random = run_with_order("random:7");
+  ASSERT(random == run_with_order("random:7"));
+  ASSERT(random != run_with_order("canonical"));
+}
+
+int main()
+{
+  test_parse();
+  test_permutations();
+  test_runner();
+}
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/detail/sampling_profiler.cuh>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "test_asserts.cuh"
+
+namespace
+{
+
+// Busy-wait so that CPU time is spent on this thread:
+void spin_for(std::chrono::milliseconds duration)
+{
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end)
+  {
+  }
+}
+
+} // namespace
+
+void test_basic()
+{
+  using namespace std::literals::chrono_literals;
+
+  if (!nvbench::detail::sampling_profiler::is_supported())
+  {
+    return;
+  }
+
+  nvbench::detail::sampling_profiler profiler;
+  profiler.start(1000);
+  spin_for(200ms);
+  profiler.stop();
+
+  // ~200 samples are expected; leave plenty of slack for loaded machines:
+  const auto num_samples = profiler.get_sample_count();
+  ASSERT_MSG(num_samples > 10, "{} samples", num_samples);
+  ASSERT(profiler.get_dropped_count() == 0);
+
+  const auto top = profiler.get_top_functions(3);
+  ASSERT(!top.empty());
+  ASSERT(top.size() <= 3);
+  nvbench::int64_t self_samples = 0;
+  for (std::size_t i = 0; i < top.size(); ++i)
+  {
+    ASSERT(!top[i].name.empty());
+    ASSERT(top[i].self_samples <= top[i].total_samples);
+    ASSERT(top[i].total_samples <= num_samples);
+    if (i > 0)
+    {
+      ASSERT(top[i].self_samples <= top[i - 1].self_samples);
+    }
+    self_samples += top[i].self_samples;
+  }
+  ASSERT(self_samples <= num_samples);
+}
+
+void test_folded_stacks()
+{
+  using namespace std::literals::chrono_literals;
+
+  if (!nvbench::detail::sampling_profiler::is_supported())
+  {
+    return;
+  }
+
+  nvbench::detail::sampling_profiler profiler;
+  profiler.start(1000);
+  spin_for(100ms);
+  profiler.stop();
+
+  const std::string filename = "sampling_profiler_test.folded";
+  profiler.write_folded_stacks(filename);
+
+  // Each line is `frame;...;frame <count>` and the counts add up to the total:
+  std::ifstream file{filename};
+  ASSERT(file.is_open());
+  nvbench::int64_t total = 0;
+  std::string line;
+  while (std::getline(file, line))
+  {
+    const auto space = line.rfind(' ');
+    ASSERT_MSG(space != std::string::npos && space > 0, "Line: '{}'", line);
+    total += std::stoll(line.substr(space + 1));
+  }
+  file.close();
+  std::remove(filename.c_str());
+
+  ASSERT_MSG(total == profiler.get_sample_count(),
+             "{} != {}",
+             total,
+             profiler.get_sample_count());
+}
+
+void test_restart()
+{
+  using namespace std::literals::chrono_literals;
+
+  if (!nvbench::detail::sampling_profiler::is_supported())
+  {
+    return;
+  }
+
+  // Samples accumulate across start/stop intervals, and no samples are
+  // taken while stopped:
+  nvbench::detail::sampling_profiler profiler;
+  profiler.start(1000);
+  spin_for(50ms);
+  profiler.stop();
+  const auto first = profiler.get_sample_count();
+
+  spin_for(50ms);
+  ASSERT(profiler.get_sample_count() == first);
+
+  profiler.start(1000);
+  spin_for(50ms);
+  profiler.stop();
+  ASSERT(profiler.get_sample_count() > first);
+}
+
+int main()
+{
+  test_basic();
+  test_folded_stacks();
+  test_restart();
+}
@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/sanity_check.cuh>
+#include <nvbench/do_not_optimize.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+using sanity_check = nvbench::detail::sanity_check;
+
+namespace
+{
+
+std::string get_warning(const nvbench::state &state)
+{
+  const auto &summaries = state.get_summaries();
+  const auto iter = std::find_if(summaries.cbegin(), summaries.cend(), [](const auto &summ) {
+    return summ.get_tag() == "nv/sanity/warning";
+  });
+  return iter == summaries.cend() ? std::string{} : iter->get_string("value");
+}
+
+} // namespace
+
+void test_barriers()
+{
+  // The barriers don't change values:
+  int value = 42;
+  nvbench::do_not_optimize(value);
+  ASSERT(value == 42);
+
+  const double constant = 1.5;
+  nvbench::do_not_optimize(constant);
+
+  std::array<int, 64> buffer{};
+  buffer[3] = 7;
+  nvbench::do_not_optimize(buffer);
+  nvbench::clobber_memory();
+  ASSERT(buffer[3] == 7);
+
+  int sum = 0;
+  for (int i = 0; i < 100; ++i)
+  {
+    sum += i;
+    nvbench::do_not_optimize(sum);
+  }
+  ASSERT(sum == 4950);
+}
+
+void test_calibrate()
+{
+  nvbench::cpu_timer timer;
+  nvbench::detail::cpu_counters counters;
+  nvbench::detail::counting_cpu_timer counting_timer{timer, counters};
+
+  const auto empty = sanity_check::calibrate(counting_timer, 100);
+  ASSERT(empty.samples == 100);
+  ASSERT(empty.mean >= 0.);
+  ASSERT(empty.mean < 1e-3);
+  ASSERT(empty.stdev >= 0.);
+}
+
+void test_is_empty()
+{
+  const sanity_check::empty_launch empty{20e-9, 2e-9, 1000};
+
+  // Within the noise, or within 10% of the empty time:
+  ASSERT(sanity_check::is_empty(empty, 20e-9, 2e-9, 1000));
+  ASSERT(sanity_check::is_empty(empty, 21e-9, 1e-9, 1000000));
+  ASSERT(sanity_check::is_empty(empty, 25e-9, 50e-9, 100));
+  ASSERT(sanity_check::is_empty(empty, 10e-9, 1e-9, 1000));
+
+  ASSERT(!sanity_check::is_empty(empty, 30e-9, 2e-9, 1000));
+  ASSERT(!sanity_check::is_empty(empty, 1e-6, 1e-7, 10));
+
+  // Not enough samples to tell:
+  ASSERT(!sanity_check::is_empty(empty, 20e-9, 2e-9, 1));
+  ASSERT(!sanity_check::is_empty({20e-9, 2e-9, 0}, 20e-9, 2e-9, 1000));
+}
+
+namespace
+{
+
+// "linear" takes 1 ns per element; "flat" takes about 20 ns regardless of the
+// size, which is also the empty launch time.
+void scaling_generator(nvbench::state &state)
+{
+  const auto elements = state.get_int64("Elements");
+  const bool is_flat  = state.get_string("Variant") == "flat";
+  const auto time     = is_flat ? 20e-9 + 1e-13 * static_cast<double>(elements)
+                               : 1e-9 * static_cast<double>(elements);
+
+  state.add_element_count(static_cast<std::size_t>(elements));
+  auto &summ = state.add_summary("nv/cpu_only/time/cpu/mean");
+  summ.set_float64("value", time);
+
+  sanity_check::add_empty_launch_summaries(state, {20e-9, 1e-9, 1000}, time, 1e-9, 1000);
+}
+NVBENCH_DEFINE_CALLABLE(scaling_generator, scaling_callable);
+
+using benchmark_type = nvbench::benchmark<scaling_callable>;
+using runner_type    = nvbench::runner<benchmark_type>;
+
+} // namespace
+
+void test_size_scaling()
+{
+  benchmark_type bench;
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_power_of_two_axis("Elements", {10, 12, 14});
+  bench.add_string_axis("Variant", {"flat", "linear"});
+  bench.add_int64_axis("Other", {1, 2});
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  ASSERT(bench.get_states().size() == 12);
+  for (const auto &state : bench.get_states())
+  {
+    ASSERT(state.get_summary("nv/cpu_only/time/empty/mean").get_float64("value") == 20e-9);
+
+    // "Other" doesn't change the element count, so it isn't a size axis:
+    const auto warning = get_warning(state);
+    if (state.get_string("Variant") == "flat")
+    {
+      ASSERT_MSG(warning == "no work, flat in Elements", "{}", warning);
+    }
+    else
+    {
+      ASSERT_MSG(warning.empty(), "{}", warning);
+    }
+  }
+}
+
+int main()
+{
+  test_barriers();
+  test_calibrate();
+  test_is_empty();
+  test_size_scaling();
+}
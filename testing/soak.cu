@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/soak.cuh>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+using soak_tracker = nvbench::detail::soak_tracker;
+
+namespace
+{
+
+void dummy_generator(nvbench::state &) {}
+NVBENCH_DEFINE_CALLABLE(dummy_generator, dummy_callable);
+using benchmark_type = nvbench::benchmark<dummy_callable>;
+
+const nvbench::float64_t empty = std::numeric_limits<nvbench::float64_t>::quiet_NaN();
+
+} // namespace
+
+void test_disabled()
+{
+  benchmark_type bench;
+  soak_tracker soak{bench};
+  ASSERT(!soak.is_enabled());
+  ASSERT(soak.get_window_means().empty());
+}
+
+void test_stable()
+{
+  // Noise without a trend:
+  const std::vector<nvbench::float64_t> means{1.00, 1.02, 0.98, 1.01, 0.99, 1.02, 0.98, 1.00};
+  const auto result = soak_tracker::compute_trend(means, 0.05);
+  ASSERT(result.verdict == "STABLE");
+  ASSERT(result.first == 1.00);
+  ASSERT(result.last == 1.00);
+  ASSERT(std::abs(result.drift) < 0.05);
+}
+
+void test_degraded()
+{
+  // 10% slower over the run, with some noise:
+  const std::vector<nvbench::float64_t> means{1.000, 1.016, 1.018, 1.036, 1.038,
+                                              1.056, 1.058, 1.076, 1.078, 1.096};
+  const auto result = soak_tracker::compute_trend(means, 0.05);
+  ASSERT_MSG(result.verdict == "DEGRADED", "Drift: {}", result.drift);
+  ASSERT(std::abs(result.drift - 0.1) < 0.01);
+  ASSERT(result.t_stat > soak_tracker::significant_t_stat);
+
+  // Below the threshold:
+  ASSERT(soak_tracker::compute_trend(means, 0.2).verdict == "STABLE");
+}
+
+void test_improved()
+{
+  const std::vector<nvbench::float64_t> means{2.0, 1.9, 1.8, 1.7, 1.6};
+  const auto result = soak_tracker::compute_trend(means, 0.05);
+  ASSERT(result.verdict == "IMPROVED");
+  ASSERT(std::abs(result.drift + 0.2) < 1e-9);
+  ASSERT(result.t_stat > soak_tracker::significant_t_stat);
+}
+
+void test_insignificant()
+{
+  // A single outlier in the last window is not a trend:
+  const std::vector<nvbench::float64_t> means{1.0, 1.0, 1.0, 1.0, 1.0, 1.5};
+  const auto result = soak_tracker::compute_trend(means, 0.05);
+  ASSERT_MSG(result.verdict == "STABLE", "t = {}", result.t_stat);
+  ASSERT(result.last == 1.5);
+}
+
+void test_empty_windows()
+{
+  const std::vector<nvbench::float64_t> means{empty, 1.0, empty, 1.1, 1.2, empty, 1.3};
+  const auto result = soak_tracker::compute_trend(means, 0.05);
+  ASSERT(result.first == 1.0);
+  ASSERT(result.last == 1.3);
+  ASSERT(result.verdict == "DEGRADED");
+
+  // Too few windows to fit:
+  ASSERT(soak_tracker::compute_trend({empty, 1.0, 2.0}, 0.05).verdict == "STABLE");
+  ASSERT(soak_tracker::compute_trend({}, 0.05).verdict == "STABLE");
+}
+
+void test_iterations()
+{
+  benchmark_type bench;
+  bench.set_soak_iterations(100);
+  bench.set_soak_windows(4);
+
+  soak_tracker soak{bench};
+  ASSERT(soak.is_enabled());
+  for (int i = 0; i < 100; ++i)
+  {
+    ASSERT(!soak.is_finished(0.));
+    soak.add_sample(static_cast<nvbench::float64_t>(i / 25 + 1), 0.);
+  }
+  ASSERT(soak.is_finished(0.));
+
+  const auto means = soak.get_window_means();
+  ASSERT(means.size() == 4);
+  ASSERT(means[0] == 1.);
+  ASSERT(means[1] == 2.);
+  ASSERT(means[2] == 3.);
+  ASSERT(means[3] == 4.);
+}
+
+void test_kept_samples()
+{
+  constexpr auto max_kept = soak_tracker::max_kept_samples;
+  const auto count        = static_cast<nvbench::int64_t>(max_kept + 10);
+
+  // Everything is kept when not soaking:
+  {
+    benchmark_type bench;
+    soak_tracker soak{bench};
+    std::vector<nvbench::float64_t> times;
+    for (nvbench::int64_t i = 0; i < count; ++i)
+    {
+      soak.keep_sample(times, static_cast<nvbench::float64_t>(i), i);
+    }
+    soak_tracker::restore_order(times, count);
+    ASSERT(times.size() == max_kept + 10);
+    ASSERT(times.front() == 0.);
+  }
+
+  // Soak runs keep the most recent samples, in order:
+  benchmark_type bench;
+  bench.set_soak_iterations(count);
+  soak_tracker soak{bench};
+  std::vector<nvbench::float64_t> times;
+  for (nvbench::int64_t i = 0; i < count; ++i)
+  {
+    soak.keep_sample(times, static_cast<nvbench::float64_t>(i), i);
+  }
+  ASSERT(times.size() == max_kept);
+
+  soak_tracker::restore_order(times, count);
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    ASSERT_MSG(times[i] == static_cast<nvbench::float64_t>(i + 10), "{}: {}", i, times[i]);
+  }
+
+  // Nothing to restore before wrapping around:
+  std::vector<nvbench::float64_t> few{1., 2., 3.};
+  soak_tracker::restore_order(few, 3);
+  ASSERT(few == (std::vector<nvbench::float64_t>{1., 2., 3.}));
+}
+
+void test_duration()
+{
+  benchmark_type bench;
+  bench.set_soak_duration(10.);
+  bench.set_soak_windows(5);
+
+  soak_tracker soak{bench};
+  // Samples are binned by the walltime at which they started:
+  soak.add_sample(1., 1.);  // [0, 1)
+  soak.add_sample(1., 3.5); // [2.5, 3.5)
+  soak.add_sample(3., 6.5); // [3.5, 6.5)
+  soak.add_sample(2., 12.); // [10, 12): Past the end
+  ASSERT(!soak.is_finished(9.9));
+  ASSERT(soak.is_finished(10.));
+
+  const auto means = soak.get_window_means();
+  ASSERT(means.size() == 5);
+  ASSERT(means[0] == 1.);
+  ASSERT(means[1] == 2.);
+  ASSERT(std::isnan(means[2]));
+  ASSERT(std::isnan(means[3]));
+  ASSERT(means[4] == 2.);
+}
+
+int main()
+{
+  test_disabled();
+  test_stable();
+  test_degraded();
+  test_improved();
+  test_insignificant();
+  test_empty_windows();
+  test_iterations();
+  test_kept_samples();
+  test_duration();
+}
@@ -116,6 +116,20 @@ void test_summaries()
   ASSERT(state.get_summary("Test Summary1").get_int64("Int") == 128);
   ASSERT(state.get_summary("Test Summary1").get_string("String") == "str");
   ASSERT(state.get_summary("Test Summary2").get_size() == 0);
+
+  {
+    static const auto &desc = nvbench::summary_registry::get().add(
+      {"Test Summary3", "Registered", "duration", "A registered summary"});
+    nvbench::summary &summary = state.add_summary(desc);
+    summary.set_float64("value", 1.5);
+  }
+
+  // Registered summaries are found by tag and by name:
+  ASSERT(state.get_summaries().size() == 3);
+  ASSERT(state.get_summary("Test Summary3").get_descriptor() != nullptr);
+  ASSERT(state.get_summary("Test Summary3").get_float64("value") == 1.5);
+  ASSERT(&state.get_summary("Registered") == &state.get_summary("Test Summary3"));
+  ASSERT_THROWS_ANY([[maybe_unused]] const auto &summ = state.get_summary("Missing"));
 }
 
 void test_defaults()
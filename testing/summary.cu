@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/summary.cuh>
+#include <nvbench/summary_registry.cuh>
+
+#include <algorithm>
+
+#include "test_asserts.cuh"
+
+void test_registry()
+{
+  auto &registry = nvbench::summary_registry::get();
+
+  const auto &desc = registry.add(
+    {"test/registry/time", "Time", "duration", "Test description", "Hidden for testing."});
+  ASSERT(desc.tag == "test/registry/time");
+  ASSERT(registry.find("test/registry/time") == &desc);
+  ASSERT(registry.find("test/registry/missing") == nullptr);
+
+  // Identical descriptors are shared:
+  const auto &again = registry.add(
+    {"test/registry/time", "Time", "duration", "Test description", "Hidden for testing."});
+  ASSERT(&again == &desc);
+
+  // Conflicting metadata and missing tags are rejected:
+  ASSERT_THROWS_ANY(registry.add({"test/registry/time", "Other Time", "duration"}));
+  ASSERT_THROWS_ANY(registry.add({"", "Untagged"}));
+
+  const auto descriptors = registry.get_descriptors();
+  ASSERT(std::count(descriptors.cbegin(), descriptors.cend(), &desc) == 1);
+}
+
+void test_untagged_metadata()
+{
+  nvbench::summary summ{"test/untagged"};
+  ASSERT(summ.get_tag() == "test/untagged");
+  ASSERT(summ.get_descriptor() == nullptr);
+  ASSERT(summ.get_name() == "test/untagged");
+  ASSERT(summ.get_hint().empty());
+  ASSERT(summ.get_description().empty());
+  ASSERT(!summ.is_hidden());
+
+  summ.set_string("name", "Untagged");
+  summ.set_string("hint", "bytes");
+  summ.set_string("hide", "");
+  ASSERT(summ.get_name() == "Untagged");
+  ASSERT(summ.get_hint() == "bytes");
+  ASSERT(summ.is_hidden());
+}
+
+void test_descriptor_metadata()
+{
+  const auto &desc = nvbench::summary_registry::get().add(
+    {"test/descriptor/rate", "Rate", "item_rate", "Items per second"});
+
+  nvbench::summary summ{desc};
+  summ.set_float64("value", 2.0);
+  ASSERT(summ.get_tag() == "test/descriptor/rate");
+  ASSERT(summ.get_descriptor() == &desc);
+  ASSERT(summ.get_name() == "Rate");
+  ASSERT(summ.get_hint() == "item_rate");
+  ASSERT(summ.get_description() == "Items per second");
+  ASSERT(!summ.is_hidden());
+
+  // Only values are stored in the summary:
+  ASSERT(summ.get_size() == 1);
+
+  // Values override the descriptor:
+  summ.set_string("description", "Overridden");
+  summ.set_string("hide", "Hidden for testing.");
+  ASSERT(summ.get_description() == "Overridden");
+  ASSERT(summ.is_hidden());
+
+  // Retagging keeps the metadata:
+  summ.set_tag("test/descriptor/retagged");
+  ASSERT(summ.get_descriptor() == nullptr);
+  ASSERT(summ.get_tag() == "test/descriptor/retagged");
+  ASSERT(summ.get_name() == "Rate");
+  ASSERT(summ.get_hint() == "item_rate");
+  ASSERT(summ.get_description() == "Overridden");
+  ASSERT(summ.get_float64("value") == 2.0);
+}
+
+int main()
+{
+  test_registry();
+  test_untagged_metadata();
+  test_descriptor_metadata();
+}
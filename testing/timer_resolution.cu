@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 with the LLVM exception
+ *  (the "License"); you may not use this file except in compliance with
+ *  the License.
+ *
+ *  You may obtain a copy of the License at
+ *
+ *      http://llvm.org/foundation/relicensing/LICENSE.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <nvbench/benchmark.cuh>
+#include <nvbench/callable.cuh>
+#include <nvbench/detail/timer_resolution.cuh>
+#include <nvbench/runner.cuh>
+#include <nvbench/state.cuh>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "test_asserts.cuh"
+
+using timer_resolution = nvbench::detail::timer_resolution;
+
+namespace
+{
+
+bool has_summary(const nvbench::state &state, const std::string &tag)
+{
+  const auto &summaries = state.get_summaries();
+  return std::any_of(summaries.cbegin(), summaries.cend(), [&tag](const auto &summ) {
+    return summ.get_tag() == tag;
+  });
+}
+
+// A 1 us timer with a mean of "Ticks" ticks:
+void ticks_generator(nvbench::state &state)
+{
+  const auto mean = 1e-6 * static_cast<nvbench::float64_t>(state.get_int64("Ticks"));
+  timer_resolution::add_summaries(state, 1e-6, mean);
+}
+NVBENCH_DEFINE_CALLABLE(ticks_generator, ticks_callable);
+
+using benchmark_type = nvbench::benchmark<ticks_callable>;
+using runner_type    = nvbench::runner<benchmark_type>;
+
+// Fake clocks that take 27 ns to read. "fine" ticks every nanosecond, so
+// consecutive readings never repeat; "coarse" ticks every microsecond.
+nvbench::float64_t measure_fake_clock(const std::string &kind)
+{
+  nvbench::int64_t now = 0;
+  const auto tick      = kind == "fine" ? nvbench::int64_t{1} : nvbench::int64_t{1000};
+  return timer_resolution::measure(
+    [&now, tick]() {
+      now += 27;
+      return now / tick * tick;
+    },
+    1e-9);
+}
+
+void clock_generator(nvbench::state &state)
+{
+  const auto resolution = measure_fake_clock(state.get_string("Clock"));
+  timer_resolution::add_summaries(state, resolution, 346e-9);
+}
+NVBENCH_DEFINE_CALLABLE(clock_generator, clock_callable);
+
+} // namespace
+
+void test_measure()
+{
+  const auto resolution = timer_resolution::measure_cpu(10, 0.001);
+  ASSERT(resolution >= 1e-9);
+  ASSERT(resolution < 1e-3);
+
+  // Measured once per process:
+  const auto cached = timer_resolution::get_cpu();
+  ASSERT(cached >= 1e-9);
+  ASSERT(cached < 1e-3);
+  ASSERT(timer_resolution::get_cpu() == cached);
+}
+
+void test_summaries()
+{
+  benchmark_type bench;
+  bench.set_devices(std::vector<int>{});
+  bench.add_int64_axis("Ticks", {5, 99, 100, 1000});
+
+  runner_type runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  ASSERT(bench.get_states().size() == 4);
+  for (const auto &state : bench.get_states())
+  {
+    const auto ticks = state.get_int64("Ticks");
+    ASSERT(state.get_summary("nv/cpu_only/time/resolution").get_float64("value") == 1e-6);
+
+    const bool flagged = has_summary(state, "nv/cpu_only/time/ticks");
+    ASSERT_MSG(flagged == (ticks < 100), "{} ticks", ticks);
+    if (flagged)
+    {
+      ASSERT(state.get_summary("nv/cpu_only/time/ticks").get_int64("value") <= ticks);
+      ASSERT(state.get_summary("nv/cpu_only/time/ticks").get_int64("value") >= ticks - 1);
+    }
+  }
+}
+
+void test_fake_clocks()
+{
+  // The steps of the fine clock only measure the cost of a read:
+  ASSERT(measure_fake_clock("fine") == 1e-9);
+
+  const auto coarse = measure_fake_clock("coarse");
+  ASSERT_MSG(std::abs(coarse - 1e-6) < 1e-12, "{}", coarse);
+
+  nvbench::benchmark<clock_callable> bench;
+  bench.set_devices(std::vector<int>{});
+  bench.add_string_axis("Clock", {"fine", "coarse"});
+
+  nvbench::runner<nvbench::benchmark<clock_callable>> runner{bench};
+  runner.generate_states();
+  runner.run();
+
+  const auto &states = bench.get_states();
+  ASSERT(states.size() == 2);
+  ASSERT(!has_summary(states[0], "nv/cpu_only/time/ticks"));
+  ASSERT(states[1].get_summary("nv/cpu_only/time/ticks").get_int64("value") == 0);
+}
+
+int main()
+{
+  test_measure();
+  test_summaries();
+  test_fake_clocks();
+}